@@ -0,0 +1,591 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           BattlefieldSnapshot.cpp
+*   @brief          战场快照的保存与恢复。
+*   @details        Battlefield_C 快照相关成员函数的实现。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           头文件。
+*   @{
+*/
+#include <string.h>
+#include "BattlefieldSnapshot.h"
+
+using namespace CombatSimulation;
+/** @}  */
+
+
+//记录区紧随头部，按 8 字节对齐
+static const int snapshot_header_size = (int)((sizeof(SnapshotHeader_T) + 7) / 8 * 8);
+
+//增量记录按字比较，字掩码的每一位对应记录中的一个字
+static_assert(sizeof(AircraftSnapshot_T) % sizeof(SnapshotWord_T) == 0 &&
+	sizeof(AircraftSnapshot_T) / sizeof(SnapshotWord_T) <= 64, "飞机快照记录超出字掩码位数");
+static_assert(sizeof(MissileSnapshot_T) % sizeof(SnapshotWord_T) == 0 &&
+	sizeof(MissileSnapshot_T) / sizeof(SnapshotWord_T) <= 64, "导弹快照记录超出字掩码位数");
+
+
+//把 record 中与 base_record 不同的字写入 data：先写字掩码，再按顺序写掩码中置位的字。返回写入字节数，空间不足时返回 -1
+static int SaveDeltaRecord(
+	const void*						record,
+	const void*						base_record,
+	int								record_size,
+	unsigned char*					data,
+	int								capacity)
+{
+	const unsigned char* word = (const unsigned char*)record;
+	const unsigned char* base_word = (const unsigned char*)base_record;
+	int word_count = record_size / (int)sizeof(SnapshotWord_T);
+	if (capacity < (int)sizeof(SnapshotWord_T)) {
+		return -1;
+	}
+
+	SnapshotWord_T word_mask = 0;
+	int size = (int)sizeof(SnapshotWord_T);
+	for (int w = 0; w < word_count; w++) {
+		int offset = w * (int)sizeof(SnapshotWord_T);
+		if (memcmp(word + offset, base_word + offset, sizeof(SnapshotWord_T)) == 0) {
+			continue;
+		}
+		if (size + (int)sizeof(SnapshotWord_T) > capacity) {
+			return -1;
+		}
+		memcpy(data + size, word + offset, sizeof(SnapshotWord_T));
+		size += (int)sizeof(SnapshotWord_T);
+		word_mask |= (SnapshotWord_T)1 << w;
+	}
+	memcpy(data, &word_mask, sizeof(word_mask));
+
+	return size;
+}
+
+
+//以 base_record 为底，按 data 中的字掩码覆盖有变化的字，结果写入 record。返回读取的字节数
+static int LoadDeltaRecord(
+	const unsigned char*			data,
+	const void*						base_record,
+	int								record_size,
+	void*							record)
+{
+	unsigned char* word = (unsigned char*)record;
+	int word_count = record_size / (int)sizeof(SnapshotWord_T);
+
+	SnapshotWord_T word_mask;
+	memcpy(&word_mask, data, sizeof(word_mask));
+	int size = (int)sizeof(SnapshotWord_T);
+	if (base_record != NULL) {
+		memcpy(record, base_record, record_size);
+	}
+	else {
+		memset(record, 0, record_size);
+	}
+	for (int w = 0; w < word_count; w++) {
+		if ((word_mask & ((SnapshotWord_T)1 << w)) != 0) {
+			memcpy(word + w * (int)sizeof(SnapshotWord_T), data + size, sizeof(SnapshotWord_T));
+			size += (int)sizeof(SnapshotWord_T);
+		}
+	}
+
+	return size;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          快照所需的最大字节数
+*   @details        按 max_object 架飞机、max_object 枚导弹和 SNAPSHOT_MAX_EVENT 个待触发事件计算，
+					预先分配的快照缓冲区不小于此值即可保存任意状态
+*   @retval         字节数
+*/
+int Battlefield_C::SnapshotCapacity()
+{
+	return snapshot_header_size + max_object * (int)sizeof(AircraftSnapshot_T) + max_object * (int)sizeof(MissileSnapshot_T)
+		+ SNAPSHOT_MAX_EVENT * (int)sizeof(EventRecord_T);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          保存完整快照
+*   @details        按实体数线性复制，不分配内存。快照不含指针，可按字节复制到任意位置。待触发的调度事件一并保存
+*   @param[out]     buffer          快照缓冲区
+*   @param[in]      buffer_size     缓冲区字节数
+*   @param[out]     out_size        快照字节数，可为 NULL
+*   @retval         0               正常
+*   @retval         1               错误，缓冲区不足或待触发事件超过 SNAPSHOT_MAX_EVENT
+*/
+int Battlefield_C::SaveSnapshot(
+	void*							buffer,
+	int								buffer_size,
+	int*							out_size) const
+{
+	int event_count = event_scheduler.PendingCount();
+	int size = snapshot_header_size + aircraft_count * (int)sizeof(AircraftSnapshot_T)
+		+ missile_count * (int)sizeof(MissileSnapshot_T) + event_count * (int)sizeof(EventRecord_T);
+	if (buffer == NULL || buffer_size < size || event_count > SNAPSHOT_MAX_EVENT) {
+		return 1;
+	}
+
+	unsigned char* data = (unsigned char*)buffer;
+	SnapshotHeader_T* header = (SnapshotHeader_T*)data;
+	SaveHeader(header);
+	header->kind = SNAPSHOT_FULL;
+	header->size = size;
+
+	AircraftSnapshot_T* aircraft_record = (AircraftSnapshot_T*)(data + snapshot_header_size);
+	for (int i = 0; i < aircraft_count; i++) {
+		SaveAircraft(i, &aircraft_record[i]);
+	}
+	MissileSnapshot_T* missile_record = (MissileSnapshot_T*)(aircraft_record + aircraft_count);
+	for (int i = 0; i < missile_count; i++) {
+		SaveMissile(i, &missile_record[i]);
+	}
+	EventRecord_T* event_record = (EventRecord_T*)(missile_record + missile_count);
+	event_scheduler.Save(event_record, event_count, &header->event_count);
+
+	if (out_size != NULL) {
+		*out_size = size;
+	}
+
+	return CS_OK;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          保存增量快照
+*   @details        只记录与基准快照不同的实体，且每个实体只记录与基准不同的字(8 字节)，未变化的实体和字恢复时取自基准快照。
+					只推进一步或只改动少数控制量的分支，增量远小于完整快照。待触发的调度事件总是完整保存
+*   @param[in]      base            基准快照，必须是完整快照
+*   @param[out]     buffer          快照缓冲区
+*   @param[in]      buffer_size     缓冲区字节数
+*   @param[out]     out_size        快照字节数，可为 NULL
+*   @retval         0               正常
+*   @retval         1               错误，缓冲区不足或待触发事件超过 SNAPSHOT_MAX_EVENT
+*/
+int Battlefield_C::SaveDelta(
+	const void*						base,
+	void*							buffer,
+	int								buffer_size,
+	int*							out_size) const
+{
+	const SnapshotHeader_T* base_header = (const SnapshotHeader_T*)base;
+	if (base == NULL || buffer == NULL || buffer_size < snapshot_header_size ||
+		base_header->magic != SNAPSHOT_MAGIC || base_header->kind != SNAPSHOT_FULL) {
+		return 1;
+	}
+
+	const AircraftSnapshot_T* base_aircraft = (const AircraftSnapshot_T*)((const unsigned char*)base + snapshot_header_size);
+	const MissileSnapshot_T* base_missile = (const MissileSnapshot_T*)(base_aircraft + base_header->aircraft_count);
+
+	unsigned char* data = (unsigned char*)buffer;
+	SnapshotHeader_T* header = (SnapshotHeader_T*)data;
+	SaveHeader(header);
+	header->kind = SNAPSHOT_DELTA;
+
+	//逐个实体生成记录，与基准相同的不写入，有变化的只写入变化的字；基准中没有的实体以全零记录为底
+	int size = snapshot_header_size;
+	for (int i = 0; i < aircraft_count; i++) {
+		AircraftSnapshot_T record;
+		AircraftSnapshot_T zero_record;
+		SaveAircraft(i, &record);
+		if (i < base_header->aircraft_count && memcmp(&record, &base_aircraft[i], sizeof(record)) == 0) {
+			continue;
+		}
+		memset(&zero_record, 0, sizeof(zero_record));
+		int record_size = SaveDeltaRecord(&record, (i < base_header->aircraft_count) ? &base_aircraft[i] : &zero_record,
+			(int)sizeof(record), data + size, buffer_size - size);
+		if (record_size < 0) {
+			return 1;
+		}
+		size += record_size;
+		header->aircraft_mask |= 1u << i;
+	}
+	for (int i = 0; i < missile_count; i++) {
+		MissileSnapshot_T record;
+		MissileSnapshot_T zero_record;
+		SaveMissile(i, &record);
+		if (i < base_header->missile_count && memcmp(&record, &base_missile[i], sizeof(record)) == 0) {
+			continue;
+		}
+		memset(&zero_record, 0, sizeof(zero_record));
+		int record_size = SaveDeltaRecord(&record, (i < base_header->missile_count) ? &base_missile[i] : &zero_record,
+			(int)sizeof(record), data + size, buffer_size - size);
+		if (record_size < 0) {
+			return 1;
+		}
+		size += record_size;
+		header->missile_mask |= 1u << i;
+	}
+
+	int event_count = event_scheduler.PendingCount();
+	if (event_count > SNAPSHOT_MAX_EVENT || size + event_count * (int)sizeof(EventRecord_T) > buffer_size) {
+		return 1;
+	}
+	event_scheduler.Save((EventRecord_T*)(data + size), event_count, &header->event_count);
+	size += event_count * (int)sizeof(EventRecord_T);
+
+	header->size = size;
+	if (out_size != NULL) {
+		*out_size = size;
+	}
+
+	return CS_OK;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          恢复快照
+*   @details        恢复全部实体状态、活动列表和本步击毁事件，并重建空间索引。快照中的名字编号指向保存时战场的字符串表，
+					恢复到其他战场时应先复制字符串表(string_table = 源战场.string_table)。
+					待触发的调度事件按保存时的节点、序号和时间片恢复，保存时取得的事件句柄仍可取消；
+					事件处理函数和上下文不在快照中，沿用目标战场已登记的(SetHandler)
+*   @param[in]      snapshot        完整快照或增量快照
+*   @param[in]      base            增量快照的基准快照，恢复完整快照时可为 NULL
+*   @retval         0               正常
+*   @retval         1               错误，快照无效或缺少基准
+*/
+int Battlefield_C::RestoreSnapshot(
+	const void*						snapshot,
+	const void*						base)
+{
+	const SnapshotHeader_T* header = (const SnapshotHeader_T*)snapshot;
+	if (snapshot == NULL || header->magic != SNAPSHOT_MAGIC ||
+		header->aircraft_count < 0 || header->aircraft_count > max_object ||
+		header->missile_count < 0 || header->missile_count > max_object ||
+		header->event_count < 0 || header->event_count > SNAPSHOT_MAX_EVENT) {
+		return 1;
+	}
+
+	const unsigned char* record = (const unsigned char*)snapshot + snapshot_header_size;
+	const AircraftSnapshot_T* base_aircraft = NULL;
+	const MissileSnapshot_T* base_missile = NULL;
+	int base_aircraft_count = 0;
+	int base_missile_count = 0;
+
+	if (header->kind == SNAPSHOT_DELTA) {
+		//未记录的实体必须能在基准快照中找到
+		const SnapshotHeader_T* base_header = (const SnapshotHeader_T*)base;
+		if (base == NULL || base_header->magic != SNAPSHOT_MAGIC || base_header->kind != SNAPSHOT_FULL) {
+			return 1;
+		}
+		for (int i = 0; i < header->aircraft_count; i++) {
+			if ((header->aircraft_mask & (1u << i)) == 0 && i >= base_header->aircraft_count) {
+				return 1;
+			}
+		}
+		for (int i = 0; i < header->missile_count; i++) {
+			if ((header->missile_mask & (1u << i)) == 0 && i >= base_header->missile_count) {
+				return 1;
+			}
+		}
+		base_aircraft = (const AircraftSnapshot_T*)((const unsigned char*)base + snapshot_header_size);
+		base_missile = (const MissileSnapshot_T*)(base_aircraft + base_header->aircraft_count);
+		base_aircraft_count = base_header->aircraft_count;
+		base_missile_count = base_header->missile_count;
+	}
+	else if (header->kind != SNAPSHOT_FULL) {
+		return 1;
+	}
+
+	for (int i = 0; i < header->aircraft_count; i++) {
+		AircraftSnapshot_T entity;
+		if (header->kind == SNAPSHOT_FULL) {
+			memcpy(&entity, record, sizeof(entity));
+			record += sizeof(entity);
+			LoadAircraft(i, entity);
+		}
+		else if ((header->aircraft_mask & (1u << i)) != 0) {
+			record += LoadDeltaRecord(record, (i < base_aircraft_count) ? &base_aircraft[i] : NULL, (int)sizeof(entity), &entity);
+			LoadAircraft(i, entity);
+		}
+		else {
+			LoadAircraft(i, base_aircraft[i]);
+		}
+	}
+	for (int i = 0; i < header->missile_count; i++) {
+		MissileSnapshot_T entity;
+		if (header->kind == SNAPSHOT_FULL) {
+			memcpy(&entity, record, sizeof(entity));
+			record += sizeof(entity);
+			LoadMissile(i, entity);
+		}
+		else if ((header->missile_mask & (1u << i)) != 0) {
+			record += LoadDeltaRecord(record, (i < base_missile_count) ? &base_missile[i] : NULL, (int)sizeof(entity), &entity);
+			LoadMissile(i, entity);
+		}
+		else {
+			LoadMissile(i, base_missile[i]);
+		}
+	}
+
+	//快照之外的槽位视为空
+	for (int i = header->aircraft_count; i < aircraft_count; i++) {
+		aircraft_list[i].base_live = 0;
+	}
+	for (int i = header->missile_count; i < missile_count; i++) {
+		missile_list[i].base_live = 0;
+		missile_list[i].missile_live = 0;
+	}
+
+	time = header->time;
+	aircraft_count = header->aircraft_count;
+	missile_count = header->missile_count;
+
+	active_aircraft_count = header->active_aircraft_count;
+	active_missile_count = header->active_missile_count;
+	aircraft_synced = header->aircraft_synced;
+	missile_synced = header->missile_synced;
+	memcpy(active_aircraft_list, header->active_aircraft_list, sizeof(active_aircraft_list));
+	memcpy(active_missile_list, header->active_missile_list, sizeof(active_missile_list));
+	memcpy(aircraft_dead_seen, header->aircraft_dead_seen, sizeof(aircraft_dead_seen));
+	memcpy(missile_dead_seen, header->missile_dead_seen, sizeof(missile_dead_seen));
+
+	kill_event_count = header->kill_event_count;
+	memcpy(kill_event_list, header->kill_event_list, sizeof(kill_event_list));
+
+	lod_enable = header->lod_enable;
+	lod_promote_range = header->lod_promote_range;
+	lod_demote_range = header->lod_demote_range;
+
+	UpdateSpatialIndex();
+
+	//事件记录紧随实体记录
+	if (event_scheduler.Load((const EventRecord_T*)record, header->event_count, header->event_tick, header->event_serial) != 0) {
+		return 1;
+	}
+
+	return CS_OK;
+}
+
+
+void Battlefield_C::SaveHeader(SnapshotHeader_T* header) const
+{
+	memset(header, 0, sizeof(SnapshotHeader_T));
+	header->magic = SNAPSHOT_MAGIC;
+
+	header->time = time;
+	header->aircraft_count = aircraft_count;
+	header->missile_count = missile_count;
+
+	header->active_aircraft_count = active_aircraft_count;
+	header->active_missile_count = active_missile_count;
+	header->aircraft_synced = aircraft_synced;
+	header->missile_synced = missile_synced;
+	//只复制有效部分，其余保持为0，相同状态的战场快照逐字节相同
+	memcpy(header->active_aircraft_list, active_aircraft_list, active_aircraft_count * sizeof(int));
+	memcpy(header->active_missile_list, active_missile_list, active_missile_count * sizeof(int));
+	memcpy(header->aircraft_dead_seen, aircraft_dead_seen, aircraft_synced * sizeof(int));
+	memcpy(header->missile_dead_seen, missile_dead_seen, missile_synced * sizeof(int));
+
+	header->kill_event_count = kill_event_count;
+	memcpy(header->kill_event_list, kill_event_list, kill_event_count * sizeof(KillEvent_T));
+
+	header->lod_enable = lod_enable;
+	header->lod_promote_range = lod_promote_range;
+	header->lod_demote_range = lod_demote_range;
+
+	header->event_serial = event_scheduler.NextSerial();
+	header->event_tick = event_scheduler.CurrentTick();
+}
+
+
+void Battlefield_C::SaveAircraft(int index, AircraftSnapshot_T* record) const
+{
+	const Aircraft_Object_C& air = aircraft_list[index];
+
+	//清零填充字节，增量快照按字节比较记录
+	memset(record, 0, sizeof(AircraftSnapshot_T));
+
+	record->base_live = air.base_live;
+	record->base_team = air.base_team;
+	record->Sim_id = air.Sim_id;
+	record->base_name_id = air.p_cold->base_name_id;
+	record->base_type_id = air.p_cold->base_type_id;
+	record->lod_level = air.lod_level;
+
+	record->coordinate[0] = air.coordinate_longitude;
+	record->coordinate[1] = air.coordinate_latitude;
+	record->coordinate[2] = air.coordinate_altitude;
+	record->coordinate[3] = air.coordinate_roll;
+	record->coordinate[4] = air.coordinate_pitch;
+	record->coordinate[5] = air.coordinate_yaw;
+	record->velocity[0] = air.velocity_north;
+	record->velocity[1] = air.velocity_east;
+	record->velocity[2] = air.velocity_downward;
+
+	for (int r = 0; r < 4; r++) {
+		for (int c = 0; c < 4; c++) {
+			record->craft_state[r * 4 + c] = air.craft_state(r, c);
+		}
+		record->craft_handle[r] = air.craft_handle(r);
+	}
+
+	record->lod_interval = air.lod_interval;
+	record->lod_elapsed = air.lod_elapsed;
+	for (int i = 0; i < 3; i++) {
+		record->lod_turn_rate[i] = air.lod_turn_rate(i);
+	}
+	for (int i = 0; i < 4; i++) {
+		record->lod_handle[i] = air.lod_handle(i);
+	}
+
+	record->radar_state = air.p_cold->radar_state;
+	record->mounted_missile_count = air.p_cold->mounted_missile_count;
+	record->locked_id_count = air.p_cold->locked_id_count;
+	memcpy(record->locked_id_list, air.p_cold->locked_id_list, sizeof(record->locked_id_list));
+}
+
+
+void Battlefield_C::SaveMissile(int index, MissileSnapshot_T* record) const
+{
+	const Missile_Object_C& missile = missile_list[index];
+
+	memset(record, 0, sizeof(MissileSnapshot_T));
+
+	record->base_live = missile.base_live;
+	record->base_team = missile.base_team;
+	record->Sim_id = missile.Sim_id;
+	record->base_name_id = missile.p_cold->base_name_id;
+	record->base_type_id = missile.p_cold->base_type_id;
+	record->missile_live = missile.missile_live;
+	record->father_id = missile.father_id;
+	record->target_index = (missile.p_target_air != NULL) ? (int)(missile.p_target_air - aircraft_list) : -1;
+
+	record->coordinate[0] = missile.coordinate_longitude;
+	record->coordinate[1] = missile.coordinate_latitude;
+	record->coordinate[2] = missile.coordinate_altitude;
+	record->coordinate[3] = missile.coordinate_roll;
+	record->coordinate[4] = missile.coordinate_pitch;
+	record->coordinate[5] = missile.coordinate_yaw;
+	record->velocity[0] = missile.velocity_north;
+	record->velocity[1] = missile.velocity_east;
+	record->velocity[2] = missile.velocity_downward;
+
+	for (int r = 0; r < 4; r++) {
+		for (int c = 0; c < 4; c++) {
+			record->missile_state[r * 4 + c] = missile.missile_state(r, c);
+		}
+		record->missile_handle[r] = missile.missile_handle(r);
+	}
+
+	record->destroy_range = missile.destroy_range;
+	record->max_journey = missile.max_journey;
+	record->distance_target = missile.distance_target;
+	for (int i = 0; i < 3; i++) {
+		record->missile_position_last[i] = missile.missile_position_last(i);
+	}
+	record->missile_journey = missile.missile_journey;
+	record->missile_err[0] = missile.missile_errA;
+	record->missile_err[1] = missile.missile_errP;
+	record->missile_err[2] = missile.missile_errR;
+	record->missile_err[3] = missile.missile_errAsum;
+	record->missile_err[4] = missile.missile_errPsum;
+
+	record->radar_state = missile.p_cold->radar_state;
+	record->lead_state = missile.p_cold->lead_state;
+}
+
+
+void Battlefield_C::LoadAircraft(int index, const AircraftSnapshot_T& record)
+{
+	Aircraft_Object_C& air = aircraft_list[index];
+
+	air.base_live = record.base_live;
+	air.base_team = record.base_team;
+	air.Sim_id = record.Sim_id;
+	air.p_cold->base_name_id = record.base_name_id;
+	air.p_cold->base_type_id = record.base_type_id;
+	air.lod_level = record.lod_level;
+
+	air.coordinate_longitude = record.coordinate[0];
+	air.coordinate_latitude = record.coordinate[1];
+	air.coordinate_altitude = record.coordinate[2];
+	air.coordinate_roll = record.coordinate[3];
+	air.coordinate_pitch = record.coordinate[4];
+	air.coordinate_yaw = record.coordinate[5];
+	air.velocity_north = record.velocity[0];
+	air.velocity_east = record.velocity[1];
+	air.velocity_downward = record.velocity[2];
+
+	for (int r = 0; r < 4; r++) {
+		for (int c = 0; c < 4; c++) {
+			air.craft_state(r, c) = record.craft_state[r * 4 + c];
+		}
+		air.craft_handle(r) = record.craft_handle[r];
+	}
+
+	air.lod_interval = record.lod_interval;
+	air.lod_elapsed = record.lod_elapsed;
+	for (int i = 0; i < 3; i++) {
+		air.lod_turn_rate(i) = record.lod_turn_rate[i];
+	}
+	for (int i = 0; i < 4; i++) {
+		air.lod_handle(i) = record.lod_handle[i];
+	}
+
+	air.p_cold->radar_state = record.radar_state;
+	air.p_cold->mounted_missile_count = record.mounted_missile_count;
+	air.p_cold->locked_id_count = record.locked_id_count;
+	memcpy(air.p_cold->locked_id_list, record.locked_id_list, sizeof(air.p_cold->locked_id_list));
+}
+
+
+void Battlefield_C::LoadMissile(int index, const MissileSnapshot_T& record)
+{
+	Missile_Object_C& missile = missile_list[index];
+
+	missile.base_live = record.base_live;
+	missile.base_team = record.base_team;
+	missile.Sim_id = record.Sim_id;
+	missile.p_cold->base_name_id = record.base_name_id;
+	missile.p_cold->base_type_id = record.base_type_id;
+	missile.missile_live = record.missile_live;
+	missile.father_id = record.father_id;
+	missile.p_target_air = (record.target_index >= 0 && record.target_index < max_object) ?
+		&aircraft_list[record.target_index] : NULL;
+
+	missile.coordinate_longitude = record.coordinate[0];
+	missile.coordinate_latitude = record.coordinate[1];
+	missile.coordinate_altitude = record.coordinate[2];
+	missile.coordinate_roll = record.coordinate[3];
+	missile.coordinate_pitch = record.coordinate[4];
+	missile.coordinate_yaw = record.coordinate[5];
+	missile.velocity_north = record.velocity[0];
+	missile.velocity_east = record.velocity[1];
+	missile.velocity_downward = record.velocity[2];
+
+	for (int r = 0; r < 4; r++) {
+		for (int c = 0; c < 4; c++) {
+			missile.missile_state(r, c) = record.missile_state[r * 4 + c];
+		}
+		missile.missile_handle(r) = record.missile_handle[r];
+	}
+
+	missile.destroy_range = record.destroy_range;
+	missile.max_journey = record.max_journey;
+	missile.distance_target = record.distance_target;
+	for (int i = 0; i < 3; i++) {
+		missile.missile_position_last(i) = record.missile_position_last[i];
+	}
+	missile.missile_journey = record.missile_journey;
+	missile.missile_errA = record.missile_err[0];
+	missile.missile_errP = record.missile_err[1];
+	missile.missile_errR = record.missile_err[2];
+	missile.missile_errAsum = record.missile_err[3];
+	missile.missile_errPsum = record.missile_err[4];
+
+	missile.p_cold->radar_state = record.radar_state;
+	missile.p_cold->lead_state = record.lead_state;
+}
@@ -0,0 +1,156 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           BattlefieldSnapshot.h
+*   @brief          战场快照数据结构。
+*   @details        快照由一个头部和若干实体记录组成，全部为不含指针的平凡结构，可直接按字节复制、保存到文件或在进程间传递。
+					目标飞机指针记录为 aircraft_list 下标，战场信息指针和字符串表不进入快照，恢复时沿用目标战场自身的。
+					完整快照包含全部实体记录；增量快照只包含相对基准快照有变化的实体中有变化的字，用于搜索树中大量分支的廉价保存。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+#ifndef Battlefield_Snapshot_H
+#define Battlefield_Snapshot_H
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           头文件。
+*   @{
+*/
+#include "UnitDefine.h"
+
+/** @}  */
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          CombatSimulation 命名空间。
+*   @details        CombatSimulation 命名空间。
+*/
+namespace CombatSimulation
+{
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @name           快照宏定义。
+	*   @{
+	*/
+#define SNAPSHOT_MAGIC 0x50414E53 //快照标识 "SNAP"
+#define SNAPSHOT_FULL 0           //完整快照
+#define SNAPSHOT_DELTA 1          //增量快照
+#define SNAPSHOT_MAX_EVENT 256    //快照可保存的待触发调度事件数
+	/** @}  */
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          快照字。
+	*   @details        增量快照比较和保存的单位，实体记录按此长度划分为字，字掩码也用此类型保存。
+	*/
+	typedef unsigned long long SnapshotWord_T;
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          飞机快照记录。
+	*   @details        飞机快照记录。
+	*/
+	struct AircraftSnapshot_T
+	{
+		int								base_live;
+		int								base_team;
+		int								Sim_id;
+		int								base_name_id;
+		int								base_type_id;
+		int								lod_level;
+		double							coordinate[6];					//!< 经度、纬度、高度、滚转、俯仰、偏航
+		double							velocity[3];					//!< 北、东、地向速度
+		double							craft_state[16];				//!< 飞机状态，按行存放
+		double							craft_handle[4];				//!< 飞机控制参数
+		double							lod_interval;
+		double							lod_elapsed;
+		double							lod_turn_rate[3];
+		double							lod_handle[4];
+		int								radar_state;
+		int								mounted_missile_count;
+		int								locked_id_count;
+		int								locked_id_list[max_object];
+	};
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          导弹快照记录。
+	*   @details        导弹快照记录。
+	*/
+	struct MissileSnapshot_T
+	{
+		int								base_live;
+		int								base_team;
+		int								Sim_id;
+		int								base_name_id;
+		int								base_type_id;
+		int								missile_live;
+		int								father_id;
+		int								target_index;					//!< 目标飞机在 aircraft_list 中的下标，无目标时为 -1
+		double							coordinate[6];					//!< 经度、纬度、高度、滚转、俯仰、偏航
+		double							velocity[3];					//!< 北、东、地向速度
+		double							missile_state[16];				//!< 导弹状态，按行存放
+		double							missile_handle[4];				//!< 导弹控制参数
+		double							destroy_range;
+		double							max_journey;
+		double							distance_target;
+		double							missile_position_last[3];
+		double							missile_journey;
+		double							missile_err[5];					//!< 制导误差：方位、俯仰、滚转、累积方位、累积俯仰
+		int								radar_state;
+		int								lead_state;
+	};
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          快照头部。
+	*   @details        其后依次为飞机记录、导弹记录和 event_count 条待触发事件记录(EventRecord_T)。完整快照中实体记录数等于实体数；
+					增量快照中只有 aircraft_mask/missile_mask 中置位的实体有记录，按下标从小到大排列；每条记录先是一个字掩码(SnapshotWord_T)，
+					第 w 位置位表示实体记录的第 w 个字与基准不同，其后按顺序为这些字，基准中没有的实体以全零记录为底。事件记录总是完整保存。
+	*/
+	struct SnapshotHeader_T
+	{
+		int								magic;							//!< SNAPSHOT_MAGIC
+		int								kind;							//!< SNAPSHOT_FULL/SNAPSHOT_DELTA
+		int								size;							//!< 快照总字节数
+		unsigned int					aircraft_mask;					//!< 增量快照中有记录的飞机
+		unsigned int					missile_mask;					//!< 增量快照中有记录的导弹
+
+		double							time;
+		int								aircraft_count;
+		int								missile_count;
+
+		int								active_aircraft_count;
+		int								active_aircraft_list[max_object];
+		int								active_missile_count;
+		int								active_missile_list[max_object];
+		int								aircraft_synced;
+		int								missile_synced;
+		int								aircraft_dead_seen[max_object];
+		int								missile_dead_seen[max_object];
+
+		int								kill_event_count;
+		KillEvent_T						kill_event_list[max_object];
+
+		int								lod_enable;
+		double							lod_promote_range;
+		double							lod_demote_range;
+
+		int								event_count;					//!< 待触发事件记录数
+		unsigned int					event_serial;					//!< 调度器下一个登记序号
+		long long						event_tick;						//!< 调度器已处理到的时间片
+	};
+}
+
+
+
+#endif // Battlefield_Snapshot_H
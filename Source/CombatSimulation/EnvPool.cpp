@@ -0,0 +1,252 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           EnvPool.cpp
+*   @brief          异步战场池实现。
+*   @details        异步战场池实现。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           头文件。
+*   @{
+*/
+#include <string.h>
+#include <chrono>
+#include "EnvPool.h"
+
+using namespace CombatSimulation;
+/** @}  */
+
+
+//空转等待：先让出时间片，多次落空后短暂休眠，空闲时不占满核
+static void IdleWait(int* idle_count)
+{
+	(*idle_count)++;
+	if (*idle_count < 64) {
+		std::this_thread::yield();
+	}
+	else {
+		std::this_thread::sleep_for(std::chrono::microseconds(50));
+	}
+}
+
+
+EnvPool_C::EnvPool_C(
+	int								in_env_count,
+	int								in_agent_count,
+	int								in_thread_count)
+	: envs(in_env_count, in_agent_count, 1),
+	request_queue(in_env_count),
+	complete_queue(in_env_count)
+{
+	int env_count = envs.EnvCount();
+	int agent_count = envs.AgentCount();
+
+	env_state = new int[env_count];
+	request_type = new int[env_count];
+	action_buffer = new double[(size_t)env_count * agent_count * VB_ACTION_SIZE];
+	obs_buffer = new double[(size_t)env_count * agent_count * envs.ObsSize()];
+	reward_buffer = new double[(size_t)env_count * agent_count];
+	done_buffer = new int[env_count];
+	in_flight = 0;
+
+	for (int i = 0; i < env_count; i++) {
+		env_state[i] = EP_IDLE;
+		request_type[i] = EP_IDLE;
+		done_buffer[i] = 0;
+	}
+
+	if (in_thread_count <= 0) {
+		in_thread_count = (int)std::thread::hardware_concurrency();
+		if (in_thread_count <= 0) {
+			in_thread_count = 1;
+		}
+	}
+
+	stopping.store(false);
+	for (int i = 0; i < in_thread_count; i++) {
+		thread_list.push_back(std::thread(&EnvPool_C::WorkerLoop, this));
+	}
+}
+
+
+EnvPool_C::~EnvPool_C()
+{
+	stopping.store(true);
+	for (size_t i = 0; i < thread_list.size(); i++) {
+		thread_list[i].join();
+	}
+
+	delete[] env_state;
+	delete[] request_type;
+	delete[] action_buffer;
+	delete[] obs_buffer;
+	delete[] reward_buffer;
+	delete[] done_buffer;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          提交全部战场的初始化请求
+*   @details        初始化完成的战场经 Recv 取回初始观测，奖励为0，结束标志为0
+*   @retval         0               正常
+*   @retval         1               错误，有战场的请求尚未取回
+*/
+int EnvPool_C::AsyncReset()
+{
+	for (int i = 0; i < envs.EnvCount(); i++) {
+		if (env_state[i] != EP_IDLE) {
+			return 1;
+		}
+	}
+
+	for (int i = 0; i < envs.EnvCount(); i++) {
+		Submit(i, EP_RESET);
+	}
+
+	return CS_OK;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          提交推进请求
+*   @details        复制控制量后立即返回，由工作线程推进
+*   @param[in]      env_ids         战场序号 [count]
+*   @param[in]      count           战场个数
+*   @param[in]      actions         控制量 [count][agent_count][VB_ACTION_SIZE]
+*   @retval         0               正常
+*   @retval         1               错误，序号无效或该战场的请求尚未取回
+*/
+int EnvPool_C::Send(
+	const int*						env_ids,
+	int								count,
+	const double*					actions)
+{
+	if (env_ids == NULL || actions == NULL || count < 0) {
+		return 1;
+	}
+
+	//先整体检查，出错时不提交任何战场
+	for (int k = 0; k < count; k++) {
+		int env_index = env_ids[k];
+		if (env_index < 0 || env_index >= envs.EnvCount() || env_state[env_index] != EP_IDLE) {
+			return 1;
+		}
+	}
+
+	size_t action_size = (size_t)envs.AgentCount() * VB_ACTION_SIZE;
+	for (int k = 0; k < count; k++) {
+		int env_index = env_ids[k];
+		memcpy(action_buffer + env_index * action_size, actions + k * action_size, action_size * sizeof(double));
+		Submit(env_index, EP_STEP);
+	}
+
+	return CS_OK;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          取回最先完成的一批结果
+*   @details        阻塞直到取回 batch_size 个战场的结果，未取回的请求不足 batch_size 时只等待这些请求
+*   @param[in]      batch_size      取回个数
+*   @param[out]     env_ids_out     战场序号 [batch_size]
+*   @param[out]     obs_out         观测 [batch_size][agent_count][ObsSize()]
+*   @param[out]     reward_out      奖励 [batch_size][agent_count]
+*   @param[out]     done_out        结束标志 [batch_size]
+*   @retval         实际取回的个数
+*/
+int EnvPool_C::Recv(
+	int								batch_size,
+	int*							env_ids_out,
+	double*							obs_out,
+	double*							reward_out,
+	int*							done_out)
+{
+	if (env_ids_out == NULL || obs_out == NULL || reward_out == NULL || done_out == NULL) {
+		return 0;
+	}
+	if (batch_size > in_flight) {
+		batch_size = in_flight;
+	}
+
+	size_t obs_size = (size_t)envs.AgentCount() * envs.ObsSize();
+	size_t reward_size = (size_t)envs.AgentCount();
+
+	int received = 0;
+	int idle_count = 0;
+	while (received < batch_size) {
+		int env_index;
+		if (complete_queue.Pop(&env_index) != 0) {
+			IdleWait(&idle_count);
+			continue;
+		}
+		idle_count = 0;
+
+		env_ids_out[received] = env_index;
+		memcpy(obs_out + received * obs_size, obs_buffer + env_index * obs_size, obs_size * sizeof(double));
+		memcpy(reward_out + received * reward_size, reward_buffer + env_index * reward_size, reward_size * sizeof(double));
+		done_out[received] = done_buffer[env_index];
+
+		env_state[env_index] = EP_IDLE;
+		in_flight--;
+		received++;
+	}
+
+	return received;
+}
+
+
+int EnvPool_C::Submit(int env_index, int type)
+{
+	env_state[env_index] = type;
+	request_type[env_index] = type;
+	in_flight++;
+
+	//队列容量不小于战场数，而每个战场至多在队列中出现一次，不会满
+	request_queue.Push(env_index);
+
+	return CS_OK;
+}
+
+
+void EnvPool_C::WorkerLoop()
+{
+	size_t action_size = (size_t)envs.AgentCount() * VB_ACTION_SIZE;
+	size_t obs_size = (size_t)envs.AgentCount() * envs.ObsSize();
+	size_t reward_size = (size_t)envs.AgentCount();
+
+	int idle_count = 0;
+	while (!stopping.load(std::memory_order_relaxed)) {
+		int env_index;
+		if (request_queue.Pop(&env_index) != 0) {
+			IdleWait(&idle_count);
+			continue;
+		}
+		idle_count = 0;
+
+		if (request_type[env_index] == EP_RESET) {
+			envs.ResetEnv(env_index, obs_buffer + env_index * obs_size);
+			for (size_t a = 0; a < reward_size; a++) {
+				reward_buffer[env_index * reward_size + a] = 0;
+			}
+			done_buffer[env_index] = 0;
+		}
+		else {
+			envs.StepEnv(env_index, action_buffer + env_index * action_size, obs_buffer + env_index * obs_size,
+				reward_buffer + env_index * reward_size, done_buffer + env_index);
+		}
+
+		complete_queue.Push(env_index);
+	}
+}
@@ -0,0 +1,172 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           EnvPool.h
+*   @brief          异步战场池。
+*   @details        工作线程各自独立推进战场，调用者用 Send 提交一部分战场的控制量，用 Recv 取回最先完成的一批结果，
+					单个耗时较长的战场(多枚导弹齐射、重新初始化等)不会拖慢其余战场。
+					请求与完成通过无锁队列传递，逐步调用中不分配内存。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+#ifndef Env_Pool_H
+#define Env_Pool_H
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           头文件。
+*   @{
+*/
+#include <vector>
+#include <thread>
+#include <atomic>
+#include "VecBattlefield.h"
+#include "../Tools/lockfree_queue.h"
+
+/** @}  */
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          CombatSimulation 命名空间。
+*   @details        CombatSimulation 命名空间。
+*/
+namespace CombatSimulation
+{
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @name           异步战场池宏定义。
+	*   @{
+	*/
+#define EP_IDLE 0    //战场空闲，可以提交
+#define EP_STEP 1    //已提交推进请求
+#define EP_RESET 2   //已提交初始化请求
+	/** @}  */
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          异步战场池。
+	*   @details        每个战场同一时刻至多有一个未取回的请求。Send、Recv 和 AsyncReset 只能由同一个线程调用。
+					战场的步长、初始化函数和种子通过 Envs() 设置，须在第一次提交之前完成。
+					数组布局与 VecBattlefield_C 相同，只是第一维为本次提交或取回的战场个数，顺序与 env_ids 对应。
+	*/
+	class EnvPool_C
+	{
+	public:
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          创建异步战场池
+		*   @details        创建异步战场池，参数超出范围时截断到有效范围
+		*   @param[in]      in_env_count    战场数量，不小于1
+		*   @param[in]      in_agent_count  每个战场的智能体数量，1 ~ max_object
+		*   @param[in]      in_thread_count 工作线程数，不大于0时取硬件线程数
+		*/
+		EnvPool_C(
+			int								in_env_count,
+			int								in_agent_count,
+			int								in_thread_count = 0);
+		~EnvPool_C();
+
+		//持有线程，禁止拷贝
+		EnvPool_C(const EnvPool_C&) = delete;
+		EnvPool_C& operator=(const EnvPool_C&) = delete;
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          提交全部战场的初始化请求
+		*   @details        初始化完成的战场经 Recv 取回初始观测，奖励为0，结束标志为0
+		*   @retval         0               正常
+		*   @retval         1               错误，有战场的请求尚未取回
+		*/
+		int AsyncReset();
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          提交推进请求
+		*   @details        复制控制量后立即返回，由工作线程推进
+		*   @param[in]      env_ids         战场序号 [count]
+		*   @param[in]      count           战场个数
+		*   @param[in]      actions         控制量 [count][agent_count][VB_ACTION_SIZE]
+		*   @retval         0               正常
+		*   @retval         1               错误，序号无效或该战场的请求尚未取回
+		*/
+		int Send(
+			const int*						env_ids,
+			int								count,
+			const double*					actions);
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          取回最先完成的一批结果
+		*   @details        阻塞直到取回 batch_size 个战场的结果，未取回的请求不足 batch_size 时只等待这些请求
+		*   @param[in]      batch_size      取回个数
+		*   @param[out]     env_ids_out     战场序号 [batch_size]
+		*   @param[out]     obs_out         观测 [batch_size][agent_count][ObsSize()]
+		*   @param[out]     reward_out      奖励 [batch_size][agent_count]
+		*   @param[out]     done_out        结束标志 [batch_size]
+		*   @retval         实际取回的个数
+		*/
+		int Recv(
+			int								batch_size,
+			int*							env_ids_out,
+			double*							obs_out,
+			double*							reward_out,
+			int*							done_out);
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          访问战场集合
+		*   @details        用于设置步长、初始化函数和种子，不应在有请求未取回时修改
+		*   @retval         战场集合
+		*/
+		VecBattlefield_C& Envs() { return envs; }
+
+		int EnvCount() const { return envs.EnvCount(); }
+		int AgentCount() const { return envs.AgentCount(); }
+		int ObsSize() const { return envs.ObsSize(); }
+		int ThreadCount() const { return (int)thread_list.size(); }
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          未取回的请求数
+		*   @details        未取回的请求数
+		*   @retval         请求数
+		*/
+		int InFlight() const { return in_flight; }
+
+	private:
+		VecBattlefield_C				envs;							//!< 战场集合，只使用其单战场接口
+
+		//每个战场的请求与结果，工作线程只访问自己领取到的战场
+		int*							env_state;						//!< 请求状态 EP_IDLE/EP_STEP/EP_RESET，只由调用线程读写
+		int*							request_type;					//!< 请求类型，提交时写入，由工作线程读取
+		double*							action_buffer;					//!< 控制量 [env_count][agent_count][VB_ACTION_SIZE]
+		double*							obs_buffer;						//!< 观测 [env_count][agent_count][ObsSize()]
+		double*							reward_buffer;					//!< 奖励 [env_count][agent_count]
+		int*							done_buffer;					//!< 结束标志 [env_count]
+		int								in_flight;						//!< 未取回的请求数
+
+		LockFreeQueue_C<int>			request_queue;					//!< 待处理的战场序号
+		LockFreeQueue_C<int>			complete_queue;					//!< 已完成的战场序号
+
+		std::vector<std::thread>		thread_list;					//!< 工作线程
+		std::atomic<bool>				stopping;
+
+		//提交一个请求
+		int Submit(int env_index, int type);
+
+		//工作线程主循环
+		void WorkerLoop();
+	};
+}
+
+
+
+#endif // Env_Pool_H
@@ -0,0 +1,487 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           EventScheduler.cpp
+*   @brief          稀疏事件调度实现。
+*   @details        稀疏事件调度实现。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           头文件。
+*   @{
+*/
+#include "EventScheduler.h"
+#include <math.h>
+#include <stddef.h>
+#include <algorithm>
+
+using namespace CombatSimulation;
+/** @}  */
+
+
+//时刻换算为时间片时允许的舍入误差，避免 0.1/0.02 之类落到相邻片
+static const double tick_epsilon = 1e-9;
+
+
+EventScheduler_C::EventScheduler_C(
+	double							in_resolution,
+	int								in_wheel_size,
+	int								in_capacity)
+{
+	resolution = (in_resolution > 0) ? in_resolution : 0.01;
+
+	int size = 2;
+	while (size < in_wheel_size) {
+		size <<= 1;
+	}
+	wheel_mask = size - 1;
+	wheel_head.assign(size, -1);
+	wheel_count = 0;
+	current_tick = 0;
+
+	if (in_capacity < 1) {
+		in_capacity = 1;
+	}
+	node_list.resize(in_capacity);
+	free_list.reserve(in_capacity);
+	for (int i = in_capacity - 1; i >= 0; i--) {
+		node_list[i].serial = 0;
+		free_list.push_back(i);
+	}
+	overflow_heap.reserve(in_capacity);
+	due_list.reserve(in_capacity);
+
+	next_serial = 1;
+	pending_count = 0;
+
+	for (int t = 0; t < ES_MAX_TYPE; t++) {
+		handler_list[t] = NULL;
+		context_list[t] = NULL;
+	}
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          设置事件处理函数
+*   @details        设置事件处理函数，没有处理函数的事件到期后直接丢弃
+*   @param[in]      type            事件类型
+*   @param[in]      handler         处理函数，NULL 表示不处理
+*   @param[in]      context         传给处理函数的上下文
+*   @retval         0               正常
+*   @retval         1               错误，类型越界
+*/
+int EventScheduler_C::SetHandler(
+	int								type,
+	EventHandler_F					handler,
+	void*							context)
+{
+	if (type < 0 || type >= ES_MAX_TYPE) {
+		return 1;
+	}
+
+	handler_list[type] = handler;
+	context_list[type] = context;
+
+	return 0;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          登记事件
+*   @details        time 不晚于当前时刻时在下一个时间片触发
+*   @param[in]      time            发生时刻，单位：秒
+*   @param[in]      type            事件类型
+*   @param[in]      entity          相关实体下标
+*   @param[in]      param           附加参数
+*   @param[out]     handle_out      事件句柄，可为 NULL
+*   @retval         0               正常
+*   @retval         1               错误，类型越界
+*/
+int EventScheduler_C::Schedule(
+	double							time,
+	int								type,
+	int								entity,
+	double							param,
+	EventHandle_T*					handle_out)
+{
+	if (type < 0 || type >= ES_MAX_TYPE) {
+		return 1;
+	}
+
+	//节点用完时扩容一倍
+	if (free_list.empty()) {
+		int old_size = (int)node_list.size();
+		node_list.resize(old_size * 2);
+		for (int i = old_size * 2 - 1; i >= old_size; i--) {
+			node_list[i].serial = 0;
+			free_list.push_back(i);
+		}
+	}
+	int node = free_list.back();
+	free_list.pop_back();
+
+	EventNode_T& event_node = node_list[node];
+	event_node.event.time = time;
+	event_node.event.type = type;
+	event_node.event.entity = entity;
+	event_node.event.param = param;
+	event_node.tick = (long long)ceil(time / resolution - tick_epsilon);
+	if (event_node.tick <= current_tick) {
+		event_node.tick = current_tick + 1;
+	}
+	event_node.serial = next_serial++;
+	if (next_serial == 0) {
+		next_serial = 1;
+	}
+	event_node.cancelled = 0;
+	event_node.next = -1;
+
+	Insert(node);
+	pending_count++;
+
+	if (handle_out != NULL) {
+		handle_out->node = node;
+		handle_out->serial = event_node.serial;
+	}
+
+	return 0;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          取消事件
+*   @details        取消事件
+*   @param[in]      handle          事件句柄
+*   @retval         0               正常
+*   @retval         1               错误，事件已触发、已取消或句柄无效
+*/
+int EventScheduler_C::Cancel(EventHandle_T handle)
+{
+	if (handle.node < 0 || handle.node >= (int)node_list.size()) {
+		return 1;
+	}
+
+	EventNode_T& event_node = node_list[handle.node];
+	if (event_node.serial == 0 || event_node.serial != handle.serial || event_node.cancelled != 0) {
+		return 1;
+	}
+
+	//节点留在时间轮或堆中，到期时回收
+	event_node.cancelled = 1;
+	pending_count--;
+
+	return 0;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          推进到指定时刻
+*   @details        触发全部到期事件
+*   @param[in]      now             当前时刻，单位：秒
+*   @param[in]      owner           传给处理函数的所有者
+*   @retval         本次触发的事件数
+*/
+int EventScheduler_C::Advance(
+	double							now,
+	void*							owner)
+{
+	long long target_tick = (long long)floor(now / resolution + tick_epsilon);
+	int fired = 0;
+
+	while (current_tick < target_tick) {
+		//时间轮为空时直接跳到堆中最早事件之前
+		if (wheel_count == 0) {
+			long long jump = target_tick;
+			if (!overflow_heap.empty()) {
+				long long first = node_list[overflow_heap[0]].tick - 1;
+				if (first < jump) {
+					jump = first;
+				}
+			}
+			if (jump > current_tick) {
+				current_tick = jump;
+			}
+			if (current_tick >= target_tick) {
+				break;
+			}
+		}
+
+		//迁入堆中已进入时间轮范围的事件
+		while (!overflow_heap.empty() && node_list[overflow_heap[0]].tick <= current_tick + wheel_mask + 1) {
+			Insert(HeapPop());
+		}
+
+		current_tick++;
+		fired += FireTick(owner);
+	}
+
+	return fired;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          清空
+*   @details        取消全部事件，时刻归零，处理函数保留
+*   @retval         0               正常
+*/
+int EventScheduler_C::Clear()
+{
+	free_list.clear();
+	for (int i = (int)node_list.size() - 1; i >= 0; i--) {
+		node_list[i].serial = 0;
+		free_list.push_back(i);
+	}
+	std::fill(wheel_head.begin(), wheel_head.end(), -1);
+	wheel_count = 0;
+	overflow_heap.clear();
+	current_tick = 0;
+	pending_count = 0;
+
+	return 0;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          保存待触发事件
+*   @details        按节点下标顺序写出未触发且未取消的事件，处理函数和上下文不保存
+*   @param[out]     record_list     事件记录
+*   @param[in]      capacity        record_list 的记录数
+*   @param[out]     out_count       写出的记录数
+*   @retval         0               正常
+*   @retval         1               错误，参数为空或记录数不足
+*/
+int EventScheduler_C::Save(
+	EventRecord_T*					record_list,
+	int								capacity,
+	int*							out_count) const
+{
+	if (out_count == NULL || (record_list == NULL && pending_count > 0) || capacity < pending_count) {
+		return 1;
+	}
+
+	int count = 0;
+	for (int i = 0; i < (int)node_list.size(); i++) {
+		const EventNode_T& event_node = node_list[i];
+		if (event_node.serial == 0 || event_node.cancelled != 0) {
+			continue;
+		}
+		record_list[count].event = event_node.event;
+		record_list[count].tick = event_node.tick;
+		record_list[count].serial = event_node.serial;
+		record_list[count].node = i;
+		count++;
+	}
+	*out_count = count;
+
+	return 0;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          恢复待触发事件
+*   @details        先清空，再把事件放回原节点，已处理到的时间片和登记序号取保存时的值，处理函数保留。
+*                   恢复后触发顺序与保存时的调度器相同
+*   @param[in]      record_list     Save 写出的事件记录
+*   @param[in]      count           记录数
+*   @param[in]      in_current_tick 保存时的 CurrentTick()
+*   @param[in]      in_next_serial  保存时的 NextSerial()
+*   @retval         0               正常
+*   @retval         1               错误，记录无效，调度器为空
+*/
+int EventScheduler_C::Load(
+	const EventRecord_T*			record_list,
+	int								count,
+	long long						in_current_tick,
+	unsigned int					in_next_serial)
+{
+	Clear();
+	if (count < 0 || (record_list == NULL && count > 0) || in_next_serial == 0) {
+		return 1;
+	}
+
+	//节点下标须在节点池上限内且互不相同，触发时刻须在已处理的时间片之后
+	int node_count = (int)node_list.size();
+	for (int k = 0; k < count; k++) {
+		const EventRecord_T& record = record_list[k];
+		if (record.node < 0 || record.node >= ES_MAX_NODE || record.serial == 0 ||
+			record.event.type < 0 || record.event.type >= ES_MAX_TYPE || record.tick <= in_current_tick) {
+			return 1;
+		}
+		if (record.node >= node_count) {
+			node_count = record.node + 1;
+		}
+	}
+	if (node_count > (int)node_list.size()) {
+		int old_size = (int)node_list.size();
+		node_list.resize(node_count);
+		for (int i = old_size; i < node_count; i++) {
+			node_list[i].serial = 0;
+		}
+	}
+	for (int k = 0; k < count; k++) {
+		if (node_list[record_list[k].node].serial != 0) {
+			Clear();
+			return 1;
+		}
+		EventNode_T& event_node = node_list[record_list[k].node];
+		event_node.event = record_list[k].event;
+		event_node.tick = record_list[k].tick;
+		event_node.serial = record_list[k].serial;
+		event_node.cancelled = 0;
+		event_node.next = -1;
+	}
+
+	current_tick = in_current_tick;
+	next_serial = in_next_serial;
+	free_list.clear();
+	for (int i = (int)node_list.size() - 1; i >= 0; i--) {
+		if (node_list[i].serial == 0) {
+			free_list.push_back(i);
+		}
+	}
+	for (int k = 0; k < count; k++) {
+		Insert(record_list[k].node);
+	}
+	pending_count = count;
+
+	return 0;
+}
+
+
+bool EventScheduler_C::Earlier(int a, int b) const
+{
+	const EventNode_T& x = node_list[a];
+	const EventNode_T& y = node_list[b];
+	if (x.tick != y.tick) {
+		return x.tick < y.tick;
+	}
+	if (x.event.time != y.event.time) {
+		return x.event.time < y.event.time;
+	}
+	return x.serial < y.serial;
+}
+
+
+//时间轮覆盖 (current_tick, current_tick + 槽数]，每个槽只含一个时间片的事件
+void EventScheduler_C::Insert(int node)
+{
+	EventNode_T& event_node = node_list[node];
+	if (event_node.tick > current_tick + wheel_mask + 1) {
+		HeapPush(node);
+		return;
+	}
+
+	int slot = (int)(event_node.tick & wheel_mask);
+	event_node.next = wheel_head[slot];
+	wheel_head[slot] = node;
+	wheel_count++;
+}
+
+
+void EventScheduler_C::HeapPush(int node)
+{
+	overflow_heap.push_back(node);
+	int i = (int)overflow_heap.size() - 1;
+	while (i > 0) {
+		int parent = (i - 1) / 2;
+		if (!Earlier(overflow_heap[i], overflow_heap[parent])) {
+			break;
+		}
+		std::swap(overflow_heap[i], overflow_heap[parent]);
+		i = parent;
+	}
+}
+
+
+int EventScheduler_C::HeapPop()
+{
+	int top = overflow_heap[0];
+	overflow_heap[0] = overflow_heap.back();
+	overflow_heap.pop_back();
+
+	int size = (int)overflow_heap.size();
+	int i = 0;
+	for (;;) {
+		int smallest = i;
+		int left = 2 * i + 1;
+		int right = left + 1;
+		if (left < size && Earlier(overflow_heap[left], overflow_heap[smallest])) {
+			smallest = left;
+		}
+		if (right < size && Earlier(overflow_heap[right], overflow_heap[smallest])) {
+			smallest = right;
+		}
+		if (smallest == i) {
+			break;
+		}
+		std::swap(overflow_heap[i], overflow_heap[smallest]);
+		i = smallest;
+	}
+
+	return top;
+}
+
+
+int EventScheduler_C::FireTick(void* owner)
+{
+	int slot = (int)(current_tick & wheel_mask);
+	if (wheel_head[slot] < 0) {
+		return 0;
+	}
+
+	//摘下整个槽，处理函数新登记的事件不会落入本片
+	due_list.clear();
+	for (int node = wheel_head[slot]; node >= 0; node = node_list[node].next) {
+		due_list.push_back(node);
+	}
+	wheel_head[slot] = -1;
+	wheel_count -= (int)due_list.size();
+
+	if (due_list.size() > 1) {
+		std::sort(due_list.begin(), due_list.end(), [this](int a, int b) { return Earlier(a, b); });
+	}
+
+	int fired = 0;
+	for (size_t k = 0; k < due_list.size(); k++) {
+		int node = due_list[k];
+		//处理函数中可能取消本片中尚未触发的事件
+		if (node_list[node].cancelled != 0) {
+			FreeNode(node);
+			continue;
+		}
+
+		//处理函数登记事件可能使节点池扩容，先复制
+		ScheduledEvent_T event = node_list[node].event;
+		pending_count--;
+		FreeNode(node);
+
+		if (handler_list[event.type] != NULL) {
+			handler_list[event.type](owner, &event, context_list[event.type]);
+		}
+		fired++;
+	}
+
+	return fired;
+}
+
+
+void EventScheduler_C::FreeNode(int node)
+{
+	node_list[node].serial = 0;
+	free_list.push_back(node);
+}
@@ -0,0 +1,265 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           EventScheduler.h
+*   @brief          稀疏事件调度。
+*   @details        登记将来某一时刻发生的事件(雷达重访、锁定转换、超时等)，仿真推进到该时刻时回调处理函数，
+					未到期的事件不占用逐步计算。近期事件放在时间轮中，按时间片直接定位；超出时间轮范围的放在最小堆中，
+					进入时间轮范围后再迁入。没有到期事件时，每步的开销为检查一个时间轮槽和堆顶。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+#ifndef Event_Scheduler_H
+#define Event_Scheduler_H
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           头文件。
+*   @{
+*/
+#include <vector>
+
+/** @}  */
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          CombatSimulation 命名空间。
+*   @details        CombatSimulation 命名空间。
+*/
+namespace CombatSimulation
+{
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @name           事件调度宏定义。
+	*   @{
+	*/
+#define ES_MAX_TYPE 32           //事件类型数，类型取值 0 ~ ES_MAX_TYPE-1
+#define ES_MAX_NODE (1 << 24)    //恢复时接受的节点下标上限
+	/** @}  */
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          事件。
+	*   @details        事件。
+	*/
+	struct ScheduledEvent_T
+	{
+		double							time;							//!< 发生时刻，单位：秒
+		int								type;							//!< 事件类型，决定处理函数
+		int								entity;							//!< 相关实体下标，由登记者解释
+		double							param;							//!< 附加参数，由登记者解释
+	};
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          事件句柄。
+	*   @details        用于取消事件；事件触发或取消后句柄失效，再次取消返回错误。
+	*/
+	struct EventHandle_T
+	{
+		int								node;							//!< 事件节点下标
+		unsigned int					serial;							//!< 登记序号
+	};
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          待触发事件记录。
+	*   @details        用于保存和恢复调度器状态，不含指针，可按字节复制。node、serial 与登记时返回的句柄相同，恢复后句柄仍然有效。
+	*/
+	struct EventRecord_T
+	{
+		ScheduledEvent_T				event;
+		long long						tick;							//!< 所在时间片
+		unsigned int					serial;							//!< 登记序号
+		int								node;							//!< 事件节点下标
+	};
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          事件处理函数。
+	*   @details        在 Advance 中按发生时刻先后调用，可在其中登记新事件(如周期事件登记下一次)或取消其他事件。
+	*   @param[in]      owner           Advance 传入的所有者，战场中为 Battlefield_C*
+	*   @param[in]      event           到期事件
+	*   @param[in]      context         登记处理函数时传入的上下文
+	*   @retval         0               正常
+	*/
+	typedef int (*EventHandler_F)(
+		void* owner,
+		const ScheduledEvent_T* event,
+		void* context);
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          事件调度器。
+	*   @details        时间按 resolution 分片，事件在 time 所在片的末尾之后的第一次 Advance 中触发，不会提前。
+					同一次 Advance 中先按时间片、再按发生时刻、最后按登记顺序触发，结果与步长无关地确定。
+					事件节点和时间轮预先分配，节点用完时扩容。
+	*/
+	class EventScheduler_C
+	{
+	public:
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          创建调度器
+		*   @details        创建调度器
+		*   @param[in]      in_resolution   时间片长度，单位：秒，应不大于仿真步长
+		*   @param[in]      in_wheel_size   时间轮槽数，取不小于该值的2的幂
+		*   @param[in]      in_capacity     预分配的事件数
+		*/
+		EventScheduler_C(
+			double							in_resolution = 0.01,
+			int								in_wheel_size = 1024,
+			int								in_capacity = 64);
+		~EventScheduler_C() {}
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          设置事件处理函数
+		*   @details        设置事件处理函数，没有处理函数的事件到期后直接丢弃
+		*   @param[in]      type            事件类型
+		*   @param[in]      handler         处理函数，NULL 表示不处理
+		*   @param[in]      context         传给处理函数的上下文
+		*   @retval         0               正常
+		*   @retval         1               错误，类型越界
+		*/
+		int SetHandler(
+			int								type,
+			EventHandler_F					handler,
+			void*							context);
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          登记事件
+		*   @details        time 不晚于当前时刻时在下一个时间片触发
+		*   @param[in]      time            发生时刻，单位：秒
+		*   @param[in]      type            事件类型
+		*   @param[in]      entity          相关实体下标
+		*   @param[in]      param           附加参数
+		*   @param[out]     handle_out      事件句柄，可为 NULL
+		*   @retval         0               正常
+		*   @retval         1               错误，类型越界
+		*/
+		int Schedule(
+			double							time,
+			int								type,
+			int								entity,
+			double							param,
+			EventHandle_T*					handle_out);
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          取消事件
+		*   @details        取消事件
+		*   @param[in]      handle          事件句柄
+		*   @retval         0               正常
+		*   @retval         1               错误，事件已触发、已取消或句柄无效
+		*/
+		int Cancel(EventHandle_T handle);
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          推进到指定时刻
+		*   @details        触发全部到期事件
+		*   @param[in]      now             当前时刻，单位：秒
+		*   @param[in]      owner           传给处理函数的所有者
+		*   @retval         本次触发的事件数
+		*/
+		int Advance(
+			double							now,
+			void*							owner);
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          清空
+		*   @details        取消全部事件，时刻归零，处理函数保留
+		*   @retval         0               正常
+		*/
+		int Clear();
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          保存待触发事件
+		*   @details        按节点下标顺序写出未触发且未取消的事件，处理函数和上下文不保存
+		*   @param[out]     record_list     事件记录
+		*   @param[in]      capacity        record_list 的记录数
+		*   @param[out]     out_count       写出的记录数
+		*   @retval         0               正常
+		*   @retval         1               错误，参数为空或记录数不足
+		*/
+		int Save(
+			EventRecord_T*					record_list,
+			int								capacity,
+			int*							out_count) const;
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          恢复待触发事件
+		*   @details        先清空，再把事件放回原节点，已处理到的时间片和登记序号取保存时的值，处理函数保留。
+		*                   恢复后触发顺序与保存时的调度器相同
+		*   @param[in]      record_list     Save 写出的事件记录
+		*   @param[in]      count           记录数
+		*   @param[in]      in_current_tick 保存时的 CurrentTick()
+		*   @param[in]      in_next_serial  保存时的 NextSerial()
+		*   @retval         0               正常
+		*   @retval         1               错误，记录无效，调度器为空
+		*/
+		int Load(
+			const EventRecord_T*			record_list,
+			int								count,
+			long long						in_current_tick,
+			unsigned int					in_next_serial);
+
+		int PendingCount() const { return pending_count; }
+		long long CurrentTick() const { return current_tick; }
+		unsigned int NextSerial() const { return next_serial; }
+		double Resolution() const { return resolution; }
+
+	private:
+		struct EventNode_T
+		{
+			ScheduledEvent_T				event;
+			long long						tick;						//!< 所在时间片
+			unsigned int					serial;						//!< 登记序号，0 表示空闲
+			int								cancelled;
+			int								next;						//!< 时间轮槽内链表
+		};
+
+		double							resolution;						//!< 时间片长度，单位：秒
+		long long						current_tick;					//!< 已处理到的时间片
+		int								wheel_mask;						//!< 槽数-1
+		std::vector<int>				wheel_head;						//!< 每个槽的链表头，-1 为空
+		int								wheel_count;					//!< 时间轮中的事件数(含已取消)
+		std::vector<int>				overflow_heap;					//!< 超出时间轮范围的事件，按 (时间片, 时刻, 序号) 的最小堆
+
+		std::vector<EventNode_T>		node_list;						//!< 事件节点池
+		std::vector<int>				free_list;						//!< 空闲节点
+		std::vector<int>				due_list;						//!< 当前时间片的到期事件，避免每步分配
+		unsigned int					next_serial;
+		int								pending_count;					//!< 未触发且未取消的事件数
+
+		EventHandler_F					handler_list[ES_MAX_TYPE];
+		void*							context_list[ES_MAX_TYPE];
+
+		//按 (时间片, 时刻, 序号) 比较先后
+		bool Earlier(int a, int b) const;
+		//事件放入时间轮或堆
+		void Insert(int node);
+		void HeapPush(int node);
+		int HeapPop();
+		//处理一个时间片，返回触发数
+		int FireTick(void* owner);
+		void FreeNode(int node);
+	};
+}
+
+
+
+#endif // Event_Scheduler_H
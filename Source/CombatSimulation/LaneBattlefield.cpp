@@ -0,0 +1,441 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           LaneBattlefield.cpp
+*   @brief          多战场按通道并行解算实现。
+*   @details        通道的装载、写回、导弹发射和逐槽位调度；逐通道的动力学、制导和命中判定在 LaneKernel.cpp 中。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           头文件。
+*   @{
+*/
+#include "LaneBattlefield.h"
+
+using namespace CombatSimulation;
+using namespace Eigen;
+/** @}  */
+
+
+//LaneKernel.cpp 不包含本模块头文件，状态取值和常数需与之一致
+static_assert(LB_LIVE == CS_LIVE && LB_NOT_LIVE == CS_NOT_LIVE && LB_MISS == CS_MISS, "lane status mismatch");
+static_assert(LB_GRAVITY == simple_gravity, "lane gravity mismatch");
+
+LaneBattlefield_C::LaneBattlefield_C(
+	int								in_lane_count,
+	int								in_aircraft_slots,
+	int								in_missile_slots)
+{
+	lane_count = (in_lane_count < 1) ? 1 : in_lane_count;
+	lane_stride = (lane_count + LB_LANE_ALIGN - 1) / LB_LANE_ALIGN * LB_LANE_ALIGN;
+	aircraft_slots = (in_aircraft_slots < 1) ? 1 : ((in_aircraft_slots > max_object) ? max_object : in_aircraft_slots);
+	missile_slots = (in_missile_slots < 0) ? 0 : ((in_missile_slots > max_object) ? max_object : in_missile_slots);
+
+	aircraft_data.assign((size_t)aircraft_slots * LB_AIR_FIELDS * lane_stride, 0.0);
+	aircraft_live.assign((size_t)aircraft_slots * lane_stride, 0);
+	aircraft_team.assign((size_t)aircraft_slots * lane_stride, 0);
+	aircraft_id.assign((size_t)aircraft_slots * lane_stride, 0);
+	missile_data.assign((size_t)missile_slots * LB_MIS_FIELDS * lane_stride, 0.0);
+	missile_live.assign((size_t)missile_slots * lane_stride, 0);
+	missile_target.assign((size_t)missile_slots * lane_stride, 0);
+	missile_father.assign((size_t)missile_slots * lane_stride, 0);
+	missile_team.assign((size_t)missile_slots * lane_stride, 0);
+	lane_time.assign(lane_stride, 0.0);
+	target_data.assign((size_t)LB_TARGET_FIELDS * lane_stride, 0.0);
+	target_live.assign(lane_stride, 0);
+	lane_kill.assign(lane_stride, 0);
+
+	//补齐的通道和死亡实体保持单位四元数，解算时不产生非数
+	for (int s = 0; s < aircraft_slots; s++) {
+		double* q0 = AircraftRow(s, LB_Q0);
+		for (int l = 0; l < lane_stride; l++) {
+			q0[l] = 1;
+		}
+	}
+	for (int m = 0; m < missile_slots; m++) {
+		double* q0 = MissileRow(m, LB_Q0);
+		for (int l = 0; l < lane_stride; l++) {
+			q0[l] = 1;
+		}
+	}
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          由战场装载一个通道
+*   @details        复制飞机和导弹的运动状态、控制量、制导状态与存活状态，已结束的导弹同样复制，用于逐通道重新开始对局
+*   @param[in]      lane            通道序号
+*   @param[in]      battlefield     战场
+*   @retval         0               正常
+*   @retval         1               错误
+*/
+int LaneBattlefield_C::LoadLane(
+	int								lane,
+	const Battlefield_C&			battlefield)
+{
+	if (lane < 0 || lane >= lane_count) {
+		return 1;
+	}
+	//运行中的导弹目标必须在飞机槽位内
+	for (int m = 0; m < missile_slots && m < battlefield.missile_count; m++) {
+		const Missile_Object_C& missile = battlefield.missile_list[m];
+		if (missile.missile_live == CS_LIVE) {
+			int target = (int)(missile.p_target_air - battlefield.aircraft_list);
+			if (missile.p_target_air == NULL || target < 0 || target >= aircraft_slots) {
+				return 1;
+			}
+		}
+	}
+
+	ResetLane(lane);
+	lane_time[lane] = battlefield.time;
+
+	for (int s = 0; s < aircraft_slots && s < battlefield.aircraft_count; s++) {
+		const Aircraft_Object_C& air = battlefield.aircraft_list[s];
+		for (int i = 0; i < 3; i++) {
+			AircraftRow(s, LB_PX + i)[lane] = air.craft_state(0, i);
+			AircraftRow(s, LB_VX + i)[lane] = air.craft_state(1, i);
+		}
+		for (int i = 0; i < 4; i++) {
+			AircraftRow(s, LB_Q0 + i)[lane] = air.craft_state(2, i);
+			AircraftRow(s, LB_H_ROLL + i)[lane] = air.craft_handle(i);
+		}
+		aircraft_live[(size_t)s * lane_stride + lane] = (air.base_live == CS_LIVE) ? 1 : 0;
+		aircraft_team[(size_t)s * lane_stride + lane] = air.base_team;
+		aircraft_id[(size_t)s * lane_stride + lane] = air.Sim_id;
+	}
+
+	for (int m = 0; m < missile_slots && m < battlefield.missile_count; m++) {
+		const Missile_Object_C& missile = battlefield.missile_list[m];
+		size_t index = (size_t)m * lane_stride + lane;
+
+		//已结束的导弹同样装载全部状态，写回时保持不变
+		missile_live[index] = missile.missile_live;
+		missile_father[index] = missile.father_id;
+		missile_team[index] = missile.base_team;
+		missile_target[index] = (missile.p_target_air != NULL) ? (int)(missile.p_target_air - battlefield.aircraft_list) : -1;
+
+		for (int i = 0; i < 3; i++) {
+			MissileRow(m, LB_PX + i)[lane] = missile.missile_state(0, i);
+			MissileRow(m, LB_VX + i)[lane] = missile.missile_state(1, i);
+			MissileRow(m, LB_LAST_X + i)[lane] = missile.missile_position_last(i);
+		}
+		for (int i = 0; i < 4; i++) {
+			MissileRow(m, LB_Q0 + i)[lane] = missile.missile_state(2, i);
+			MissileRow(m, LB_H_ROLL + i)[lane] = missile.missile_handle(i);
+		}
+		MissileRow(m, LB_ERR_A)[lane] = missile.missile_errA;
+		MissileRow(m, LB_ERR_P)[lane] = missile.missile_errP;
+		MissileRow(m, LB_ERR_R)[lane] = missile.missile_errR;
+		MissileRow(m, LB_ERR_A_SUM)[lane] = missile.missile_errAsum;
+		MissileRow(m, LB_ERR_P_SUM)[lane] = missile.missile_errPsum;
+		MissileRow(m, LB_JOURNEY)[lane] = missile.missile_journey;
+		MissileRow(m, LB_DESTROY)[lane] = missile.destroy_range;
+		MissileRow(m, LB_MAX_JOURNEY)[lane] = missile.max_journey;
+	}
+
+	return CS_OK;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          把一个通道写回战场
+*   @details        写回运动状态、控制量、制导状态与存活状态，并更新经纬高、姿态角和速度，用于显示或与 Battlefield_C 混合使用。
+					飞机只写回 aircraft_count 以内的槽位；通道中新发射的导弹同时写入身份信息，并相应增大 missile_count
+*   @param[in]      lane            通道序号
+*   @param[out]     battlefield     战场
+*   @retval         0               正常
+*   @retval         1               错误
+*/
+int LaneBattlefield_C::StoreLane(
+	int								lane,
+	Battlefield_C*					battlefield) const
+{
+	if (lane < 0 || lane >= lane_count || battlefield == NULL) {
+		return 1;
+	}
+
+	const BattlefieldHeader_T& header = battlefield->battle_header;
+	battlefield->time = lane_time[lane];
+
+	for (int s = 0; s < aircraft_slots && s < battlefield->aircraft_count; s++) {
+		Aircraft_Object_C& air = battlefield->aircraft_list[s];
+		for (int i = 0; i < 3; i++) {
+			air.craft_state(0, i) = AircraftField(s, LB_PX + i)[lane];
+			air.craft_state(1, i) = AircraftField(s, LB_VX + i)[lane];
+		}
+		for (int i = 0; i < 4; i++) {
+			air.craft_state(2, i) = AircraftField(s, LB_Q0 + i)[lane];
+			air.craft_handle(i) = AircraftField(s, LB_H_ROLL + i)[lane];
+		}
+		air.base_live = aircraft_live[(size_t)s * lane_stride + lane];
+
+		navigation_to_earth(&air.coordinate_longitude, &air.coordinate_latitude, &air.coordinate_altitude,
+			air.craft_state(0, 0), air.craft_state(0, 1), air.craft_state(0, 2),
+			header.reference_longitude, header.reference_latitude, header.reference_altitude);
+		quaternion_bn_to_euler(&air.coordinate_roll, &air.coordinate_pitch, &air.coordinate_yaw, air.craft_state.row(2));
+		air.velocity_north = air.craft_state(1, 0);
+		air.velocity_east = air.craft_state(1, 1);
+		air.velocity_downward = air.craft_state(1, 2);
+	}
+
+	for (int m = 0; m < missile_slots; m++) {
+		size_t index = (size_t)m * lane_stride + lane;
+		Missile_Object_C& missile = battlefield->missile_list[m];
+
+		if (m >= battlefield->missile_count) {
+			if (missile_live[index] == 0) {
+				continue;
+			}
+			//通道中新发射的导弹，身份信息与 MissileFire 一致
+			missile.Sim_id = 20000000 + m + 1;
+			missile.p_cold->base_name_id = battlefield->string_table.Intern("PL-10");
+			missile.p_cold->base_type_id = battlefield->string_table.Intern("Air+Missile");
+			for (int k = battlefield->missile_count; k < m; k++) {
+				battlefield->missile_list[k].missile_live = 0;
+				battlefield->missile_list[k].base_live = 0;
+			}
+			battlefield->missile_count = m + 1;
+		}
+
+		missile.missile_live = missile_live[index];
+		missile.base_live = (missile_live[index] == CS_LIVE) ? 1 : 0;
+		missile.father_id = missile_father[index];
+		missile.base_team = missile_team[index];
+		missile.p_target_air = (missile_target[index] >= 0) ? &battlefield->aircraft_list[missile_target[index]] : NULL;
+
+		for (int i = 0; i < 3; i++) {
+			missile.missile_state(0, i) = MissileRow(m, LB_PX + i)[lane];
+			missile.missile_state(1, i) = MissileRow(m, LB_VX + i)[lane];
+			missile.missile_state(3, i) = 0;
+			missile.missile_position_last(i) = MissileRow(m, LB_LAST_X + i)[lane];
+		}
+		missile.missile_state(0, 3) = 0;
+		missile.missile_state(1, 3) = 0;
+		missile.missile_state(3, 3) = 0;
+		for (int i = 0; i < 4; i++) {
+			missile.missile_state(2, i) = MissileRow(m, LB_Q0 + i)[lane];
+			missile.missile_handle(i) = MissileRow(m, LB_H_ROLL + i)[lane];
+		}
+		missile.missile_errA = MissileRow(m, LB_ERR_A)[lane];
+		missile.missile_errP = MissileRow(m, LB_ERR_P)[lane];
+		missile.missile_errR = MissileRow(m, LB_ERR_R)[lane];
+		missile.missile_errAsum = MissileRow(m, LB_ERR_A_SUM)[lane];
+		missile.missile_errPsum = MissileRow(m, LB_ERR_P_SUM)[lane];
+		missile.missile_journey = MissileRow(m, LB_JOURNEY)[lane];
+		missile.destroy_range = MissileRow(m, LB_DESTROY)[lane];
+		missile.max_journey = MissileRow(m, LB_MAX_JOURNEY)[lane];
+
+		navigation_to_earth(&missile.coordinate_longitude, &missile.coordinate_latitude, &missile.coordinate_altitude,
+			missile.missile_state(0, 0), missile.missile_state(0, 1), missile.missile_state(0, 2),
+			header.reference_longitude, header.reference_latitude, header.reference_altitude);
+		quaternion_bn_to_euler(&missile.coordinate_roll, &missile.coordinate_pitch, &missile.coordinate_yaw,
+			missile.missile_state.row(2));
+		missile.velocity_north = missile.missile_state(1, 0);
+		missile.velocity_east = missile.missile_state(1, 1);
+		missile.velocity_downward = missile.missile_state(1, 2);
+	}
+
+	return CS_OK;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          清空一个通道
+*   @details        全部实体置为死亡，时标归零
+*   @param[in]      lane            通道序号
+*   @retval         0               正常
+*   @retval         1               错误
+*/
+int LaneBattlefield_C::ResetLane(int lane)
+{
+	if (lane < 0 || lane >= lane_count) {
+		return 1;
+	}
+
+	lane_time[lane] = 0;
+
+	for (int s = 0; s < aircraft_slots; s++) {
+		for (int f = 0; f < LB_AIR_FIELDS; f++) {
+			AircraftRow(s, f)[lane] = 0;
+		}
+		AircraftRow(s, LB_Q0)[lane] = 1;
+		aircraft_live[(size_t)s * lane_stride + lane] = 0;
+		aircraft_team[(size_t)s * lane_stride + lane] = 0;
+		aircraft_id[(size_t)s * lane_stride + lane] = 0;
+	}
+
+	for (int m = 0; m < missile_slots; m++) {
+		for (int f = 0; f < LB_MIS_FIELDS; f++) {
+			MissileRow(m, f)[lane] = 0;
+		}
+		MissileRow(m, LB_Q0)[lane] = 1;
+		missile_live[(size_t)m * lane_stride + lane] = 0;
+		missile_target[(size_t)m * lane_stride + lane] = -1;
+		missile_father[(size_t)m * lane_stride + lane] = 0;
+		missile_team[(size_t)m * lane_stride + lane] = 0;
+	}
+
+	return CS_OK;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          设置飞机控制量
+*   @details        设置飞机控制量
+*   @param[in]      lane            通道序号
+*   @param[in]      slot            飞机槽位
+*   @param[in]      handle          控制量：滚转角速率、俯仰角速率、偏航角速率、加速度
+*   @retval         0               正常
+*   @retval         1               错误
+*/
+int LaneBattlefield_C::SetHandle(
+	int								lane,
+	int								slot,
+	const double*					handle)
+{
+	if (lane < 0 || lane >= lane_count || slot < 0 || slot >= aircraft_slots || handle == NULL) {
+		return 1;
+	}
+
+	for (int i = 0; i < 4; i++) {
+		AircraftRow(slot, LB_H_ROLL + i)[lane] = handle[i];
+	}
+
+	return CS_OK;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          发射导弹
+*   @details        导弹以发射机当前的位置、速度和姿态出发，攻击指定目标，与 Battlefield_C::MissileFire 相同；
+					发射机id取 LoadLane 装载的飞机仿真id
+*   @param[in]      lane            通道序号
+*   @param[in]      missile_slot    导弹槽位，应处于未发射或已结束状态
+*   @param[in]      attack_slot     发射机槽位
+*   @param[in]      target_slot     目标飞机槽位
+*   @retval         0               正常
+*   @retval         1               错误
+*/
+int LaneBattlefield_C::LaunchMissile(
+	int								lane,
+	int								missile_slot,
+	int								attack_slot,
+	int								target_slot)
+{
+	if (lane < 0 || lane >= lane_count || missile_slot < 0 || missile_slot >= missile_slots ||
+		attack_slot < 0 || attack_slot >= aircraft_slots || target_slot < 0 || target_slot >= aircraft_slots) {
+		return 1;
+	}
+	size_t index = (size_t)missile_slot * lane_stride + lane;
+	if (missile_live[index] == CS_LIVE) {
+		return 1;
+	}
+
+	for (int f = 0; f < LB_MIS_FIELDS; f++) {
+		MissileRow(missile_slot, f)[lane] = 0;
+	}
+	for (int f = LB_PX; f <= LB_Q3; f++) {
+		MissileRow(missile_slot, f)[lane] = AircraftRow(attack_slot, f)[lane];
+	}
+	MissileRow(missile_slot, LB_LAST_X)[lane] = AircraftRow(attack_slot, LB_PX)[lane];
+	MissileRow(missile_slot, LB_LAST_Y)[lane] = AircraftRow(attack_slot, LB_PY)[lane];
+	MissileRow(missile_slot, LB_LAST_Z)[lane] = AircraftRow(attack_slot, LB_PZ)[lane];
+	MissileRow(missile_slot, LB_DESTROY)[lane] = CS_MISSILE_DESTROY_RANGE;
+	MissileRow(missile_slot, LB_MAX_JOURNEY)[lane] = CS_MISSILE_MAX_JOURNEY;
+
+	missile_live[index] = CS_LIVE;
+	missile_target[index] = target_slot;
+	missile_father[index] = aircraft_id[(size_t)attack_slot * lane_stride + lane];
+	missile_team[index] = aircraft_team[(size_t)attack_slot * lane_stride + lane];
+
+	return CS_OK;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          全部通道单步解算
+*   @details        与 Battlefield_C::Run 顺序相同：先解算全部飞机，再逐枚导弹做命中判定、制导和动力学解算，最后做近炸判定
+*   @param[in]      d_time          单步时间间隔 单位：秒
+*   @retval         0               正常
+*/
+int LaneBattlefield_C::Run(double d_time)
+{
+	for (int l = 0; l < lane_stride; l++) {
+		lane_time[l] += d_time;
+	}
+
+	const double* target_row[LB_TARGET_FIELDS];
+	for (int f = 0; f < LB_TARGET_FIELDS; f++) {
+		target_row[f] = &target_data[(size_t)f * lane_stride];
+	}
+
+	for (int s = 0; s < aircraft_slots; s++) {
+		double* row[LB_AIR_FIELDS];
+		for (int f = 0; f < LB_AIR_FIELDS; f++) {
+			row[f] = AircraftRow(s, f);
+		}
+		LaneRunAircraft(row, AircraftLive(s), lane_stride, d_time);
+	}
+	for (int m = 0; m < missile_slots; m++) {
+		double* row[LB_MIS_FIELDS];
+		for (int f = 0; f < LB_MIS_FIELDS; f++) {
+			row[f] = MissileRow(m, f);
+		}
+		GatherTarget(m);
+		LaneRunMissile(row, &missile_live[(size_t)m * lane_stride], target_row, &target_live[0], &lane_kill[0], lane_stride, d_time);
+		ApplyKill(m);
+	}
+	for (int m = 0; m < missile_slots; m++) {
+		const double* row[LB_MIS_FIELDS];
+		for (int f = 0; f < LB_MIS_FIELDS; f++) {
+			row[f] = MissileRow(m, f);
+		}
+		GatherTarget(m);
+		LaneRunFuze(row, &missile_live[(size_t)m * lane_stride], target_row, &target_live[0], &lane_kill[0], lane_stride, d_time);
+		ApplyKill(m);
+	}
+
+	return CS_OK;
+}
+
+
+void LaneBattlefield_C::GatherTarget(int slot)
+{
+	const int* target = &missile_target[(size_t)slot * lane_stride];
+
+	//未运行的导弹目标可能为空或不在槽位内，取0号槽位代替，结果不被使用
+	for (int l = 0; l < lane_stride; l++) {
+		int target_slot = (target[l] >= 0 && target[l] < aircraft_slots) ? target[l] : 0;
+		for (int f = 0; f < LB_TARGET_FIELDS; f++) {
+			target_data[(size_t)f * lane_stride + l] = AircraftField(target_slot, LB_PX + f)[l];
+		}
+		target_live[l] = aircraft_live[(size_t)target_slot * lane_stride + l];
+	}
+}
+
+
+void LaneBattlefield_C::ApplyKill(int slot)
+{
+	const int* target = &missile_target[(size_t)slot * lane_stride];
+
+	for (int l = 0; l < lane_stride; l++) {
+		if (lane_kill[l] != 0) {
+			aircraft_live[(size_t)target[l] * lane_stride + l] = 0;
+		}
+	}
+}
@@ -0,0 +1,232 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           LaneBattlefield.h
+*   @brief          多战场按通道并行解算。
+*   @details        小规模对局(如1v1)每个战场只有两三个实体，在单个战场内按实体向量化几乎没有收益。
+					本模块把W个战场中同一槽位的实体存放在同一组数组的W个通道中(战场为最内层维度)，
+					飞机动力学、导弹制导与动力学、命中判定逐通道执行，循环体无分支、通道间互不依赖，可由编译器展开为SIMD指令，
+					一条指令同时推进多个战场。死亡实体通过存活掩码保持原状态，单个通道可单独重新装载。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+#ifndef Lane_Battlefield_H
+#define Lane_Battlefield_H
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           头文件。
+*   @{
+*/
+#include <vector>
+#include "UnitDefine.h"
+#include "LaneKernel.h"
+
+/** @}  */
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          CombatSimulation 命名空间。
+*   @details        CombatSimulation 命名空间。
+*/
+namespace CombatSimulation
+{
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          多战场按通道并行解算。
+	*   @details        数据布局为 [槽位][字段][通道]，同一字段的W个通道连续存放。
+					每个战场(通道)的飞机槽位与 aircraft_list 下标一一对应，导弹槽位与 missile_list 下标一一对应，导弹只攻击指定目标。
+					本模式只包含完整动力学、指定目标命中判定和对指定目标的近炸判定，不含对其他敌机的近炸、分级解算和空间索引，
+					需要这些功能时使用 Battlefield_C；每方只有一架飞机时结果与 Battlefield_C 相同。
+					通道之间按步同步推进，通道数应为 LB_LANE_ALIGN 的倍数以免浪费。
+	*/
+	class LaneBattlefield_C
+	{
+	public:
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          创建通道战场
+		*   @details        创建通道战场，参数超出范围时截断到有效范围，全部实体初始为死亡
+		*   @param[in]      in_lane_count       通道(战场)数量，不小于1
+		*   @param[in]      in_aircraft_slots   每个战场的飞机槽位数，1 ~ max_object
+		*   @param[in]      in_missile_slots    每个战场的导弹槽位数，0 ~ max_object
+		*/
+		LaneBattlefield_C(
+			int								in_lane_count,
+			int								in_aircraft_slots,
+			int								in_missile_slots);
+		~LaneBattlefield_C() {}
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          由战场装载一个通道
+		*   @details        复制飞机和导弹的运动状态、控制量、制导状态与存活状态，已结束的导弹同样复制，用于逐通道重新开始对局
+		*   @param[in]      lane            通道序号
+		*   @param[in]      battlefield     战场
+		*   @retval         0               正常
+		*   @retval         1               错误
+		*/
+		int LoadLane(
+			int								lane,
+			const Battlefield_C&			battlefield);
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          把一个通道写回战场
+		*   @details        写回运动状态、控制量、制导状态与存活状态，并更新经纬高、姿态角和速度，用于显示或与 Battlefield_C 混合使用。
+					飞机只写回 aircraft_count 以内的槽位；通道中新发射的导弹同时写入身份信息，并相应增大 missile_count
+		*   @param[in]      lane            通道序号
+		*   @param[out]     battlefield     战场
+		*   @retval         0               正常
+		*   @retval         1               错误
+		*/
+		int StoreLane(
+			int								lane,
+			Battlefield_C*					battlefield) const;
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          清空一个通道
+		*   @details        全部实体置为死亡，时标归零
+		*   @param[in]      lane            通道序号
+		*   @retval         0               正常
+		*   @retval         1               错误
+		*/
+		int ResetLane(int lane);
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          设置飞机控制量
+		*   @details        设置飞机控制量
+		*   @param[in]      lane            通道序号
+		*   @param[in]      slot            飞机槽位
+		*   @param[in]      handle          控制量：滚转角速率、俯仰角速率、偏航角速率、加速度
+		*   @retval         0               正常
+		*   @retval         1               错误
+		*/
+		int SetHandle(
+			int								lane,
+			int								slot,
+			const double*					handle);
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          发射导弹
+		*   @details        导弹以发射机当前的位置、速度和姿态出发，攻击指定目标，与 Battlefield_C::MissileFire 相同
+		*   @param[in]      lane            通道序号
+		*   @param[in]      missile_slot    导弹槽位，应处于未发射或已结束状态
+		*   @param[in]      attack_slot     发射机槽位
+		*   @param[in]      target_slot     目标飞机槽位
+		*   @retval         0               正常
+		*   @retval         1               错误
+		*/
+		int LaunchMissile(
+			int								lane,
+			int								missile_slot,
+			int								attack_slot,
+			int								target_slot);
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          全部通道单步解算
+		*   @details        与 Battlefield_C::Run 顺序相同：先解算全部飞机，再逐枚导弹做命中判定、制导和动力学解算，最后做近炸判定
+		*   @param[in]      d_time          单步时间间隔 单位：秒
+		*   @retval         0               正常
+		*/
+		int Run(double d_time);
+
+		int LaneCount() const { return lane_count; }
+		int AircraftSlots() const { return aircraft_slots; }
+		int MissileSlots() const { return missile_slots; }
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          飞机字段
+		*   @details        返回某槽位某字段的通道数组，长度为 LaneCount()，用于批量读取观测
+		*   @param[in]      slot            飞机槽位
+		*   @param[in]      field           字段 LB_PX ~ LB_H_ACCEL
+		*   @retval         通道数组
+		*/
+		const double* AircraftField(int slot, int field) const {
+			return &aircraft_data[((size_t)slot * LB_AIR_FIELDS + field) * lane_stride];
+		}
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          飞机存活状态
+		*   @details        返回某槽位的通道数组，0 死亡，1 存活
+		*   @param[in]      slot            飞机槽位
+		*   @retval         通道数组
+		*/
+		const int* AircraftLive(int slot) const {
+			return &aircraft_live[(size_t)slot * lane_stride];
+		}
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          导弹状态
+		*   @details        返回某槽位的通道数组，取值同 missile_live：1-运行中  0-未发射 -1-命中 -2-超出范围未命中
+		*   @param[in]      slot            导弹槽位
+		*   @retval         通道数组
+		*/
+		const int* MissileLive(int slot) const {
+			return &missile_live[(size_t)slot * lane_stride];
+		}
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          通道时标
+		*   @details        返回通道数组，单位：秒
+		*   @retval         通道数组
+		*/
+		const double* LaneTime() const { return &lane_time[0]; }
+
+	private:
+		int								lane_count;						//!< 通道数
+		int								lane_stride;					//!< 每行长度，补齐到 LB_LANE_ALIGN 的倍数
+		int								aircraft_slots;					//!< 飞机槽位数
+		int								missile_slots;					//!< 导弹槽位数
+
+		std::vector<double>				aircraft_data;					//!< 飞机数据 [槽位][LB_AIR_FIELDS][通道]
+		std::vector<int>				aircraft_live;					//!< 飞机存活 [槽位][通道]
+		std::vector<int>				aircraft_team;					//!< 飞机所属队伍 [槽位][通道]
+		std::vector<int>				aircraft_id;					//!< 飞机仿真id [槽位][通道]，由 LoadLane 装载，用作导弹发射机id
+		std::vector<double>				missile_data;					//!< 导弹数据 [槽位][LB_MIS_FIELDS][通道]
+		std::vector<int>				missile_live;					//!< 导弹状态 [槽位][通道]
+		std::vector<int>				missile_target;					//!< 导弹目标飞机下标 [槽位][通道]，无目标为 -1
+		std::vector<int>				missile_father;					//!< 发射机仿真id [槽位][通道]，只用于写回
+		std::vector<int>				missile_team;					//!< 导弹所属队伍 [槽位][通道]，只用于写回
+		std::vector<double>				lane_time;						//!< 通道时标 [通道]
+		std::vector<double>				target_data;					//!< 当前导弹槽位各通道目标的位置和速度 [LB_TARGET_FIELDS][通道]
+		std::vector<int>				target_live;					//!< 当前导弹槽位各通道目标的存活状态 [通道]
+		std::vector<int>				lane_kill;						//!< 当前导弹槽位各通道本次是否击毁目标 [通道]
+
+		double* AircraftRow(int slot, int field) {
+			return &aircraft_data[((size_t)slot * LB_AIR_FIELDS + field) * lane_stride];
+		}
+		double* MissileRow(int slot, int field) {
+			return &missile_data[((size_t)slot * LB_MIS_FIELDS + field) * lane_stride];
+		}
+		const double* MissileRow(int slot, int field) const {
+			return &missile_data[((size_t)slot * LB_MIS_FIELDS + field) * lane_stride];
+		}
+
+		//把导弹槽位各通道目标的位置、速度和存活状态复制到连续数组，通道循环中不按目标下标随机读取
+		void GatherTarget(int slot);
+
+		//按 lane_kill 把导弹槽位的目标置为死亡，通道循环中不按目标下标随机写入
+		void ApplyKill(int slot);
+	};
+}
+
+
+
+#endif // Lane_Battlefield_H
@@ -0,0 +1,365 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           LaneKernel.cpp
+*   @brief          通道战场逐通道解算核心实现。
+*   @details        动力学、制导公式与 FlyTac 中 __f/runge4、__missile_f/__missile_runge4、Flight_find_point 及
+					Missile_Object_C::Run/HitCheck 逐项对应，只是把矩阵运算展开为标量，并把条件分支改写为选择，
+					使每个通道的循环体相同，便于编译器向量化。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           头文件。
+*   @{
+*/
+#include "LaneKernel.h"
+#include <math.h>
+
+using namespace CombatSimulation;
+/** @}  */
+
+
+static const double lane_pi = 3.14159265358979323846;
+
+#define LB_STATE 10 //运动状态维数：位置3、速度3、四元数4
+
+//通道循环中各字段行互不重叠、每个通道只读写本通道，告知编译器忽略可能的依赖以便向量化
+#if defined(_MSC_VER)
+#define LB_IVDEP __pragma(loop(ivdep))
+#elif defined(__GNUC__)
+#define LB_IVDEP _Pragma("GCC ivdep")
+#else
+#define LB_IVDEP
+#endif
+
+
+//状态微分，对应 __f 与 __missile_f；导弹 lift_coef 为0，drag_coef 为8e-10
+static inline void LaneDerivative(
+	double*							d,
+	const double*					s,
+	double							accelerator,
+	double							wx,
+	double							wy,
+	double							wz,
+	double							lift_coef,
+	double							drag_coef)
+{
+	double q0 = s[6], q1 = s[7], q2 = s[8], q3 = s[9];
+
+	//Rbn，同 quaternion_to_rotation
+	double r00 = q0 * q0 + q1 * q1 - q2 * q2 - q3 * q3;
+	double r01 = 2 * (q1 * q2 - q0 * q3);
+	double r02 = 2 * (q1 * q3 + q0 * q2);
+	double r10 = 2 * (q1 * q2 + q0 * q3);
+	double r11 = q0 * q0 - q1 * q1 + q2 * q2 - q3 * q3;
+	double r12 = 2 * (q2 * q3 - q0 * q1);
+	double r20 = 2 * (q1 * q3 - q0 * q2);
+	double r21 = 2 * (q2 * q3 + q0 * q1);
+	double r22 = q0 * q0 - q1 * q1 - q2 * q2 + q3 * q3;
+
+	//机体系速度 = Rnb * v_n
+	double vb0 = r00 * s[3] + r10 * s[4] + r20 * s[5];
+	double vb1 = r01 * s[3] + r11 * s[4] + r21 * s[5];
+	double vb2 = r02 * s[3] + r12 * s[4] + r22 * s[5];
+
+	//升力随高度变化，阻力方向和速度方向相反
+	double lift = -(vb0 < 0 ? -1 : 1) * lift_coef * vb0 * vb0;
+	lift *= exp((s[2] > 0 ? s[2] : 0) / 5000);
+	double ax = -(vb0 < 0 ? -1 : 1) * drag_coef * fabs(pow(vb0, 4));
+	double ay = -(vb1 < 0 ? -1 : 1) * 1e-8 * fabs(pow(vb1, 4));
+	double az = -(vb2 < 0 ? -1 : 1) * 1e-6 * fabs(pow(vb2, 4));
+
+	double ab0 = ((s[2] > 33000) ? 0 : accelerator) + ax;
+	double ab1 = ay;
+	double ab2 = lift + az;
+
+	//导航系加速度，重力方向向下
+	double dv[3];
+	dv[0] = r00 * ab0 + r01 * ab1 + r02 * ab2;
+	dv[1] = r10 * ab0 + r11 * ab1 + r12 * ab2;
+	dv[2] = r20 * ab0 + r21 * ab1 + r22 * ab2 + LB_GRAVITY;
+
+	for (int i = 0; i < 3; i++) {
+		double v = s[3 + i];
+		bool reverse = fabs(v) > 340 && fabs(dv[i]) > fabs(v) && dv[i] * v < 0;
+		d[i] = v;
+		d[3 + i] = reverse ? -v : dv[i];
+	}
+
+	//四元数微分 0.5 * W * q
+	d[6] = 0.5 * (-wx * q1 - wy * q2 - wz * q3);
+	d[7] = 0.5 * (wx * q0 + wz * q2 - wy * q3);
+	d[8] = 0.5 * (wy * q0 - wz * q1 + wx * q3);
+	d[9] = 0.5 * (wz * q0 + wy * q1 - wx * q2);
+}
+
+
+//四阶龙格库塔推进并归一化四元数，对应 Flight/missile_Flight 中的角速率限幅与 runge4
+static inline void LaneRunge4(
+	double*							out,
+	const double*					s,
+	double							dt,
+	const double*					handle,
+	double							lift_coef,
+	double							drag_coef)
+{
+	double maxw = lane_pi / 2, maxw2 = lane_pi / 12;
+	double wx = (fabs(handle[0]) < maxw) ? handle[0] : (maxw * fabs(handle[0]) / handle[0]);
+	double wy = (fabs(handle[1]) < maxw) ? handle[1] : (maxw * fabs(handle[1]) / handle[1]);
+	double wz = (fabs(handle[2]) < maxw2) ? handle[2] : (maxw2 * fabs(handle[2]) / handle[2]);
+
+	double k1[LB_STATE], k2[LB_STATE], k3[LB_STATE], k4[LB_STATE], xn[LB_STATE];
+
+	LaneDerivative(k1, s, handle[3], wx, wy, wz, lift_coef, drag_coef);
+	for (int i = 0; i < LB_STATE; i++) {
+		xn[i] = s[i] + 0.5 * dt * k1[i];
+	}
+	LaneDerivative(k2, xn, handle[3], wx, wy, wz, lift_coef, drag_coef);
+	for (int i = 0; i < LB_STATE; i++) {
+		xn[i] = s[i] + 0.5 * dt * k2[i];
+	}
+	LaneDerivative(k3, xn, handle[3], wx, wy, wz, lift_coef, drag_coef);
+	for (int i = 0; i < LB_STATE; i++) {
+		xn[i] = s[i] + dt * k3[i];
+	}
+	LaneDerivative(k4, xn, handle[3], wx, wy, wz, lift_coef, drag_coef);
+
+	for (int i = 0; i < LB_STATE; i++) {
+		out[i] = s[i] + dt * (k1[i] + 2 * k2[i] + 2 * k3[i] + k4[i]) / 6.0;
+	}
+
+	double norm = sqrt(out[6] * out[6] + out[7] * out[7] + out[8] * out[8] + out[9] * out[9]);
+	for (int i = 6; i < LB_STATE; i++) {
+		out[i] = out[i] / norm;
+	}
+}
+
+
+//机体系下某矢量的方位角和俯仰角，矢量先由 Rnb 转到机体系
+static inline void LaneBodyAngle(
+	double*							azimuth,
+	double*							pitch,
+	const double*					q,
+	double							n0,
+	double							n1,
+	double							n2)
+{
+	double q0 = q[0], q1 = q[1], q2 = q[2], q3 = q[3];
+	double r00 = q0 * q0 + q1 * q1 - q2 * q2 - q3 * q3;
+	double r01 = 2 * (q1 * q2 - q0 * q3);
+	double r02 = 2 * (q1 * q3 + q0 * q2);
+	double r10 = 2 * (q1 * q2 + q0 * q3);
+	double r11 = q0 * q0 - q1 * q1 + q2 * q2 - q3 * q3;
+	double r12 = 2 * (q2 * q3 - q0 * q1);
+	double r20 = 2 * (q1 * q3 - q0 * q2);
+	double r21 = 2 * (q2 * q3 + q0 * q1);
+	double r22 = q0 * q0 - q1 * q1 - q2 * q2 + q3 * q3;
+
+	double b0 = r00 * n0 + r10 * n1 + r20 * n2;
+	double b1 = r01 * n0 + r11 * n1 + r21 * n2;
+	double b2 = r02 * n0 + r12 * n1 + r22 * n2;
+
+	*azimuth = atan2(b1, b0);
+	*pitch = atan2(-b2, sqrt(b0 * b0 + b1 * b1));
+}
+
+
+void CombatSimulation::LaneRunAircraft(
+	double* const*					in_row,
+	const int*						live,
+	int								stride,
+	double							d_time)
+{
+	//行指针复制到局部数组，循环中的写入不会改变行指针，编译器才能把它们提到循环外
+	double* row[LB_AIR_FIELDS];
+	for (int f = 0; f < LB_AIR_FIELDS; f++) {
+		row[f] = in_row[f];
+	}
+
+	LB_IVDEP
+	for (int l = 0; l < stride; l++) {
+		double s[LB_STATE], out[LB_STATE], handle[4];
+		for (int i = 0; i < LB_STATE; i++) {
+			s[i] = row[i][l];
+		}
+		for (int i = 0; i < 4; i++) {
+			handle[i] = row[LB_H_ROLL + i][l];
+		}
+
+		LaneRunge4(out, s, d_time, handle, 5e-5, 1e-9);
+
+		//死亡实体保持原状态
+		bool active = live[l] == LB_LIVE;
+		for (int i = 0; i < LB_STATE; i++) {
+			row[i][l] = active ? out[i] : s[i];
+		}
+	}
+}
+
+
+void CombatSimulation::LaneRunMissile(
+	double* const*					in_row,
+	int*							status,
+	const double* const*			in_target_row,
+	const int*						target_live,
+	int*							kill,
+	int								stride,
+	double							d_time)
+{
+	double* row[LB_MIS_FIELDS];
+	const double* target_row[LB_TARGET_FIELDS];
+	for (int f = 0; f < LB_MIS_FIELDS; f++) {
+		row[f] = in_row[f];
+	}
+	for (int f = 0; f < LB_TARGET_FIELDS; f++) {
+		target_row[f] = in_target_row[f];
+	}
+
+	LB_IVDEP
+	for (int l = 0; l < stride; l++) {
+		double s[LB_STATE];
+		for (int i = 0; i < LB_STATE; i++) {
+			s[i] = row[i][l];
+		}
+
+		//目标状态
+		double tp[3], tv[3];
+		for (int i = 0; i < 3; i++) {
+			tp[i] = target_row[LB_PX + i][l];
+			tv[i] = target_row[LB_VX + i][l];
+		}
+
+		double dx = tp[0] - s[0], dy = tp[1] - s[1], dz = tp[2] - s[2];
+		double distance = sqrt(dx * dx + dy * dy + dz * dz);
+		double target_speed = sqrt(tv[0] * tv[0] + tv[1] * tv[1] + tv[2] * tv[2]);
+		double missile_speed = sqrt(s[3] * s[3] + s[4] * s[4] + s[5] * s[5]);
+		double destroy = row[LB_DESTROY][l];
+
+		//瞄准目标运动方向的前方
+		double k_target = (distance <= destroy * 1.5) ? 195 * target_speed / missile_speed
+			: target_speed / (0.001 * distance);
+		double aim[3];
+		for (int i = 0; i < 3; i++) {
+			aim[i] = tp[i] + (tv[i] / target_speed) * k_target;
+		}
+
+		//命中判定，目标已被击毁时按未命中结束
+		double jx = s[0] - row[LB_LAST_X][l], jy = s[1] - row[LB_LAST_Y][l], jz = s[2] - row[LB_LAST_Z][l];
+		double journey = row[LB_JOURNEY][l] + sqrt(jx * jx + jy * jy + jz * jz);
+		//条件按位组合，避免短路求值产生分支
+		int running = status[l] == LB_LIVE;
+		int in_range = running & (distance <= destroy);
+		int hit = in_range & (target_live[l] == LB_LIVE);
+		int miss = running & (hit ^ 1) & (in_range | (journey >= row[LB_MAX_JOURNEY][l]));
+		int active = running & (hit ^ 1) & (miss ^ 1);
+
+		//击毁目标写在循环之后，循环内只有连续写入
+		kill[l] = hit;
+		status[l] = hit ? LB_NOT_LIVE : (miss ? LB_MISS : status[l]);
+
+		//过点飞制导，同 Flight_find_point
+		double roll = 180 * atan2(2 * (s[8] * s[9] + s[6] * s[7]),
+			s[6] * s[6] - s[7] * s[7] - s[8] * s[8] + s[9] * s[9]) / lane_pi;
+		double ax = aim[0] - s[0], ay = aim[1] - s[1], az = aim[2] - s[2];
+		double aim_distance = sqrt(ax * ax + ay * ay + az * az);
+
+		double azimuth, pitch, azimuth_v, pitch_v;
+		LaneBodyAngle(&azimuth, &pitch, &s[6], ax, ay, az);
+		LaneBodyAngle(&azimuth_v, &pitch_v, &s[6], s[3], s[4], s[5]);
+		double err_a = azimuth - azimuth_v;
+		double err_p = pitch - pitch_v;
+		double err_roll = ((err_a >= 0) ? 1 : -1) * 0.4 * (roll * lane_pi / 180);
+
+		double last_a = row[LB_ERR_A][l], last_p = row[LB_ERR_P][l], last_r = row[LB_ERR_R][l];
+		double sum_a = row[LB_ERR_A_SUM][l] + err_a;
+		double sum_p = row[LB_ERR_P_SUM][l] + err_p;
+
+		bool far_point = aim_distance > 30;
+		bool large_error = fabs(err_a) > lane_pi / 18;
+
+		//PID_Roll: Kp 1, Ki 0.5, Kd 10；PID_Pitch: Kp 1, Ki 0, Kd 2；PID_Yaw: Kp 1, Ki 0, Kd 20
+		double roll_upright = (err_a + err_roll) + 0.5 * sum_a + 10. * (err_a - last_a + err_roll - last_r);
+		double roll_inverted = err_roll;
+		double roll_small = err_roll + 10. * (err_roll - last_r);
+		roll_small = (roll >= 170) ? -2 : ((roll <= -170) ? 2 : roll_small);
+		double d_roll = large_error ? ((fabs(roll) <= 90) ? roll_upright : roll_inverted) : roll_small;
+		double d_pitch = err_p + 0.0 * sum_p + 2 * (err_p - last_p);
+		double d_yaw = err_a + 0.0 * sum_a + 20 * (err_a - last_a);
+
+		double handle[4];
+		handle[0] = far_point ? d_roll : 0;
+		handle[1] = far_point ? d_pitch : 0;
+		handle[2] = far_point ? d_yaw : 0;
+		handle[3] = 90;
+
+		double out[LB_STATE];
+		LaneRunge4(out, s, d_time, handle, 0, 8e-10);
+
+		//只有继续飞行的导弹更新状态
+		for (int i = 0; i < LB_STATE; i++) {
+			row[i][l] = active ? out[i] : s[i];
+		}
+		for (int i = 0; i < 4; i++) {
+			row[LB_H_ROLL + i][l] = active ? handle[i] : row[LB_H_ROLL + i][l];
+		}
+		row[LB_ERR_A][l] = active ? (far_point ? err_a : 0) : last_a;
+		row[LB_ERR_P][l] = active ? (far_point ? err_p : 0) : last_p;
+		row[LB_ERR_R][l] = active ? (far_point ? err_roll : 0) : last_r;
+		row[LB_ERR_A_SUM][l] = (active && far_point) ? sum_a : row[LB_ERR_A_SUM][l];
+		row[LB_ERR_P_SUM][l] = (active && far_point) ? sum_p : row[LB_ERR_P_SUM][l];
+		row[LB_JOURNEY][l] = (running && !in_range) ? journey : row[LB_JOURNEY][l];
+		row[LB_LAST_X][l] = active ? s[0] : row[LB_LAST_X][l];
+		row[LB_LAST_Y][l] = active ? s[1] : row[LB_LAST_Y][l];
+		row[LB_LAST_Z][l] = active ? s[2] : row[LB_LAST_Z][l];
+	}
+}
+
+
+void CombatSimulation::LaneRunFuze(
+	const double* const*			in_row,
+	int*							status,
+	const double* const*			in_target_row,
+	const int*						target_live,
+	int*							kill,
+	int								stride,
+	double							d_time)
+{
+	const double* row[LB_MIS_FIELDS];
+	const double* target_row[LB_TARGET_FIELDS];
+	for (int f = 0; f < LB_MIS_FIELDS; f++) {
+		row[f] = in_row[f];
+	}
+	for (int f = 0; f < LB_TARGET_FIELDS; f++) {
+		target_row[f] = in_target_row[f];
+	}
+
+	LB_IVDEP
+	for (int l = 0; l < stride; l++) {
+		//同 MissileProximityCheck：t∈[-d_time,0] 内相对位置 r+v*t 的最近点距离
+		double rx = row[LB_PX][l] - target_row[LB_PX][l];
+		double ry = row[LB_PY][l] - target_row[LB_PY][l];
+		double rz = row[LB_PZ][l] - target_row[LB_PZ][l];
+		double vx = row[LB_VX][l] - target_row[LB_VX][l];
+		double vy = row[LB_VY][l] - target_row[LB_VY][l];
+		double vz = row[LB_VZ][l] - target_row[LB_VZ][l];
+		double vv = vx * vx + vy * vy + vz * vz;
+		double rv = rx * vx + ry * vy + rz * vz;
+		double t = (vv > 0) ? -rv / vv : 0;
+		t = (t < -d_time) ? -d_time : ((t > 0) ? 0 : t);
+		double dx = rx + vx * t;
+		double dy = ry + vy * t;
+		double dz = rz + vz * t;
+
+		bool fuze = status[l] == LB_LIVE && target_live[l] == LB_LIVE && dx * dx + dy * dy + dz * dz <= row[LB_DESTROY][l] * row[LB_DESTROY][l];
+		kill[l] = fuze ? 1 : 0;
+		status[l] = fuze ? LB_NOT_LIVE : status[l];
+	}
+}
@@ -0,0 +1,134 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           LaneKernel.h
+*   @brief          通道战场逐通道解算核心。
+*   @details        LaneBattlefield_C 的飞机推进、导弹制导推进和近炸判定循环，按 [字段][通道] 的行指针处理一个槽位的全部通道。
+					本文件单独以快速浮点模型和 AVX2 指令集编译，因此只依赖标准数学库，不包含 Eigen 及其他仿真头文件：
+					Eigen 在启用 AVX 时把定长矩阵按32字节对齐，若与其他文件的编译选项不同，同一个类在两处的内存布局会不一致。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+#ifndef Lane_Kernel_H
+#define Lane_Kernel_H
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          CombatSimulation 命名空间。
+*   @details        CombatSimulation 命名空间。
+*/
+namespace CombatSimulation
+{
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @name           通道数据字段。
+	*   @{
+	*/
+#define LB_PX 0          //位置，北向，单位：米
+#define LB_PY 1          //位置，东向，单位：米
+#define LB_PZ 2          //位置，地向，单位：米
+#define LB_VX 3          //速度，北向，单位：米/秒
+#define LB_VY 4          //速度，东向，单位：米/秒
+#define LB_VZ 5          //速度，地向，单位：米/秒
+#define LB_Q0 6          //姿态四元数(bn)，标量
+#define LB_Q1 7
+#define LB_Q2 8
+#define LB_Q3 9
+#define LB_H_ROLL 10     //控制量，滚转角速率，单位：弧度/秒
+#define LB_H_PITCH 11    //控制量，俯仰角速率，单位：弧度/秒
+#define LB_H_YAW 12      //控制量，偏航角速率，单位：弧度/秒
+#define LB_H_ACCEL 13    //控制量，加速度，单位：米/秒^2
+#define LB_AIR_FIELDS 14 //飞机字段数
+
+#define LB_ERR_A 14      //导弹制导，上一时刻方位角误差
+#define LB_ERR_P 15      //导弹制导，上一时刻俯仰角误差
+#define LB_ERR_R 16      //导弹制导，上一时刻滚转误差
+#define LB_ERR_A_SUM 17  //导弹制导，累积方位角误差
+#define LB_ERR_P_SUM 18  //导弹制导，累积俯仰角误差
+#define LB_JOURNEY 19    //导弹已飞行路程，单位：米
+#define LB_LAST_X 20     //导弹上一时刻位置
+#define LB_LAST_Y 21
+#define LB_LAST_Z 22
+#define LB_DESTROY 23    //导弹杀伤半径，单位：米
+#define LB_MAX_JOURNEY 24 //导弹最大射程，单位：米
+#define LB_MIS_FIELDS 25 //导弹字段数
+
+#define LB_TARGET_FIELDS 6 //导弹目标字段数，LB_PX ~ LB_VZ
+
+#define LB_LANE_ALIGN 8  //通道数补齐到此值的倍数，保证每行可整段装入向量寄存器
+
+#define LB_LIVE 1        //存活或运行中，取值同 CS_LIVE
+#define LB_NOT_LIVE -1   //导弹命中，取值同 CS_NOT_LIVE
+#define LB_MISS -2       //导弹未命中，取值同 CS_MISS
+
+#define LB_GRAVITY 9.8015 //重力加速度，取值同 simple_gravity
+	/** @}  */
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          飞机槽位的全部通道推进一步
+	*   @details        四阶龙格库塔推进运动状态，死亡通道保持原状态
+	*   @param[in,out]  in_row          飞机各字段的通道数组，LB_AIR_FIELDS 行
+	*   @param[in]      live            飞机存活状态的通道数组
+	*   @param[in]      stride          通道数组长度
+	*   @param[in]      d_time          单步时间间隔 单位：秒
+	*/
+	void LaneRunAircraft(
+		double* const*					in_row,
+		const int*						live,
+		int								stride,
+		double							d_time);
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          导弹槽位的全部通道推进一步
+	*   @details        命中判定、过点飞制导和动力学解算，击毁的目标只记入 kill，由调用方置为死亡
+	*   @param[in,out]  in_row          导弹各字段的通道数组，LB_MIS_FIELDS 行
+	*   @param[in,out]  status          导弹状态的通道数组
+	*   @param[in]      in_target_row   目标位置和速度的通道数组，LB_TARGET_FIELDS 行
+	*   @param[in]      target_live     目标存活状态的通道数组
+	*   @param[out]     kill            各通道本次是否击毁目标，1 击毁，0 未击毁
+	*   @param[in]      stride          通道数组长度
+	*   @param[in]      d_time          单步时间间隔 单位：秒
+	*/
+	void LaneRunMissile(
+		double* const*					in_row,
+		int*							status,
+		const double* const*			in_target_row,
+		const int*						target_live,
+		int*							kill,
+		int								stride,
+		double							d_time);
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          导弹槽位的全部通道对目标做近炸判定
+	*   @details        与 MissileProximityCheck 相同，取 t∈[-d_time,0] 内的最近点距离与杀伤半径比较
+	*   @param[in]      in_row          导弹各字段的通道数组，LB_MIS_FIELDS 行
+	*   @param[in,out]  status          导弹状态的通道数组
+	*   @param[in]      in_target_row   目标位置和速度的通道数组，LB_TARGET_FIELDS 行
+	*   @param[in]      target_live     目标存活状态的通道数组
+	*   @param[out]     kill            各通道本次是否击毁目标，1 击毁，0 未击毁
+	*   @param[in]      stride          通道数组长度
+	*   @param[in]      d_time          单步时间间隔 单位：秒
+	*/
+	void LaneRunFuze(
+		const double* const*			in_row,
+		int*							status,
+		const double* const*			in_target_row,
+		const int*						target_live,
+		int*							kill,
+		int								stride,
+		double							d_time);
+}
+
+
+
+#endif // Lane_Kernel_H
@@ -0,0 +1,536 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           ResetPool.cpp
+*   @brief          初始态池实现。
+*   @details        初始态池实现。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           头文件。
+*   @{
+*/
+#include "ResetPool.h"
+#include "../Tools/coordinate.h"
+#include <chrono>
+
+using namespace CombatSimulation;
+/** @}  */
+
+
+//后台线程等待取用：先让出时间片，仍无可生成的局时短暂休眠
+static void IdleWait(int* idle_count)
+{
+	(*idle_count)++;
+	if (*idle_count < 64) {
+		std::this_thread::yield();
+	}
+	else {
+		std::this_thread::sleep_for(std::chrono::microseconds(50));
+	}
+}
+
+
+ResetPool_C::ResetPool_C(
+	int								in_slot_count,
+	int								in_agent_count,
+	int								in_env_count)
+	: ready_count(0),
+	miss_count(0),
+	running(false)
+{
+	agent_count = in_agent_count;
+	if (agent_count < 1) {
+		agent_count = 1;
+	}
+	if (agent_count > max_object) {
+		agent_count = max_object;
+	}
+
+	//槽按战场均分，每个战场至少1个
+	env_count = (in_env_count < 1) ? 1 : in_env_count;
+	depth = (in_slot_count < env_count) ? 1 : in_slot_count / env_count;
+	slot_count = depth * env_count;
+
+	slot_size = Battlefield_C::SnapshotCapacity();
+	slot_buffer.resize((size_t)slot_count * slot_size);
+	slot_list = new ResetSlot_T[slot_count];
+	for (int i = 0; i < slot_count; i++) {
+		slot_list[i].state.store(SLOT_EMPTY);
+		slot_list[i].seed = 0;
+		slot_list[i].episode = 0;
+	}
+	next_take = new std::atomic<unsigned long long>[env_count];
+	for (int i = 0; i < env_count; i++) {
+		next_take[i].store(0);
+	}
+	next_produce.assign(env_count, 0);
+
+	reset_func = NULL;
+	reset_context = NULL;
+	distribution = DefaultDistribution();
+	seed = 1;
+
+	scratch.InitCoordinate(126.0, 30.0, 0.0);
+	name_table = scratch.string_table;
+}
+
+
+ResetPool_C::~ResetPool_C()
+{
+	Stop();
+	delete[] slot_list;
+	delete[] next_take;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          设置参考点
+*   @details        只能在停止状态下设置
+*   @param[in]      in_reference_longitude             参考点经度，单位：deg
+*   @param[in]      in_reference_latitude              参考点纬度，单位：deg
+*   @param[in]      in_reference_altitude              参考点高度，单位：米
+*   @retval         0               正常
+*   @retval         1               错误，池正在运行
+*/
+int ResetPool_C::SetReference(
+	double							in_reference_longitude,
+	double							in_reference_latitude,
+	double							in_reference_altitude)
+{
+	if (running.load()) {
+		return 1;
+	}
+
+	scratch.InitCoordinate(in_reference_longitude, in_reference_latitude, in_reference_altitude);
+
+	return CS_OK;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          设置对局初始化函数
+*   @details        不设置或设为 NULL 时按 SetDistribution 设置的分布生成。只能在停止状态下设置。
+					初始化函数的随机数发生器由(种子，战场序号，episode)导出，函数须只依赖传入的参数，
+					可能在后台线程和 Take 的调用线程中同时调用
+*   @param[in]      in_reset        对局初始化函数
+*   @param[in]      in_context      传给初始化函数的上下文
+*   @retval         0               正常
+*   @retval         1               错误，池正在运行
+*/
+int ResetPool_C::SetReset(
+	BattlefieldReset_F				in_reset,
+	void*							in_context)
+{
+	if (running.load()) {
+		return 1;
+	}
+
+	reset_func = in_reset;
+	reset_context = in_context;
+
+	return CS_OK;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          设置初始态分布
+*   @details        只能在停止状态下设置
+*   @param[in]      in_distribution 初始态分布
+*   @retval         0               正常
+*   @retval         1               错误，池正在运行
+*/
+int ResetPool_C::SetDistribution(const ResetDistribution_T& in_distribution)
+{
+	if (running.load()) {
+		return 1;
+	}
+
+	distribution = in_distribution;
+
+	return CS_OK;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          开始后台生成
+*   @details        清空池中已有的初始态，按新种子为每个战场从第0局开始生成
+*   @param[in]      in_seed         随机数种子，与 Take 传入的种子相同时才能命中
+*   @retval         0               正常
+*/
+int ResetPool_C::Start(unsigned long long in_seed)
+{
+	Stop();
+
+	for (int i = 0; i < slot_count; i++) {
+		slot_list[i].state.store(SLOT_EMPTY);
+	}
+	for (int i = 0; i < env_count; i++) {
+		next_take[i].store(0);
+		next_produce[i] = 0;
+	}
+	ready_count.store(0);
+	miss_count.store(0);
+
+	seed = in_seed;
+	running.store(true);
+	producer = std::thread(&ResetPool_C::ProducerLoop, this);
+
+	return CS_OK;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          停止后台生成
+*   @details        等待后台线程退出，池中已就绪的初始态仍可取用
+*   @retval         0               正常
+*/
+int ResetPool_C::Stop()
+{
+	running.store(false);
+	if (producer.joinable()) {
+		producer.join();
+	}
+
+	return CS_OK;
+}
+
+
+//战场 env_index 第 episode 局中第 entity 个实体的随机数键，局序号超过32位的部分并入种子
+static void SampleKey(
+	CounterRand_T*					key,
+	unsigned long long				seed,
+	int								env_index,
+	unsigned long long				episode,
+	int								entity)
+{
+	crand_key(key, seed + (episode >> 32) * 0x9E3779B97F4A7C15ULL, (unsigned int)env_index, (unsigned int)entity,
+		(unsigned int)episode);
+}
+
+
+//按分布布置第 a 架飞机，noise 为位置北、东、高度、速度、航向5个标准高斯扰动
+static void PlaceAircraft(
+	Battlefield_C*					battlefield,
+	int								a,
+	const ResetDistribution_T&		dist,
+	const double					noise[5])
+{
+	const BattlefieldHeader_T& header = battlefield->battle_header;
+	int team = 1 + a % 2;
+	double side = (team == 1) ? -1.0 : 1.0;
+
+	double north = side * 0.5 * dist.separation + dist.position_sigma * noise[0];
+	double east = dist.lateral_spacing * (a / 2) + dist.position_sigma * noise[1];
+	double altitude = dist.altitude + dist.altitude_sigma * noise[2];
+
+	double lon, lat, alt;
+	navigation_to_earth(&lon, &lat, &alt, north, east, 0.0,
+		header.reference_longitude, header.reference_latitude, header.reference_altitude);
+
+	//1队向北，2队向南
+	double yaw = ((team == 1) ? 0.0 : 180.0) + dist.heading_sigma * noise[4];
+	double speed = dist.speed + dist.speed_sigma * noise[3];
+	double yaw_rad;
+	deg2rad(&yaw_rad, yaw);
+	battlefield->aircraft_list[a].Init(10000001 + a, "F-16", team, lon, lat, altitude, 0, 0, yaw,
+		speed * cos(yaw_rad), speed * sin(yaw_rad), 0.0);
+	battlefield->aircraft_list[a].craft_handle.setZero();
+}
+
+
+void ResetPool_C::ProducerLoop()
+{
+	int idle_count = 0;
+
+	while (running.load(std::memory_order_relaxed)) {
+		int produced = 0;
+		for (int e = 0; e < env_count && running.load(std::memory_order_relaxed); e++) {
+			produced += ProduceOne(e);
+		}
+		if (produced == 0) {
+			IdleWait(&idle_count);
+		}
+		else {
+			idle_count = 0;
+		}
+	}
+}
+
+
+int ResetPool_C::ProduceOne(int env_index)
+{
+	//取用方已越过的局不再生成，最多领先 depth 局
+	unsigned long long take = next_take[env_index].load(std::memory_order_acquire);
+	if (next_produce[env_index] < take) {
+		next_produce[env_index] = take;
+	}
+	unsigned long long episode = next_produce[env_index];
+	if (episode - take >= (unsigned long long)depth) {
+		return 0;
+	}
+
+	//槽中是已被越过的局时收回重用
+	ResetSlot_T& slot = slot_list[env_index * depth + (int)(episode % depth)];
+	int state = SLOT_READY;
+	if (slot.state.load(std::memory_order_acquire) == SLOT_READY && (slot.seed != seed || slot.episode < take) &&
+		slot.state.compare_exchange_strong(state, SLOT_BUSY, std::memory_order_acq_rel)) {
+		ready_count.fetch_sub(1, std::memory_order_relaxed);
+		slot.state.store(SLOT_EMPTY, std::memory_order_release);
+	}
+	if (slot.state.load(std::memory_order_acquire) != SLOT_EMPTY) {
+		return 0;
+	}
+
+	//生成失败的局留给 Take 同步生成，由其返回错误
+	next_produce[env_index]++;
+	if (Generate(&scratch, seed, env_index, episode) != 0) {
+		return 1;
+	}
+
+	int slot_index = (int)(&slot - slot_list);
+	scratch.SaveSnapshot(&slot_buffer[(size_t)slot_index * slot_size], slot_size, NULL);
+
+	//新登记的名字先同步到副本，再放出引用它的快照
+	if (name_table.Count() != scratch.string_table.Count()) {
+		std::lock_guard<std::mutex> lock(name_lock);
+		name_table = scratch.string_table;
+	}
+
+	slot.seed = seed;
+	slot.episode = episode;
+	slot.state.store(SLOT_READY, std::memory_order_release);
+	ready_count.fetch_add(1, std::memory_order_relaxed);
+
+	return 1;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          取出一份初始态
+*   @details        池中有(in_seed，env_index，episode)的初始态时恢复到目标战场，否则在调用线程中同步生成，结果相同。
+					时标、实体、事件和活动列表全部被替换，参考点、字符串表和分级解算设置保留
+*   @param[in,out]  battlefield     目标战场
+*   @param[in]      in_seed         随机数种子
+*   @param[in]      env_index       战场序号
+*   @param[in]      episode         局序号
+*   @retval         0               正常
+*   @retval         1               错误，参数无效或初始化函数返回错误
+*/
+int ResetPool_C::Take(
+	Battlefield_C*					battlefield,
+	unsigned long long				in_seed,
+	int								env_index,
+	unsigned long long				episode)
+{
+	if (battlefield == NULL || env_index < 0 || env_index >= env_count) {
+		return 1;
+	}
+
+	int slot_index = env_index * depth + (int)(episode % depth);
+	ResetSlot_T& slot = slot_list[slot_index];
+	int state = SLOT_READY;
+	int hit = 0;
+	if (slot.state.compare_exchange_strong(state, SLOT_BUSY, std::memory_order_acq_rel)) {
+		if (slot.seed == in_seed && slot.episode == episode) {
+			hit = 1;
+		}
+		else if (slot.seed == in_seed && slot.episode > episode) {
+			//后面的局，留待以后取用
+			slot.state.store(SLOT_READY, std::memory_order_release);
+		}
+		else {
+			ready_count.fetch_sub(1, std::memory_order_relaxed);
+			slot.state.store(SLOT_EMPTY, std::memory_order_release);
+		}
+	}
+
+	//后台线程下一次从本局之后生成
+	next_take[env_index].store(episode + 1, std::memory_order_release);
+
+	if (hit == 0) {
+		miss_count.fetch_add(1, std::memory_order_relaxed);
+		return (Generate(battlefield, in_seed, env_index, episode) == 0) ? CS_OK : 1;
+	}
+
+	int lod_enable = battlefield->lod_enable;
+	double lod_promote_range = battlefield->lod_promote_range;
+	double lod_demote_range = battlefield->lod_demote_range;
+
+	battlefield->RestoreSnapshot(&slot_buffer[(size_t)slot_index * slot_size]);
+	ready_count.fetch_sub(1, std::memory_order_relaxed);
+	slot.state.store(SLOT_EMPTY, std::memory_order_release);
+
+	battlefield->lod_enable = lod_enable;
+	battlefield->lod_promote_range = lod_promote_range;
+	battlefield->lod_demote_range = lod_demote_range;
+
+	{
+		std::lock_guard<std::mutex> lock(name_lock);
+		StringTable_C& table = battlefield->string_table;
+		for (int i = 0; i < battlefield->aircraft_count; i++) {
+			Aircraft_Object_C& air = battlefield->aircraft_list[i];
+			air.p_cold->base_name_id = RemapName(table, air.p_cold->base_name_id);
+			air.p_cold->base_type_id = RemapName(table, air.p_cold->base_type_id);
+		}
+		for (int i = 0; i < battlefield->missile_count; i++) {
+			Missile_Object_C& missile = battlefield->missile_list[i];
+			missile.p_cold->base_name_id = RemapName(table, missile.p_cold->base_name_id);
+			missile.p_cold->base_type_id = RemapName(table, missile.p_cold->base_type_id);
+		}
+	}
+
+	return CS_OK;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          同步生成一份初始态
+*   @details        在调用线程中清空目标战场并按(in_seed，env_index，episode)生成，与后台生成的相同，不经过池
+*   @param[in,out]  battlefield     目标战场
+*   @param[in]      in_seed         随机数种子
+*   @param[in]      env_index       战场序号
+*   @param[in]      episode         局序号
+*   @retval         0               正常
+*   @retval         其他            初始化函数返回的错误
+*/
+int ResetPool_C::Generate(
+	Battlefield_C*					battlefield,
+	unsigned long long				in_seed,
+	int								env_index,
+	unsigned long long				episode) const
+{
+	battlefield->Reset();
+	int error;
+	if (reset_func != NULL) {
+		//自定义初始化函数使用 GaussRand_T，种子取自槽位 max_object 的计数器随机数
+		CounterRand_T key;
+		GaussRand_T rand_state;
+		double u;
+		SampleKey(&key, in_seed, env_index, episode, max_object);
+		crand_uniform(&u, &key, 0);
+		gaussrand_init(&rand_state, (unsigned long long)(u * 9007199254740992.0));
+		error = reset_func(battlefield, env_index, agent_count, &rand_state, reset_context);
+	}
+	else {
+		error = DistributionSample(battlefield, agent_count, distribution, in_seed, env_index, episode);
+	}
+	if (error != 0) {
+		return error;
+	}
+
+	//初始化函数未布置足够的飞机时，补齐为死亡的占位
+	for (int a = battlefield->aircraft_count; a < agent_count; a++) {
+		battlefield->aircraft_list[a].base_live = 0;
+		battlefield->aircraft_list[a].craft_state.setZero();
+	}
+	if (battlefield->aircraft_count < agent_count) {
+		battlefield->aircraft_count = agent_count;
+	}
+
+	return CS_OK;
+}
+
+
+int ResetPool_C::RemapName(StringTable_C& table, int id)
+{
+	return table.Intern(name_table.Lookup(id));
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          默认初始态分布
+*   @details        两队相距20公里，同队间隔1公里，位置标准差500米，高度6000±200米，速度250米/秒
+*/
+ResetDistribution_T ResetPool_C::DefaultDistribution()
+{
+	ResetDistribution_T dist;
+	dist.separation = 20000.0;
+	dist.lateral_spacing = 1000.0;
+	dist.position_sigma = 500.0;
+	dist.altitude = 6000.0;
+	dist.altitude_sigma = 200.0;
+	dist.speed = 250.0;
+	dist.speed_sigma = 0.0;
+	dist.heading_sigma = 0.0;
+
+	return dist;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          按分布初始化对局
+*   @details        context 为 ResetDistribution_T*，为 NULL 时使用默认分布
+*/
+int ResetPool_C::DistributionReset(
+	Battlefield_C* battlefield,
+	int env_index,
+	int agent_count,
+	GaussRand_T* rand_state,
+	void* context)
+{
+	(void)env_index;
+	ResetDistribution_T dist = (context != NULL) ? *(const ResetDistribution_T*)context : DefaultDistribution();
+
+	for (int a = 0; a < agent_count; a++) {
+		double noise[5];
+		for (int k = 0; k < 5; k++) {
+			gaussrand(&noise[k], rand_state);
+		}
+		PlaceAircraft(battlefield, a, dist, noise);
+	}
+	battlefield->aircraft_count = agent_count;
+
+	return CS_OK;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          按分布生成战场 env_index 的第 episode 局初始态
+*   @details        与 DistributionReset 的布置相同，第 a 架飞机的5个高斯扰动取 crand_normal，键为(seed，env_index，a，episode)，
+*                   任一局、任一架飞机的扰动都可单独复现
+*   @param[in,out]  battlefield     已清空的战场
+*   @param[in]      agent_count     智能体数量
+*   @param[in]      dist            初始态分布
+*   @param[in]      in_seed         随机数种子
+*   @param[in]      env_index       战场序号
+*   @param[in]      episode         局序号
+*   @retval         0               正常
+*/
+int ResetPool_C::DistributionSample(
+	Battlefield_C* battlefield,
+	int agent_count,
+	const ResetDistribution_T& dist,
+	unsigned long long in_seed,
+	int env_index,
+	unsigned long long episode)
+{
+	for (int a = 0; a < agent_count; a++) {
+		CounterRand_T key;
+		double noise[5];
+		SampleKey(&key, in_seed, env_index, episode, a);
+		crand_normal_batch(noise, 5, &key, 0);
+		PlaceAircraft(battlefield, a, dist, noise);
+	}
+	battlefield->aircraft_count = agent_count;
+
+	return CS_OK;
+}
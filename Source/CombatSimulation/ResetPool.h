@@ -0,0 +1,308 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           ResetPool.h
+*   @brief          初始态池。
+*   @details        后台线程预先按给定分布生成对局初始态，以快照形式存放在池中。重新开始对局时直接从池中取一份快照恢复，
+					经纬高到导航系的转换、欧拉角到四元数的转换和名字登记都已在后台完成。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+#ifndef Reset_Pool_H
+#define Reset_Pool_H
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           头文件。
+*   @{
+*/
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include "BattlefieldSnapshot.h"
+#include "../Tools/tool_function.h"
+#include "../Tools/counter_rand.h"
+
+/** @}  */
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          CombatSimulation 命名空间。
+*   @details        CombatSimulation 命名空间。
+*/
+namespace CombatSimulation
+{
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          对局初始化函数。
+	*   @details        在已清空的战场中布置新对局。前 agent_count 架飞机(aircraft_list[0] ~ aircraft_list[agent_count-1])为受控智能体，
+					aircraft_count 不得小于 agent_count。
+	*   @param[in,out]  battlefield     已清空的战场
+	*   @param[in]      env_index       战场序号
+	*   @param[in]      agent_count     智能体数量
+	*   @param[in,out]  rand_state      本战场的随机数发生器，用于初始态扰动
+	*   @param[in]      context         调用者传入的上下文
+	*   @retval         0               正常
+	*   @retval         其他            错误
+	*/
+	typedef int (*BattlefieldReset_F)(
+		Battlefield_C* battlefield,
+		int env_index,
+		int agent_count,
+		GaussRand_T* rand_state,
+		void* context);
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          初始态分布。
+	*   @details        智能体按序号交替分为1、2两队，在参考点南北两侧对头飞行。各项在均值上叠加高斯扰动，标准差为0时不扰动。
+	*/
+	struct ResetDistribution_T
+	{
+		double							separation;						//!< 两队南北间距，单位：米
+		double							lateral_spacing;				//!< 同队飞机东向间隔，单位：米
+		double							position_sigma;					//!< 水平位置标准差，单位：米
+		double							altitude;						//!< 高度，单位：米
+		double							altitude_sigma;					//!< 高度标准差，单位：米
+		double							speed;							//!< 速度，单位：米/秒
+		double							speed_sigma;					//!< 速度标准差，单位：米/秒
+		double							heading_sigma;					//!< 航向标准差，单位：deg
+	};
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          初始态池。
+	*   @details        每个战场的第 episode 局初始态由(种子，战场序号，episode)唯一确定，与生成时机、生成线程和是否命中池无关。
+					槽按战场均分，每个战场有 slot_count / env_count 个槽，第 episode 局固定放在第 episode % 深度 个槽中，
+					后台线程为每个战场提前生成取用方之后的若干局，以快照形式存放。Take 在槽中找到同一键的初始态时直接恢复，
+					否则在调用线程中同步生成，两种方式得到的初始态相同。
+					同一战场的 Take 须依次调用，不同战场可在多个线程中同时调用。
+					目标战场的参考点须与池的参考点相同；名字编号在取出时换算为目标战场字符串表中的编号。
+	*/
+	class ResetPool_C
+	{
+	public:
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          创建初始态池
+		*   @details        创建初始态池，参数超出范围时截断到有效范围。创建后处于停止状态
+		*   @param[in]      in_slot_count   槽数，不足 in_env_count 时按每个战场1个槽
+		*   @param[in]      in_agent_count  智能体数量，1 ~ max_object
+		*   @param[in]      in_env_count    战场数量，不小于1
+		*/
+		ResetPool_C(
+			int								in_slot_count,
+			int								in_agent_count,
+			int								in_env_count = 1);
+		~ResetPool_C();
+
+		//持有后台线程，禁止拷贝
+		ResetPool_C(const ResetPool_C&) = delete;
+		ResetPool_C& operator=(const ResetPool_C&) = delete;
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          设置参考点
+		*   @details        只能在停止状态下设置
+		*   @param[in]      in_reference_longitude             参考点经度，单位：deg
+		*   @param[in]      in_reference_latitude              参考点纬度，单位：deg
+		*   @param[in]      in_reference_altitude              参考点高度，单位：米
+		*   @retval         0               正常
+		*   @retval         1               错误，池正在运行
+		*/
+		int SetReference(
+			double							in_reference_longitude,
+			double							in_reference_latitude,
+			double							in_reference_altitude);
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          设置对局初始化函数
+		*   @details        不设置或设为 NULL 时按 SetDistribution 设置的分布生成。只能在停止状态下设置。
+						初始化函数的随机数发生器由(种子，战场序号，episode)导出，函数须只依赖传入的参数，
+						可能在后台线程和 Take 的调用线程中同时调用
+		*   @param[in]      in_reset        对局初始化函数
+		*   @param[in]      in_context      传给初始化函数的上下文
+		*   @retval         0               正常
+		*   @retval         1               错误，池正在运行
+		*/
+		int SetReset(
+			BattlefieldReset_F				in_reset,
+			void*							in_context);
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          设置初始态分布
+		*   @details        只能在停止状态下设置
+		*   @param[in]      in_distribution 初始态分布
+		*   @retval         0               正常
+		*   @retval         1               错误，池正在运行
+		*/
+		int SetDistribution(const ResetDistribution_T& in_distribution);
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          开始后台生成
+		*   @details        清空池中已有的初始态，按新种子为每个战场从第0局开始生成
+		*   @param[in]      in_seed         随机数种子，与 Take 传入的种子相同时才能命中
+		*   @retval         0               正常
+		*/
+		int Start(unsigned long long in_seed);
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          停止后台生成
+		*   @details        等待后台线程退出，池中已就绪的初始态仍可取用
+		*   @retval         0               正常
+		*/
+		int Stop();
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          取出一份初始态
+		*   @details        池中有(in_seed，env_index，episode)的初始态时恢复到目标战场，否则在调用线程中同步生成，结果相同。
+						时标、实体、事件和活动列表全部被替换，参考点、字符串表和分级解算设置保留
+		*   @param[in,out]  battlefield     目标战场
+		*   @param[in]      in_seed         随机数种子
+		*   @param[in]      env_index       战场序号
+		*   @param[in]      episode         局序号
+		*   @retval         0               正常
+		*   @retval         1               错误，参数无效或初始化函数返回错误
+		*/
+		int Take(
+			Battlefield_C*					battlefield,
+			unsigned long long				in_seed,
+			int								env_index,
+			unsigned long long				episode);
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          同步生成一份初始态
+		*   @details        在调用线程中清空目标战场并按(in_seed，env_index，episode)生成，与后台生成的相同，不经过池
+		*   @param[in,out]  battlefield     目标战场
+		*   @param[in]      in_seed         随机数种子
+		*   @param[in]      env_index       战场序号
+		*   @param[in]      episode         局序号
+		*   @retval         0               正常
+		*   @retval         其他            初始化函数返回的错误
+		*/
+		int Generate(
+			Battlefield_C*					battlefield,
+			unsigned long long				in_seed,
+			int								env_index,
+			unsigned long long				episode) const;
+
+		int ReadyCount() const { return ready_count.load(std::memory_order_relaxed); }
+		int MissCount() const { return miss_count.load(std::memory_order_relaxed); }
+		int SlotCount() const { return slot_count; }
+		int AgentCount() const { return agent_count; }
+		int EnvCount() const { return env_count; }
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          默认初始态分布
+		*   @details        两队相距20公里，同队间隔1公里，位置标准差500米，高度6000±200米，速度250米/秒
+		*/
+		static ResetDistribution_T DefaultDistribution();
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          按分布初始化对局
+		*   @details        context 为 ResetDistribution_T*，为 NULL 时使用默认分布
+		*/
+		static int DistributionReset(
+			Battlefield_C* battlefield,
+			int env_index,
+			int agent_count,
+			GaussRand_T* rand_state,
+			void* context);
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          按分布生成战场 env_index 的第 episode 局初始态
+		*   @details        与 DistributionReset 的布置相同，第 a 架飞机的5个高斯扰动取 crand_normal，键为(seed，env_index，a，episode)
+		*   @param[in,out]  battlefield     已清空的战场
+		*   @param[in]      agent_count     智能体数量
+		*   @param[in]      dist            初始态分布
+		*   @param[in]      in_seed         随机数种子
+		*   @param[in]      env_index       战场序号
+		*   @param[in]      episode         局序号
+		*   @retval         0               正常
+		*/
+		static int DistributionSample(
+			Battlefield_C* battlefield,
+			int agent_count,
+			const ResetDistribution_T& dist,
+			unsigned long long in_seed,
+			int env_index,
+			unsigned long long episode);
+
+	private:
+		//槽状态
+		enum
+		{
+			SLOT_EMPTY = 0,												//!< 空槽，后台线程可写入
+			SLOT_READY = 1,												//!< 已存放初始态
+			SLOT_BUSY = 2												//!< 正在被取用或检查
+		};
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          槽。
+		*   @details        键在状态置为 SLOT_READY 之前写入，取用方以 SLOT_READY -> SLOT_BUSY 独占后读取。
+		*/
+		struct ResetSlot_T
+		{
+			std::atomic<int>			state;
+			unsigned long long			seed;							//!< 生成时的种子
+			unsigned long long			episode;						//!< 局序号
+		};
+
+		int								slot_count;						//!< 槽数
+		int								agent_count;					//!< 智能体数量
+		int								env_count;						//!< 战场数量
+		int								depth;							//!< 每个战场的槽数
+		int								slot_size;						//!< 每个槽的字节数
+		std::vector<unsigned char>		slot_buffer;					//!< 快照存储 [slot_count][slot_size]
+		ResetSlot_T*					slot_list;						//!< 槽状态 [env_count][depth]
+
+		std::atomic<unsigned long long>* next_take;						//!< 每个战场下次取用的局序号，由 Take 写入
+		std::vector<unsigned long long>	next_produce;					//!< 每个战场下次生成的局序号，只由后台线程访问
+		std::atomic<int>				ready_count;
+		std::atomic<int>				miss_count;						//!< 同步生成的次数
+
+		Battlefield_C					scratch;						//!< 后台线程生成初始态用的战场
+		StringTable_C					name_table;						//!< 后台字符串表的副本，供 Take 换算名字编号
+		std::mutex						name_lock;
+
+		BattlefieldReset_F				reset_func;
+		void*							reset_context;
+		ResetDistribution_T				distribution;
+		unsigned long long				seed;
+
+		std::thread						producer;						//!< 后台线程
+		std::atomic<bool>				running;
+
+		//后台线程入口
+		void ProducerLoop();
+
+		//为战场 env_index 生成下一局，返回 1 表示生成了一份
+		int ProduceOne(int env_index);
+
+		//把名字编号换算为目标战场字符串表中的编号
+		int RemapName(StringTable_C& table, int id);
+	};
+}
+
+
+
+#endif // Reset_Pool_H
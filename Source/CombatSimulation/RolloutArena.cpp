@@ -0,0 +1,273 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           RolloutArena.cpp
+*   @brief          并行推演实现。
+*   @details        并行推演实现。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           头文件。
+*   @{
+*/
+#include "RolloutArena.h"
+
+using namespace CombatSimulation;
+/** @}  */
+
+
+//飞机所属队伍中是否有一队全部被击毁
+static int TeamEliminated(const Battlefield_C* battlefield)
+{
+	int team_list[max_object];
+	int team_live[max_object];
+	int team_count = 0;
+
+	for (int i = 0; i < battlefield->aircraft_count; i++) {
+		const Aircraft_Object_C& air = battlefield->aircraft_list[i];
+		int k = 0;
+		while (k < team_count && team_list[k] != air.base_team) {
+			k++;
+		}
+		if (k == team_count) {
+			team_list[team_count] = air.base_team;
+			team_live[team_count] = 0;
+			team_count++;
+		}
+		if (air.base_live == CS_LIVE) {
+			team_live[k]++;
+		}
+	}
+
+	for (int k = 0; k < team_count; k++) {
+		if (team_live[k] == 0) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+
+RolloutArena_C::RolloutArena_C(
+	int								in_branch_capacity,
+	int								in_thread_count)
+	: pool(in_thread_count)
+{
+	branch_capacity = (in_branch_capacity < 1) ? 1 : in_branch_capacity;
+	branch_count = 0;
+	branch_list = new Battlefield_C[branch_capacity];
+	root_snapshot.resize(Battlefield_C::SnapshotCapacity());
+
+	done_func = NULL;
+	done_context = NULL;
+
+	run_controls = NULL;
+	run_segment_count = 0;
+	run_segment_time = 0;
+	run_horizon = 0;
+	run_d_time = 0;
+	run_summary = NULL;
+}
+
+
+RolloutArena_C::~RolloutArena_C()
+{
+	delete[] branch_list;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          分叉
+*   @details        保存源战场快照，之后的 Run 中每个分支都从该状态开始。源战场不被修改
+*   @param[in]      source          源战场
+*   @param[in]      in_branch_count 分支数，1 ~ 最大分支数
+*   @retval         0               正常
+*   @retval         1               错误
+*/
+int RolloutArena_C::Fork(
+	const Battlefield_C&			source,
+	int								in_branch_count)
+{
+	if (in_branch_count < 1 || in_branch_count > branch_capacity) {
+		return 1;
+	}
+
+	if (source.SaveSnapshot(&root_snapshot[0], (int)root_snapshot.size(), NULL) != CS_OK) {
+		return 1;
+	}
+
+	branch_count = in_branch_count;
+	for (int k = 0; k < branch_count; k++) {
+		Battlefield_C& branch = branch_list[k];
+		branch.InitCoordinate(source.battle_header.reference_longitude, source.battle_header.reference_latitude,
+			source.battle_header.reference_altitude);
+		//名字编号沿用源战场，字符串表很小，每次分叉都复制
+		branch.string_table = source.string_table;
+	}
+
+	return CS_OK;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          设置结局判定函数
+*   @details        不设置或设为 NULL 时，飞机所属队伍中有一队全部被击毁即结局已定
+*   @param[in]      in_done         结局判定函数
+*   @param[in]      in_context      传给判定函数的上下文
+*   @retval         0               正常
+*/
+int RolloutArena_C::SetDone(
+	RolloutDone_F					in_done,
+	void*							in_context)
+{
+	done_func = in_done;
+	done_context = in_context;
+
+	return CS_OK;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          并行推演全部分支
+*   @details        每个分支从分叉状态开始，按各自控制序列推演 horizon 秒或直到结局已定
+*   @param[in]      controls        控制序列 [branch_count][segment_count][aircraft_count][4]，为 NULL 时保持源战场的控制量
+*   @param[in]      segment_count   每个分支的控制段数
+*   @param[in]      segment_time    每段时长，单位：秒，按 d_time 四舍五入为整数步
+*   @param[in]      horizon         推演时长，单位：秒
+*   @param[in]      d_time          仿真步长，单位：秒
+*   @param[out]     summary_out     推演结果 [branch_count]
+*   @retval         0               正常
+*   @retval         1               错误
+*/
+int RolloutArena_C::Run(
+	const double*					controls,
+	int								segment_count,
+	double							segment_time,
+	double							horizon,
+	double							d_time,
+	RolloutSummary_T*				summary_out)
+{
+	if (branch_count < 1 || summary_out == NULL || d_time <= 0 || horizon < 0) {
+		return 1;
+	}
+	if (controls != NULL && (segment_count < 1 || segment_time <= 0)) {
+		return 1;
+	}
+
+	run_controls = controls;
+	run_segment_count = segment_count;
+	run_segment_time = segment_time;
+	run_horizon = horizon;
+	run_d_time = d_time;
+	run_summary = summary_out;
+
+	pool.ParallelFor(branch_count, RunTask, this);
+
+	run_controls = NULL;
+	run_summary = NULL;
+
+	return CS_OK;
+}
+
+
+void RolloutArena_C::RunTask(void* context, int branch)
+{
+	((RolloutArena_C*)context)->RunBranch(branch);
+}
+
+
+int RolloutArena_C::RunBranch(int branch)
+{
+	Battlefield_C& battlefield = branch_list[branch];
+	RolloutSummary_T& summary = run_summary[branch];
+
+	battlefield.RestoreSnapshot(&root_snapshot[0]);
+
+	int aircraft_count = battlefield.aircraft_count;
+	size_t segment_size = (size_t)aircraft_count * 4;
+	const double* branch_controls = (run_controls != NULL) ?
+		run_controls + (size_t)branch * run_segment_count * segment_size : NULL;
+
+	summary.steps = 0;
+	summary.decided = 0;
+	summary.kill_count = 0;
+	summary.killed_mask = 0;
+	summary.min_miss_distance = -1;
+	summary.closest_approach = -1;
+
+	//步数取整，避免累加误差多走或少走一步；分段同样按步序号计算，不用累加的时标
+	int step_count = (int)(run_horizon / run_d_time + 0.5);
+	int steps_per_segment = (int)(run_segment_time / run_d_time + 0.5);
+	if (steps_per_segment < 1) {
+		steps_per_segment = 1;
+	}
+	for (int step = 0; step < step_count; step++) {
+		if (branch_controls != NULL) {
+			int segment = step / steps_per_segment;
+			if (segment >= run_segment_count) {
+				segment = run_segment_count - 1;
+			}
+			const double* handle = branch_controls + segment * segment_size;
+			for (int i = 0; i < aircraft_count; i++) {
+				battlefield.aircraft_list[i].craft_handle << handle[i * 4 + 0], handle[i * 4 + 1],
+					handle[i * 4 + 2], handle[i * 4 + 3];
+			}
+		}
+
+		battlefield.Run(run_d_time);
+		summary.steps++;
+
+		for (int e = 0; e < battlefield.kill_event_count; e++) {
+			const KillEvent_T& kill = battlefield.kill_event_list[e];
+			summary.kill_count++;
+			summary.killed_mask |= 1u << kill.aircraft_index;
+			if (summary.min_miss_distance < 0 || kill.miss_distance < summary.min_miss_distance) {
+				summary.min_miss_distance = kill.miss_distance;
+			}
+		}
+
+		//运行中导弹与目标的最近距离
+		for (int k = 0; k < battlefield.active_missile_count; k++) {
+			const Missile_Object_C& missile = battlefield.missile_list[battlefield.active_missile_list[k]];
+			if (missile.missile_live != CS_LIVE || missile.p_target_air == NULL) {
+				continue;
+			}
+			double distance = (missile.p_target_air->craft_state.row(0) - missile.missile_state.row(0)).norm();
+			if (summary.closest_approach < 0 || distance < summary.closest_approach) {
+				summary.closest_approach = distance;
+			}
+		}
+
+		int done = (done_func != NULL) ? done_func(&battlefield, branch, done_context) : TeamEliminated(&battlefield);
+		if (done != 0) {
+			summary.decided = 1;
+			break;
+		}
+	}
+
+	summary.end_time = battlefield.time;
+	summary.aircraft_count = battlefield.aircraft_count;
+	for (int i = 0; i < max_object; i++) {
+		const Aircraft_Object_C& air = battlefield.aircraft_list[i];
+		int valid = i < battlefield.aircraft_count;
+		summary.final_live[i] = valid ? air.base_live : 0;
+		for (int j = 0; j < 3; j++) {
+			summary.final_position[i][j] = valid ? air.craft_state(0, j) : 0;
+			summary.final_velocity[i][j] = valid ? air.craft_state(1, j) : 0;
+		}
+	}
+
+	return CS_OK;
+}
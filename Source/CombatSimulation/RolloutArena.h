@@ -0,0 +1,190 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           RolloutArena.h
+*   @brief          并行推演。
+*   @details        从当前战场状态分叉出K个副本，各自按不同的控制序列推演一段时间，并行执行，只返回每个分支的简要结果，
+					用于规划和反事实分析。副本战场在池中复用，分叉通过快照完成，推演过程中不分配内存。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+#ifndef Rollout_Arena_H
+#define Rollout_Arena_H
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           头文件。
+*   @{
+*/
+#include <vector>
+#include "BattlefieldSnapshot.h"
+#include "../Tools/worker_pool.h"
+
+/** @}  */
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          CombatSimulation 命名空间。
+*   @details        CombatSimulation 命名空间。
+*/
+namespace CombatSimulation
+{
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          分支推演结果。
+	*   @details        只记录结果，不保存轨迹。
+	*/
+	struct RolloutSummary_T
+	{
+		int								steps;							//!< 实际推演步数
+		double							end_time;						//!< 结束时标，单位：秒
+		int								decided;						//!< 1 提前结束(结局已定)，0 推演到时长
+		int								kill_count;						//!< 击毁事件数
+		unsigned int					killed_mask;					//!< 被击毁飞机，第i位对应 aircraft_list[i]
+		double							min_miss_distance;				//!< 击毁事件中的最小脱靶量，没有击毁时为 -1，单位：米
+		double							closest_approach;				//!< 运行中导弹与其目标的最近距离，没有导弹时为 -1，单位：米
+		int								aircraft_count;					//!< 飞机数量
+		int								final_live[max_object];			//!< 结束时飞机存活状态
+		double							final_position[max_object][3];	//!< 结束时飞机导航系位置，单位：米
+		double							final_velocity[max_object][3];	//!< 结束时飞机导航系速度，单位：米/秒
+	};
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          结局判定函数。
+	*   @details        每步之后调用，返回非0时该分支提前结束。
+	*   @param[in]      battlefield     分支战场
+	*   @param[in]      branch          分支序号
+	*   @param[in]      context         调用者传入的上下文
+	*   @retval         0               继续
+	*   @retval         其他            结局已定
+	*/
+	typedef int (*RolloutDone_F)(
+		const Battlefield_C* battlefield,
+		int branch,
+		void* context);
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          并行推演。
+	*   @details        先 Fork 记录源战场状态，再用 Run 推演全部分支；同一次 Fork 可以多次 Run 不同的控制序列。
+					控制序列按时间分段，每段内控制量不变，布局为 [branch_count][segment_count][aircraft_count][4]，
+					与 craft_handle 相同；超出最后一段的时间沿用最后一段。
+	*/
+	class RolloutArena_C
+	{
+	public:
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          创建推演池
+		*   @details        创建推演池
+		*   @param[in]      in_branch_capacity  最大分支数，不小于1
+		*   @param[in]      in_thread_count     并行线程数，不大于0时取硬件线程数
+		*/
+		RolloutArena_C(
+			int								in_branch_capacity,
+			int								in_thread_count = 0);
+		~RolloutArena_C();
+
+		//持有战场数组，禁止拷贝
+		RolloutArena_C(const RolloutArena_C&) = delete;
+		RolloutArena_C& operator=(const RolloutArena_C&) = delete;
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          分叉
+		*   @details        保存源战场快照，之后的 Run 中每个分支都从该状态开始。源战场不被修改
+		*   @param[in]      source          源战场
+		*   @param[in]      in_branch_count 分支数，1 ~ 最大分支数
+		*   @retval         0               正常
+		*   @retval         1               错误
+		*/
+		int Fork(
+			const Battlefield_C&			source,
+			int								in_branch_count);
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          设置结局判定函数
+		*   @details        不设置或设为 NULL 时，飞机所属队伍中有一队全部被击毁即结局已定
+		*   @param[in]      in_done         结局判定函数
+		*   @param[in]      in_context      传给判定函数的上下文
+		*   @retval         0               正常
+		*/
+		int SetDone(
+			RolloutDone_F					in_done,
+			void*							in_context);
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          并行推演全部分支
+		*   @details        每个分支从分叉状态开始，按各自控制序列推演 horizon 秒或直到结局已定
+		*   @param[in]      controls        控制序列 [branch_count][segment_count][aircraft_count][4]，为 NULL 时保持源战场的控制量
+		*   @param[in]      segment_count   每个分支的控制段数
+		*   @param[in]      segment_time    每段时长，单位：秒，按 d_time 四舍五入为整数步
+		*   @param[in]      horizon         推演时长，单位：秒
+		*   @param[in]      d_time          仿真步长，单位：秒
+		*   @param[out]     summary_out     推演结果 [branch_count]
+		*   @retval         0               正常
+		*   @retval         1               错误
+		*/
+		int Run(
+			const double*					controls,
+			int								segment_count,
+			double							segment_time,
+			double							horizon,
+			double							d_time,
+			RolloutSummary_T*				summary_out);
+
+		int BranchCount() const { return branch_count; }
+		int ThreadCount() const { return pool.ThreadCount(); }
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          访问分支战场
+		*   @details        Run 之后为该分支的结束状态，可用于查看详细状态或继续推演
+		*   @param[in]      branch          分支序号
+		*   @retval         战场指针，序号无效时返回 NULL
+		*/
+		Battlefield_C* Branch(int branch) {
+			return (branch >= 0 && branch < branch_count) ? &branch_list[branch] : NULL;
+		}
+
+	private:
+		int								branch_capacity;				//!< 最大分支数
+		int								branch_count;					//!< 本次分支数
+		Battlefield_C*					branch_list;					//!< 分支战场池
+		std::vector<unsigned char>		root_snapshot;					//!< 分叉状态快照
+
+		WorkerPool_C					pool;							//!< 并行线程池
+
+		RolloutDone_F					done_func;
+		void*							done_context;
+
+		//本次 Run 的参数，由并行任务读取
+		const double*					run_controls;
+		int								run_segment_count;
+		double							run_segment_time;
+		double							run_horizon;
+		double							run_d_time;
+		RolloutSummary_T*				run_summary;
+
+		//并行任务入口
+		static void RunTask(void* context, int branch);
+
+		//推演单个分支
+		int RunBranch(int branch);
+	};
+}
+
+
+
+#endif // Rollout_Arena_H
@@ -0,0 +1,526 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           ScenarioFile.cpp
+*   @brief          二进制想定库实现。
+*   @details        二进制想定库实现。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           头文件。
+*   @{
+*/
+#include "ScenarioFile.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+using namespace CombatSimulation;
+/** @}  */
+
+
+//打开普通文件
+static FILE* OpenStream(const char* path, const char* mode)
+{
+	FILE* file = NULL;
+#ifdef _WIN32
+	if (fopen_s(&file, path, mode) != 0) {
+		return NULL;
+	}
+#else
+	file = fopen(path, mode);
+#endif
+	return file;
+}
+
+
+//按空白切分一行，返回词数；'#' 之后为注释
+static int SplitLine(char* line, char** word_list, int max_word)
+{
+	int word_count = 0;
+	char* p = line;
+
+	while (*p != 0 && *p != '#') {
+		while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') {
+			p++;
+		}
+		if (*p == 0 || *p == '#') {
+			break;
+		}
+		if (word_count == max_word) {
+			return -1;
+		}
+		word_list[word_count++] = p;
+		while (*p != 0 && *p != '#' && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n') {
+			p++;
+		}
+		if (*p == '#') {
+			*p = 0;
+			break;
+		}
+		if (*p != 0) {
+			*p++ = 0;
+		}
+	}
+
+	return word_count;
+}
+
+
+//整词转换为数值，不是完整数值时返回1
+static int ParseDouble(const char* word, double* value)
+{
+	char* end = NULL;
+	*value = strtod(word, &end);
+	return (end == word || *end != 0) ? 1 : 0;
+}
+
+
+static int ParseInt(const char* word, int* value)
+{
+	char* end = NULL;
+	long v = strtol(word, &end, 10);
+	*value = (int)v;
+	return (end == word || *end != 0) ? 1 : 0;
+}
+
+
+//复制定长名字，超长时返回1
+static int CopyName(char* dst, const char* src)
+{
+	size_t length = strlen(src);
+	if (length >= SCENARIO_NAME_SIZE) {
+		return 1;
+	}
+	memset(dst, 0, SCENARIO_NAME_SIZE);
+	memcpy(dst, src, length);
+	return 0;
+}
+
+
+ScenarioFile_C::ScenarioFile_C()
+{
+	data = NULL;
+	data_size = 0;
+	header = NULL;
+	scenario_table = NULL;
+	entity_table = NULL;
+	name_table = NULL;
+
+	map_view = NULL;
+	map_size = 0;
+#ifdef _WIN32
+	file_handle = NULL;
+	mapping_handle = NULL;
+#endif
+}
+
+
+ScenarioFile_C::~ScenarioFile_C()
+{
+	Close();
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          打开想定库文件
+*   @details        以只读方式映射整个文件并检查文件头，已打开的文件先关闭
+*   @param[in]      path            文件路径
+*   @retval         0               正常
+*   @retval         1               错误，文件无法打开或格式不符
+*/
+int ScenarioFile_C::Open(const char* path)
+{
+	Close();
+	if (path == NULL) {
+		return 1;
+	}
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE) {
+		return 1;
+	}
+	LARGE_INTEGER size;
+	if (GetFileSizeEx(file, &size) == 0 || size.QuadPart < (LONGLONG)sizeof(ScenarioFileHeader_T)) {
+		CloseHandle(file);
+		return 1;
+	}
+	HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mapping == NULL) {
+		CloseHandle(file);
+		return 1;
+	}
+	void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (view == NULL) {
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return 1;
+	}
+	file_handle = file;
+	mapping_handle = mapping;
+	map_view = view;
+	map_size = size.QuadPart;
+#else
+	int file = open(path, O_RDONLY);
+	if (file < 0) {
+		return 1;
+	}
+	struct stat status;
+	if (fstat(file, &status) != 0 || status.st_size < (off_t)sizeof(ScenarioFileHeader_T)) {
+		close(file);
+		return 1;
+	}
+	void* view = mmap(NULL, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+	close(file);
+	if (view == MAP_FAILED) {
+		return 1;
+	}
+	map_view = view;
+	map_size = (long long)status.st_size;
+#endif
+
+	data = (const unsigned char*)map_view;
+	data_size = map_size;
+	if (Validate() != 0) {
+		Close();
+		return 1;
+	}
+
+	return CS_OK;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          使用内存中的想定库
+*   @details        数据由调用者持有，关闭前须一直有效，首地址须按8字节对齐
+*   @param[in]      in_data         想定库数据
+*   @param[in]      size            字节数
+*   @retval         0               正常
+*   @retval         1               错误，格式不符
+*/
+int ScenarioFile_C::Attach(const void* in_data, long long size)
+{
+	Close();
+	if (in_data == NULL || ((size_t)in_data & 7) != 0) {
+		return 1;
+	}
+
+	data = (const unsigned char*)in_data;
+	data_size = size;
+	if (Validate() != 0) {
+		Close();
+		return 1;
+	}
+
+	return CS_OK;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          关闭想定库
+*   @details        解除文件映射
+*   @retval         0               正常
+*/
+int ScenarioFile_C::Close()
+{
+	if (map_view != NULL) {
+#ifdef _WIN32
+		UnmapViewOfFile(map_view);
+		CloseHandle((HANDLE)mapping_handle);
+		CloseHandle((HANDLE)file_handle);
+		mapping_handle = NULL;
+		file_handle = NULL;
+#else
+		munmap(map_view, (size_t)map_size);
+#endif
+		map_view = NULL;
+		map_size = 0;
+	}
+
+	data = NULL;
+	data_size = 0;
+	header = NULL;
+	scenario_table = NULL;
+	entity_table = NULL;
+	name_table = NULL;
+
+	return CS_OK;
+}
+
+
+int ScenarioFile_C::Validate()
+{
+	if (data_size < (long long)sizeof(ScenarioFileHeader_T)) {
+		return 1;
+	}
+
+	const ScenarioFileHeader_T* file_header = (const ScenarioFileHeader_T*)data;
+	if (file_header->magic != SCENARIO_MAGIC || file_header->version != SCENARIO_VERSION
+		|| file_header->header_size != (int)sizeof(ScenarioFileHeader_T)
+		|| file_header->record_size != (int)sizeof(AircraftSnapshot_T)
+		|| file_header->file_size != data_size) {
+		return 1;
+	}
+	if (file_header->scenario_count < 0 || file_header->entity_count < 0 || file_header->name_count < 1) {
+		return 1;
+	}
+
+	//各表须对齐且完整位于文件内
+	long long table_offset[3] = { file_header->scenario_offset, file_header->entity_offset, file_header->name_offset };
+	long long table_size[3] = {
+		(long long)file_header->scenario_count * (long long)sizeof(ScenarioRecord_T),
+		(long long)file_header->entity_count * (long long)sizeof(AircraftSnapshot_T),
+		(long long)file_header->name_count * SCENARIO_NAME_SIZE };
+	for (int t = 0; t < 3; t++) {
+		if (table_offset[t] < (long long)sizeof(ScenarioFileHeader_T) || (table_offset[t] & 7) != 0
+			|| table_offset[t] + table_size[t] > data_size) {
+			return 1;
+		}
+	}
+
+	header = file_header;
+	scenario_table = (const ScenarioRecord_T*)(data + file_header->scenario_offset);
+	entity_table = (const AircraftSnapshot_T*)(data + file_header->entity_offset);
+	name_table = (const char*)(data + file_header->name_offset);
+
+	return CS_OK;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          访问想定记录
+*   @details        访问想定记录
+*   @param[in]      index           想定下标
+*   @retval         想定记录，下标无效时返回 NULL
+*/
+const ScenarioRecord_T* ScenarioFile_C::Scenario(int index) const
+{
+	if (header == NULL || index < 0 || index >= header->scenario_count) {
+		return NULL;
+	}
+
+	return &scenario_table[index];
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          查询名字
+*   @details        查询名字
+*   @param[in]      name_index      名字表下标
+*   @retval         名字，下标无效时返回空字符串
+*/
+const char* ScenarioFile_C::Name(int name_index) const
+{
+	if (header == NULL || name_index < 0 || name_index >= header->name_count) {
+		return "";
+	}
+
+	const char* name = name_table + (size_t)name_index * SCENARIO_NAME_SIZE;
+	//文件损坏时名字可能没有结尾0
+	return (name[SCENARIO_NAME_SIZE - 1] == 0) ? name : "";
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          实例化想定
+*   @details        清空战场后装入想定中的飞机，参考点不同时重新设置参考点。名字换算为战场字符串表中的编号，分级解算设置保留
+*   @param[in]      index           想定下标
+*   @param[in,out]  battlefield     目标战场
+*   @retval         0               正常
+*   @retval         1               错误
+*/
+int ScenarioFile_C::Instantiate(
+	int								index,
+	Battlefield_C*					battlefield) const
+{
+	const ScenarioRecord_T* scenario = Scenario(index);
+	if (scenario == NULL || battlefield == NULL) {
+		return 1;
+	}
+	if (scenario->entity_count < 0 || scenario->entity_count > max_object || scenario->first_entity < 0
+		|| scenario->first_entity > header->entity_count - scenario->entity_count) {
+		return 1;
+	}
+
+	const BattlefieldHeader_T& battle_header = battlefield->battle_header;
+	if (battle_header.reference_longitude != scenario->reference[0] || battle_header.reference_latitude != scenario->reference[1]
+		|| battle_header.reference_altitude != scenario->reference[2]) {
+		battlefield->InitCoordinate(scenario->reference[0], scenario->reference[1], scenario->reference[2]);
+	}
+
+	battlefield->Reset();
+
+	StringTable_C& table = battlefield->string_table;
+	const AircraftSnapshot_T* record = entity_table + scenario->first_entity;
+	for (int i = 0; i < scenario->entity_count; i++) {
+		battlefield->LoadAircraft(i, record[i]);
+		Aircraft_Object_C& air = battlefield->aircraft_list[i];
+		air.p_cold->base_name_id = table.Intern(Name(record[i].base_name_id));
+		air.p_cold->base_type_id = table.Intern(Name(record[i].base_type_id));
+	}
+	battlefield->aircraft_count = scenario->entity_count;
+
+	return CS_OK;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          文本想定转换为二进制想定库
+*   @details        按文本格式逐行读取，用 Aircraft_Object_C::Init 算出初始状态后写入二进制文件
+*   @param[in]      text_path       文本想定路径
+*   @param[in]      binary_path     二进制想定库路径
+*   @retval         0               正常
+*   @retval         1               错误，文件无法读写或文本格式错误
+*/
+int ScenarioFile_C::ConvertText(
+	const char*						text_path,
+	const char*						binary_path)
+{
+	FILE* text = OpenStream(text_path, "r");
+	if (text == NULL) {
+		return 1;
+	}
+
+	std::vector<ScenarioRecord_T> scenario_list;
+	std::vector<AircraftSnapshot_T> entity_list;
+	//临时战场的字符串表即名字表，编号0为空字符串
+	Battlefield_C* scratch = new Battlefield_C;
+	int open_scenario = 0;
+	int error = 0;
+
+	char line[1024];
+	char* word[16];
+	while (error == 0 && fgets(line, sizeof(line), text) != NULL) {
+		int word_count = SplitLine(line, word, 16);
+		if (word_count == 0) {
+			continue;
+		}
+		if (word_count < 0) {
+			error = 1;
+		}
+		else if (strcmp(word[0], "scenario") == 0 && word_count == 5 && open_scenario == 0) {
+			ScenarioRecord_T scenario;
+			memset(&scenario, 0, sizeof(scenario));
+			error = CopyName(scenario.label, word[1]);
+			for (int k = 0; k < 3 && error == 0; k++) {
+				error = ParseDouble(word[2 + k], &scenario.reference[k]);
+			}
+			scenario.first_entity = (int)entity_list.size();
+			scenario.entity_count = 0;
+			scenario_list.push_back(scenario);
+
+			scratch->InitCoordinate(scenario.reference[0], scenario.reference[1], scenario.reference[2]);
+			scratch->Reset();
+			open_scenario = 1;
+		}
+		else if (strcmp(word[0], "aircraft") == 0 && word_count == 13 && open_scenario != 0) {
+			ScenarioRecord_T& scenario = scenario_list.back();
+			int sim_id = 0, team = 0;
+			double value[9];
+			char name[SCENARIO_NAME_SIZE];
+			error = (scenario.entity_count < max_object) ? 0 : 1;
+			error |= ParseInt(word[1], &sim_id);
+			error |= CopyName(name, word[2]);
+			error |= ParseInt(word[3], &team);
+			for (int k = 0; k < 9; k++) {
+				error |= ParseDouble(word[4 + k], &value[k]);
+			}
+			if (error == 0) {
+				int i = scenario.entity_count;
+				scratch->aircraft_list[i].Init(sim_id, name, team, value[0], value[1], value[2], value[3], value[4], value[5],
+					value[6], value[7], value[8]);
+				scratch->aircraft_list[i].craft_handle.setZero();
+
+				AircraftSnapshot_T record;
+				memset(&record, 0, sizeof(record));
+				scratch->SaveAircraft(i, &record);
+				entity_list.push_back(record);
+				scenario.entity_count++;
+			}
+		}
+		else if (strcmp(word[0], "end") == 0 && word_count == 1 && open_scenario != 0) {
+			open_scenario = 0;
+		}
+		else {
+			error = 1;
+		}
+	}
+	fclose(text);
+	if (open_scenario != 0) {
+		error = 1;
+	}
+
+	//名字表：记录中的名字编号即临时字符串表编号
+	std::vector<char> name_list;
+	int name_count = scratch->string_table.Count();
+	name_list.resize((size_t)name_count * SCENARIO_NAME_SIZE, 0);
+	for (int n = 0; n < name_count && error == 0; n++) {
+		error = CopyName(&name_list[(size_t)n * SCENARIO_NAME_SIZE], scratch->string_table.Lookup(n));
+	}
+	delete scratch;
+	if (error != 0) {
+		return 1;
+	}
+
+	ScenarioFileHeader_T file_header;
+	memset(&file_header, 0, sizeof(file_header));
+	file_header.magic = SCENARIO_MAGIC;
+	file_header.version = SCENARIO_VERSION;
+	file_header.header_size = (int)sizeof(ScenarioFileHeader_T);
+	file_header.record_size = (int)sizeof(AircraftSnapshot_T);
+	file_header.scenario_count = (int)scenario_list.size();
+	file_header.entity_count = (int)entity_list.size();
+	file_header.name_count = name_count;
+	file_header.scenario_offset = sizeof(ScenarioFileHeader_T);
+	file_header.entity_offset = file_header.scenario_offset + (long long)scenario_list.size() * sizeof(ScenarioRecord_T);
+	file_header.name_offset = file_header.entity_offset + (long long)entity_list.size() * sizeof(AircraftSnapshot_T);
+	file_header.file_size = file_header.name_offset + (long long)name_list.size();
+
+	FILE* binary = OpenStream(binary_path, "wb");
+	if (binary == NULL) {
+		return 1;
+	}
+	size_t written = fwrite(&file_header, sizeof(file_header), 1, binary);
+	if (!scenario_list.empty()) {
+		written += fwrite(&scenario_list[0], sizeof(ScenarioRecord_T) * scenario_list.size(), 1, binary);
+	}
+	else {
+		written++;
+	}
+	if (!entity_list.empty()) {
+		written += fwrite(&entity_list[0], sizeof(AircraftSnapshot_T) * entity_list.size(), 1, binary);
+	}
+	else {
+		written++;
+	}
+	written += fwrite(&name_list[0], name_list.size(), 1, binary);
+	fclose(binary);
+
+	return (written == 4) ? CS_OK : 1;
+}
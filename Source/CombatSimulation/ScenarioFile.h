@@ -0,0 +1,201 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           ScenarioFile.h
+*   @brief          二进制想定库。
+*   @details        一个文件保存大量想定，依次为文件头、想定表、实体表和名字表，全部为定长平凡结构。
+					实体记录与快照中的飞机记录相同，导航系状态和四元数已在转换时算好，名字以名字表下标引用。
+					文件按只读方式映射到内存后直接使用，实例化到战场只是复制记录，不做文本解析和坐标转换。
+					文本想定由 ConvertText 转换为二进制，文本格式：
+					scenario <标签> <参考点经度> <参考点纬度> <参考点高度>
+					aircraft <仿真编号> <名字> <队伍> <经度> <纬度> <高度> <滚转> <俯仰> <偏航> <北速> <东速> <地速>
+					end
+					'#' 之后为注释，角度单位为 deg，其余为米、米/秒。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+#ifndef Scenario_File_H
+#define Scenario_File_H
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           头文件。
+*   @{
+*/
+#include "BattlefieldSnapshot.h"
+
+/** @}  */
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          CombatSimulation 命名空间。
+*   @details        CombatSimulation 命名空间。
+*/
+namespace CombatSimulation
+{
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @name           想定库宏定义。
+	*   @{
+	*/
+#define SCENARIO_MAGIC 0x4E454353   //想定库标识 "SCEN"
+#define SCENARIO_VERSION 1          //想定库格式版本
+#define SCENARIO_NAME_SIZE 32       //标签、名字的最大长度，含结尾0
+	/** @}  */
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          想定库文件头。
+	*   @details        偏移量均从文件起始处算起，单位：字节。
+	*/
+	struct ScenarioFileHeader_T
+	{
+		int								magic;							//!< SCENARIO_MAGIC
+		int								version;						//!< SCENARIO_VERSION
+		int								header_size;					//!< sizeof(ScenarioFileHeader_T)
+		int								record_size;					//!< sizeof(AircraftSnapshot_T)，记录布局变化时拒绝加载
+		int								scenario_count;					//!< 想定数
+		int								entity_count;					//!< 实体总数
+		int								name_count;						//!< 名字数
+		int								reserved;
+		long long						scenario_offset;				//!< 想定表位置
+		long long						entity_offset;					//!< 实体表位置
+		long long						name_offset;					//!< 名字表位置
+		long long						file_size;						//!< 文件总字节数
+	};
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          想定记录。
+	*   @details        想定的实体为实体表中 [first_entity, first_entity + entity_count) 的连续记录。
+	*/
+	struct ScenarioRecord_T
+	{
+		char							label[SCENARIO_NAME_SIZE];		//!< 想定标签
+		double							reference[3];					//!< 参考点经度、纬度(deg)、高度(米)
+		int								first_entity;					//!< 第一个实体在实体表中的下标
+		int								entity_count;					//!< 实体数，不大于 max_object
+	};
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          想定库。
+	*   @details        打开后只读，可在多个线程中同时实例化不同或相同的想定。
+	*/
+	class ScenarioFile_C
+	{
+	public:
+		ScenarioFile_C();
+		~ScenarioFile_C();
+
+		//持有文件映射，禁止拷贝
+		ScenarioFile_C(const ScenarioFile_C&) = delete;
+		ScenarioFile_C& operator=(const ScenarioFile_C&) = delete;
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          打开想定库文件
+		*   @details        以只读方式映射整个文件并检查文件头，已打开的文件先关闭
+		*   @param[in]      path            文件路径
+		*   @retval         0               正常
+		*   @retval         1               错误，文件无法打开或格式不符
+		*/
+		int Open(const char* path);
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          使用内存中的想定库
+		*   @details        数据由调用者持有，关闭前须一直有效，首地址须按8字节对齐
+		*   @param[in]      data            想定库数据
+		*   @param[in]      size            字节数
+		*   @retval         0               正常
+		*   @retval         1               错误，格式不符
+		*/
+		int Attach(const void* data, long long size);
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          关闭想定库
+		*   @details        解除文件映射
+		*   @retval         0               正常
+		*/
+		int Close();
+
+		int ScenarioCount() const { return (header != NULL) ? header->scenario_count : 0; }
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          访问想定记录
+		*   @details        访问想定记录
+		*   @param[in]      index           想定下标
+		*   @retval         想定记录，下标无效时返回 NULL
+		*/
+		const ScenarioRecord_T* Scenario(int index) const;
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          查询名字
+		*   @details        查询名字
+		*   @param[in]      name_index      名字表下标
+		*   @retval         名字，下标无效时返回空字符串
+		*/
+		const char* Name(int name_index) const;
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          实例化想定
+		*   @details        清空战场后装入想定中的飞机，参考点不同时重新设置参考点。名字换算为战场字符串表中的编号，分级解算设置保留
+		*   @param[in]      index           想定下标
+		*   @param[in,out]  battlefield     目标战场
+		*   @retval         0               正常
+		*   @retval         1               错误
+		*/
+		int Instantiate(
+			int								index,
+			Battlefield_C*					battlefield) const;
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          文本想定转换为二进制想定库
+		*   @details        按文本格式逐行读取，用 Aircraft_Object_C::Init 算出初始状态后写入二进制文件
+		*   @param[in]      text_path       文本想定路径
+		*   @param[in]      binary_path     二进制想定库路径
+		*   @retval         0               正常
+		*   @retval         1               错误，文件无法读写或文本格式错误
+		*/
+		static int ConvertText(
+			const char*						text_path,
+			const char*						binary_path);
+
+	private:
+		const unsigned char*			data;							//!< 想定库首地址
+		long long						data_size;						//!< 想定库字节数
+		const ScenarioFileHeader_T*		header;
+		const ScenarioRecord_T*			scenario_table;
+		const AircraftSnapshot_T*		entity_table;
+		const char*						name_table;						//!< [name_count][SCENARIO_NAME_SIZE]
+
+		//文件映射句柄，Attach 时为空
+		void*							map_view;
+		long long						map_size;
+#ifdef _WIN32
+		void*							file_handle;
+		void*							mapping_handle;
+#endif
+
+		//检查文件头和各表范围，通过后设置表指针
+		int Validate();
+	};
+}
+
+
+
+#endif // Scenario_File_H
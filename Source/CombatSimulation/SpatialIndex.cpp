@@ -0,0 +1,629 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           SpatialIndex.cpp
+*   @brief          战场空间索引实现。
+*   @details        战场空间索引实现。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           头文件。
+*   @{
+*/
+#include "SpatialIndex.h"
+#include <math.h>
+#include <stdlib.h>
+#include <algorithm>
+
+using namespace Eigen;
+using namespace CombatSimulation;
+/** @}  */
+
+#define SI_LEAF_SIZE 8   //BVH叶节点最大实体数
+#define SI_STACK_SIZE 64 //BVH遍历栈深度
+
+
+SpatialIndex_C::SpatialIndex_C()
+{
+	mode = SI_GRID;
+	cell_size = 5000;
+	inv_cell_size = 1.0 / cell_size;
+	hash_mask = 0;
+	for (int i = 0; i < 3; i++) {
+		grid_min[i] = 0;
+		grid_max[i] = -1;
+	}
+	stats.entity_count = 0;
+	stats.cell_count = 0;
+	stats.query_count = 0;
+	stats.visit_count = 0;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          设置索引模式
+*   @details        设置索引模式，下次 Build 生效
+*   @param[in]      in_mode             SI_GRID 均匀网格，SI_BVH 层次包围盒
+*   @param[in]      in_cell_size        网格边长，单位：米，通常取最常用的查询半径
+*   @retval         0                   正常
+*   @retval         -1                  参数错误
+*/
+int SpatialIndex_C::SetMode(
+	int								in_mode,
+	double							in_cell_size)
+{
+	if ((in_mode != SI_GRID && in_mode != SI_BVH) || !(in_cell_size > 0)) {
+		return SI_ERROR;
+	}
+
+	mode = in_mode;
+	cell_size = in_cell_size;
+	inv_cell_size = 1.0 / in_cell_size;
+
+	return SI_OK;
+}
+
+
+int SpatialIndex_C::CellCoord(double v) const
+{
+	return (int)floor(v * inv_cell_size);
+}
+
+
+int SpatialIndex_C::CellHash(int cx, int cy, int cz) const
+{
+	unsigned int h = ((unsigned int)cx * 73856093u) ^ ((unsigned int)cy * 19349663u) ^ ((unsigned int)cz * 83492791u);
+	return (int)(h & (unsigned int)hash_mask);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          重建索引
+*   @details        网格模式为计数排序，O(N)；BVH模式为中位数划分，O(NlogN)
+*   @param[in]      in_x                北向坐标数组，单位：米
+*   @param[in]      in_y                东向坐标数组，单位：米
+*   @param[in]      in_z                地向坐标数组，单位：米
+*   @param[in]      in_id               实体编号数组，查询结果返回此编号
+*   @param[in]      in_count            实体数量
+*   @retval         0                   正常
+*   @retval         -1                  参数错误
+*/
+int SpatialIndex_C::Build(
+	const double*					in_x,
+	const double*					in_y,
+	const double*					in_z,
+	const int*						in_id,
+	int								in_count)
+{
+	if (in_count < 0 || (in_count > 0 && (in_x == NULL || in_y == NULL || in_z == NULL || in_id == NULL))) {
+		return SI_ERROR;
+	}
+
+	stats.entity_count = in_count;
+	stats.query_count = 0;
+	stats.visit_count = 0;
+
+	sort_x.resize(in_count);
+	sort_y.resize(in_count);
+	sort_z.resize(in_count);
+	sort_id.resize(in_count);
+
+	if (mode == SI_BVH) {
+		return BuildBvh(in_x, in_y, in_z, in_id, in_count);
+	}
+	return BuildGrid(in_x, in_y, in_z, in_id, in_count);
+}
+
+
+int SpatialIndex_C::BuildGrid(
+	const double*					in_x,
+	const double*					in_y,
+	const double*					in_z,
+	const int*						in_id,
+	int								in_count)
+{
+	//桶数取不小于2N的2的幂，平均每桶不到一个网格
+	int table_size = 64;
+	while (table_size < 2 * in_count) {
+		table_size <<= 1;
+	}
+	hash_mask = table_size - 1;
+	stats.cell_count = table_size;
+
+	cell_start.assign(table_size + 1, 0);
+	entity_hash.resize(in_count);
+	sort_cell.resize(3 * in_count);
+
+	for (int i = 0; i < 3; i++) {
+		grid_min[i] = 0;
+		grid_max[i] = -1;
+	}
+
+	//第一遍：计算哈希并计数
+	for (int i = 0; i < in_count; i++) {
+		int cx = CellCoord(in_x[i]);
+		int cy = CellCoord(in_y[i]);
+		int cz = CellCoord(in_z[i]);
+		if (i == 0) {
+			grid_min[0] = grid_max[0] = cx;
+			grid_min[1] = grid_max[1] = cy;
+			grid_min[2] = grid_max[2] = cz;
+		}
+		else {
+			grid_min[0] = std::min(grid_min[0], cx); grid_max[0] = std::max(grid_max[0], cx);
+			grid_min[1] = std::min(grid_min[1], cy); grid_max[1] = std::max(grid_max[1], cy);
+			grid_min[2] = std::min(grid_min[2], cz); grid_max[2] = std::max(grid_max[2], cz);
+		}
+		int h = CellHash(cx, cy, cz);
+		entity_hash[i] = h;
+		cell_start[h + 1]++;
+	}
+
+	//前缀和得到各桶起始下标
+	for (int h = 0; h < table_size; h++) {
+		cell_start[h + 1] += cell_start[h];
+	}
+
+	//第二遍：按桶散列，借用 cell_start 作写指针，结束后再恢复
+	for (int i = 0; i < in_count; i++) {
+		int dst = cell_start[entity_hash[i]]++;
+		sort_x[dst] = in_x[i];
+		sort_y[dst] = in_y[i];
+		sort_z[dst] = in_z[i];
+		sort_id[dst] = in_id[i];
+		sort_cell[3 * dst + 0] = CellCoord(in_x[i]);
+		sort_cell[3 * dst + 1] = CellCoord(in_y[i]);
+		sort_cell[3 * dst + 2] = CellCoord(in_z[i]);
+	}
+	for (int h = table_size; h > 0; h--) {
+		cell_start[h] = cell_start[h - 1];
+	}
+	cell_start[0] = 0;
+
+	return SI_OK;
+}
+
+
+int SpatialIndex_C::BuildBvh(
+	const double*					in_x,
+	const double*					in_y,
+	const double*					in_z,
+	const int*						in_id,
+	int								in_count)
+{
+	order.resize(in_count);
+	for (int i = 0; i < in_count; i++) {
+		order[i] = i;
+	}
+
+	nodes.clear();
+	nodes.reserve(2 * (in_count / SI_LEAF_SIZE + 1));
+	if (in_count > 0) {
+		BuildNode(0, 0, in_count, in_x, in_y, in_z);
+	}
+	stats.cell_count = (int)nodes.size();
+
+	for (int i = 0; i < in_count; i++) {
+		int src = order[i];
+		sort_x[i] = in_x[src];
+		sort_y[i] = in_y[src];
+		sort_z[i] = in_z[src];
+		sort_id[i] = in_id[src];
+	}
+
+	return SI_OK;
+}
+
+
+int SpatialIndex_C::BuildNode(
+	int								node,
+	int								begin,
+	int								end,
+	const double*					in_x,
+	const double*					in_y,
+	const double*					in_z)
+{
+	const double* axis_data[3] = { in_x, in_y, in_z };
+
+	nodes.resize(node + 1);
+	SpatialNode_T box;
+	for (int a = 0; a < 3; a++) {
+		box.box_min[a] = axis_data[a][order[begin]];
+		box.box_max[a] = axis_data[a][order[begin]];
+	}
+	for (int i = begin + 1; i < end; i++) {
+		for (int a = 0; a < 3; a++) {
+			double v = axis_data[a][order[i]];
+			box.box_min[a] = std::min(box.box_min[a], v);
+			box.box_max[a] = std::max(box.box_max[a], v);
+		}
+	}
+
+	if (end - begin <= SI_LEAF_SIZE) {
+		box.first = begin;
+		box.count = end - begin;
+		nodes[node] = box;
+		return SI_OK;
+	}
+
+	//按最长轴中位数划分
+	int axis = 0;
+	for (int a = 1; a < 3; a++) {
+		if (box.box_max[a] - box.box_min[a] > box.box_max[axis] - box.box_min[axis]) {
+			axis = a;
+		}
+	}
+	const double* key = axis_data[axis];
+	int mid = (begin + end) / 2;
+	std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end,
+		[key](int a, int b) { return key[a] < key[b]; });
+
+	//左子节点紧随父节点，右子节点在左子树之后
+	BuildNode(node + 1, begin, mid, in_x, in_y, in_z);
+	box.first = (int)nodes.size();
+	box.count = 0;
+	BuildNode(box.first, mid, end, in_x, in_y, in_z);
+	nodes[node] = box;
+
+	return SI_OK;
+}
+
+
+//点到包围盒距离的平方
+static double BoxDistance2(
+	const SpatialNode_T&			box,
+	const Vector3d&					p)
+{
+	double d2 = 0;
+	for (int a = 0; a < 3; a++) {
+		double d = std::max(std::max(box.box_min[a] - p(a), p(a) - box.box_max[a]), 0.0);
+		d2 += d * d;
+	}
+	return d2;
+}
+
+
+int SpatialIndex_C::Collect(
+	int*							out_id,
+	int*							out_count,
+	int								max_out,
+	const Vector3d&					center,
+	double							radius,
+	const Vector3d&					apex,
+	const double*					cone_dir,
+	double							cos_half,
+	double							range)
+{
+	const double r2 = radius * radius;
+	const double range2 = range * range;
+	int found = 0;
+	stats.query_count++;
+
+	//单个实体的精确判定
+	auto accept = [&](int i) {
+		stats.visit_count++;
+		double dx = sort_x[i] - center(0);
+		double dy = sort_y[i] - center(1);
+		double dz = sort_z[i] - center(2);
+		if (dx * dx + dy * dy + dz * dz > r2) {
+			return;
+		}
+		if (cone_dir != NULL) {
+			double vx = sort_x[i] - apex(0);
+			double vy = sort_y[i] - apex(1);
+			double vz = sort_z[i] - apex(2);
+			double v2 = vx * vx + vy * vy + vz * vz;
+			double along = vx * cone_dir[0] + vy * cone_dir[1] + vz * cone_dir[2];
+			if (v2 > range2 || along < cos_half * sqrt(v2)) {
+				return;
+			}
+		}
+		if (found < max_out) {
+			out_id[found++] = sort_id[i];
+		}
+	};
+
+	int n = stats.entity_count;
+	if (mode == SI_BVH) {
+		if (n > 0) {
+			int stack[SI_STACK_SIZE];
+			int top = 0;
+			stack[top++] = 0;
+			while (top > 0) {
+				int self = stack[--top];
+				const SpatialNode_T& node = nodes[self];
+				if (BoxDistance2(node, center) > r2) {
+					continue;
+				}
+				if (node.count > 0) {
+					for (int i = node.first; i < node.first + node.count; i++) {
+						accept(i);
+					}
+				}
+				else {
+					stack[top++] = node.first;
+					stack[top++] = self + 1;
+				}
+			}
+		}
+	}
+	else {
+		int lo[3], hi[3];
+		double c[3] = { center(0), center(1), center(2) };
+		double cells = 1;
+		for (int a = 0; a < 3; a++) {
+			lo[a] = std::max(CellCoord(c[a] - radius), grid_min[a]);
+			hi[a] = std::min(CellCoord(c[a] + radius), grid_max[a]);
+			cells *= (double)(hi[a] - lo[a] + 1);
+		}
+
+		if (lo[0] <= hi[0] && lo[1] <= hi[1] && lo[2] <= hi[2]) {
+			if (cells > n) {
+				//查询范围覆盖的网格多于实体数，直接遍历
+				for (int i = 0; i < n; i++) {
+					accept(i);
+				}
+			}
+			else {
+				for (int cx = lo[0]; cx <= hi[0]; cx++) {
+					for (int cy = lo[1]; cy <= hi[1]; cy++) {
+						for (int cz = lo[2]; cz <= hi[2]; cz++) {
+							int h = CellHash(cx, cy, cz);
+							for (int i = cell_start[h]; i < cell_start[h + 1]; i++) {
+								//哈希冲突的其他网格跳过，避免重复
+								if (sort_cell[3 * i] != cx || sort_cell[3 * i + 1] != cy || sort_cell[3 * i + 2] != cz) {
+									continue;
+								}
+								accept(i);
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+
+	*out_count = found;
+	return SI_OK;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          半径查询
+*   @details        返回与中心点距离不大于半径的实体，顺序不定
+*   @param[out]     out_id              结果实体编号
+*   @param[out]     out_count           结果数量，超过 max_out 时截断
+*   @param[in]      max_out             结果数组长度
+*   @param[in]      center              查询中心，导航坐标系，单位：米
+*   @param[in]      radius              查询半径，单位：米
+*   @retval         0                   正常
+*   @retval         -1                  参数错误
+*/
+int SpatialIndex_C::QueryRadius(
+	int*							out_id,
+	int*							out_count,
+	int								max_out,
+	const Vector3d&					center,
+	double							radius)
+{
+	if (out_id == NULL || out_count == NULL || max_out < 0 || radius < 0) {
+		return SI_ERROR;
+	}
+
+	return Collect(out_id, out_count, max_out, center, radius, center, NULL, 0, 0);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          锥形查询
+*   @details        先以锥形的外接球做粗筛，再按距离和锥角精确判定
+*   @param[out]     out_id              结果实体编号
+*   @param[out]     out_count           结果数量，超过 max_out 时截断
+*   @param[in]      max_out             结果数组长度
+*   @param[in]      apex                锥顶，导航坐标系，单位：米
+*   @param[in]      dir                 锥轴方向，无需归一化
+*   @param[in]      half_angle          半锥角，单位：弧度
+*   @param[in]      range               作用距离，单位：米
+*   @retval         0                   正常
+*   @retval         -1                  参数错误
+*/
+int SpatialIndex_C::QueryCone(
+	int*							out_id,
+	int*							out_count,
+	int								max_out,
+	const Vector3d&					apex,
+	const Vector3d&					dir,
+	double							half_angle,
+	double							range)
+{
+	double dir_norm = dir.norm();
+	if (out_id == NULL || out_count == NULL || max_out < 0 || range < 0 || half_angle < 0 || !(dir_norm > 0)) {
+		return SI_ERROR;
+	}
+
+	double cone_dir[3] = { dir(0) / dir_norm, dir(1) / dir_norm, dir(2) / dir_norm };
+	double cos_half = cos(half_angle);
+
+	//半锥角不超过90度时锥形为凸体，外接球心取轴线中点；否则取锥顶为球心
+	Vector3d center = apex;
+	double radius = range;
+	if (half_angle <= acos(0.0)) {
+		center = apex + 0.5 * range * Vector3d(cone_dir[0], cone_dir[1], cone_dir[2]);
+		radius = range * std::max(0.5, sqrt(1.25 - cos_half));
+	}
+
+	return Collect(out_id, out_count, max_out, center, radius, apex, cone_dir, cos_half, range);
+}
+
+
+void SpatialIndex_C::InsertNearest(
+	int*							best_id,
+	double*							best_d2,
+	int*							found,
+	int								k,
+	int								id,
+	double							d2)
+{
+	if (*found == k && d2 >= best_d2[k - 1]) {
+		return;
+	}
+	int pos = (*found < k) ? (*found)++ : k - 1;
+	while (pos > 0 && best_d2[pos - 1] > d2) {
+		best_d2[pos] = best_d2[pos - 1];
+		best_id[pos] = best_id[pos - 1];
+		pos--;
+	}
+	best_d2[pos] = d2;
+	best_id[pos] = id;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          k近邻查询
+*   @details        网格模式由中心网格逐圈向外扩展，BVH模式近子树优先遍历，均在第k近距离小于未访问区域的最近距离时停止
+*   @param[out]     out_id              结果实体编号，长度不小于k
+*   @param[out]     out_dist            结果距离，单位：米，长度不小于k，可为NULL
+*   @param[out]     out_count           结果数量，实体不足k个时小于k
+*   @param[in]      k                   近邻数量
+*   @param[in]      center              查询中心，导航坐标系，单位：米
+*   @param[in]      exclude_id          不参与查询的实体编号，例如查询者自身，不需要时取-1
+*   @retval         0                   正常
+*   @retval         -1                  参数错误
+*/
+int SpatialIndex_C::QueryNearest(
+	int*							out_id,
+	double*							out_dist,
+	int*							out_count,
+	int								k,
+	const Vector3d&					center,
+	int								exclude_id)
+{
+	if (out_id == NULL || out_count == NULL || k <= 0) {
+		return SI_ERROR;
+	}
+
+	if ((int)nearest_d2.size() < k) {
+		nearest_d2.resize(k);
+	}
+	double* best_d2 = &nearest_d2[0];
+	int found = 0;
+	int n = stats.entity_count;
+	stats.query_count++;
+
+	auto test = [&](int i) {
+		if (sort_id[i] == exclude_id) {
+			return;
+		}
+		stats.visit_count++;
+		double dx = sort_x[i] - center(0);
+		double dy = sort_y[i] - center(1);
+		double dz = sort_z[i] - center(2);
+		InsertNearest(out_id, best_d2, &found, k, sort_id[i], dx * dx + dy * dy + dz * dz);
+	};
+
+	if (n == 0) {
+		//空索引
+	}
+	else if (mode == SI_BVH) {
+		int stack[SI_STACK_SIZE];
+		int top = 0;
+		stack[top++] = 0;
+		while (top > 0) {
+			int self = stack[--top];
+			const SpatialNode_T& node = nodes[self];
+			if (found == k && BoxDistance2(node, center) >= best_d2[k - 1]) {
+				continue;
+			}
+			if (node.count > 0) {
+				for (int i = node.first; i < node.first + node.count; i++) {
+					test(i);
+				}
+			}
+			else {
+				//近的子节点后入栈，先被访问
+				int left = self + 1;
+				int right = node.first;
+				if (BoxDistance2(nodes[left], center) < BoxDistance2(nodes[right], center)) {
+					stack[top++] = right;
+					stack[top++] = left;
+				}
+				else {
+					stack[top++] = left;
+					stack[top++] = right;
+				}
+			}
+		}
+	}
+	else {
+		double volume = 1;
+		for (int a = 0; a < 3; a++) {
+			volume *= (double)(grid_max[a] - grid_min[a] + 1);
+		}
+
+		if (volume > 4.0 * n) {
+			//实体稀疏，逐圈扩展不如直接遍历
+			for (int i = 0; i < n; i++) {
+				test(i);
+			}
+		}
+		else {
+			int c[3] = { CellCoord(center(0)), CellCoord(center(1)), CellCoord(center(2)) };
+			for (int r = 0; ; r++) {
+				int lo[3], hi[3];
+				bool covered = true;
+				for (int a = 0; a < 3; a++) {
+					lo[a] = std::max(c[a] - r, grid_min[a]);
+					hi[a] = std::min(c[a] + r, grid_max[a]);
+					covered = covered && c[a] - r <= grid_min[a] && c[a] + r >= grid_max[a];
+				}
+
+				//只访问第r圈的网格
+				for (int cx = lo[0]; cx <= hi[0]; cx++) {
+					for (int cy = lo[1]; cy <= hi[1]; cy++) {
+						bool shell = std::abs(cx - c[0]) == r || std::abs(cy - c[1]) == r;
+						int step = shell ? 1 : 2 * r;
+						for (int cz = shell ? lo[2] : c[2] - r; cz <= hi[2]; cz += step) {
+							if (cz < lo[2]) {
+								continue;
+							}
+							int h = CellHash(cx, cy, cz);
+							for (int i = cell_start[h]; i < cell_start[h + 1]; i++) {
+								if (sort_cell[3 * i] != cx || sort_cell[3 * i + 1] != cy || sort_cell[3 * i + 2] != cz) {
+									continue;
+								}
+								test(i);
+							}
+						}
+					}
+				}
+
+				//第r+1圈与中心点的距离不小于 r*cell_size
+				double reach = r * cell_size;
+				if (covered || (found == k && best_d2[k - 1] <= reach * reach)) {
+					break;
+				}
+			}
+		}
+	}
+
+	if (out_dist != NULL) {
+		for (int i = 0; i < found; i++) {
+			out_dist[i] = sqrt(best_d2[i]);
+		}
+	}
+	*out_count = found;
+	return SI_OK;
+}
@@ -0,0 +1,238 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           SpatialIndex.h
+*   @brief          战场空间索引。
+*   @details        在导航坐标系(NED)位置上建立加速结构，提供半径、锥形(传感器视场)和k近邻查询。
+					均匀网格模式：哈希网格，每帧O(N)重建，适用于分布较均匀的场景。
+					BVH模式：按最长轴中位数划分的层次包围盒，适用于编队等聚集场景。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+#ifndef Spatial_Index_H
+#define Spatial_Index_H
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           头文件。
+*   @{
+*/
+#include <vector>
+#include "../Tools/eigen337/Eigen/Dense"
+
+/** @}  */
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          CombatSimulation 命名空间。
+*   @details        CombatSimulation 命名空间。
+*/
+namespace CombatSimulation
+{
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @name           空间索引宏定义。
+	*   @{
+	*/
+#define SI_GRID 0 //均匀网格模式
+#define SI_BVH 1  //BVH模式
+
+#define SI_OK 0
+#define SI_ERROR -1
+	/** @}  */
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          BVH节点。
+	*   @details        叶节点 count > 0，first 为排序后实体的起始下标；内部节点 count = 0，first 为右子节点下标，左子节点紧随其后。
+	*/
+	struct SpatialNode_T
+	{
+		double							box_min[3];						//!< 包围盒最小角点，单位：米
+		double							box_max[3];						//!< 包围盒最大角点，单位：米
+		int								first;							//!< 叶节点：起始下标；内部节点：右子节点下标
+		int								count;							//!< 叶节点实体数量，内部节点为0
+	};
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          空间索引统计。
+	*   @details        记录最近一次重建与累计查询开销，用于评估索引效果。
+	*/
+	struct SpatialStats_T
+	{
+		int								entity_count;					//!< 实体数量
+		int								cell_count;						//!< 网格模式：哈希表长度；BVH模式：节点数量
+		long long						query_count;					//!< 累计查询次数
+		long long						visit_count;					//!< 累计距离检测次数
+	};
+
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          空间索引。
+	*   @details        每帧调用 Build 重建，之后的查询返回构建时传入的实体编号。内部缓存重复使用，实体数量不增加时重建不再分配内存。
+	*/
+	class SpatialIndex_C
+	{
+	public:
+		SpatialIndex_C();
+		~SpatialIndex_C() {}
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          设置索引模式
+		*   @details        设置索引模式，下次 Build 生效
+		*   @param[in]      in_mode             SI_GRID 均匀网格，SI_BVH 层次包围盒
+		*   @param[in]      in_cell_size        网格边长，单位：米，通常取最常用的查询半径
+		*   @retval         0                   正常
+		*   @retval         -1                  参数错误
+		*/
+		int SetMode(
+			int								in_mode,
+			double							in_cell_size);
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          重建索引
+		*   @details        网格模式为计数排序，O(N)；BVH模式为中位数划分，O(NlogN)
+		*   @param[in]      in_x                北向坐标数组，单位：米
+		*   @param[in]      in_y                东向坐标数组，单位：米
+		*   @param[in]      in_z                地向坐标数组，单位：米
+		*   @param[in]      in_id               实体编号数组，查询结果返回此编号
+		*   @param[in]      in_count            实体数量
+		*   @retval         0                   正常
+		*   @retval         -1                  参数错误
+		*/
+		int Build(
+			const double*					in_x,
+			const double*					in_y,
+			const double*					in_z,
+			const int*						in_id,
+			int								in_count);
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          半径查询
+		*   @details        返回与中心点距离不大于半径的实体，顺序不定
+		*   @param[out]     out_id              结果实体编号
+		*   @param[out]     out_count           结果数量，超过 max_out 时截断
+		*   @param[in]      max_out             结果数组长度
+		*   @param[in]      center              查询中心，导航坐标系，单位：米
+		*   @param[in]      radius              查询半径，单位：米
+		*   @retval         0                   正常
+		*   @retval         -1                  参数错误
+		*/
+		int QueryRadius(
+			int*							out_id,
+			int*							out_count,
+			int								max_out,
+			const Eigen::Vector3d&			center,
+			double							radius);
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          锥形查询
+		*   @details        返回位于以 apex 为顶点、dir 为轴、半锥角 half_angle、作用距离 range 的锥形内的实体，用于传感器视场
+		*   @param[out]     out_id              结果实体编号
+		*   @param[out]     out_count           结果数量，超过 max_out 时截断
+		*   @param[in]      max_out             结果数组长度
+		*   @param[in]      apex                锥顶，导航坐标系，单位：米
+		*   @param[in]      dir                 锥轴方向，无需归一化
+		*   @param[in]      half_angle          半锥角，单位：弧度
+		*   @param[in]      range               作用距离，单位：米
+		*   @retval         0                   正常
+		*   @retval         -1                  参数错误
+		*/
+		int QueryCone(
+			int*							out_id,
+			int*							out_count,
+			int								max_out,
+			const Eigen::Vector3d&			apex,
+			const Eigen::Vector3d&			dir,
+			double							half_angle,
+			double							range);
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          k近邻查询
+		*   @details        返回距中心点最近的k个实体，按距离由近到远排列
+		*   @param[out]     out_id              结果实体编号，长度不小于k
+		*   @param[out]     out_dist            结果距离，单位：米，长度不小于k，可为NULL
+		*   @param[out]     out_count           结果数量，实体不足k个时小于k
+		*   @param[in]      k                   近邻数量
+		*   @param[in]      center              查询中心，导航坐标系，单位：米
+		*   @param[in]      exclude_id          不参与查询的实体编号，例如查询者自身，不需要时取-1
+		*   @retval         0                   正常
+		*   @retval         -1                  参数错误
+		*/
+		int QueryNearest(
+			int*							out_id,
+			double*							out_dist,
+			int*							out_count,
+			int								k,
+			const Eigen::Vector3d&			center,
+			int								exclude_id);
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          读取统计信息
+		*   @details        读取统计信息，查询计数在每次 Build 时清零
+		*   @retval         统计信息
+		*/
+		const SpatialStats_T& Stats() const { return stats; }
+
+	private:
+		int								mode;							//!< 索引模式
+		double							cell_size;						//!< 网格边长，单位：米
+		double							inv_cell_size;					//!< 网格边长倒数
+		SpatialStats_T					stats;							//!< 统计信息
+
+		//按网格或BVH叶节点排序后的实体，结构数组便于编译器向量化
+		std::vector<double>				sort_x;
+		std::vector<double>				sort_y;
+		std::vector<double>				sort_z;
+		std::vector<int>				sort_id;
+
+		//网格模式
+		std::vector<int>				sort_cell;						//!< 排序后实体所在网格坐标，每实体3个
+		std::vector<int>				cell_start;						//!< 哈希桶起始下标，长度为桶数+1
+		std::vector<int>				entity_hash;					//!< 重建时每个实体的哈希桶
+		int								hash_mask;						//!< 桶数-1，桶数为2的幂
+		int								grid_min[3];					//!< 全部实体所在网格坐标范围
+		int								grid_max[3];
+
+		//BVH模式
+		std::vector<SpatialNode_T>		nodes;							//!< BVH节点，0为根节点
+		std::vector<int>				order;							//!< 构建时的实体排列
+
+		std::vector<double>				nearest_d2;						//!< k近邻候选距离平方
+
+		//网格坐标及哈希
+		int CellCoord(double v) const;
+		int CellHash(int cx, int cy, int cz) const;
+
+		int BuildGrid(const double* in_x, const double* in_y, const double* in_z, const int* in_id, int in_count);
+		int BuildBvh(const double* in_x, const double* in_y, const double* in_z, const int* in_id, int in_count);
+		int BuildNode(int node, int begin, int end, const double* in_x, const double* in_y, const double* in_z);
+
+		//在给定网格内/BVH中收集距离不大于半径的实体，cone_dir 非NULL时再按锥角筛选
+		int Collect(int* out_id, int* out_count, int max_out, const Eigen::Vector3d& center, double radius,
+			const Eigen::Vector3d& apex, const double* cone_dir, double cos_half, double range);
+
+		//k近邻候选插入，保持按距离升序
+		static void InsertNearest(int* best_id, double* best_d2, int* found, int k, int id, double d2);
+	};
+}
+
+
+
+#endif // Spatial_Index_H
@@ -0,0 +1,65 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           StringTable.cpp
+*   @brief          字符串驻留表实现。
+*   @details        字符串驻留表实现。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           头文件。
+*   @{
+*/
+#include "StringTable.h"
+
+using namespace CombatSimulation;
+/** @}  */
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          登记字符串
+*   @details        已登记的字符串直接返回原编号
+*   @param[in]      str             字符串，NULL 视为空字符串
+*   @retval         字符串编号
+*/
+int StringTable_C::Intern(const char* str)
+{
+	std::string key = (str != NULL) ? str : "";
+
+	std::unordered_map<std::string, int>::const_iterator found = string_map.find(key);
+	if (found != string_map.end()) {
+		return found->second;
+	}
+
+	int id = (int)string_list.size();
+	string_list.push_back(key);
+	string_map[key] = id;
+
+	return id;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          查询字符串
+*   @details        查询字符串
+*   @param[in]      id              字符串编号
+*   @retval         字符串，编号无效时返回空字符串
+*/
+const char* StringTable_C::Lookup(int id) const
+{
+	if (id < 0 || id >= (int)string_list.size()) {
+		return "";
+	}
+
+	return string_list[id].c_str();
+}
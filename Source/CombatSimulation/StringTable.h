@@ -0,0 +1,86 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           StringTable.h
+*   @brief          字符串驻留表。
+*   @details        名字、类型等字符串只保存一份，实体内只记录32位编号，避免实体携带大块字符数组。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+#ifndef String_Table_H
+#define String_Table_H
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           头文件。
+*   @{
+*/
+#include <string>
+#include <deque>
+#include <unordered_map>
+
+/** @}  */
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          CombatSimulation 命名空间。
+*   @details        CombatSimulation 命名空间。
+*/
+namespace CombatSimulation
+{
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          字符串驻留表。
+	*   @details        相同字符串返回相同编号，编号0固定为空字符串。编号在表的生命周期内不变。
+	*/
+	class StringTable_C
+	{
+	public:
+		StringTable_C() {
+			Intern("");
+		}
+		~StringTable_C() {}
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          登记字符串
+		*   @details        已登记的字符串直接返回原编号
+		*   @param[in]      str             字符串，NULL 视为空字符串
+		*   @retval         字符串编号
+		*/
+		int Intern(const char* str);
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          查询字符串
+		*   @details        查询字符串
+		*   @param[in]      id              字符串编号
+		*   @retval         字符串，编号无效时返回空字符串
+		*/
+		const char* Lookup(int id) const;
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          已登记字符串数量
+		*   @details        已登记字符串数量，含编号0的空字符串
+		*   @retval         字符串数量
+		*/
+		int Count() const { return (int)string_list.size(); }
+
+	private:
+		std::deque<std::string>					string_list;			//!< 按编号保存的字符串，deque 追加时不移动已有元素，查询返回的指针一直有效
+		std::unordered_map<std::string, int>	string_map;				//!< 字符串到编号的索引
+	};
+}
+
+
+
+#endif // String_Table_H
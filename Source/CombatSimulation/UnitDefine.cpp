@@ -114,9 +114,8 @@ int Aircraft_Object_C::Init(
 	Sim_id = in_simulation_id;
 	base_live = CS_LIVE;
 
-	strcpy_s(base_name, max_str, in_base_name.c_str());
-
-	strcpy_s(base_type, max_str, "Air+FixedWing");
+	p_cold->base_name_id = p_string_table->Intern(in_base_name.c_str());
+	p_cold->base_type_id = p_string_table->Intern("Air+FixedWing");
 	base_team = in_base_team;
 
 	coordinate_longitude = in_lon;
@@ -126,7 +125,12 @@ int Aircraft_Object_C::Init(
 	coordinate_pitch =     in_pitch;
 	coordinate_yaw =       in_yaw;
 
-	radar_state = 1;
+	p_cold->radar_state = 1;
+
+	lod_level = CS_LOD_FULL;
+	lod_turn_rate.setZero();
+	lod_handle.setZero();
+	lod_elapsed = 0;
 
 	double xn, yn, zn;
 	earth_to_navigation(&xn, &yn, &zn, coordinate_longitude, coordinate_latitude, coordinate_altitude,
@@ -146,7 +150,8 @@ int Aircraft_Object_C::Init(
 // --------------------------------------------------------------------------------------------------------------------------------
 /**
 *   @brief          飞机实体单步解算
-*   @details        飞机实体单步解算
+*   @details        完整动力学每步积分；粗略运动学累积到 lod_interval 再推进一次，期间状态保持不变。
+					粗略运动学不响应控制参数，craft_handle 与降级时不同时先恢复完整动力学再解算本步
 *   @param[in]      d_time          单步时间间隔 单位：秒
 *   @retval         0               正常
 *   @retval         -1              飞机已死亡
@@ -157,9 +162,67 @@ int Aircraft_Object_C::Run(double d_time)
 		return CS_NOT_LIVE;
 	}
 
-	//飞机状态解算
-	Flight(&craft_state, craft_state, d_time, craft_handle);
+	//外部改变了控制参数
+	if (lod_level == CS_LOD_COARSE && craft_handle != lod_handle) {
+		SetLevelOfDetail(CS_LOD_FULL);
+	}
+
+	if (lod_level == CS_LOD_COARSE) {
+		lod_elapsed += d_time;
+		if (lod_elapsed < lod_interval) {
+			return CS_OK;
+		}
+		Flight_coarse(&craft_state, craft_state, lod_elapsed, lod_turn_rate);
+		lod_elapsed = 0;
+	}
+	else {
+		Vector3d v0 = craft_state.row(1).head(3).transpose();
+
+		//飞机状态解算
+		Flight(&craft_state, craft_state, d_time, craft_handle);
+
+		//由速度变化估计转率 w = v0 x v1 / (|v|^2 * dt)，降级时使用
+		Vector3d v1 = craft_state.row(1).head(3).transpose();
+		double v2 = v1.squaredNorm();
+		if (v2 > 0 && d_time > 0) {
+			lod_turn_rate = v0.cross(v1) / (v2 * d_time);
+		}
+	}
+
+	return UpdateCoordinate();
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          切换解算精度
+*   @details        降级时沿用完整动力学最近一步估计的转率并记下当时的控制参数；升级时先把粗略模式下累积未推进的时间推进完，保证状态连续
+*   @param[in]      in_lod_level    CS_LOD_FULL 完整动力学，CS_LOD_COARSE 粗略运动学
+*   @retval         0               正常
+*/
+int Aircraft_Object_C::SetLevelOfDetail(int in_lod_level)
+{
+	if (in_lod_level == lod_level) {
+		return CS_OK;
+	}
+
+	if (lod_level == CS_LOD_COARSE && lod_elapsed > 0) {
+		Flight_coarse(&craft_state, craft_state, lod_elapsed, lod_turn_rate);
+		UpdateCoordinate();
+	}
+
+	lod_elapsed = 0;
+	lod_level = in_lod_level;
+	if (lod_level == CS_LOD_COARSE) {
+		lod_handle = craft_handle;
+	}
+
+	return CS_OK;
+}
 
+
+int Aircraft_Object_C::UpdateCoordinate()
+{
 	//坐标转换
 
 	navigation_to_earth(&coordinate_longitude, &coordinate_latitude, &coordinate_altitude, 
@@ -212,9 +275,8 @@ int Missile_Object_C::Init(
 	Sim_id = in_simulation_id;
 	base_live = CS_LIVE;
 
-	strcpy_s(base_name, max_str, in_base_name.c_str());
-
-	strcpy_s(base_type, max_str, "Air+Missile");
+	p_cold->base_name_id = p_string_table->Intern(in_base_name.c_str());
+	p_cold->base_type_id = p_string_table->Intern("Air+Missile");
 	base_team = in_base_team;
 
 	coordinate_longitude = in_lon;
@@ -224,7 +286,7 @@ int Missile_Object_C::Init(
 	coordinate_pitch = in_pitch;
 	coordinate_yaw = in_yaw;
 
-	radar_state = 1;
+	p_cold->radar_state = 1;
 
 	double xn, yn, zn;
 	earth_to_navigation(&xn, &yn, &zn, coordinate_longitude, coordinate_latitude, coordinate_altitude,
@@ -237,6 +299,15 @@ int Missile_Object_C::Init(
 		qbn(0), qbn(1), qbn(2), qbn(3),
 		0, 0, 0, 0;
 
+	missile_position_last = missile_state.row(0).head(3).transpose();
+	missile_journey = 0;
+
+	missile_errA = 0;
+	missile_errP = 0;
+	missile_errR = 0;
+	missile_errAsum = 0;
+	missile_errPsum = 0;
+
 	return CS_OK;
 }
 
@@ -309,21 +380,23 @@ int Missile_Object_C::Run(
 *   @details        导弹命中判定
 *   @retval         0               运行中，未命中
 *   @retval         -1              已命中
-*   @retval         -2              超出射程，未命中
+*   @retval         -2              超出射程或目标已被击毁，未命中
 */
 int Missile_Object_C::HitCheck()
 {
-	static Matrix4d missile_position_last = missile_state;
-	static double missile_journey = 0;
-
 	if (distance_target <= destroy_range) {
+		//目标已被近炸或其他导弹击毁时不再重复记入
+		if (p_target_air->base_live != CS_LIVE) {
+			return CS_MISS;
+		}
 
 		p_target_air->base_live = 0;
 
 		return CS_NOT_LIVE;
 	}
 
-	double d_distance = (missile_state.row(0) - missile_position_last.row(0)).norm();
+	Vector3d missile_position = missile_state.row(0).head(3).transpose();
+	double d_distance = (missile_position - missile_position_last).norm();
 	missile_journey += d_distance;
 
 	if (missile_journey >= max_journey) {
@@ -331,7 +404,7 @@ int Missile_Object_C::HitCheck()
 	}
 
 
-	missile_position_last = missile_state;
+	missile_position_last = missile_position;
 
 	return CS_LIVE;
 }
@@ -359,6 +432,37 @@ int Battlefield_C::InitCoordinate(
 }
 
 
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          清空战场
+*   @details        时标归零，清除全部飞机、导弹、事件、待触发的调度事件及活动列表，保留参考点、字符串表、事件处理函数和分级解算设置，用于重复开始新的对局
+*   @retval         0                    正常
+*/
+int Battlefield_C::Reset()
+{
+	time = 0;
+
+	for (int i = 0; i < max_object; i++) {
+		aircraft_list[i].base_live = 0;
+		missile_list[i].base_live = 0;
+		missile_list[i].missile_live = 0;
+	}
+	aircraft_count = 0;
+	missile_count = 0;
+	kill_event_count = 0;
+
+	active_aircraft_count = 0;
+	active_missile_count = 0;
+	aircraft_synced = 0;
+	missile_synced = 0;
+
+	aircraft_index.Build(NULL, NULL, NULL, NULL, 0);
+	event_scheduler.Clear();
+
+	return CS_OK;
+}
+
+
 // --------------------------------------------------------------------------------------------------------------------------------
 /**
 *   @brief          飞机发射导弹
@@ -382,5 +486,304 @@ int Battlefield_C::MissileFire(
 	missile_list[missile_count - 1].p_target_air = &target_air;
 	missile_list[missile_count - 1].missile_live = CS_LIVE;
 
+	return CS_OK;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          战场单步解算
+*   @details        依次解算全部飞机与导弹、重建空间索引并做近炸判定，推进时标并触发到期的调度事件，只访问本战场内的数据，多个战场可在不同线程中同时解算
+*   @param[in]      d_time          单步时间间隔 单位：秒
+*   @retval         0               正常
+*/
+int Battlefield_C::Run(
+	double d_time)
+{
+	kill_event_count = 0;
+	time += d_time;
+
+	RefreshActiveList();
+
+	for (int k = 0; k < active_aircraft_count; k++) {
+		aircraft_list[active_aircraft_list[k]].Run(d_time);
+	}
+
+	for (int k = 0; k < active_missile_count; k++) {
+		int i = active_missile_list[k];
+		if (missile_list[i].missile_live != CS_LIVE) {
+			continue;
+		}
+		//指定目标命中同样记入事件
+		if (missile_list[i].Run(d_time) == CS_NOT_LIVE) {
+			AddKillEvent(i, (int)(missile_list[i].p_target_air - aircraft_list), missile_list[i].distance_target);
+		}
+	}
+
+	UpdateSpatialIndex();
+
+	MissileProximityCheck(d_time);
+
+	UpdateLevelOfDetail();
+
+	event_scheduler.Advance(time, this);
+
+	return CS_OK;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          重建飞机空间索引
+*   @details        以导航坐标系位置重建 aircraft_index，Run 结束时自动调用，修改飞机位置后也可手动调用
+*   @retval         0               正常
+*/
+int Battlefield_C::UpdateSpatialIndex()
+{
+	int count = 0;
+	for (int k = 0; k < active_aircraft_count; k++) {
+		int i = active_aircraft_list[k];
+		if (aircraft_list[i].base_live != CS_LIVE) {
+			continue;
+		}
+		index_x[count] = aircraft_list[i].craft_state(0, 0);
+		index_y[count] = aircraft_list[i].craft_state(0, 1);
+		index_z[count] = aircraft_list[i].craft_state(0, 2);
+		index_id[count] = i;
+		count++;
+	}
+
+	aircraft_index.Build(index_x, index_y, index_z, index_id, count);
+
+	return CS_OK;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          导弹近炸引信判定
+*   @details        对每枚飞行中的导弹，以空间索引粗筛可及范围内的敌方飞机，再按上一步内相对匀速运动求最近点距离，
+					不大于杀伤半径即引爆，击毁最近的敌机并写入 kill_event_list。需在 UpdateSpatialIndex 之后调用，Run 中自动调用
+*   @param[in]      d_time          单步时间间隔 单位：秒
+*   @retval         本步近炸引爆的导弹数量
+*/
+int Battlefield_C::MissileProximityCheck(
+	double d_time)
+{
+	//存活飞机的最大速度，用于确定粗筛半径
+	double max_air_speed = 0;
+	for (int k = 0; k < active_aircraft_count; k++) {
+		int i = active_aircraft_list[k];
+		if (aircraft_list[i].base_live == CS_LIVE && aircraft_list[i].craft_state.row(1).norm() > max_air_speed) {
+			max_air_speed = aircraft_list[i].craft_state.row(1).norm();
+		}
+	}
+
+	int fired = 0;
+	int candidate[max_object];
+	int candidate_count;
+
+	//候选敌机相对位置、相对速度，结构数组便于编译器向量化
+	double rx[max_object], ry[max_object], rz[max_object];
+	double vx[max_object], vy[max_object], vz[max_object];
+	double miss2[max_object];
+
+	for (int k = 0; k < active_missile_count; k++) {
+		int m = active_missile_list[k];
+		Missile_Object_C& missile = missile_list[m];
+		if (missile.missile_live != CS_LIVE) {
+			continue;
+		}
+
+		Vector3d missile_pos = missile.missile_state.row(0).head(3).transpose();
+		Vector3d missile_vel = missile.missile_state.row(1).head(3).transpose();
+
+		//粗筛：一步之内导弹与任意飞机可能到达的距离
+		double reach = missile.destroy_range + (missile_vel.norm() + max_air_speed) * d_time;
+		aircraft_index.QueryRadius(candidate, &candidate_count, max_object, missile_pos, reach);
+
+		int n = 0;
+		for (int c = 0; c < candidate_count; c++) {
+			Aircraft_Object_C& air = aircraft_list[candidate[c]];
+			if (air.base_live != CS_LIVE || air.base_team == missile.base_team) {
+				continue;
+			}
+			candidate[n] = candidate[c];
+			rx[n] = missile_pos(0) - air.craft_state(0, 0);
+			ry[n] = missile_pos(1) - air.craft_state(0, 1);
+			rz[n] = missile_pos(2) - air.craft_state(0, 2);
+			vx[n] = missile_vel(0) - air.craft_state(1, 0);
+			vy[n] = missile_vel(1) - air.craft_state(1, 1);
+			vz[n] = missile_vel(2) - air.craft_state(1, 2);
+			n++;
+		}
+		if (n == 0) {
+			continue;
+		}
+
+		//精确判定：t∈[-d_time,0] 内相对位置 r+v*t 的最近点距离
+		for (int c = 0; c < n; c++) {
+			double vv = vx[c] * vx[c] + vy[c] * vy[c] + vz[c] * vz[c];
+			double rv = rx[c] * vx[c] + ry[c] * vy[c] + rz[c] * vz[c];
+			double t = (vv > 0) ? -rv / vv : 0;
+			t = (t < -d_time) ? -d_time : ((t > 0) ? 0 : t);
+			double dx = rx[c] + vx[c] * t;
+			double dy = ry[c] + vy[c] * t;
+			double dz = rz[c] + vz[c] * t;
+			miss2[c] = dx * dx + dy * dy + dz * dz;
+		}
+
+		int best = 0;
+		for (int c = 1; c < n; c++) {
+			if (miss2[c] < miss2[best]) {
+				best = c;
+			}
+		}
+		if (miss2[best] > missile.destroy_range * missile.destroy_range) {
+			continue;
+		}
+
+		aircraft_list[candidate[best]].base_live = 0;
+		missile.missile_live = CS_NOT_LIVE;
+		missile.base_live = 0;
+		AddKillEvent(m, candidate[best], sqrt(miss2[best]));
+		fired++;
+	}
+
+	return fired;
+}
+
+
+int Battlefield_C::AddKillEvent(
+	int								missile_index,
+	int								aircraft_index,
+	double							miss_distance)
+{
+	if (kill_event_count >= max_object) {
+		return CS_MISS;
+	}
+
+	KillEvent_T& kill = kill_event_list[kill_event_count++];
+	kill.time = time;
+	kill.missile_index = missile_index;
+	kill.aircraft_index = aircraft_index;
+	kill.missile_id = missile_list[missile_index].Sim_id;
+	kill.aircraft_id = aircraft_list[aircraft_index].Sim_id;
+	kill.miss_distance = miss_distance;
+
+	return CS_OK;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          更新飞机解算精度
+*   @details        威胁为敌方飞机和敌方导弹。最近威胁在 lod_promote_range 内的飞机使用完整动力学，
+					超出 lod_demote_range 的使用粗略运动学，两者之间保持原精度。需在 UpdateSpatialIndex 之后调用，Run 中自动调用
+*   @retval         0               正常
+*/
+int Battlefield_C::UpdateLevelOfDetail()
+{
+	int candidate[max_object];
+	int candidate_count;
+
+	for (int k = 0; k < active_aircraft_count; k++) {
+		Aircraft_Object_C& air = aircraft_list[active_aircraft_list[k]];
+		if (air.base_live != CS_LIVE) {
+			continue;
+		}
+		if (lod_enable == 0) {
+			air.SetLevelOfDetail(CS_LOD_FULL);
+			continue;
+		}
+
+		Vector3d pos = air.craft_state.row(0).head(3).transpose();
+
+		//最近威胁距离，只关心 lod_demote_range 以内
+		double threat2 = lod_demote_range * lod_demote_range * 1.0001;
+		aircraft_index.QueryRadius(candidate, &candidate_count, max_object, pos, lod_demote_range);
+		for (int c = 0; c < candidate_count; c++) {
+			Aircraft_Object_C& other = aircraft_list[candidate[c]];
+			if (other.base_team == air.base_team) {
+				continue;
+			}
+			double d2 = (other.craft_state.row(0).head(3).transpose() - pos).squaredNorm();
+			if (d2 < threat2) {
+				threat2 = d2;
+			}
+		}
+		for (int j = 0; j < active_missile_count; j++) {
+			Missile_Object_C& missile = missile_list[active_missile_list[j]];
+			if (missile.missile_live != CS_LIVE || missile.base_team == air.base_team) {
+				continue;
+			}
+			double d2 = (missile.missile_state.row(0).head(3).transpose() - pos).squaredNorm();
+			if (d2 < threat2) {
+				threat2 = d2;
+			}
+		}
+
+		if (threat2 < lod_promote_range * lod_promote_range) {
+			air.SetLevelOfDetail(CS_LOD_FULL);
+		}
+		else if (threat2 > lod_demote_range * lod_demote_range) {
+			air.SetLevelOfDetail(CS_LOD_COARSE);
+		}
+	}
+
+	return CS_OK;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          更新活动实体列表
+*   @details        将 aircraft_count、missile_count 新增的存活实体追加到列表末尾，移除已死亡且已保留过一步的实体，
+					列表保持原有顺序。Run 开始时自动调用，不使用 Run 时应在每步开始调用
+*   @retval         0               正常
+*/
+int Battlefield_C::RefreshActiveList()
+{
+	//移除死亡实体
+	int n = 0;
+	for (int k = 0; k < active_aircraft_count; k++) {
+		int i = active_aircraft_list[k];
+		if (aircraft_list[i].base_live != CS_LIVE) {
+			if (aircraft_dead_seen[i]) {
+				continue;
+			}
+			aircraft_dead_seen[i] = 1;
+		}
+		active_aircraft_list[n++] = i;
+	}
+	active_aircraft_count = n;
+
+	n = 0;
+	for (int k = 0; k < active_missile_count; k++) {
+		int i = active_missile_list[k];
+		if (missile_list[i].missile_live != CS_LIVE) {
+			if (missile_dead_seen[i]) {
+				continue;
+			}
+			missile_dead_seen[i] = 1;
+		}
+		active_missile_list[n++] = i;
+	}
+	active_missile_count = n;
+
+	//追加新增实体
+	for (; aircraft_synced < aircraft_count && aircraft_synced < max_object; aircraft_synced++) {
+		if (aircraft_list[aircraft_synced].base_live == CS_LIVE) {
+			aircraft_dead_seen[aircraft_synced] = 0;
+			active_aircraft_list[active_aircraft_count++] = aircraft_synced;
+		}
+	}
+	for (; missile_synced < missile_count && missile_synced < max_object; missile_synced++) {
+		if (missile_list[missile_synced].missile_live == CS_LIVE) {
+			missile_dead_seen[missile_synced] = 0;
+			active_missile_list[active_missile_count++] = missile_synced;
+		}
+	}
+
 	return CS_OK;
 }
\ No newline at end of file
@@ -25,6 +25,9 @@
 #include "../FlyTac/aircraft.h"
 #include "../FlyTac/missile.h"
 #include "../Tools/JoySticks.h"
+#include "SpatialIndex.h"
+#include "StringTable.h"
+#include "EventScheduler.h"
 
 /** @}  */
 
@@ -48,6 +51,12 @@ namespace CombatSimulation
 #define CS_LIVE 1
 #define CS_NOT_LIVE -1
 #define CS_MISS -2
+
+#define CS_LOD_FULL 0   //完整动力学
+#define CS_LOD_COARSE 1 //粗略运动学
+
+#define CS_MISSILE_DESTROY_RANGE 250.0  //导弹默认杀伤半径，单位：米
+#define CS_MISSILE_MAX_JOURNEY 30000.0  //导弹默认最大射程，单位：米
 	/** @}  */
 
 	// --------------------------------------------------------------------------------------------------------------------------------
@@ -67,7 +76,39 @@ namespace CombatSimulation
 		double							reference_altitude;				//!< 参考点高度，单位：米
 	};
 
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          击毁事件。
+	*   @details        导弹引爆击毁飞机时记录，每个仿真步清空。
+	*/
+	struct KillEvent_T
+	{
+		double							time;							//!< 发生时标，单位：秒
+		int								missile_index;					//!< 导弹在 missile_list 中的下标
+		int								aircraft_index;					//!< 被击毁飞机在 aircraft_list 中的下标
+		int								missile_id;						//!< 导弹仿真id
+		int								aircraft_id;					//!< 被击毁飞机仿真id
+		double							miss_distance;					//!< 引爆时脱靶量，单位：米
+	};
+
+
 
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          作战单位冷数据。
+	*   @details        只在初始化、输出和快照时访问的名字、传感器及挂载信息。由战场按槽位存放在 aircraft_cold_list、missile_cold_list 中，
+						单位记录只保留逐步解算读写的数据。飞机与导弹共用此结构，各自只使用其中一部分。
+	*/
+	struct UnitCold_T
+	{
+		int								base_name_id;					//!< 对象名字在字符串表中的编号，例：F-16
+		int								base_type_id;					//!< 类型在字符串表中的编号，例：Air+FixedWing
+		int								radar_state;					//!< 飞机雷达状态 0-关机 1-搜索 2-锁定；导弹末制导雷达状态 0-未捕获目标 1-捕获目标
+		int								lead_state;						//!< 导弹引导状态 0-未被引导 1-引导中
+		int								mounted_missile_count;			//!< 飞机挂载的导弹数量
+		int								locked_id_count;				//!< 飞机锁定目标数量
+		int								locked_id_list[max_object];		//!< 飞机锁定目标列表
+	};
 
 	// --------------------------------------------------------------------------------------------------------------------------------
 	/**
@@ -79,16 +120,13 @@ namespace CombatSimulation
 	public:
 		Unit_Object_C() {
 			base_live = 0;
+			p_string_table = NULL;
+			p_cold = NULL;
 		}
 		~Unit_Object_C() {}
 
-		BattlefieldHeader_T*			p_battle_header;					//!< 战场信息
-
-		int  							Sim_id;							//!< 编号，唯一标识
+		//逐步读写的数据在前，与派生类的运动状态相邻
 		int  							base_live;						//!< 存活，0 死亡，1 存活
-
-		char  							base_name[max_str];				//!< 基本信息，必填，对象名字，例：F-16
-		char  							base_type[max_str];				//!< 基本信息，必填，类型，例：Air+FixedWing
 		int   							base_team;		                //!< 基本信息，必填，所属队伍
 
 		double							coordinate_longitude;			//!< 坐标，经度，单位：度
@@ -102,6 +140,32 @@ namespace CombatSimulation
 		double							velocity_east;					//!< 速度，东向，单位：米/秒
 		double							velocity_downward;				//!< 速度，地面方向，单位：米/秒
 
+		BattlefieldHeader_T*			p_battle_header;					//!< 战场信息
+
+		int  							Sim_id;							//!< 编号，唯一标识
+		StringTable_C*					p_string_table;					//!< 字符串表，由战场持有
+		UnitCold_T*						p_cold;							//!< 冷数据，由战场按槽位持有
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          对象名字
+		*   @details        由字符串表查询对象名字
+		*   @retval         对象名字，例：F-16
+		*/
+		const char* BaseName() const {
+			return (p_string_table != NULL && p_cold != NULL) ? p_string_table->Lookup(p_cold->base_name_id) : "";
+		}
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          对象类型
+		*   @details        由字符串表查询对象类型
+		*   @retval         对象类型，例：Air+FixedWing
+		*/
+		const char* BaseType() const {
+			return (p_string_table != NULL && p_cold != NULL) ? p_string_table->Lookup(p_cold->base_type_id) : "";
+		}
+
 // --------------------------------------------------------------------------------------------------------------------------------
 /**
 *   @brief          设置单位坐标
@@ -140,15 +204,15 @@ namespace CombatSimulation
 	class Aircraft_Object_C:public Unit_Object_C
 	{
 	public:
-		Aircraft_Object_C() {}
+		Aircraft_Object_C() {
+			lod_level = CS_LOD_FULL;
+			lod_interval = 1.0;
+			lod_turn_rate.setZero();
+			lod_handle.setZero();
+			lod_elapsed = 0;
+		}
 		~Aircraft_Object_C() {}
 
-		int								radar_state;					        //!< 雷达状态 0-关机 1-搜索 2-锁定
-		int								locked_id_count;						//!< 锁定目标数量
-		int								locked_id_list[max_object];				//!< 锁定目标列表
-
-		int								mounted_missile_count;					//!< 挂载的导弹数量
-
 // --------------------------------------------------------------------------------------------------------------------------------
 /**
 *   @brief          初始化一个飞机实体
@@ -194,28 +258,57 @@ namespace CombatSimulation
 
 		//int MissileFire(int target_id);
 
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          切换解算精度
+		*   @details        降级时沿用完整动力学最近一步估计的转率并记下当时的控制参数；升级时先把粗略模式下累积未推进的时间推进完，保证状态连续
+		*   @param[in]      in_lod_level    CS_LOD_FULL 完整动力学，CS_LOD_COARSE 粗略运动学
+		*   @retval         0               正常
+		*/
+		int SetLevelOfDetail(int in_lod_level);
+
 		//***********FlyTac**************//
 		Eigen::Matrix4d					craft_state;							//!< 飞机状态
 		Eigen::Vector4d					craft_handle;							//!< 飞机控制参数
 
-		
+		//***********LOD**************//
+		int								lod_level;								//!< 解算精度 0-完整动力学 1-粗略运动学
+		double							lod_interval;							//!< 粗略运动学更新间隔，单位：秒
+		double							lod_elapsed;							//!< 粗略模式下尚未推进的时间，单位：秒
+		Eigen::Vector3d					lod_turn_rate;							//!< 导航系转率矢量估计，单位：弧度/秒
+		Eigen::Vector4d					lod_handle;								//!< 降级时的控制参数，粗略模式下 craft_handle 与之不同时恢复完整动力学
+
+		//雷达、挂载及锁定列表见 p_cold
+
+	private:
+		//由导航系状态更新经纬高、姿态角和速度
+		int UpdateCoordinate();
 	};
 
+	class LaneBattlefield_C;
+	class Battlefield_C;
+	class ScenarioFile_C;
+	struct AircraftSnapshot_T;
+	struct MissileSnapshot_T;
+	struct SnapshotHeader_T;
+
 	class Missile_Object_C :public Unit_Object_C
 	{
+		//通道战场装载、写回制导状态；战场保存、恢复快照
+		friend class LaneBattlefield_C;
+		friend class Battlefield_C;
+
 	public:
 		Missile_Object_C() {
 			missile_live = 0;
 		}
 		~Missile_Object_C() {}
-		int								father_id;								//!< 发射机id
 		int								missile_live;					        //!< 导弹状态 1-运行中  0-未发射/死亡 -1-命中 -2-超出范围未命中
-		int								radar_state;					        //!< 末制导雷达状态 0-雷达未捕获目标  1-末制导雷达捕获目标
-		int								lead_state;								//!< 引导状态 0-未被引导 1-引导中
+		int								father_id;								//!< 发射机id
 		Aircraft_Object_C*				p_target_air;								//!< 目标飞机
 
-		double							destroy_range = 250;					//!< 杀伤半径，单位：米
-		double							max_journey = 30000;					//!< 最大射程，单位：米
+		double							destroy_range = CS_MISSILE_DESTROY_RANGE;					//!< 杀伤半径，单位：米
+		double							max_journey = CS_MISSILE_MAX_JOURNEY;					//!< 最大射程，单位：米
 
 // --------------------------------------------------------------------------------------------------------------------------------
 /**
@@ -278,10 +371,16 @@ namespace CombatSimulation
 		//导弹与目标距离（米）
 		double distance_target;
 
+		//命中判定状态，每枚导弹独立保存
+		Eigen::Vector3d					missile_position_last;					//!< 上一时刻导弹位置
+		double							missile_journey;						//!< 已飞行路程，单位：米
+
 		//***********FlyTac**************//
 		//导弹过点飞控制参数
 		double missile_errA = 0, missile_errP = 0, missile_errR = 0,
 			missile_errAsum = 0, missile_errPsum = 0;
+
+		//末制导雷达及引导状态见 p_cold
 	};
 
 
@@ -292,28 +391,70 @@ namespace CombatSimulation
 */
 	class Battlefield_C
 	{
+		//想定库装入、生成飞机记录
+		friend class ScenarioFile_C;
 
 	public:
 		Battlefield_C() {
 			time = 0;
 			aircraft_count = 0;
 			missile_count = 0;
+			kill_event_count = 0;
+
+			active_aircraft_count = 0;
+			active_missile_count = 0;
+			aircraft_synced = 0;
+			missile_synced = 0;
+
+			lod_enable = 0;
+			lod_promote_range = 80000;
+			lod_demote_range = 100000;
 
 			for (int i = 0; i < max_object; i++) {
 				aircraft_list[i].p_battle_header = &battle_header;
 				missile_list[i].p_battle_header = &battle_header;
+				aircraft_list[i].p_string_table = &string_table;
+				missile_list[i].p_string_table = &string_table;
+				aircraft_cold_list[i] = UnitCold_T();
+				missile_cold_list[i] = UnitCold_T();
+				aircraft_list[i].p_cold = &aircraft_cold_list[i];
+				missile_list[i].p_cold = &missile_cold_list[i];
 			}
 		}
 
 		~Battlefield_C() {}
 
+		//成员指针指向自身的战场信息，禁止拷贝
+		Battlefield_C(const Battlefield_C&) = delete;
+		Battlefield_C& operator=(const Battlefield_C&) = delete;
+
 		double							time;							//!< 时标
 		BattlefieldHeader_T				battle_header;					//!< 战场信息
+		StringTable_C					string_table;					//!< 名字、类型字符串表
 
 		int								aircraft_count;					//!< 飞行器 数量
 		Aircraft_Object_C				aircraft_list[max_object];		//!< 飞行器 列表
 		int								missile_count;					//!< 导弹 数量
 		Missile_Object_C				missile_list[max_object];		//!< 导弹 列表
+		UnitCold_T						aircraft_cold_list[max_object];	//!< 飞行器 冷数据，与 aircraft_list 同下标
+		UnitCold_T						missile_cold_list[max_object];	//!< 导弹 冷数据，与 missile_list 同下标
+
+		//活动实体列表，逐步循环只遍历这些下标；死亡实体多保留一步，便于输出其被摧毁的一帧
+		int								active_aircraft_count;			//!< 活动飞机 数量
+		int								active_aircraft_list[max_object];	//!< 活动飞机 列表，aircraft_list 下标
+		int								active_missile_count;			//!< 活动导弹 数量
+		int								active_missile_list[max_object];	//!< 活动导弹 列表，missile_list 下标
+
+		SpatialIndex_C					aircraft_index;					//!< 存活飞机空间索引，实体编号为 aircraft_list 下标
+
+		EventScheduler_C				event_scheduler;				//!< 稀疏事件调度，Run 结束时触发到期事件，处理函数的 owner 为本战场
+
+		int								kill_event_count;				//!< 本步击毁事件 数量
+		KillEvent_T						kill_event_list[max_object];	//!< 本步击毁事件 列表，每枚导弹至多引爆一次
+
+		int								lod_enable;						//!< 分级解算 0-关闭 1-启用。粗略运动学按转率外推、不读取 craft_handle，外部改变了控制参数的飞机当步恢复完整动力学
+		double							lod_promote_range;				//!< 与最近威胁距离小于此值时升级为完整动力学，应不小于敌方传感器及武器作用距离，单位：米
+		double							lod_demote_range;				//!< 与最近威胁距离大于此值时降级为粗略运动学，大于 lod_promote_range 形成滞环，单位：米
 
 // --------------------------------------------------------------------------------------------------------------------------------
 /**
@@ -329,6 +470,14 @@ namespace CombatSimulation
 			double							in_reference_latitude,
 			double							in_reference_altitude);
 
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          清空战场
+		*   @details        时标归零，清除全部飞机、导弹、事件、待触发的调度事件及活动列表，保留参考点、字符串表、事件处理函数和分级解算设置，用于重复开始新的对局
+		*   @retval         0                    正常
+		*/
+		int Reset();
+
 
 		// --------------------------------------------------------------------------------------------------------------------------------
 		/**
@@ -341,6 +490,133 @@ namespace CombatSimulation
 		int MissileFire(
 			Aircraft_Object_C& attack_air,
 			Aircraft_Object_C& target_air);
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          战场单步解算
+		*   @details        依次解算全部飞机与导弹、重建空间索引并做近炸判定，推进时标并触发到期的调度事件，只访问本战场内的数据，多个战场可在不同线程中同时解算
+		*   @param[in]      d_time          单步时间间隔 单位：秒
+		*   @retval         0               正常
+		*/
+		int Run(double d_time);
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          重建飞机空间索引
+		*   @details        以导航坐标系位置重建 aircraft_index，Run 结束时自动调用，修改飞机位置后也可手动调用
+		*   @retval         0               正常
+		*/
+		int UpdateSpatialIndex();
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          导弹近炸引信判定
+		*   @details        对每枚飞行中的导弹，以空间索引粗筛可及范围内的敌方飞机，再按上一步内相对匀速运动求最近点距离，
+							不大于杀伤半径即引爆，击毁最近的敌机并写入 kill_event_list。需在 UpdateSpatialIndex 之后调用，Run 中自动调用
+		*   @param[in]      d_time          单步时间间隔 单位：秒
+		*   @retval         本步近炸引爆的导弹数量
+		*/
+		int MissileProximityCheck(double d_time);
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          更新飞机解算精度
+		*   @details        威胁为敌方飞机和敌方导弹。最近威胁在 lod_promote_range 内的飞机使用完整动力学，
+							超出 lod_demote_range 的使用粗略运动学，两者之间保持原精度。需在 UpdateSpatialIndex 之后调用，Run 中自动调用
+		*   @retval         0               正常
+		*/
+		int UpdateLevelOfDetail();
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          更新活动实体列表
+		*   @details        将 aircraft_count、missile_count 新增的存活实体追加到列表末尾，移除已死亡且已保留过一步的实体，
+							列表保持原有顺序。Run 开始时自动调用，不使用 Run 时应在每步开始调用
+		*   @retval         0               正常
+		*/
+		int RefreshActiveList();
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          快照所需的最大字节数
+		*   @details        按 max_object 架飞机、max_object 枚导弹和 SNAPSHOT_MAX_EVENT 个待触发事件计算，
+							预先分配的快照缓冲区不小于此值即可保存任意状态
+		*   @retval         字节数
+		*/
+		static int SnapshotCapacity();
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          保存完整快照
+		*   @details        按实体数线性复制，不分配内存。快照不含指针，可按字节复制到任意位置。待触发的调度事件一并保存
+		*   @param[out]     buffer          快照缓冲区
+		*   @param[in]      buffer_size     缓冲区字节数
+		*   @param[out]     out_size        快照字节数，可为 NULL
+		*   @retval         0               正常
+		*   @retval         1               错误，缓冲区不足或待触发事件超过 SNAPSHOT_MAX_EVENT
+		*/
+		int SaveSnapshot(
+			void*							buffer,
+			int								buffer_size,
+			int*							out_size) const;
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          保存增量快照
+		*   @details        只记录与基准快照不同的实体，且每个实体只记录与基准不同的字(8 字节)，未变化的实体和字恢复时取自基准快照。
+							只推进一步或只改动少数控制量的分支，增量远小于完整快照。待触发的调度事件总是完整保存
+		*   @param[in]      base            基准快照，必须是完整快照
+		*   @param[out]     buffer          快照缓冲区
+		*   @param[in]      buffer_size     缓冲区字节数
+		*   @param[out]     out_size        快照字节数，可为 NULL
+		*   @retval         0               正常
+		*   @retval         1               错误，缓冲区不足或待触发事件超过 SNAPSHOT_MAX_EVENT
+		*/
+		int SaveDelta(
+			const void*						base,
+			void*							buffer,
+			int								buffer_size,
+			int*							out_size) const;
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          恢复快照
+		*   @details        恢复全部实体状态、活动列表和本步击毁事件，并重建空间索引。快照中的名字编号指向保存时战场的字符串表，
+					恢复到其他战场时应先复制字符串表(string_table = 源战场.string_table)。
+					待触发的调度事件按保存时的节点、序号和时间片恢复，保存时取得的事件句柄仍可取消；
+					事件处理函数和上下文不在快照中，沿用目标战场已登记的(SetHandler)
+		*   @param[in]      snapshot        完整快照或增量快照
+		*   @param[in]      base            增量快照的基准快照，恢复完整快照时可为 NULL
+		*   @retval         0               正常
+		*   @retval         1               错误，快照无效或缺少基准
+		*/
+		int RestoreSnapshot(
+			const void*						snapshot,
+			const void*						base = NULL);
+
+	private:
+		//重建索引用的存活飞机位置
+		double							index_x[max_object];
+		double							index_y[max_object];
+		double							index_z[max_object];
+		int								index_id[max_object];
+
+		//已纳入活动列表的实体数，之后的为新增实体
+		int								aircraft_synced;
+		int								missile_synced;
+		//活动列表中的实体上次更新时已死亡
+		int								aircraft_dead_seen[max_object];
+		int								missile_dead_seen[max_object];
+
+		//记录一次击毁事件
+		int AddKillEvent(int missile_index, int aircraft_index, double miss_distance);
+
+		//快照头部及单个实体记录的保存与恢复
+		void SaveHeader(SnapshotHeader_T* header) const;
+		void SaveAircraft(int index, AircraftSnapshot_T* record) const;
+		void SaveMissile(int index, MissileSnapshot_T* record) const;
+		void LoadAircraft(int index, const AircraftSnapshot_T& record);
+		void LoadMissile(int index, const MissileSnapshot_T& record);
 	};
 }
 
@@ -0,0 +1,461 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           VecBattlefield.cpp
+*   @brief          批量战场实现。
+*   @details        批量战场实现。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           头文件。
+*   @{
+*/
+#include "VecBattlefield.h"
+#include "../Tools/coordinate.h"
+
+using namespace CombatSimulation;
+/** @}  */
+
+
+//智能体所属的不同队伍数，only_live 为1时只统计存活的
+static int CountTeam(const Battlefield_C& battlefield, int agent_count, int only_live)
+{
+	int team_list[max_object];
+	int team_count = 0;
+
+	for (int a = 0; a < agent_count; a++) {
+		const Aircraft_Object_C& air = battlefield.aircraft_list[a];
+		if (only_live != 0 && air.base_live != CS_LIVE) {
+			continue;
+		}
+		int k = 0;
+		while (k < team_count && team_list[k] != air.base_team) {
+			k++;
+		}
+		if (k == team_count) {
+			team_list[team_count++] = air.base_team;
+		}
+	}
+
+	return team_count;
+}
+
+
+VecBattlefield_C::VecBattlefield_C(
+	int								in_env_count,
+	int								in_agent_count,
+	int								in_thread_count)
+	: pool(in_thread_count)
+{
+	env_count = (in_env_count < 1) ? 1 : in_env_count;
+	agent_count = in_agent_count;
+	if (agent_count < 1) {
+		agent_count = 1;
+	}
+	if (agent_count > max_object) {
+		agent_count = max_object;
+	}
+
+	env_list = new Battlefield_C[env_count];
+	rand_list = new GaussRand_T[env_count];
+	reset_error = new int[env_count];
+	episode_list = new unsigned long long[env_count];
+
+	reset_func = NULL;
+	reset_context = NULL;
+	reset_pool = NULL;
+	seed = 1;
+
+	d_time = 0.02;
+	frame_skip = 5;
+	max_time = 300;
+
+	batch_actions = NULL;
+	batch_obs = NULL;
+	batch_reward = NULL;
+	batch_done = NULL;
+
+	for (int i = 0; i < env_count; i++) {
+		env_list[i].InitCoordinate(126.0, 30.0, 0.0);
+		reset_error[i] = 0;
+	}
+	//与 Seed(1) 相同
+	Seed(seed);
+}
+
+
+VecBattlefield_C::~VecBattlefield_C()
+{
+	delete[] env_list;
+	delete[] rand_list;
+	delete[] reset_error;
+	delete[] episode_list;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          设置对局初始化函数
+*   @details        不设置或设为 NULL 时使用默认的两队对头布置。已设置初始态池时不能设置自定义初始化函数
+*   @param[in]      in_reset        对局初始化函数
+*   @param[in]      in_context      传给初始化函数的上下文
+*   @retval         0               正常
+*   @retval         1               错误，已设置初始态池
+*/
+int VecBattlefield_C::SetReset(
+	BattlefieldReset_F				in_reset,
+	void*							in_context)
+{
+	if (in_reset != NULL && reset_pool != NULL) {
+		return 1;
+	}
+
+	reset_func = in_reset;
+	reset_context = in_context;
+
+	return CS_OK;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          设置初始态池
+*   @details        设置后第 i 个战场的第 k 局初始态按(种子，i，k)从池中取出，池中没有时由池同步生成，结果与池的状态无关。
+					自定义初始化函数使用各战场自己的发生器，与按局取键的池不能同时使用
+*   @param[in]      in_reset_pool   初始态池，为 NULL 时不使用
+*   @retval         0               正常
+*   @retval         1               错误，智能体数量不一致、池的战场数不足或已设置自定义初始化函数
+*/
+int VecBattlefield_C::SetResetPool(ResetPool_C* in_reset_pool)
+{
+	if (in_reset_pool != NULL &&
+		(in_reset_pool->AgentCount() != agent_count || in_reset_pool->EnvCount() < env_count || reset_func != NULL)) {
+		return 1;
+	}
+
+	reset_pool = in_reset_pool;
+
+	return CS_OK;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          设置步长
+*   @details        一次 Step 推进 frame_skip 个仿真步，控制量在其间保持不变
+*   @param[in]      in_d_time       仿真步长，单位：秒
+*   @param[in]      in_frame_skip   每次 Step 的仿真步数
+*   @param[in]      in_max_time     单局最长时间，单位：秒
+*   @retval         0               正常
+*   @retval         1               错误
+*/
+int VecBattlefield_C::SetStep(
+	double							in_d_time,
+	int								in_frame_skip,
+	double							in_max_time)
+{
+	if (in_d_time <= 0 || in_frame_skip < 1 || in_max_time <= 0) {
+		return 1;
+	}
+
+	d_time = in_d_time;
+	frame_skip = in_frame_skip;
+	max_time = in_max_time;
+
+	return CS_OK;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          设置随机数种子
+*   @details        每个战场的发生器由种子与战场序号导出，相同种子得到相同的初始态序列；各战场的局序号归零。下次 Reset 起生效
+*   @param[in]      in_seed         随机数种子
+*   @retval         0               正常
+*/
+int VecBattlefield_C::Seed(unsigned long long in_seed)
+{
+	seed = in_seed;
+	for (int i = 0; i < env_count; i++) {
+		//相邻种子经LCG扩散后序列互不相关
+		gaussrand_init(&rand_list[i], seed * 0x9E3779B97F4A7C15ULL + (unsigned long long)i);
+		episode_list[i] = 0;
+	}
+
+	return CS_OK;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          全部战场重新开始
+*   @details        并行初始化全部战场并输出初始观测
+*   @param[out]     obs_out         观测 [env_count][agent_count][ObsSize()]，可为 NULL
+*   @retval         0               正常
+*   @retval         1               错误，初始化函数返回错误
+*/
+int VecBattlefield_C::Reset(double* obs_out)
+{
+	batch_obs = obs_out;
+	pool.ParallelFor(env_count, ResetTask, this);
+	batch_obs = NULL;
+
+	for (int i = 0; i < env_count; i++) {
+		if (reset_error[i] != 0) {
+			return 1;
+		}
+	}
+
+	return CS_OK;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          全部战场推进一步
+*   @details        写入控制量，并行推进 frame_skip 个仿真步，输出观测、奖励和结束标志。
+*   @param[in]      actions         控制量 [env_count][agent_count][VB_ACTION_SIZE]
+*   @param[out]     obs_out         观测 [env_count][agent_count][ObsSize()]
+*   @param[out]     reward_out      奖励 [env_count][agent_count]
+*   @param[out]     done_out        结束标志 [env_count]，1 表示本步结束并已重新初始化
+*   @retval         0               正常
+*   @retval         1               错误
+*/
+int VecBattlefield_C::Step(
+	const double*					actions,
+	double*							obs_out,
+	double*							reward_out,
+	int*							done_out)
+{
+	if (actions == NULL || obs_out == NULL || reward_out == NULL || done_out == NULL) {
+		return 1;
+	}
+
+	batch_actions = actions;
+	batch_obs = obs_out;
+	batch_reward = reward_out;
+	batch_done = done_out;
+
+	pool.ParallelFor(env_count, StepTask, this);
+
+	batch_actions = NULL;
+	batch_obs = NULL;
+	batch_reward = NULL;
+	batch_done = NULL;
+
+	return CS_OK;
+}
+
+
+void VecBattlefield_C::StepTask(void* context, int env_index)
+{
+	VecBattlefield_C* vec = (VecBattlefield_C*)context;
+
+	vec->StepEnv(env_index,
+		vec->batch_actions + (size_t)env_index * vec->agent_count * VB_ACTION_SIZE,
+		vec->batch_obs + (size_t)env_index * vec->agent_count * vec->ObsSize(),
+		vec->batch_reward + (size_t)env_index * vec->agent_count,
+		vec->batch_done + env_index);
+}
+
+
+void VecBattlefield_C::ResetTask(void* context, int env_index)
+{
+	VecBattlefield_C* vec = (VecBattlefield_C*)context;
+
+	vec->ResetEnv(env_index,
+		(vec->batch_obs != NULL) ? vec->batch_obs + (size_t)env_index * vec->agent_count * vec->ObsSize() : NULL);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          单个战场推进一步
+*   @details        与 Step 相同，只处理一个战场。不同战场可在不同线程中同时调用
+*   @param[in]      env_index       战场序号
+*   @param[in]      action          控制量 [agent_count][VB_ACTION_SIZE]
+*   @param[out]     obs             观测 [agent_count][ObsSize()]
+*   @param[out]     reward          奖励 [agent_count]
+*   @param[out]     done_out        结束标志，1 表示本步结束并已重新初始化
+*   @retval         0               正常
+*   @retval         1               错误
+*/
+int VecBattlefield_C::StepEnv(
+	int								env_index,
+	const double*					action,
+	double*							obs,
+	double*							reward,
+	int*							done_out)
+{
+	if (env_index < 0 || env_index >= env_count) {
+		return 1;
+	}
+
+	Battlefield_C& battlefield = env_list[env_index];
+
+	for (int a = 0; a < agent_count; a++) {
+		battlefield.aircraft_list[a].craft_handle << action[a * VB_ACTION_SIZE + 0], action[a * VB_ACTION_SIZE + 1],
+			action[a * VB_ACTION_SIZE + 2], action[a * VB_ACTION_SIZE + 3];
+		reward[a] = 0;
+	}
+
+	int done = 0;
+	for (int f = 0; f < frame_skip && done == 0; f++) {
+		battlefield.Run(d_time);
+
+		//击毁事件计入奖励：发射机 +1，被击毁的飞机 -1
+		for (int e = 0; e < battlefield.kill_event_count; e++) {
+			const KillEvent_T& kill = battlefield.kill_event_list[e];
+			if (kill.aircraft_index >= 0 && kill.aircraft_index < agent_count) {
+				reward[kill.aircraft_index] -= 1;
+			}
+			int father_id = battlefield.missile_list[kill.missile_index].father_id;
+			for (int a = 0; a < agent_count; a++) {
+				if (battlefield.aircraft_list[a].Sim_id == father_id) {
+					reward[a] += 1;
+					break;
+				}
+			}
+		}
+
+		//任一队的智能体全部被击毁时结束
+		if (CountTeam(battlefield, agent_count, 1) < CountTeam(battlefield, agent_count, 0)) {
+			done = 1;
+		}
+		if (battlefield.time >= max_time) {
+			done = 1;
+		}
+	}
+
+	*done_out = done;
+	if (done != 0) {
+		ResetOne(env_index);
+	}
+
+	return WriteObservation(env_index, obs);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          单个战场重新开始
+*   @details        与 Reset 相同，只处理一个战场。不同战场可在不同线程中同时调用
+*   @param[in]      env_index       战场序号
+*   @param[out]     obs             观测 [agent_count][ObsSize()]，可为 NULL
+*   @retval         0               正常
+*   @retval         1               错误
+*/
+int VecBattlefield_C::ResetEnv(
+	int								env_index,
+	double*							obs)
+{
+	if (env_index < 0 || env_index >= env_count) {
+		return 1;
+	}
+
+	if (ResetOne(env_index) != 0) {
+		return 1;
+	}
+	if (obs != NULL) {
+		WriteObservation(env_index, obs);
+	}
+
+	return CS_OK;
+}
+
+
+int VecBattlefield_C::ResetOne(int env_index)
+{
+	Battlefield_C& battlefield = env_list[env_index];
+
+	//按局取键，池中没有时由池同步生成，已补齐占位飞机
+	if (reset_pool != NULL) {
+		reset_error[env_index] = reset_pool->Take(&battlefield, seed, env_index, episode_list[env_index]);
+		episode_list[env_index]++;
+		return reset_error[env_index];
+	}
+
+	battlefield.Reset();
+	if (reset_func != NULL) {
+		reset_error[env_index] = reset_func(&battlefield, env_index, agent_count, &rand_list[env_index], reset_context);
+	}
+	else {
+		reset_error[env_index] = DefaultReset(&battlefield, env_index, agent_count, &rand_list[env_index], NULL);
+	}
+
+	//初始化函数未布置足够的飞机时，补齐为死亡的占位，观测中存活标志为0
+	for (int a = battlefield.aircraft_count; a < agent_count; a++) {
+		battlefield.aircraft_list[a].base_live = 0;
+		battlefield.aircraft_list[a].craft_state.setZero();
+	}
+	if (battlefield.aircraft_count < agent_count) {
+		battlefield.aircraft_count = agent_count;
+	}
+
+	return reset_error[env_index];
+}
+
+
+int VecBattlefield_C::WriteObservation(int env_index, double* obs)
+{
+	const Battlefield_C& battlefield = env_list[env_index];
+	int obs_size = ObsSize();
+
+	for (int a = 0; a < agent_count; a++) {
+		const Aircraft_Object_C& self = battlefield.aircraft_list[a];
+		double* out = obs + (size_t)a * obs_size;
+
+		//本机：导航系位置、速度，姿态四元数，存活
+		for (int j = 0; j < 3; j++) {
+			out[j] = self.craft_state(0, j);
+			out[3 + j] = self.craft_state(1, j);
+		}
+		for (int j = 0; j < 4; j++) {
+			out[6 + j] = self.craft_state(2, j);
+		}
+		out[10] = (self.base_live == CS_LIVE) ? 1.0 : 0.0;
+		out += VB_OBS_SELF;
+
+		//其他智能体：相对位置、相对速度，存活，是否敌方
+		for (int b = 0; b < agent_count; b++) {
+			if (b == a) {
+				continue;
+			}
+			const Aircraft_Object_C& other = battlefield.aircraft_list[b];
+			for (int j = 0; j < 3; j++) {
+				out[j] = other.craft_state(0, j) - self.craft_state(0, j);
+				out[3 + j] = other.craft_state(1, j) - self.craft_state(1, j);
+			}
+			out[6] = (other.base_live == CS_LIVE) ? 1.0 : 0.0;
+			out[7] = (other.base_team != self.base_team) ? 1.0 : 0.0;
+			out += VB_OBS_OTHER;
+		}
+	}
+
+	return CS_OK;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          默认对局初始化
+*   @details        智能体按序号交替分为1、2两队，在参考点南北各10公里处、约6000米高度对头飞行，位置和高度带高斯扰动
+*/
+int VecBattlefield_C::DefaultReset(
+	Battlefield_C* battlefield,
+	int env_index,
+	int agent_count,
+	GaussRand_T* rand_state,
+	void* context)
+{
+	(void)context;
+	return ResetPool_C::DistributionReset(battlefield, env_index, agent_count, rand_state, NULL);
+}
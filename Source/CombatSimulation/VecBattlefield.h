@@ -0,0 +1,265 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           VecBattlefield.h
+*   @brief          批量战场。
+*   @details        持有多个相互独立的战场，一次调用写入全部控制量、在多核上并行推进并输出观测、奖励和结束标志，
+					供强化学习批量采样使用。输入输出均为调用者提供的连续数组，逐步调用中不分配内存。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+#ifndef Vec_Battlefield_H
+#define Vec_Battlefield_H
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           头文件。
+*   @{
+*/
+#include "UnitDefine.h"
+#include "ResetPool.h"
+#include "../Tools/worker_pool.h"
+#include "../Tools/tool_function.h"
+
+/** @}  */
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          CombatSimulation 命名空间。
+*   @details        CombatSimulation 命名空间。
+*/
+namespace CombatSimulation
+{
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @name           批量战场宏定义。
+	*   @{
+	*/
+#define VB_ACTION_SIZE 4  //每架飞机控制量维数，与 craft_handle 相同：滚转角速率、俯仰角速率、偏航角速率、加速度
+#define VB_OBS_SELF 11    //观测中本机部分维数：位置3、速度3、四元数4、存活1
+#define VB_OBS_OTHER 8    //观测中每架其他飞机维数：相对位置3、相对速度3、存活1、敌方1
+	/** @}  */
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          批量战场。
+	*   @details        数组布局(均为行优先、连续存放)：
+					actions     [env_count][agent_count][VB_ACTION_SIZE]
+					obs_out     [env_count][agent_count][ObsSize()]
+					reward_out  [env_count][agent_count]
+					done_out    [env_count]
+					对局结束的战场在 Step 内自动重新初始化，此时 obs_out 中为新对局的初始观测。
+	*/
+	class VecBattlefield_C
+	{
+	public:
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          创建批量战场
+		*   @details        创建批量战场，参数超出范围时截断到有效范围
+		*   @param[in]      in_env_count    战场数量，不小于1
+		*   @param[in]      in_agent_count  每个战场的智能体数量，1 ~ max_object
+		*   @param[in]      in_thread_count 并行线程数，不大于0时取硬件线程数
+		*/
+		VecBattlefield_C(
+			int								in_env_count,
+			int								in_agent_count,
+			int								in_thread_count = 0);
+		~VecBattlefield_C();
+
+		//持有战场数组，禁止拷贝
+		VecBattlefield_C(const VecBattlefield_C&) = delete;
+		VecBattlefield_C& operator=(const VecBattlefield_C&) = delete;
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          设置对局初始化函数
+		*   @details        不设置或设为 NULL 时使用默认的两队对头布置。已设置初始态池时不能设置自定义初始化函数，
+						初始态改由池的初始化函数(ResetPool_C::SetReset)生成
+		*   @param[in]      in_reset        对局初始化函数
+		*   @param[in]      in_context      传给初始化函数的上下文
+		*   @retval         0               正常
+		*   @retval         1               错误，已设置初始态池
+		*/
+		int SetReset(
+			BattlefieldReset_F				in_reset,
+			void*							in_context);
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          设置初始态池
+		*   @details        设置后第 i 个战场的第 k 局初始态按(种子，i，k)从池中取出，池中没有时由池同步生成，结果与池的状态无关。
+						池以与 Seed 相同的种子启动时才能命中。池的智能体数量和参考点应与本批量战场相同，
+						由调用者负责启动和停止，生存期不短于本批量战场
+		*   @param[in]      in_reset_pool   初始态池，为 NULL 时不使用
+		*   @retval         0               正常
+		*   @retval         1               错误，智能体数量不一致、池的战场数不足或已设置自定义初始化函数
+		*/
+		int SetResetPool(ResetPool_C* in_reset_pool);
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          设置步长
+		*   @details        一次 Step 推进 frame_skip 个仿真步，控制量在其间保持不变
+		*   @param[in]      in_d_time       仿真步长，单位：秒
+		*   @param[in]      in_frame_skip   每次 Step 的仿真步数
+		*   @param[in]      in_max_time     单局最长时间，单位：秒
+		*   @retval         0               正常
+		*   @retval         1               错误
+		*/
+		int SetStep(
+			double							in_d_time,
+			int								in_frame_skip,
+			double							in_max_time);
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          设置随机数种子
+		*   @details        每个战场的发生器由种子与战场序号导出，相同种子得到相同的初始态序列；各战场的局序号归零。下次 Reset 起生效
+		*   @param[in]      in_seed         随机数种子
+		*   @retval         0               正常
+		*/
+		int Seed(unsigned long long in_seed);
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          全部战场重新开始
+		*   @details        并行初始化全部战场并输出初始观测
+		*   @param[out]     obs_out         观测 [env_count][agent_count][ObsSize()]，可为 NULL
+		*   @retval         0               正常
+		*   @retval         1               错误，初始化函数返回错误
+		*/
+		int Reset(double* obs_out);
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          全部战场推进一步
+		*   @details        写入控制量，并行推进 frame_skip 个仿真步，输出观测、奖励和结束标志。
+					奖励：导弹击毁敌机时发射机 +1，被击毁的飞机 -1。
+					结束：任一队的智能体全部被击毁，或达到单局最长时间。
+		*   @param[in]      actions         控制量 [env_count][agent_count][VB_ACTION_SIZE]
+		*   @param[out]     obs_out         观测 [env_count][agent_count][ObsSize()]
+		*   @param[out]     reward_out      奖励 [env_count][agent_count]
+		*   @param[out]     done_out        结束标志 [env_count]，1 表示本步结束并已重新初始化
+		*   @retval         0               正常
+		*   @retval         1               错误
+		*/
+		int Step(
+			const double*					actions,
+			double*							obs_out,
+			double*							reward_out,
+			int*							done_out);
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          单个战场推进一步
+		*   @details        与 Step 相同，只处理一个战场。不同战场可在不同线程中同时调用
+		*   @param[in]      env_index       战场序号
+		*   @param[in]      action          控制量 [agent_count][VB_ACTION_SIZE]
+		*   @param[out]     obs             观测 [agent_count][ObsSize()]
+		*   @param[out]     reward          奖励 [agent_count]
+		*   @param[out]     done_out        结束标志，1 表示本步结束并已重新初始化
+		*   @retval         0               正常
+		*   @retval         1               错误
+		*/
+		int StepEnv(
+			int								env_index,
+			const double*					action,
+			double*							obs,
+			double*							reward,
+			int*							done_out);
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          单个战场重新开始
+		*   @details        与 Reset 相同，只处理一个战场。不同战场可在不同线程中同时调用
+		*   @param[in]      env_index       战场序号
+		*   @param[out]     obs             观测 [agent_count][ObsSize()]，可为 NULL
+		*   @retval         0               正常
+		*   @retval         1               错误
+		*/
+		int ResetEnv(
+			int								env_index,
+			double*							obs);
+
+		int EnvCount() const { return env_count; }
+		int AgentCount() const { return agent_count; }
+		int ThreadCount() const { return pool.ThreadCount(); }
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          每个智能体的观测维数
+		*   @details        本机 VB_OBS_SELF 维，其余每个智能体 VB_OBS_OTHER 维，按 aircraft_list 顺序跳过本机
+		*   @retval         观测维数
+		*/
+		int ObsSize() const { return VB_OBS_SELF + VB_OBS_OTHER * (agent_count - 1); }
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          访问单个战场
+		*   @details        用于显示或调试，不应在 Step 执行期间修改
+		*   @param[in]      env_index       战场序号
+		*   @retval         战场指针，序号无效时返回 NULL
+		*/
+		Battlefield_C* Env(int env_index) {
+			return (env_index >= 0 && env_index < env_count) ? &env_list[env_index] : NULL;
+		}
+
+		// --------------------------------------------------------------------------------------------------------------------------------
+		/**
+		*   @brief          默认对局初始化
+		*   @details        智能体按序号交替分为1、2两队，在参考点南北各10公里处、约6000米高度对头飞行，位置和高度带高斯扰动
+		*/
+		static int DefaultReset(
+			Battlefield_C* battlefield,
+			int env_index,
+			int agent_count,
+			GaussRand_T* rand_state,
+			void* context);
+
+	private:
+		int								env_count;						//!< 战场数量
+		int								agent_count;					//!< 每个战场的智能体数量
+		Battlefield_C*					env_list;						//!< 战场数组
+		GaussRand_T*					rand_list;						//!< 每个战场的随机数发生器
+		int*							reset_error;					//!< 每个战场最近一次初始化的返回值
+		unsigned long long*				episode_list;					//!< 每个战场下一局的序号
+
+		WorkerPool_C					pool;							//!< 并行线程池
+
+		BattlefieldReset_F				reset_func;
+		void*							reset_context;
+		ResetPool_C*					reset_pool;						//!< 初始态池，可为 NULL
+		unsigned long long				seed;
+
+		double							d_time;							//!< 仿真步长，单位：秒
+		int								frame_skip;						//!< 每次 Step 的仿真步数
+		double							max_time;						//!< 单局最长时间，单位：秒
+
+		//本次 Step 的调用者数组，由并行任务读取
+		const double*					batch_actions;
+		double*							batch_obs;
+		double*							batch_reward;
+		int*							batch_done;
+
+		//并行任务入口
+		static void StepTask(void* context, int env_index);
+		static void ResetTask(void* context, int env_index);
+
+		//单个战场初始化和输出观测
+		int ResetOne(int env_index);
+		int WriteObservation(int env_index, double* obs);
+	};
+}
+
+
+
+#endif // Vec_Battlefield_H
@@ -260,6 +260,69 @@ int Flight(
 }
 
 
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          Լɻ״̬
+*   @details        ٺת˶ѧģͣԶ뽻սķɻԽϴ󲽳ƽ
+					ٶƵϵתʸתλðԲȷ֣̬ٶͬתٶȴСֲ䡣
+*   @param[out]     out_state             ɻ״̬
+*   @param[in]      in_state              ɻ״̬
+*   @param[in]      in_timeslice          ʱ
+*   @param[in]      turn_rate             ϵתʸλ/
+*   @retval         0               
+*   @retval         1               
+*/
+int Flight_coarse(
+	Matrix4d* out_state,
+	const Matrix4d& in_state,
+	const double in_timeslice,
+	const Vector3d& turn_rate)
+{
+	Vector3d X0, V0;
+	X0 << in_state(0, 0), in_state(0, 1), in_state(0, 2);
+	V0 << in_state(1, 0), in_state(1, 1), in_state(1, 2);
+	Vector4d q0 = in_state.row(2);
+
+	double w = turn_rate.norm();
+	double theta = w * in_timeslice;
+
+	Vector3d X1, V1;
+	Vector4d q1;
+	if (theta < 1e-9) {
+		//ֱ߷
+		X1 = X0 + V0 * in_timeslice;
+		V1 = V0;
+		q1 = q0;
+	}
+	else {
+		Vector3d axis = turn_rate / w;
+		//Ӧңмʱٶȷ * ҳ
+		AngleAxisd half_turn(0.5 * theta, axis), full_turn(theta, axis);
+		double chord = sin(0.5 * theta) / (0.5 * theta);
+		//ٶתƽеķת
+		Vector3d V_axis = axis * axis.dot(V0);
+		X1 = X0 + (V_axis + chord * (half_turn * (V0 - V_axis))) * in_timeslice;
+		V1 = full_turn * V0;
+
+		//̬q1 = q_turn * q0
+		double c = cos(0.5 * theta), s = sin(0.5 * theta);
+		Vector3d qv0(q0(1), q0(2), q0(3)), qt = axis * s;
+		Vector3d qv1 = c * qv0 + q0(0) * qt + qt.cross(qv0);
+		q1 << c * q0(0) - qt.dot(qv0), qv1(0), qv1(1), qv1(2);
+		Vector4d qn;
+		quaterntion_normalized(&qn, q1);
+		q1 = qn;
+	}
+
+	(*out_state).row(0) << X1(0), X1(1), X1(2), 0;
+	(*out_state).row(1) << V1(0), V1(1), V1(2), 0;
+	(*out_state).row(2) = q1;
+	(*out_state).row(3) << 0, 0, 0, 0;
+
+	return 0;
+}
+
+
 
 // --------------------------------------------------------------------------------------------------------------------------------
 /**
@@ -149,6 +149,24 @@ int Flight(
 	const double in_timeslice,
 	const Eigen::Vector4d& in_handle);
 
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          Լɻ״̬
+*   @details        ٺת˶ѧģͣԶ뽻սķɻԽϴ󲽳ƽ
+					ٶƵϵתʸתλðԲȷ֣̬ٶͬתٶȴСֲ䡣
+*   @param[out]     out_state             ɻ״̬
+*   @param[in]      in_state              ɻ״̬
+*   @param[in]      in_timeslice          ʱ
+*   @param[in]      turn_rate             ϵתʸλ/
+*   @retval         0               
+*   @retval         1               
+*/
+int Flight_coarse(
+	Eigen::Matrix4d* out_state,
+	const Eigen::Matrix4d& in_state,
+	const double in_timeslice,
+	const Eigen::Vector3d& turn_rate);
+
 
 
 // --------------------------------------------------------------------------------------------------------------------------------
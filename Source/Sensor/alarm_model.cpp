@@ -0,0 +1,373 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           alarm_model.cpp
+*   @brief          雷达告警器模型及批量告警计算。
+*   @details        雷达告警器模型及批量告警计算。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   LiDaiwei
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*/
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           头文件。
+*   @{
+*/
+#include "alarm_model.h"
+#include "../Tools/tool_function.h"
+#include <string.h>
+/** @}  */
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           告警器模型常数。
+*   @{
+*/
+static const double light_speed = 299792458;            //与 Alarm() 相同
+static const double sight_factor = 4120;                //与 getRadarSight 相同
+static const double cull_margin = 1e-9;                 //剔除余量，相对于距离
+static const double range_margin = 1e-6;                //最大探测距离的余量
+/** @}  */
+
+
+AlarmModel_C::AlarmModel_C()
+{
+	serial = 0;
+	SetParam(DefaultParam());
+}
+
+
+AlarmModel_C::AlarmModel_C(const AlarmParam_T& in_param)
+{
+	serial = 0;
+	SetParam(in_param);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          设置告警器参数
+*   @details        重新计算全部常数
+*   @param[in]      in_param        告警器参数
+*   @retval         0               正常
+*/
+int AlarmModel_C::SetParam(const AlarmParam_T& in_param)
+{
+	param = in_param;
+	serial = RadarModel_C::NextSerial();
+
+	//与 getAlarmMaxDistance 相同
+	loss_scale = param.G / (pow(4 * M_PI, 2) * param.P * param.Ltx * param.Lp);
+
+	//方位角在 ±width/2 以内等价于 Vb[0] >= cos(width/2)*sqrt(Vb[0]^2+Vb[2]^2)
+	double half_azimuth = param.azimuth_alarm_width / 2.0;
+	cos_azimuth = (half_azimuth < M_PI) ? cos(half_azimuth) : -2.0;
+	//俯仰角在 ±width/2 以内等价于 |Vb[1]| <= tan(width/2)*sqrt(Vb[0]^2+Vb[2]^2)
+	double half_pitch = param.pitch_alarm_width / 2.0;
+	tan_pitch = (half_pitch < 0.5 * M_PI) ? tan(half_pitch) : -1.0;
+
+	return 0;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          告警器默认参数
+*   @details        与 Alarm_Initial 相同
+*/
+AlarmParam_T AlarmModel_C::DefaultParam()
+{
+	AlarmParam_T p;
+	Alarm_Initial(&p.P, &p.G, &p.Ltx, &p.Lp, &p.f_min, &p.f_max, &p.azimuth_alarm_width, &p.pitch_alarm_width);
+
+	return p;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          最大探测距离的平方与辐射源天线增益之比
+*   @details        与 getAlarmMaxDistance 相同，Rmax^2=RangeScale*Gt
+*   @param[in]      radar           辐射源雷达的参数
+*   @retval         Rmax^2/Gt
+*/
+double AlarmModel_C::RangeScale(const RadarParam_T& radar) const
+{
+	return radar.Pgt * radar.lambda * radar.lambda * loss_scale;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          辐射源频率是否在告警器频段内
+*   @details        频率为光速除以波长，与 Alarm() 相同
+*   @param[in]      radar           辐射源雷达的参数
+*   @retval         true            在频段内
+*/
+bool AlarmModel_C::InBand(const RadarParam_T& radar) const
+{
+	double f = light_speed / radar.lambda;
+	return f >= param.f_min && f <= param.f_max;
+}
+
+
+AlarmBatch_C::AlarmBatch_C()
+{
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          设置雷达、告警器型号表
+*   @details        清空全部缓存
+*   @param[in]      in_radar_models      各雷达型号
+*   @param[in]      in_radar_type_count  雷达型号数
+*   @param[in]      in_alarm_models      各告警器型号
+*   @param[in]      in_alarm_type_count  告警器型号数
+*   @retval         0               正常
+*   @retval         1               错误，型号表为空
+*/
+int AlarmBatch_C::SetTypes(
+	const RadarModel_C* const*		in_radar_models,
+	int								in_radar_type_count,
+	const AlarmModel_C* const*		in_alarm_models,
+	int								in_alarm_type_count)
+{
+	radar_models.clear();
+	alarm_models.clear();
+	pair_cache.clear();
+	radar_cache.clear();
+	if (in_radar_models == NULL || in_alarm_models == NULL || in_radar_type_count < 0 || in_alarm_type_count < 0) {
+		return 1;
+	}
+	for (int r = 0; r < in_radar_type_count; r++) {
+		if (in_radar_models[r] == NULL) {
+			radar_models.clear();
+			return 1;
+		}
+		radar_models.push_back(in_radar_models[r]);
+	}
+	for (int a = 0; a < in_alarm_type_count; a++) {
+		if (in_alarm_models[a] == NULL) {
+			radar_models.clear();
+			alarm_models.clear();
+			return 1;
+		}
+		alarm_models.push_back(in_alarm_models[a]);
+	}
+
+	//序号从1开始，0 表示未计算
+	PairCache_T empty_pair = { 0, 0, false, 0, 0 };
+	RadarCache_T empty_radar = { 0, 0, 0 };
+	pair_cache.assign(radar_models.size() * alarm_models.size(), empty_pair);
+	radar_cache.assign(radar_models.size(), empty_radar);
+
+	return 0;
+}
+
+
+//按序号更新缓存，型号数很少，每次 Run 逐个比较序号
+void AlarmBatch_C::UpdateCache()
+{
+	int alarm_type_count = (int)alarm_models.size();
+	for (int r = 0; r < (int)radar_models.size(); r++) {
+		const RadarModel_C* radar = radar_models[r];
+		const RadarParam_T& radar_param = radar->Param();
+
+		RadarCache_T& rc = radar_cache[r];
+		if (rc.serial != radar->Serial()) {
+			//与 RadarModel_C 的波束范围剔除限相同
+			double half_azimuth = radar_param.azimuth_radar_width / 2.0;
+			double half_pitch = radar_param.pitch_radar_width / 2.0;
+			rc.cos_azimuth = (half_azimuth < M_PI) ? cos(half_azimuth) : -2.0;
+			rc.tan_pitch = (half_pitch < 0.5 * M_PI) ? tan(half_pitch) : -1.0;
+			rc.serial = radar->Serial();
+		}
+
+		for (int a = 0; a < alarm_type_count; a++) {
+			const AlarmModel_C* alarm = alarm_models[a];
+			PairCache_T& pc = pair_cache[(size_t)r * alarm_type_count + a];
+			if (pc.radar_serial == radar->Serial() && pc.alarm_serial == alarm->Serial()) {
+				continue;
+			}
+			pc.in_band = alarm->InBand(radar_param);
+			pc.range_scale = alarm->RangeScale(radar_param);
+			pc.range2_max = pc.range_scale * radar->MaxGain() * (1.0 + 2 * range_margin);
+			pc.radar_serial = radar->Serial();
+			pc.alarm_serial = alarm->Serial();
+		}
+	}
+}
+
+
+//取给出的方向余弦矩阵，或按 Radar() 的坐标轴重定义取姿态计算
+static void StateMatrix(
+	double							Cnb[3][3],
+	const RadarBatchState_T*		state,
+	int								index)
+{
+	if (state->Cnb != NULL) {
+		memcpy(Cnb, state->Cnb[index], sizeof(double) * 9);
+		return;
+	}
+
+	double attitude[3];
+	attitude[0] = state->attitude[0][index];
+	attitude[1] = state->attitude[2][index];
+	attitude[2] = state->attitude[1][index];
+	getAttitudeMatrix(Cnb, attitude);
+}
+
+
+//体轴投影
+static void BodyVector(
+	double							Vb[3],
+	const double*					C,
+	const double					Vn[3])
+{
+	Vb[0] = C[0] * Vn[0] + C[1] * Vn[1] + C[2] * Vn[2];
+	Vb[1] = C[3] * Vn[0] + C[4] * Vn[1] + C[5] * Vn[2];
+	Vb[2] = C[6] * Vn[0] + C[7] * Vn[1] + C[8] * Vn[2];
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          批量告警
+*   @details        先按序号更新缓存，算好各飞机的方向余弦矩阵和高度平方根，再对每个告警器逐部雷达剔除、计算。
+*   @param[out]     alarm_mask           告警掩码[N][MaskWords(N)]
+*   @param[in]      aircraft             飞机状态，共N架，只使用位置、姿态或方向余弦矩阵
+*   @param[in]      radar_type           各飞机的雷达型号下标，<0 表示雷达未开机
+*   @param[in]      alarm_type           各飞机的告警器型号下标，<0 表示没有告警器
+*   @param[out]     stats                剔除统计，可为 NULL
+*   @retval         0               正常
+*   @retval         1               错误，参数为空或型号下标超出型号表
+*/
+int AlarmBatch_C::Run(
+	unsigned long long*				alarm_mask,
+	const RadarBatchState_T*		aircraft,
+	const int*						radar_type,
+	const int*						alarm_type,
+	AlarmBatchStats_T*				stats)
+{
+	if (alarm_mask == NULL || aircraft == NULL || radar_type == NULL || alarm_type == NULL ||
+		(aircraft->Cnb == NULL && (aircraft->attitude[0] == NULL || aircraft->attitude[1] == NULL || aircraft->attitude[2] == NULL))) {
+		return 1;
+	}
+	int count = aircraft->count;
+	int radar_type_count = (int)radar_models.size();
+	int alarm_type_count = (int)alarm_models.size();
+	for (int k = 0; k < count; k++) {
+		if (radar_type[k] >= radar_type_count || alarm_type[k] >= alarm_type_count) {
+			return 1;
+		}
+	}
+
+	UpdateCache();
+
+	int words = MaskWords(count);
+	memset(alarm_mask, 0, sizeof(unsigned long long) * (size_t)count * words);
+
+	//雷达开机或有告警器的飞机才计算方向余弦矩阵
+	Cnb_list.resize((size_t)count * 9);
+	sight_list.resize(count);
+	for (int k = 0; k < count; k++) {
+		if (radar_type[k] >= 0 || alarm_type[k] >= 0) {
+			StateMatrix((double(*)[3])&Cnb_list[(size_t)k * 9], aircraft, k);
+		}
+		sight_list[k] = sqrt(aircraft->position[1][k]);
+	}
+
+	AlarmBatchStats_T count_total = { 0, 0, 0, 0, 0, 0, 0 };
+	const double* const* position = aircraft->position;
+
+	for (int j = 0; j < count; j++) {
+		int a = alarm_type[j];
+		if (a < 0) {
+			continue;
+		}
+		const AlarmModel_C* alarm = alarm_models[a];
+		const double* alarm_Cnb = &Cnb_list[(size_t)j * 9];
+		double alarm_position[3] = { position[0][j], position[1][j], position[2][j] };
+		unsigned long long* row = alarm_mask + (size_t)j * words;
+
+		for (int i = 0; i < count; i++) {
+			int r = radar_type[i];
+			if (r < 0 || i == j) {
+				continue;
+			}
+			count_total.pair_count++;
+
+			//频段
+			const PairCache_T& pc = pair_cache[(size_t)r * alarm_type_count + a];
+			if (!pc.in_band) {
+				count_total.band_culled++;
+				continue;
+			}
+
+			//最大探测距离的上界
+			double Vn[3] = { position[0][i] - alarm_position[0], position[1][i] - alarm_position[1], position[2][i] - alarm_position[2] };
+			double distance2 = Vn[0] * Vn[0] + Vn[1] * Vn[1] + Vn[2] * Vn[2];
+			if (distance2 > pc.range2_max) {
+				count_total.range_culled++;
+				continue;
+			}
+
+			//视距，与 Alarm() 相同：sight 为 NaN(高度为负)时不剔除
+			double distance = sqrt(distance2);
+			double sight = sight_factor * (sight_list[i] + sight_list[j]);
+			if (sight < distance) {
+				count_total.sight_culled++;
+				continue;
+			}
+
+			//告警器接收范围
+			double Vb[3];
+			BodyVector(Vb, alarm_Cnb, Vn);
+			if (!alarm->InCone(Vb)) {
+				count_total.cone_culled++;
+				continue;
+			}
+
+			//雷达扫描范围，留余量，只剔除增益一定为0的飞机对
+			const double* radar_Cnb = &Cnb_list[(size_t)i * 9];
+			const RadarCache_T& rc = radar_cache[r];
+			double Vr[3];
+			BodyVector(Vr, radar_Cnb, Vn);
+			Vr[0] = -Vr[0];
+			Vr[1] = -Vr[1];
+			Vr[2] = -Vr[2];
+			double horizontal = sqrt(Vr[0] * Vr[0] + Vr[2] * Vr[2]);
+			double margin = cull_margin * distance;
+			if (Vr[0] < rc.cos_azimuth * horizontal - margin ||
+				(rc.tan_pitch >= 0 && fabs(Vr[1]) > rc.tan_pitch * horizontal + margin)) {
+				count_total.cone_culled++;
+				continue;
+			}
+
+			//雷达天线在告警器方向的增益，距离平方与 Rmax^2 比较
+			const RadarModel_C* radar = radar_models[r];
+			double radar_position[3] = { position[0][i], position[1][i], position[2][i] };
+			double azimuth_target_to_radar = 0, pitch_target_to_radar = 0;
+			getBodyAzimuthPitch(&azimuth_target_to_radar, &pitch_target_to_radar, (const double(*)[3])radar_Cnb,
+				radar_position, alarm_position);
+			double AntennaGain = radar->AntennaGain(azimuth_target_to_radar, pitch_target_to_radar);
+			count_total.evaluated++;
+			if (AntennaGain > 0 && distance2 <= pc.range_scale * AntennaGain) {
+				row[i / ALARM_MASK_BITS] |= 1ULL << (i % ALARM_MASK_BITS);
+				count_total.alarmed++;
+			}
+		}
+	}
+
+	if (stats != NULL) {
+		*stats = count_total;
+	}
+
+	return 0;
+}
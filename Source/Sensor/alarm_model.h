@@ -0,0 +1,261 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           alarm_model.h
+*   @brief          雷达告警器模型及批量告警计算。
+*   @details        AlarmModel_C 保存一种告警器的参数，AlarmBatch_C 对一组飞机计算每部开机雷达照射到哪些飞机的告警器。
+*                   Alarm() 中告警器最大探测距离 Rmax=sqrt(Pt*Gt*G*Lambda^2/((4pi)^2*P*Ltx*Lp))，除辐射源天线增益 Gt 外
+*                   只与雷达、告警器的参数有关，因此按(雷达型号，告警器型号)缓存 Rmax^2/Gt 和频段是否覆盖，
+*                   逐对只比较距离平方 R^2<=Rmax^2/Gt*Gt，免去开方；参数改变(序号改变)时才重新计算缓存。
+*                   告警器接收范围和雷达扫描范围用体轴投影与范围的余弦、正切限比较，免去反三角函数。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   LiDaiwei
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*/
+
+#ifndef ALARM_MODEL_H_INCLUDED
+#define ALARM_MODEL_H_INCLUDED
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           被使用的头文件。
+*   @{
+*/
+#include "radar_model.h"
+#include <vector>
+/** @}  */
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           告警掩码宏定义。
+*   @{
+*/
+#define ALARM_MASK_BITS 64               //每个掩码字的位数
+/** @}  */
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          告警器参数。
+*   @details        与 Alarm() 的告警器参数相同。
+*/
+struct AlarmParam_T
+{
+	double							P;								//!< 接收机灵敏度
+	double							G;								//!< 接收机天线增益
+	double							Ltx;							//!< 接收机传输损耗
+	double							Lp;								//!< 极化损失
+	double							f_min;							//!< 告警器接收机频率最小值
+	double							f_max;							//!< 告警器接收机频率最大值
+	double							azimuth_alarm_width;			//!< 接收机方位角范围
+	double							pitch_alarm_width;				//!< 接收机俯仰角范围
+};
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          批量告警统计。
+*   @details        每次调用重新计数，各级剔除数互不重叠。
+*/
+struct AlarmBatchStats_T
+{
+	long long						pair_count;						//!< 开机雷达与告警器的飞机对总数
+	long long						band_culled;					//!< 雷达频率不在告警器频段内
+	long long						range_culled;					//!< 超出告警器最大探测距离的上界
+	long long						sight_culled;					//!< 超出视距
+	long long						cone_culled;					//!< 超出告警器接收范围或雷达扫描范围
+	long long						evaluated;						//!< 计算天线增益的飞机对数
+	long long						alarmed;						//!< 告警的飞机对数
+};
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          告警器模型。
+*   @details        构造后只读，可在多个线程中同时使用。
+*/
+class AlarmModel_C
+{
+public:
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          创建告警器模型
+	*   @details        使用 Alarm_Initial 的默认参数
+	*/
+	AlarmModel_C();
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          创建告警器模型
+	*   @details        创建告警器模型
+	*   @param[in]      in_param        告警器参数
+	*/
+	explicit AlarmModel_C(const AlarmParam_T& in_param);
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          设置告警器参数
+	*   @details        重新计算全部常数
+	*   @param[in]      in_param        告警器参数
+	*   @retval         0               正常
+	*/
+	int SetParam(const AlarmParam_T& in_param);
+
+	const AlarmParam_T& Param() const { return param; }
+
+	//Alarm_Initial 的默认参数
+	static AlarmParam_T DefaultParam();
+
+	//参数序号，每次 SetParam 后改变，取自 RadarModel_C::NextSerial，不同对象的序号也不相同
+	unsigned int Serial() const { return serial; }
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          最大探测距离的平方与辐射源天线增益之比
+	*   @details        与 getAlarmMaxDistance 相同，Rmax^2=RangeScale*Gt
+	*   @param[in]      radar           辐射源雷达的参数
+	*   @retval         Rmax^2/Gt
+	*/
+	double RangeScale(const RadarParam_T& radar) const;
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          辐射源频率是否在告警器频段内
+	*   @details        频率为光速除以波长，与 Alarm() 相同
+	*   @param[in]      radar           辐射源雷达的参数
+	*   @retval         true            在频段内
+	*/
+	bool InBand(const RadarParam_T& radar) const;
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          辐射源是否在接收范围内
+	*   @details        Vb 为告警器机体坐标系内告警器到雷达的向量(前，上，右)，与 Alarm() 中比较探测角等价，
+	*                   接收范围边界上可能相差舍入误差；水平距离为0(雷达在正上方或正下方)时判为不在范围内，与 Alarm() 相同
+	*   @param[in]      Vb[3]           告警器到雷达的向量
+	*   @retval         true            在接收范围内
+	*/
+	bool InCone(const double Vb[3]) const
+	{
+		double horizontal2 = Vb[0] * Vb[0] + Vb[2] * Vb[2];
+		if (!(horizontal2 > 0)) {
+			return false;
+		}
+		//cos_azimuth>=0 时要求 Vb[0]>=0 且 Vb[0]^2>=cos^2*h^2，<0 时要求 Vb[0]>=0 或 Vb[0]^2<=cos^2*h^2
+		if (cos_azimuth > -1.0) {
+			double f2 = Vb[0] * Vb[0];
+			double c2 = cos_azimuth * cos_azimuth * horizontal2;
+			bool inside = (cos_azimuth >= 0) ? (Vb[0] >= 0 && f2 >= c2) : (Vb[0] >= 0 || f2 <= c2);
+			if (!inside) {
+				return false;
+			}
+		}
+		return tan_pitch < 0 || Vb[1] * Vb[1] <= tan_pitch * tan_pitch * horizontal2;
+	}
+
+private:
+	AlarmParam_T					param;
+
+	double							loss_scale;						//G/((4pi)^2*P*Ltx*Lp)
+	double							cos_azimuth;					//方位接收范围的余弦限，<=-1 表示不限
+	double							tan_pitch;						//俯仰接收范围的正切限，<0 表示不限
+
+	unsigned int					serial;
+};
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          批量告警计算。
+*   @details        保存雷达、告警器型号表和按型号对缓存的常数，Run 中修改缓存和临时数组，每个线程使用各自的对象。
+*                   型号表只保存指针，型号对象须在使用期间有效；其参数可随时修改，下次 Run 时按序号重新计算缓存。
+*/
+class AlarmBatch_C
+{
+public:
+	AlarmBatch_C();
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          设置雷达、告警器型号表
+	*   @details        清空全部缓存
+	*   @param[in]      in_radar_models      各雷达型号
+	*   @param[in]      in_radar_type_count  雷达型号数
+	*   @param[in]      in_alarm_models      各告警器型号
+	*   @param[in]      in_alarm_type_count  告警器型号数
+	*   @retval         0               正常
+	*   @retval         1               错误，型号表为空
+	*/
+	int SetTypes(
+		const RadarModel_C* const*		in_radar_models,
+		int								in_radar_type_count,
+		const AlarmModel_C* const*		in_alarm_models,
+		int								in_alarm_type_count);
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          批量告警
+	*   @details        同一组飞机既是辐射源也是告警器，第i架飞机的雷达照射到第j架飞机的告警器时，
+	*                   alarm_mask[j*MaskWords(N)+i/64] 的第 i%64 位置1，其余位清0。
+	*                   逐级剔除：频段(按型号对缓存)，距离平方与按天线增益上界算出的最大探测距离比较，视距，
+	*                   告警器接收范围，雷达扫描范围(留有余量)；其余飞机对计算雷达天线增益，比较距离平方。
+	*                   结果与逐对调用 Alarm() 相同，仅距离或角度恰在边界上时可能相差舍入误差
+	*   @param[out]     alarm_mask           告警掩码[N][MaskWords(N)]
+	*   @param[in]      aircraft             飞机状态，共N架，只使用位置、姿态或方向余弦矩阵
+	*   @param[in]      radar_type           各飞机的雷达型号下标，<0 表示雷达未开机
+	*   @param[in]      alarm_type           各飞机的告警器型号下标，<0 表示没有告警器
+	*   @param[out]     stats                剔除统计，可为 NULL
+	*   @retval         0               正常
+	*   @retval         1               错误，参数为空或型号下标超出型号表
+	*/
+	int Run(
+		unsigned long long*				alarm_mask,
+		const RadarBatchState_T*		aircraft,
+		const int*						radar_type,
+		const int*						alarm_type,
+		AlarmBatchStats_T*				stats = NULL);
+
+	//每架飞机的掩码字数
+	static int MaskWords(int count) { return (count + ALARM_MASK_BITS - 1) / ALARM_MASK_BITS; }
+
+	//第 emitter 架飞机的雷达是否照射到本机，row 为本机的掩码
+	static bool Illuminated(const unsigned long long* row, int emitter)
+	{
+		return ((row[emitter / ALARM_MASK_BITS] >> (emitter % ALARM_MASK_BITS)) & 1) != 0;
+	}
+
+private:
+	//按(雷达型号，告警器型号)缓存的常数
+	struct PairCache_T
+	{
+		unsigned int				radar_serial;					//计算缓存时的参数序号，0 表示未计算
+		unsigned int				alarm_serial;
+		bool						in_band;						//雷达频率在告警器频段内
+		double						range_scale;					//Rmax^2/Gt
+		double						range2_max;						//按天线增益上界算出的 Rmax^2，含余量
+	};
+
+	//按雷达型号缓存的扫描范围剔除限
+	struct RadarCache_T
+	{
+		unsigned int				serial;
+		double						cos_azimuth;
+		double						tan_pitch;
+	};
+
+	std::vector<const RadarModel_C*>	radar_models;
+	std::vector<const AlarmModel_C*>	alarm_models;
+	std::vector<PairCache_T>			pair_cache;					//[雷达型号][告警器型号]
+	std::vector<RadarCache_T>			radar_cache;
+
+	//每次 Run 的临时数组
+	std::vector<double>					Cnb_list;					//各飞机的方向余弦矩阵，按行存放
+	std::vector<double>					sight_list;					//各飞机高度的平方根
+
+	//按序号更新缓存
+	void UpdateCache();
+};
+
+#endif // ALARM_MODEL_H_INCLUDED
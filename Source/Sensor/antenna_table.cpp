@@ -0,0 +1,114 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           antenna_table.cpp
+*   @brief          天线方向图插值表。
+*   @details        天线方向图插值表。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   LiDaiwei
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*/
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           头文件。
+*   @{
+*/
+#include "antenna_table.h"
+#include "radar.h"
+#include <math.h>
+/** @}  */
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           插值表常数。
+*   @{
+*/
+#define ANTENNA_TABLE_MAX_SIZE 1000000                  //表长上限，防止间隔过小
+#define ANTENNA_TABLE_CHECK_POINTS 8                    //生成时每个区间与解析值比较的点数
+/** @}  */
+
+
+//增益系数的平方根
+static double SurfaceAmplitude(
+	double							theta,
+	double							k_main,
+	double							k_other)
+{
+	double f_surface = 0;
+	getSurfaceGain(&f_surface, theta, k_main, k_other);
+	return sqrt(f_surface);
+}
+
+
+AntennaTable_C::AntennaTable_C()
+{
+	inv_step = 0;
+	last_index = 0;
+	interp_type = ANTENNA_TABLE_LINEAR;
+	max_error = 0;
+	max_error_angle = 0;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          生成插值表
+*   @details        按 getSurfaceGain 取值，并在每个区间内取8个点与解析值比较，记录最大误差
+*   @param[in]      k_main          主瓣系数 4*log(sqrt(2)/theta_t^2)
+*   @param[in]      k_other         旁瓣系数 1.3916/sin(theta_b/2)
+*   @param[in]      max_theta       表覆盖的最大角度，单位：弧度
+*   @param[in]      resolution      角度间隔，单位：弧度
+*   @param[in]      interp          插值方式 ANTENNA_TABLE_LINEAR 或 ANTENNA_TABLE_CUBIC
+*   @retval         0               正常
+*   @retval         1               错误，参数无效
+*/
+int AntennaTable_C::Build(
+	double							k_main,
+	double							k_other,
+	double							max_theta,
+	double							resolution,
+	int								interp)
+{
+	if (!(resolution > 0) || !(max_theta >= 0) ||
+		(interp != ANTENNA_TABLE_LINEAR && interp != ANTENNA_TABLE_CUBIC)) {
+		return 1;
+	}
+	double interval = ceil(max_theta / resolution);
+	if (interval < 1) {
+		interval = 1;
+	}
+	if (interval > ANTENNA_TABLE_MAX_SIZE) {
+		return 1;
+	}
+
+	int n = (int)interval;
+	inv_step = 1.0 / resolution;
+	last_index = n;
+	interp_type = interp;
+
+	//value_list[k] 对应角度 (k-1)*resolution，k=0 处按对称取 -resolution
+	value_list.resize(n + 4);
+	for (int k = 0; k < n + 4; k++) {
+		value_list[k] = SurfaceAmplitude((k - 1) * resolution, k_main, k_other);
+	}
+
+	max_error = 0;
+	max_error_angle = 0;
+	for (int i = 0; i < n; i++) {
+		for (int s = 1; s < ANTENNA_TABLE_CHECK_POINTS; s++) {
+			double theta = (i + (double)s / ANTENNA_TABLE_CHECK_POINTS) * resolution;
+			double error = fabs(Value(theta) - SurfaceAmplitude(theta, k_main, k_other));
+			if (error > max_error) {
+				max_error = error;
+				max_error_angle = theta;
+			}
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,114 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           antenna_table.h
+*   @brief          天线方向图插值表。
+*   @details        按 getSurfaceGain 的解析方向图在等间隔角度上预先取值，探测时查表插值，免去 exp、sin、cos 和开方。
+*                   方向图关于0对称，表只存 0 ~ 最大角度；存的是增益系数的平方根，
+*                   两个平面相乘即为 getTargetAntennaGain 中的 sqrt(f_azimuth*f_pitch)。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   LiDaiwei
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*/
+
+#ifndef ANTENNA_TABLE_H_INCLUDED
+#define ANTENNA_TABLE_H_INCLUDED
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           被使用的头文件。
+*   @{
+*/
+#include <vector>
+/** @}  */
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           插值方式宏定义。
+*   @{
+*/
+#define ANTENNA_TABLE_LINEAR 0           //线性插值
+#define ANTENNA_TABLE_CUBIC 1            //三次插值(Catmull-Rom)
+/** @}  */
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          天线方向图插值表。
+*   @details        创建后只读，可在多个线程中同时查表。
+*/
+class AntennaTable_C
+{
+public:
+	AntennaTable_C();
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          生成插值表
+	*   @details        按 getSurfaceGain 取值，并在每个区间内取8个点与解析值比较，记录最大误差
+	*   @param[in]      k_main          主瓣系数 4*log(sqrt(2)/theta_t^2)
+	*   @param[in]      k_other         旁瓣系数 1.3916/sin(theta_b/2)
+	*   @param[in]      max_theta       表覆盖的最大角度，单位：弧度
+	*   @param[in]      resolution      角度间隔，单位：弧度
+	*   @param[in]      interp          插值方式 ANTENNA_TABLE_LINEAR 或 ANTENNA_TABLE_CUBIC
+	*   @retval         0               正常
+	*   @retval         1               错误，参数无效
+	*/
+	int Build(
+		double							k_main,
+		double							k_other,
+		double							max_theta,
+		double							resolution,
+		int								interp);
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          查表
+	*   @details        超出表范围的角度按最大角度取值，调用方应先按扫描范围剔除
+	*   @param[in]      theta           探测角，单位：弧度
+	*   @retval         增益系数的平方根 sqrt(f_surface)
+	*/
+	double Value(double theta) const
+	{
+		double t = ((theta >= 0) ? theta : -theta) * inv_step;
+		if (!(t < last_index)) {
+			t = last_index;
+		}
+		int i = (int)t;
+		double u = t - i;
+		//value_list[i+1] 对应角度 i*step，两端各多存一个点
+		const double* p = &value_list[i];
+		if (interp_type == ANTENNA_TABLE_LINEAR) {
+			return p[1] + (p[2] - p[1]) * u;
+		}
+		double a = p[1];
+		double b = 0.5 * (p[2] - p[0]);
+		double c = p[0] - 2.5 * p[1] + 2.0 * p[2] - 0.5 * p[3];
+		double d = 0.5 * (p[3] - p[0]) + 1.5 * (p[1] - p[2]);
+		return a + u * (b + u * (c + u * d));
+	}
+
+	bool Empty() const { return value_list.empty(); }
+
+	//生成时测得的插值误差(绝对误差，方向图最大值约为1)
+	double MaxError() const { return max_error; }
+	double MaxErrorAngle() const { return max_error_angle; }
+
+	int Size() const { return (int)value_list.size(); }
+
+private:
+	std::vector<double>				value_list;
+	double							inv_step;
+	double							last_index;						//最后一个区间的右端点，以区间数计
+	int								interp_type;
+
+	double							max_error;
+	double							max_error_angle;
+};
+
+#endif // ANTENNA_TABLE_H_INCLUDED
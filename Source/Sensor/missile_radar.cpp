@@ -5,11 +5,12 @@
 *   @details        雷达及全向雷达告警器功能仿真。
 *   @author         LiDaiwei
 *   @date           20191113
-*   @version        1.0.0.1
+*   @version        1.0.0.2
 *   @par Copyright
 *                   LiDaiwei
 *   @par History
 *                   1.0.0.1: LiDaiwei, 20191113, 首次创建
+*                   1.0.0.2: agent, 20261018, 参数取自 RadarModel_C::MissileParam
 
 */
 
@@ -19,6 +20,7 @@
 *   @{
 */
 #include "missile_radar.h"
+#include "radar_model.h"
 
 /** @}  */
 
@@ -55,19 +57,15 @@ int Missile_Radar_Initial(
 	double* azimuth_radar_width,
 	double* pitch_radar_width)
 {
-//	srand((unsigned)time(NULL));//设定随机数种子
-	//设置各个参数：
-	*lambda=0.03;
-	*Pgt=100;
-	*nG=0.8;
-	*Gmax=25000;
-	*theta_t=1.0;
-	*theta_b=3.14;
-	*Lr=0.9;
-//	*Br=5E6;
-//	*Nf=0.001;
-	*azimuth_radar_width=1;
-	*pitch_radar_width=1;
-
+	RadarParam_T param=RadarModel_C::MissileParam();
+	*lambda=param.lambda;
+	*Pgt=param.Pgt;
+	*nG=param.nG;
+	*Gmax=param.Gmax;
+	*theta_t=param.theta_t;
+	*theta_b=param.theta_b;
+	*Lr=param.Lr;
+	*azimuth_radar_width=param.azimuth_radar_width;
+	*pitch_radar_width=param.pitch_radar_width;
 	return 0;
 }
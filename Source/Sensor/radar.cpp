@@ -5,12 +5,15 @@
 *   @details        雷达及全向雷达告警器功能仿真。
 *   @author         LiDaiwei
 *   @date           20191102
-*   @version        1.0.0.2
+*   @version        1.0.0.5
 *   @par Copyright
 *                   LiDaiwei
 *   @par History
 *                   1.0.0.1: LiDaiwei, 20191102, 首次创建
 *                   1.0.0.2: LiDaiwei, 20191113, 删除接收机噪声环节，免去随机干扰
+*                   1.0.0.3: agent, 20261018, 修正雷达姿态角下标越界，方向余弦矩阵单独计算
+*                   1.0.0.4: agent, 20261018, 雷达探测改为 RadarModel_C 的包装
+*                   1.0.0.5: agent, 20261018, 方向余弦矩阵可由飞行模型的姿态四元数直接算出
 
 */
 
@@ -20,7 +23,8 @@
 *   @{
 */
 #include "radar.h"
-#include "tool_function.h"
+#include "radar_model.h"
+#include "../Tools/tool_function.h"
 //#include <stdlib.h>
 //#include <time.h>
 
@@ -59,19 +63,16 @@ int Radar_Initial(
 	double* azimuth_radar_width,
 	double* pitch_radar_width)
 {
-//	srand((unsigned)time(NULL));//设定随机数种子
-	//设置各个参数：
-	*lambda=0.03;
-	*Pgt=20000;
-	*nG=0.8;
-	*Gmax=25000;
-	*theta_t=1.0;
-	*theta_b=3.14;
-	*Lr=0.9;
-//	*Br=5E6;
-//	*Nf=0.001;
-	*azimuth_radar_width=2.5;
-	*pitch_radar_width=2.5;
+	RadarParam_T param=RadarModel_C::AircraftParam();
+	*lambda=param.lambda;
+	*Pgt=param.Pgt;
+	*nG=param.nG;
+	*Gmax=param.Gmax;
+	*theta_t=param.theta_t;
+	*theta_b=param.theta_b;
+	*Lr=param.Lr;
+	*azimuth_radar_width=param.azimuth_radar_width;
+	*pitch_radar_width=param.pitch_radar_width;
 
 	return 0;
 }
@@ -161,19 +162,102 @@ int getTargetAzimuthPitch(
 	const double attitudeA[3],///*弧度*/
 	const double positionB[3])
 {
-	//在导航坐标系（n系）内A到B的方向向量
-	double Vban[3]={positionB[0]-positionA[0],positionB[1]-positionA[1],positionB[2]-positionA[2]};
+	double Cnb[3][3];
+	getAttitudeMatrix(Cnb,attitudeA);
+	getBodyAzimuthPitch(azimuth,pitch,Cnb,positionA,positionB);
+	return 0;
+}
 
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          计算A机的方向余弦矩阵。
+*   @details        计算A机的方向余弦矩阵，同一架飞机对多个目标时只需计算一次。
+*   @param[out]     Cnb[3][3]              导航坐标系到A机载体坐标系的方向余弦矩阵
+*   @param[in]      attitudeA[3]           A飞机的三个欧拉角姿态(x,y,z-滚转，偏航，俯仰)
+*   @retval         0               正常
+*   @retval         1               错误
+*/
+int getAttitudeMatrix(
+	double Cnb[3][3],
+	const double attitudeA[3])
+{
 	//方向余弦矩阵的算子
 	double c1=cos(attitudeA[1]),s1=sin(attitudeA[1]);
 	double c2=cos(attitudeA[2]),s2=sin(attitudeA[2]);
 	double c3=cos(attitudeA[0]),s3=sin(attitudeA[0]);
 	//方向余弦矩阵
-	double Cnb[3][3];
 	Cnb[0][0]=c1*c2;	Cnb[0][1]=s1*s3-c1*c3*s2;	Cnb[0][2]=c3*s1+c1*s2*s3;
 	Cnb[1][0]=s2;		Cnb[1][1]=c2*c3;		Cnb[1][2]=-c2*s3;
 	Cnb[2][0]=-c2*s1;	Cnb[2][1]=c1*s3+c3*s1*s2;	Cnb[2][2]=c1*c3-s1*s2*s3;
 
+	return 0;
+}
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          由姿态四元数计算A机的方向余弦矩阵。
+*   @details        q 为飞行模型中从载体系(前右下)到导航系(北东地)的转动四元数，即 craft_state.row(2)，
+*                   结果为雷达所用的导航系(北天东)到载体系(前上右)的方向余弦矩阵，与 getAttitudeMatrix 的输出含义相同。
+*                   只做乘加，不调用三角函数；四元数未归一化时按模的平方缩放。
+*                   对应的雷达位置为(北，天，东)=(x，-z，y)，x、y、z 为飞行模型的北东地位置。
+*   @param[out]     Cnb[3][3]              导航坐标系到A机载体坐标系的方向余弦矩阵
+*   @param[in]      q[4]                   从载体系到导航系的转动四元数(q0 为标量部分)
+*   @retval         0               正常
+*   @retval         1               错误，四元数为0
+*/
+int getQuaternionMatrix(
+	double Cnb[3][3],
+	const double q[4])
+{
+	double n=q[0]*q[0]+q[1]*q[1]+q[2]*q[2]+q[3]*q[3];
+	if(n==0)
+		return 1;
+	double k=1.0/n;
+
+	//载体系到导航系的旋转矩阵 Rbn，与 quaternion_to_rotation 相同
+	double Rbn[3][3];
+	Rbn[0][0]=q[0]*q[0]+q[1]*q[1]-q[2]*q[2]-q[3]*q[3];
+	Rbn[0][1]=2*(q[1]*q[2]-q[0]*q[3]);
+	Rbn[0][2]=2*(q[1]*q[3]+q[0]*q[2]);
+	Rbn[1][0]=2*(q[1]*q[2]+q[0]*q[3]);
+	Rbn[1][1]=q[0]*q[0]-q[1]*q[1]+q[2]*q[2]-q[3]*q[3];
+	Rbn[1][2]=2*(q[2]*q[3]-q[0]*q[1]);
+	Rbn[2][0]=2*(q[1]*q[3]-q[0]*q[2]);
+	Rbn[2][1]=2*(q[2]*q[3]+q[0]*q[1]);
+	Rbn[2][2]=q[0]*q[0]-q[1]*q[1]-q[2]*q[2]+q[3]*q[3];
+
+	//北东地->北天东、前右下->前上右：第i轴取原来的第axis[i]轴，乘 sign[i]
+	static const int axis[3]={0,2,1};
+	static const double sign[3]={1,-1,1};
+	for(int i=0;i<3;i++)
+		for(int j=0;j<3;j++)
+			Cnb[i][j]=k*sign[i]*sign[j]*Rbn[axis[j]][axis[i]];
+
+	return 0;
+}
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          由方向余弦矩阵计算B机相对A机的探测方位角及俯仰角。
+*   @details        由方向余弦矩阵计算B机相对A机的探测方位角及俯仰角。
+*   @param[out]     azimuth                B机相对A机的探测方位角
+*   @param[out]     Pitch                  B机相对A机的探测俯仰角
+*   @param[in]      Cnb[3][3]              A机的方向余弦矩阵
+*   @param[in]      positionA[3]           A飞机的三维位置坐标(x,y,z)
+*   @param[in]      positionB[3]           B飞机的三维位置坐标(x,y,z)
+*   @retval         0               正常
+*   @retval         1               错误
+*/
+int getBodyAzimuthPitch(
+	double* azimuth,
+	double* pitch,
+	const double Cnb[3][3],
+	const double positionA[3],
+	const double positionB[3])
+{
+	//在导航坐标系（n系）内A到B的方向向量
+	double Vban[3]={positionB[0]-positionA[0],positionB[1]-positionA[1],positionB[2]-positionA[2]};
+
 	//在A机载体坐标系（b系）内A到B的方向向量
 	double Vbab[3];
 	Vbab[0]=Cnb[0][0]*Vban[0]+Cnb[0][1]*Vban[1]+Cnb[0][2]*Vban[2];
@@ -239,8 +323,8 @@ int getTargetRCS (
 	S2=(pitch<0)?Syn:Syp;
 	S3=Sz;
 
-	*RCS = S1*(1-sqrt(abs(sin(pitch))))*(1-sqrt(abs(sin(azimuth))))+S2*abs(sin(pitch))+
-		S3*(1-sqrt(abs(sin(pitch))))*abs(sin(azimuth));
+	*RCS = S1*(1-sqrt(fabs(sin(pitch))))*(1-sqrt(fabs(sin(azimuth))))+S2*fabs(sin(pitch))+
+		S3*(1-sqrt(fabs(sin(pitch))))*fabs(sin(azimuth));
 
 	return 0;
 }
@@ -262,23 +346,42 @@ double G_AntennaGain_surface_P(
 	const double theta_t,
 	const double theta_b)
 {
+	//主瓣、主瓣以外的系数
+	double k_main=4*log(sqrt(2)/(theta_t*theta_t));
+	double k_other=1.3916/(sin(0.5*theta_b));
+	getSurfaceGain(f_surface,theta,k_main,k_other);
 
+	return 0;
+}
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          按方向图系数计算某一个角度的天线增益。
+*   @details        G_AntennaGain_surface_P 中与角度有关的部分，系数可预先算好。
+*   @param[out]     f_surface                    平面某一个角度的天线增益系数
+*   @param[in]      theta                        目标相对雷达的探测角
+*   @param[in]      k_main                       主瓣系数 4*log(sqrt(2)/theta_t^2)
+*   @param[in]      k_other                      旁瓣系数 1.3916/sin(theta_b/2)
+*   @retval         0               正常
+*   @retval         1               错误
+*/
+int getSurfaceGain(
+	double* f_surface,
+	const double theta,
+	const double k_main,
+	const double k_other)
+{
 	//主瓣
-	double k_main=4*log(sqrt(2)/(theta_t*theta_t));
 	double f_main=exp(-k_main*theta*theta);
 	//主瓣以外
-	double k_other=1.3916/(sin(0.5*theta_b));
 	double f_other=0;
-	if(sin(theta)==0)
+	double sin_theta=sin(theta);
+	if(sin_theta==0)
 		f_other=0;
 	else
+		f_other=((1+cos(theta))/2)*(sin(k_other*sin_theta)/(k_other*sin_theta));
 
-		f_other=((1+cos(theta))/2)*(sin(k_other*sin(theta))/(k_other*sin(theta)));
-
-	double f=(f_main>=f_other)?f_main:f_other;
-	*f_surface = f;
-
-
+	*f_surface=(f_main>=f_other)?f_main:f_other;
 
 	return 0;
 }
@@ -492,6 +595,55 @@ int getTargetEchoPower(
 //}
 
 
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          计算雷达对某一RCS目标的最大探测距离。
+*   @details        getTargetEchoPower 的反函数，增益取波束范围内的上界，回波功率取 RADAR_DETECT_THRESHOLD。
+*                   目标距离大于该值时回波功率一定低于门限，不必计算角度、增益和RCS。
+*   @param[out]     Rmax                            最大探测距离
+*   @param[in]      Sigima                          目标RCS上界，取5个典型值的最大值
+*   @param[in]      Lambda                          雷达工作波长
+*   @param[in]      Pgt                             雷达发射功率
+*   @param[in]      nG                              天线效率
+*   @param[in]      Gmax                            天线最大增益
+*   @param[in]      theta_t                         主瓣波束宽度
+*   @param[in]      Lr                              雷达综合损耗Lr
+*   @param[in]      azimuth_radar_width             雷达扫描方位角范围
+*   @param[in]      pitch_radar_width               雷达扫描俯仰角范围
+*   @retval         0               正常
+*   @retval         1               错误
+*/
+int getMaxDetectRange(
+	double* Rmax,
+	const double Sigima,
+	const double Lambda,
+	const double Pgt,
+	const double nG,
+	const double Gmax,
+	const double theta_t,
+	const double Lr,
+	const double azimuth_radar_width,
+	const double pitch_radar_width)
+{
+	//单个平面的天线增益系数：旁瓣不超过1，主瓣 exp(-k*theta^2) 在 k<0 时于波束边缘最大
+	double k_main=4*log(sqrt(2)/(theta_t*theta_t));
+	double half_azimuth=(azimuth_radar_width/2.0<M_PI)?azimuth_radar_width/2.0:M_PI;
+	double half_pitch=(pitch_radar_width/2.0<M_PI/2)?pitch_radar_width/2.0:M_PI/2;
+	double f_azimuth=(k_main>=0)?1.0:exp(-k_main*half_azimuth*half_azimuth);
+	double f_pitch=(k_main>=0)?1.0:exp(-k_main*half_pitch*half_pitch);
+	if(f_azimuth<1.0)
+		f_azimuth=1.0;
+	if(f_pitch<1.0)
+		f_pitch=1.0;
+
+	//增益平方的上界，与 getTargetAntennaGain 相同
+	double G2=nG*Gmax*nG*Gmax*f_azimuth*f_pitch;
+
+	//回波功率等于门限时的距离
+	*Rmax=pow(Pgt*G2*Sigima*Lambda*Lambda*Lr/(pow(4*M_PI,3)*RADAR_DETECT_THRESHOLD),0.25);
+	return 0;
+}
+
 // --------------------------------------------------------------------------------------------------------------------------------
 /**
 *   @brief          判断并确认是否发现目标。
@@ -517,7 +669,7 @@ int confirmTarget(
 //		else
 //			*finded = false;
 
-	if (Pgr<2e-016)//
+	if (Pgr<RADAR_DETECT_THRESHOLD)//
 		*finded=false;
 	else
 		*finded=true;
@@ -610,10 +762,59 @@ int confirmAlarm(
 	return 0;
 }
 
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          雷达对单个目标的探测。
+*   @details        RadarModel_C::Detect 的包装。
+*   @param[out]     findedTarget         是or否发现目标
+*   @param[out]     Pgr                  目标回波功率
+*   @param[in]      RadarPosition[3]     雷达机的三维位置坐标(北，天，东)
+*   @param[in]      RadarCnb[3][3]       雷达机的方向余弦矩阵
+*   @param[in]      TargetPosition[3]    目标机的三维位置坐标(北，天，东)
+*   @param[in]      TargetCnb[3][3]      目标机的方向余弦矩阵
+*   @param[in]      SigimaType[5]        目标的5个RCS典型值(+x,-x,+y,-z,z)
+*   @param[in]      Lambda               雷达工作波长
+*   @param[in]      Pgt                  雷达发射功率
+*   @param[in]      nG                   天线效率
+*   @param[in]      Gmax                 天线最大增益
+*   @param[in]      theta_t              主瓣波束宽度
+*   @param[in]      theta_b              单程半功率点波束宽度
+*   @param[in]      Lr                   雷达综合损耗Lr
+*   @param[in]      azimuth_radar_width  雷达扫描方位角范围
+*   @param[in]      pitch_radar_width    雷达扫描俯仰角范围
+*   @retval         0               正常
+*   @retval         1               错误
+*/
+int RadarDetect(
+	bool* findedTarget,
+	double* Pgr,
+	const double RadarPosition[3],
+	const double RadarCnb[3][3],
+	const double TargetPosition[3],
+	const double TargetCnb[3][3],
+	const double SigimaType[5],
+	const double Lambda,
+	const double Pgt,
+	const double nG,
+	const double Gmax,
+	const double theta_t,
+	const double theta_b,
+	const double Lr,
+	const double azimuth_radar_width,
+	const double pitch_radar_width)
+{
+	RadarParam_T param={Lambda,Pgt,nG,Gmax,theta_t,theta_b,Lr,azimuth_radar_width,pitch_radar_width};
+	RadarModel_C model(param);
+	model.Detect(findedTarget,Pgr,RadarPosition,RadarCnb,TargetPosition,TargetCnb,SigimaType);
+
+	return 0;
+}
+
+
 // --------------------------------------------------------------------------------------------------------------------------------
 /**
 *   @brief          雷达功能综合函数。
-*   @details        雷达功能综合函数。
+*   @details        RadarModel_C::Detect 的包装，多次探测时应直接使用 RadarModel_C，免去每次计算常数。
 *   @param[out]     findedTarget         是or否发现目标
 *   @param[out]     Pgr                  目标回波功率
 *   @param[in]      positionRadar[3]     雷达机的三维位置坐标(x,y,z)
@@ -655,72 +856,9 @@ int Radar(
 	const double azimuth_radar_width,
 	const double pitch_radar_width)
 {
-	//重定义坐标和姿态角的坐标轴方向：
-	//定义导航坐标xyz轴分别对应北天东方向，定义机体坐标系xyz轴分别对应前上右方向
-	//如果和输入量定义不同在下方更改
-	double RadarPosition[3];
-	RadarPosition[0]=positionRadar[0];
-	RadarPosition[1]=positionRadar[1];
-	RadarPosition[2]=positionRadar[2];
-
-	double RadarAttitude[3];
-	RadarAttitude[0]=attitudeRadar[0];
-	RadarAttitude[2]=attitudeRadar[1];
-	RadarAttitude[3]=attitudeRadar[2];
-
-	double TargetPosition[3];
-	TargetPosition[0]=positionTarget[0];
-	TargetPosition[1]=positionTarget[1];
-	TargetPosition[2]=positionTarget[2];
-
-	double TargetAttitude[3];
-	TargetAttitude[0]=attitudeTarget[0];
-	TargetAttitude[1]=attitudeTarget[2];
-	TargetAttitude[2]=attitudeTarget[1];
-
-
-	//计算两机距离
-	double distance=0;
-	getDistance(&distance,RadarPosition,TargetPosition);
-
-	//计算目标相对雷达的探测角
-	double azimuth_target_to_radar=0,pitch_target_to_radar=0;
-	getTargetAzimuthPitch(&azimuth_target_to_radar,&pitch_target_to_radar,RadarPosition,RadarAttitude,TargetPosition);
-//	cout<<rad2deg(azimuth_target_to_radar)<<"____"<<rad2deg(pitch_target_to_radar)<<"___"<<endl;
-	//计算雷达相对目标的探测角
-	double azimuth_radar_to_target=0,pitch_radar_to_target=0;
-	getTargetAzimuthPitch(&azimuth_radar_to_target,&pitch_radar_to_target,TargetPosition,TargetAttitude,RadarPosition);
-
-	//判断视距
-	double sight=0;
-	getRadarSight(&sight,RadarPosition[1],TargetPosition[1]);
-	if(sight<distance)
-		*findedTarget = false;
-	else{
-		//计算天线增益
-		double AntennaGain=0;
-		getTargetAntennaGain(&AntennaGain,azimuth_target_to_radar,pitch_target_to_radar,
-					nG,theta_t,theta_b,Gmax,azimuth_radar_width,pitch_radar_width);
-
-		//计算目标RCS
-		double TargetRCS=0;
-		getTargetRCS(&TargetRCS,azimuth_radar_to_target,pitch_radar_to_target,SigimaType);
-
-		//计算雷达回波功率
-		double EchoPower=0;
-		getTargetEchoPower(&EchoPower,Pgt,AntennaGain,TargetRCS,Lambda,distance,Lr);
-		*Pgr = EchoPower;
-//		//计算接收机噪声
-//		double Noise=0;
-//		getReceivingNoise(&Noise,Br,Nf);
-
-//		//计算接收机综合信噪比
-//		double SNt=0;
-//		getSignalNoiseRatio(&SNt,EchoPower,Noise,0,0);
-//
-//		getPd(Pd,SNt);
-		confirmTarget(findedTarget,EchoPower);
-	}
+	RadarParam_T param={Lambda,Pgt,nG,Gmax,theta_t,theta_b,Lr,azimuth_radar_width,pitch_radar_width};
+	RadarModel_C model(param);
+	model.Detect(findedTarget,Pgr,positionRadar,attitudeRadar,positionTarget,attitudeTarget,SigimaType);
 
 	return 0;
 }
@@ -787,8 +925,8 @@ int Alarm(
 
 	double RadarAttitude[3];
 	RadarAttitude[0]=attitudeRadar[0];
+	RadarAttitude[1]=attitudeRadar[2];
 	RadarAttitude[2]=attitudeRadar[1];
-	RadarAttitude[3]=attitudeRadar[2];
 
 	double TargetPosition[3];
 	TargetPosition[0]=positionTarget[0];
@@ -5,12 +5,15 @@
 *   @details        雷达及全向雷达告警器功能仿真。
 *   @author         LiDaiwei
 *   @date           20191102
-*   @version        1.0.0.2
+*   @version        1.0.0.5
 *   @par Copyright
 *                   LiDaiwei
 *   @par History
 *                   1.0.0.1: LiDaiwei, 20191102, 首次创建
 *                   1.0.0.2: LiDaiwei, 20191113, 删除接收机噪声环节，免去随机干扰
+*                   1.0.0.3: agent, 20261018, 修正雷达姿态角下标越界，方向余弦矩阵单独计算
+*                   1.0.0.4: agent, 20261018, 雷达探测改为 RadarModel_C 的包装
+*                   1.0.0.5: agent, 20261018, 方向余弦矩阵可由飞行模型的姿态四元数直接算出
 
 */
 
@@ -20,6 +23,15 @@
 #define RADAR_H_INCLUDED
 
 
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           雷达宏定义。
+*   @{
+*/
+#define RADAR_DETECT_THRESHOLD 2e-016       //发现目标的最小回波功率
+/** @}  */
+
+
 // --------------------------------------------------------------------------------------------------------------------------------
 /**
 *   @brief          初始化雷达功能函数。
@@ -110,6 +122,54 @@ int getTargetAzimuthPitch(
 	const double attitudeA[3],///*弧度*/
 	const double positionB[3]);
 
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          计算A机的方向余弦矩阵。
+*   @details        计算A机的方向余弦矩阵，同一架飞机对多个目标时只需计算一次。
+*   @param[out]     Cnb[3][3]              导航坐标系到A机载体坐标系的方向余弦矩阵
+*   @param[in]      attitudeA[3]           A飞机的三个欧拉角姿态(x,y,z-滚转，偏航，俯仰)
+*   @retval         0               正常
+*   @retval         1               错误
+*/
+int getAttitudeMatrix(
+	double Cnb[3][3],
+	const double attitudeA[3]);
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          由姿态四元数计算A机的方向余弦矩阵。
+*   @details        q 为飞行模型中从载体系(前右下)到导航系(北东地)的转动四元数，即 craft_state.row(2)，
+*                   结果为雷达所用的导航系(北天东)到载体系(前上右)的方向余弦矩阵，与 getAttitudeMatrix 的输出含义相同。
+*                   只做乘加，不调用三角函数；四元数未归一化时按模的平方缩放。
+*                   对应的雷达位置为(北，天，东)=(x，-z，y)，x、y、z 为飞行模型的北东地位置。
+*   @param[out]     Cnb[3][3]              导航坐标系到A机载体坐标系的方向余弦矩阵
+*   @param[in]      q[4]                   从载体系到导航系的转动四元数(q0 为标量部分)
+*   @retval         0               正常
+*   @retval         1               错误，四元数为0
+*/
+int getQuaternionMatrix(
+	double Cnb[3][3],
+	const double q[4]);
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          由方向余弦矩阵计算B机相对A机的探测方位角及俯仰角。
+*   @details        由方向余弦矩阵计算B机相对A机的探测方位角及俯仰角。
+*   @param[out]     azimuth                B机相对A机的探测方位角
+*   @param[out]     Pitch                  B机相对A机的探测俯仰角
+*   @param[in]      Cnb[3][3]              A机的方向余弦矩阵
+*   @param[in]      positionA[3]           A飞机的三维位置坐标(x,y,z)
+*   @param[in]      positionB[3]           B飞机的三维位置坐标(x,y,z)
+*   @retval         0               正常
+*   @retval         1               错误
+*/
+int getBodyAzimuthPitch(
+	double* azimuth,
+	double* pitch,
+	const double Cnb[3][3],
+	const double positionA[3],
+	const double positionB[3]);
+
 // --------------------------------------------------------------------------------------------------------------------------------
 /**
 *   @brief          计算两个飞机之间的雷达视距。
@@ -142,6 +202,23 @@ int getTargetRCS (
 	const double pitch_RadarToTarget,
 	const double SigimaType[5]);
 
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          按方向图系数计算某一个角度的天线增益。
+*   @details        G_AntennaGain_surface_P 中与角度有关的部分，系数可预先算好。
+*   @param[out]     f_surface                    平面某一个角度的天线增益系数
+*   @param[in]      theta                        目标相对雷达的探测角
+*   @param[in]      k_main                       主瓣系数 4*log(sqrt(2)/theta_t^2)
+*   @param[in]      k_other                      旁瓣系数 1.3916/sin(theta_b/2)
+*   @retval         0               正常
+*   @retval         1               错误
+*/
+int getSurfaceGain(
+	double* f_surface,
+	const double theta,
+	const double k_main,
+	const double k_other);
+
 // --------------------------------------------------------------------------------------------------------------------------------
 /**
 *   @brief          计算雷达发射天线在目标方位的增益。
@@ -240,6 +317,36 @@ int getTargetEchoPower(
 //	double* Pd_out,
 //	const double SNt);
 
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          计算雷达对某一RCS目标的最大探测距离。
+*   @details        getTargetEchoPower 的反函数，增益取波束范围内的上界，回波功率取 RADAR_DETECT_THRESHOLD。
+*                   目标距离大于该值时回波功率一定低于门限，不必计算角度、增益和RCS。
+*   @param[out]     Rmax                            最大探测距离
+*   @param[in]      Sigima                          目标RCS上界，取5个典型值的最大值
+*   @param[in]      Lambda                          雷达工作波长
+*   @param[in]      Pgt                             雷达发射功率
+*   @param[in]      nG                              天线效率
+*   @param[in]      Gmax                            天线最大增益
+*   @param[in]      theta_t                         主瓣波束宽度
+*   @param[in]      Lr                              雷达综合损耗Lr
+*   @param[in]      azimuth_radar_width             雷达扫描方位角范围
+*   @param[in]      pitch_radar_width               雷达扫描俯仰角范围
+*   @retval         0               正常
+*   @retval         1               错误
+*/
+int getMaxDetectRange(
+	double* Rmax,
+	const double Sigima,
+	const double Lambda,
+	const double Pgt,
+	const double nG,
+	const double Gmax,
+	const double theta_t,
+	const double Lr,
+	const double azimuth_radar_width,
+	const double pitch_radar_width);
+
 // --------------------------------------------------------------------------------------------------------------------------------
 /**
 *   @brief          判断并确认是否发现目标。
@@ -325,10 +432,51 @@ int confirmAlarm(
 	const double pitch_radar_min,
 	const double pitch_radar_max);
 
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          雷达对单个目标的探测。
+*   @details        RadarModel_C::Detect 的包装，多次探测时应直接使用 RadarModel_C，免去每次计算常数。
+*   @param[out]     findedTarget         是or否发现目标
+*   @param[out]     Pgr                  目标回波功率
+*   @param[in]      RadarPosition[3]     雷达机的三维位置坐标(北，天，东)
+*   @param[in]      RadarCnb[3][3]       雷达机的方向余弦矩阵
+*   @param[in]      TargetPosition[3]    目标机的三维位置坐标(北，天，东)
+*   @param[in]      TargetCnb[3][3]      目标机的方向余弦矩阵
+*   @param[in]      SigimaType[5]        目标的5个RCS典型值(+x,-x,+y,-z,z)
+*   @param[in]      Lambda               雷达工作波长
+*   @param[in]      Pgt                  雷达发射功率
+*   @param[in]      nG                   天线效率
+*   @param[in]      Gmax                 天线最大增益
+*   @param[in]      theta_t              主瓣波束宽度
+*   @param[in]      theta_b              单程半功率点波束宽度
+*   @param[in]      Lr                   雷达综合损耗Lr
+*   @param[in]      azimuth_radar_width  雷达扫描方位角范围
+*   @param[in]      pitch_radar_width    雷达扫描俯仰角范围
+*   @retval         0               正常
+*   @retval         1               错误
+*/
+int RadarDetect(
+	bool* findedTarget,
+	double* Pgr,
+	const double RadarPosition[3],
+	const double RadarCnb[3][3],
+	const double TargetPosition[3],
+	const double TargetCnb[3][3],
+	const double SigimaType[5],
+	const double Lambda,
+	const double Pgt,
+	const double nG,
+	const double Gmax,
+	const double theta_t,
+	const double theta_b,
+	const double Lr,
+	const double azimuth_radar_width,
+	const double pitch_radar_width);
+
 // --------------------------------------------------------------------------------------------------------------------------------
 /**
 *   @brief          雷达功能综合函数。
-*   @details        雷达功能综合函数。
+*   @details        RadarModel_C::Detect 的包装，多次探测时应直接使用 RadarModel_C，免去每次计算常数。
 *   @param[out]     findedTarget         是or否发现目标
 *   @param[out]     Pgr                  目标回波功率
 *   @param[in]      positionRadar[3]     雷达机的三维位置坐标(x,y,z)
@@ -0,0 +1,53 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           radar_batch.cpp
+*   @brief          多雷达对多目标的批量探测。
+*   @details        多雷达对多目标的批量探测。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.3
+*   @par Copyright
+*                   LiDaiwei
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*                   1.0.0.2: agent, 20261018, 增加最大探测距离剔除和剔除统计
+*                   1.0.0.3: agent, 20261018, 改为 RadarModel_C::DetectBatch 的包装
+*/
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           头文件。
+*   @{
+*/
+#include "radar_batch.h"
+/** @}  */
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          批量雷达探测。
+*   @details        RadarModel_C::DetectBatch 的包装。
+*   @param[out]     findedTarget         探测矩阵[N][M]
+*   @param[out]     Pgr                  回波功率矩阵[N][M]
+*   @param[in]      radars               雷达机状态，共N部
+*   @param[in]      targets              目标机状态，共M个
+*   @param[in]      param                雷达参数，所有雷达相同
+*   @param[out]     stats                剔除统计，可为 NULL
+*   @retval         0               正常
+*   @retval         1               错误，参数为空或目标缺少RCS
+*/
+int RadarBatch(
+	bool* findedTarget,
+	double* Pgr,
+	const RadarBatchState_T* radars,
+	const RadarBatchState_T* targets,
+	const RadarParam_T* param,
+	RadarBatchStats_T* stats)
+{
+	if (param == NULL) {
+		return 1;
+	}
+
+	RadarModel_C model(*param);
+	return model.DetectBatch(findedTarget, Pgr, radars, targets, stats);
+}
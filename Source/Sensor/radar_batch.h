@@ -0,0 +1,55 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           radar_batch.h
+*   @brief          多雷达对多目标的批量探测。
+*   @details        N部雷达对M个目标一次算出探测矩阵和回波功率矩阵，探测结果与逐对调用 Radar() 相同。
+*                   计算由 RadarModel_C::DetectBatch 完成，参数类型也在 radar_model.h 中。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.3
+*   @par Copyright
+*                   LiDaiwei
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*                   1.0.0.2: agent, 20261018, 增加最大探测距离剔除和剔除统计
+*                   1.0.0.3: agent, 20261018, 改为 RadarModel_C::DetectBatch 的包装
+*/
+
+#ifndef RADAR_BATCH_H_INCLUDED
+#define RADAR_BATCH_H_INCLUDED
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           被使用的头文件。
+*   @{
+*/
+#include "radar_model.h"
+/** @}  */
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          批量雷达探测。
+*   @details        RadarModel_C::DetectBatch 的包装，每次调用都重新计算雷达常数。
+*                   第i部雷达对第j个目标的结果写入 findedTarget[i*M+j]、Pgr[i*M+j]，M 为目标数。
+*                   发现的目标对 Pgr 与 Radar() 相同；被剔除的目标对 Pgr 写0(Radar() 不修改)。
+*                   雷达与目标位置重合时(如雷达与目标为同一组飞机时的对角线)判为未发现、Pgr 为0。
+*   @param[out]     findedTarget         探测矩阵[N][M]
+*   @param[out]     Pgr                  回波功率矩阵[N][M]
+*   @param[in]      radars               雷达机状态，共N部
+*   @param[in]      targets              目标机状态，共M个
+*   @param[in]      param                雷达参数，所有雷达相同
+*   @param[out]     stats                剔除统计，可为 NULL
+*   @retval         0               正常
+*   @retval         1               错误，参数为空或目标缺少RCS
+*/
+int RadarBatch(
+	bool* findedTarget,
+	double* Pgr,
+	const RadarBatchState_T* radars,
+	const RadarBatchState_T* targets,
+	const RadarParam_T* param,
+	RadarBatchStats_T* stats = NULL);
+
+#endif // RADAR_BATCH_H_INCLUDED
@@ -0,0 +1,737 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           radar_model.cpp
+*   @brief          雷达模型。
+*   @details        雷达模型。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.6
+*   @par Copyright
+*                   LiDaiwei
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*                   1.0.0.2: agent, 20261018, 增加天线方向图插值表
+*                   1.0.0.3: agent, 20261018, 目标RCS可取自RCS表
+*                   1.0.0.4: agent, 20261018, 飞机状态可直接给出方向余弦矩阵
+*                   1.0.0.5: agent, 20261018, 增加参数序号和天线增益上界，供告警器批量计算缓存
+*                   1.0.0.6: agent, 20261018, 批量探测可只计算波束扫过范围内的目标
+*/
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           头文件。
+*   @{
+*/
+#include "radar_model.h"
+#include "../Tools/tool_function.h"
+#include <string.h>
+#include <atomic>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RADAR_SSE2
+#include <emmintrin.h>
+#endif
+/** @}  */
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           雷达模型常数。
+*   @{
+*/
+#define RADAR_BATCH_BLOCK 64                            //每块目标数，块内目标的方向余弦矩阵放在栈上
+
+static const double sight_factor = 4120;                //与 getRadarSight 相同
+static const double cull_margin = 1e-9;                 //剔除余量，相对于距离，远大于两种算法的舍入误差
+static const double range_margin = 1e-6;                //最大探测距离的余量
+/** @}  */
+
+
+//一部雷达对一块目标的几何量
+struct CullInput_T
+{
+	const double*					Cnb;							//雷达方向余弦矩阵，按行存放
+	const double*					radar_position;					//雷达位置
+	double							radar_sight;					//雷达高度的平方根
+	const double*					x;								//目标位置三个分量
+	const double*					y;
+	const double*					z;
+	const double*					target_sight;					//目标高度的平方根
+	const double*					target_range2;					//对目标的最大探测距离的平方
+	double							cos_azimuth;					//波束范围剔除限，见 RadarModel_C
+	double							tan_pitch;
+};
+
+
+//一块目标的剔除结果
+struct CullCount_T
+{
+	int								range_culled;
+	int								sight_culled;
+	int								beam_culled;
+};
+
+
+//剔除单个目标，返回1表示需要逐对计算
+static int CullOne(
+	const CullInput_T&				in,
+	int								j,
+	CullCount_T*					cull_count)
+{
+	double vx = in.x[j] - in.radar_position[0];
+	double vy = in.y[j] - in.radar_position[1];
+	double vz = in.z[j] - in.radar_position[2];
+	double d2 = vx * vx + vy * vy + vz * vz;
+
+	//最大探测距离
+	if (d2 > in.target_range2[j]) {
+		cull_count->range_culled++;
+		return 0;
+	}
+
+	//视距：sight 为 NaN(高度为负)时不剔除
+	double distance = sqrt(d2);
+	double sight = sight_factor * (in.radar_sight + in.target_sight[j]);
+	if (distance > sight * (1.0 + cull_margin)) {
+		cull_count->sight_culled++;
+		return 0;
+	}
+
+	//波束范围
+	const double* C = in.Cnb;
+	double b0 = C[0] * vx + C[1] * vy + C[2] * vz;
+	double b1 = C[3] * vx + C[4] * vy + C[5] * vz;
+	double b2 = C[6] * vx + C[7] * vy + C[8] * vz;
+	double horizontal = sqrt(b0 * b0 + b2 * b2);
+	double margin = cull_margin * distance;
+
+	if (b0 < in.cos_azimuth * horizontal - margin ||
+		(in.tan_pitch >= 0 && fabs(b1) > in.tan_pitch * horizontal + margin)) {
+		cull_count->beam_culled++;
+		return 0;
+	}
+
+	return 1;
+}
+
+
+//剔除一块目标，返回需要逐对计算的目标下标
+static int CullBlock(
+	const CullInput_T&				in,
+	int								count,
+	int*							keep_list,
+	CullCount_T*					cull_count)
+{
+	int keep_count = 0;
+	int j = 0;
+
+#ifdef RADAR_SSE2
+	const double* C = in.Cnb;
+	__m128d rx = _mm_set1_pd(in.radar_position[0]);
+	__m128d ry = _mm_set1_pd(in.radar_position[1]);
+	__m128d rz = _mm_set1_pd(in.radar_position[2]);
+	__m128d rs = _mm_set1_pd(in.radar_sight);
+	__m128d factor = _mm_set1_pd(sight_factor);
+	__m128d sight_scale = _mm_set1_pd(1.0 + cull_margin);
+	__m128d margin_scale = _mm_set1_pd(cull_margin);
+	__m128d cos_azimuth = _mm_set1_pd(in.cos_azimuth);
+	__m128d tan_pitch = _mm_set1_pd(in.tan_pitch);
+	__m128d sign_mask = _mm_set1_pd(-0.0);
+	int pitch_cull = (in.tan_pitch >= 0);
+
+	for (; j + 2 <= count; j += 2) {
+		__m128d vx = _mm_sub_pd(_mm_loadu_pd(in.x + j), rx);
+		__m128d vy = _mm_sub_pd(_mm_loadu_pd(in.y + j), ry);
+		__m128d vz = _mm_sub_pd(_mm_loadu_pd(in.z + j), rz);
+		__m128d d2 = _mm_add_pd(_mm_add_pd(_mm_mul_pd(vx, vx), _mm_mul_pd(vy, vy)), _mm_mul_pd(vz, vz));
+
+		//最大探测距离，两个目标都超出时跳过其余各级
+		int range_mask = _mm_movemask_pd(_mm_cmpgt_pd(d2, _mm_loadu_pd(in.target_range2 + j)));
+		if (range_mask == 3) {
+			cull_count->range_culled += 2;
+			continue;
+		}
+
+		//视距，NaN 比较为假，与标量版本一样不剔除
+		__m128d distance = _mm_sqrt_pd(d2);
+		__m128d sight = _mm_mul_pd(factor, _mm_add_pd(rs, _mm_loadu_pd(in.target_sight + j)));
+		int sight_mask = _mm_movemask_pd(_mm_cmpgt_pd(distance, _mm_mul_pd(sight, sight_scale))) & ~range_mask;
+
+		//波束范围，前两级已全部剔除时不算
+		int beam_mask = 0;
+		if ((range_mask | sight_mask) != 3) {
+			__m128d b0 = _mm_add_pd(_mm_add_pd(_mm_mul_pd(_mm_set1_pd(C[0]), vx), _mm_mul_pd(_mm_set1_pd(C[1]), vy)), _mm_mul_pd(_mm_set1_pd(C[2]), vz));
+			__m128d b1 = _mm_add_pd(_mm_add_pd(_mm_mul_pd(_mm_set1_pd(C[3]), vx), _mm_mul_pd(_mm_set1_pd(C[4]), vy)), _mm_mul_pd(_mm_set1_pd(C[5]), vz));
+			__m128d b2 = _mm_add_pd(_mm_add_pd(_mm_mul_pd(_mm_set1_pd(C[6]), vx), _mm_mul_pd(_mm_set1_pd(C[7]), vy)), _mm_mul_pd(_mm_set1_pd(C[8]), vz));
+			__m128d horizontal = _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(b0, b0), _mm_mul_pd(b2, b2)));
+			__m128d margin = _mm_mul_pd(margin_scale, distance);
+
+			__m128d beam = _mm_cmplt_pd(b0, _mm_sub_pd(_mm_mul_pd(cos_azimuth, horizontal), margin));
+			if (pitch_cull) {
+				__m128d abs_b1 = _mm_andnot_pd(sign_mask, b1);
+				beam = _mm_or_pd(beam, _mm_cmpgt_pd(abs_b1, _mm_add_pd(_mm_mul_pd(tan_pitch, horizontal), margin)));
+			}
+			beam_mask = _mm_movemask_pd(beam) & ~(range_mask | sight_mask);
+		}
+
+		for (int lane = 0; lane < 2; lane++) {
+			int bit = 1 << lane;
+			if (range_mask & bit) {
+				cull_count->range_culled++;
+			}
+			else if (sight_mask & bit) {
+				cull_count->sight_culled++;
+			}
+			else if (beam_mask & bit) {
+				cull_count->beam_culled++;
+			}
+			else {
+				keep_list[keep_count++] = j + lane;
+			}
+		}
+	}
+#endif
+
+	for (; j < count; j++) {
+		if (CullOne(in, j, cull_count) != 0) {
+			keep_list[keep_count++] = j;
+		}
+	}
+
+	return keep_count;
+}
+
+
+//取给出的方向余弦矩阵，或按 Radar() 的坐标轴重定义取姿态计算
+static void StateMatrix(
+	double							Cnb[3][3],
+	const RadarBatchState_T*		state,
+	int								index)
+{
+	if (state->Cnb != NULL) {
+		memcpy(Cnb, state->Cnb[index], sizeof(double) * 9);
+		return;
+	}
+
+	double attitude[3];
+	attitude[0] = state->attitude[0][index];
+	attitude[1] = state->attitude[2][index];
+	attitude[2] = state->attitude[1][index];
+	getAttitudeMatrix(Cnb, attitude);
+}
+
+
+//全局参数序号，从1开始，0 表示未计算
+static std::atomic<unsigned int> serial_counter(0);
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          取新的参数序号
+*   @details        RadarModel_C 与 AlarmModel_C 共用一个原子计数器，不同对象、不同次设置得到的序号都不相同，
+*                   对象被赋值为新对象后序号也随之改变，缓存不会误用旧参数的常数
+*   @retval         参数序号，不为0
+*/
+unsigned int RadarModel_C::NextSerial()
+{
+	unsigned int value = ++serial_counter;
+	//回绕到0时再取一次
+	return (value != 0) ? value : ++serial_counter;
+}
+
+
+RadarModel_C::RadarModel_C()
+{
+	table_resolution = 0;
+	table_interp = ANTENNA_TABLE_LINEAR;
+	table_tolerance = 0;
+	serial = 0;
+	SetParam(AircraftParam());
+}
+
+
+RadarModel_C::RadarModel_C(const RadarParam_T& in_param)
+{
+	table_resolution = 0;
+	table_interp = ANTENNA_TABLE_LINEAR;
+	table_tolerance = 0;
+	serial = 0;
+	SetParam(in_param);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          设置雷达参数
+*   @details        重新计算全部常数，已设置方向图插值表时按原设置重新生成
+*   @param[in]      in_param        雷达参数
+*   @retval         0               正常
+*   @retval         1               错误，插值表生成失败，改用解析方向图
+*   @retval         2               错误，插值表误差超过容限，改用解析方向图
+*/
+int RadarModel_C::SetParam(const RadarParam_T& in_param)
+{
+	param = in_param;
+	serial = NextSerial();
+
+	//天线方向图，与 G_AntennaGain_surface_P 相同
+	k_main = 4 * log(sqrt(2) / (param.theta_t * param.theta_t));
+	k_other = 1.3916 / (sin(0.5 * param.theta_b));
+	gain_scale = param.nG * param.Gmax;
+	half_azimuth = param.azimuth_radar_width / 2.0;
+	half_pitch = param.pitch_radar_width / 2.0;
+	deg2rad(&angle_180, 180);
+	deg2rad(&angle_360, 360);
+
+	//回波功率与最大探测距离
+	echo_scale = param.Pgt * param.lambda * param.lambda * param.Lr / pow(4 * M_PI, 3);
+	double unit_range = 0;
+	getMaxDetectRange(&unit_range, 1.0, param.lambda, param.Pgt, param.nG, param.Gmax, param.theta_t, param.Lr,
+		param.azimuth_radar_width, param.pitch_radar_width);
+	range4_analytic = unit_range * unit_range * unit_range * unit_range;
+	range4_scale = range4_analytic;
+	gain_max_analytic = sqrt(range4_analytic * RADAR_DETECT_THRESHOLD / echo_scale);
+	gain_max = gain_max_analytic;
+
+	//方位角在 ±width/2 以内等价于 Vbab[0] >= cos(width/2)*sqrt(Vbab[0]^2+Vbab[2]^2)
+	cos_azimuth = (half_azimuth < M_PI) ? cos(half_azimuth) : -2.0;
+	//俯仰角在 ±width/2 以内等价于 |Vbab[1]| <= tan(width/2)*sqrt(Vbab[0]^2+Vbab[2]^2)
+	tan_pitch = (half_pitch < 0.5 * M_PI) ? tan(half_pitch) : -1.0;
+
+	gain_table = AntennaTable_C();
+	if (table_resolution > 0) {
+		return SetGainTable(table_resolution, table_interp, table_tolerance);
+	}
+
+	return 0;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          设置天线方向图插值表
+*   @details        表覆盖两个平面扫描范围中较大的半宽，生成后与解析方向图比较，误差超过容限时不使用。
+*                   使用插值表时最大探测距离按插值误差放大，剔除仍只剔除一定未发现的目标对
+*   @param[in]      resolution      角度间隔，单位：弧度，<=0 表示使用解析方向图
+*   @param[in]      interp          插值方式 ANTENNA_TABLE_LINEAR 或 ANTENNA_TABLE_CUBIC
+*   @param[in]      tolerance       允许的最大插值误差(增益系数平方根的绝对误差)
+*   @retval         0               正常
+*   @retval         1               错误，参数无效，改用解析方向图
+*   @retval         2               错误，插值误差超过容限，改用解析方向图
+*/
+int RadarModel_C::SetGainTable(
+	double							resolution,
+	int								interp,
+	double							tolerance)
+{
+	gain_table = AntennaTable_C();
+	range4_scale = range4_analytic;
+	gain_max = gain_max_analytic;
+	table_resolution = 0;
+	serial = NextSerial();
+	if (resolution <= 0) {
+		return 0;
+	}
+
+	//方位角换算到 -pi ~ pi 后才查表
+	double max_theta = (half_azimuth > half_pitch) ? half_azimuth : half_pitch;
+	max_theta = (max_theta < M_PI) ? max_theta : M_PI;
+
+	AntennaTable_C table;
+	if (table.Build(k_main, k_other, max_theta, resolution, interp) != 0) {
+		return 1;
+	}
+	table_resolution = resolution;
+	table_interp = interp;
+	table_tolerance = tolerance;
+	if (!(table.MaxError() <= tolerance)) {
+		return 2;
+	}
+
+	//每个平面的插值结果不超过解析值加最大误差，解析值的上界不小于1
+	gain_table = table;
+	double scale = 1.0 + table.MaxError();
+	range4_scale = range4_analytic * scale * scale * scale * scale;
+	gain_max = gain_max_analytic * scale * scale;
+
+	return 0;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          机载雷达默认参数
+*   @details        机载雷达默认参数
+*/
+RadarParam_T RadarModel_C::AircraftParam()
+{
+	RadarParam_T p;
+	p.lambda = 0.03;
+	p.Pgt = 20000;
+	p.nG = 0.8;
+	p.Gmax = 25000;
+	p.theta_t = 1.0;
+	p.theta_b = 3.14;
+	p.Lr = 0.9;
+	p.azimuth_radar_width = 2.5;
+	p.pitch_radar_width = 2.5;
+
+	return p;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          导弹跟踪雷达默认参数
+*   @details        导弹跟踪雷达默认参数
+*/
+RadarParam_T RadarModel_C::MissileParam()
+{
+	RadarParam_T p;
+	p.lambda = 0.03;
+	p.Pgt = 100;
+	p.nG = 0.8;
+	p.Gmax = 25000;
+	p.theta_t = 1.0;
+	p.theta_b = 3.14;
+	p.Lr = 0.9;
+	p.azimuth_radar_width = 1;
+	p.pitch_radar_width = 1;
+
+	return p;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          天线在目标方位的增益
+*   @details        未设置插值表时与 getTargetAntennaGain 相同
+*   @param[in]      azimuth_TargetToRadar   目标相对雷达的探测方位角，0 ~ 2pi
+*   @param[in]      pitch_TargetToRadar     目标相对雷达的探测俯仰角
+*   @retval         天线增益
+*/
+double RadarModel_C::AntennaGain(
+	double							azimuth_TargetToRadar,
+	double							pitch_TargetToRadar) const
+{
+	//方位角换算到 -pi ~ pi
+	double azimuth = (azimuth_TargetToRadar > angle_180) ? -(angle_360 - azimuth_TargetToRadar) : azimuth_TargetToRadar;
+
+	//任一平面超出扫描范围时增益为0
+	if (!(azimuth >= -half_azimuth && azimuth <= half_azimuth) ||
+		!(pitch_TargetToRadar >= -half_pitch && pitch_TargetToRadar <= half_pitch)) {
+		return 0;
+	}
+
+	if (!gain_table.Empty()) {
+		return gain_scale * gain_table.Value(azimuth) * gain_table.Value(pitch_TargetToRadar);
+	}
+
+	double f_azimuth = 0, f_pitch = 0;
+	getSurfaceGain(&f_azimuth, azimuth, k_main, k_other);
+	getSurfaceGain(&f_pitch, pitch_TargetToRadar, k_main, k_other);
+
+	return gain_scale * sqrt(f_azimuth * f_pitch);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          最大探测距离
+*   @details        与 getMaxDetectRange 相同
+*   @param[in]      Sigima          目标RCS上界
+*   @retval         最大探测距离
+*/
+double RadarModel_C::MaxDetectRange(double Sigima) const
+{
+	return sqrt(sqrt(range4_scale * Sigima));
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          雷达对单个目标的探测
+*   @details        依次按最大探测距离、视距剔除，剔除时判为未发现且不修改 Pgr；天线增益为0时 Pgr 为0，不计算RCS
+*   @param[out]     findedTarget         是or否发现目标
+*   @param[out]     Pgr                  目标回波功率
+*   @param[in]      RadarPosition[3]     雷达机的三维位置坐标(北，天，东)
+*   @param[in]      RadarCnb[3][3]       雷达机的方向余弦矩阵
+*   @param[in]      TargetPosition[3]    目标机的三维位置坐标(北，天，东)
+*   @param[in]      TargetCnb[3][3]      目标机的方向余弦矩阵
+*   @param[in]      SigimaType[5]        目标的5个RCS典型值(+x,-x,+y,-z,z)，使用RCS表时可为 NULL
+*   @param[in]      rcs_table            目标的RCS表，为 NULL 或空表时由 SigimaType 计算RCS
+*   @retval         0               正常
+*   @retval         1               错误，没有可用的RCS表且 SigimaType 为 NULL
+*/
+int RadarModel_C::Detect(
+	bool*							findedTarget,
+	double*							Pgr,
+	const double					RadarPosition[3],
+	const double					RadarCnb[3][3],
+	const double					TargetPosition[3],
+	const double					TargetCnb[3][3],
+	const double					SigimaType[5],
+	const RcsTable_C*				rcs_table) const
+{
+	//空表(如 Load 失败)按没有RCS表处理
+	if (rcs_table != NULL && rcs_table->Empty()) {
+		rcs_table = NULL;
+	}
+	if (rcs_table == NULL && SigimaType == NULL) {
+		*Pgr = 0;
+		*findedTarget = false;
+		return 1;
+	}
+
+	double dx = RadarPosition[0] - TargetPosition[0];
+	double dy = RadarPosition[1] - TargetPosition[1];
+	double dz = RadarPosition[2] - TargetPosition[2];
+	double distance2 = dx * dx + dy * dy + dz * dz;
+
+	//位置重合时探测角无定义
+	if (distance2 == 0) {
+		*Pgr = 0;
+		*findedTarget = false;
+		return 0;
+	}
+
+	//最大探测距离，RCS取RCS表或典型值的最大值
+	int band = (rcs_table != NULL) ? rcs_table->BandIndex(param.lambda) : -1;
+	double sigma_max = 0;
+	if (rcs_table != NULL) {
+		sigma_max = rcs_table->MaxValue(band);
+	}
+	else {
+		sigma_max = SigimaType[0];
+		for (int s = 1; s < 5; s++) {
+			sigma_max = (SigimaType[s] > sigma_max) ? SigimaType[s] : sigma_max;
+		}
+	}
+	if (distance2 * distance2 > range4_scale * sigma_max * (1.0 + 4 * range_margin)) {
+		*findedTarget = false;
+		return 0;
+	}
+
+	//视距
+	double distance = sqrt(distance2);
+	double sight = 0;
+	getRadarSight(&sight, RadarPosition[1], TargetPosition[1]);
+	if (sight < distance) {
+		*findedTarget = false;
+		return 0;
+	}
+
+	//目标相对雷达的探测角和天线增益
+	double azimuth_target_to_radar = 0, pitch_target_to_radar = 0;
+	getBodyAzimuthPitch(&azimuth_target_to_radar, &pitch_target_to_radar, RadarCnb, RadarPosition, TargetPosition);
+	double AntennaGain = this->AntennaGain(azimuth_target_to_radar, pitch_target_to_radar);
+	if (AntennaGain == 0) {
+		*Pgr = 0;
+		*findedTarget = false;
+		return 0;
+	}
+
+	//雷达相对目标的探测角和目标RCS
+	double azimuth_radar_to_target = 0, pitch_radar_to_target = 0;
+	getBodyAzimuthPitch(&azimuth_radar_to_target, &pitch_radar_to_target, TargetCnb, TargetPosition, RadarPosition);
+	double TargetRCS = 0;
+	if (rcs_table != NULL) {
+		TargetRCS = rcs_table->Sample(azimuth_radar_to_target, pitch_radar_to_target, band);
+	}
+	else {
+		getTargetRCS(&TargetRCS, azimuth_radar_to_target, pitch_radar_to_target, SigimaType);
+	}
+
+	//回波功率
+	double EchoPower = this->EchoPower(AntennaGain, TargetRCS, distance2);
+	*Pgr = EchoPower;
+	confirmTarget(findedTarget, EchoPower);
+
+	return 0;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          雷达对单个目标的探测
+*   @details        输入与 Radar() 相同，姿态为(滚转，偏航，俯仰)
+*   @param[out]     findedTarget         是or否发现目标
+*   @param[out]     Pgr                  目标回波功率
+*   @param[in]      positionRadar[3]     雷达机的三维位置坐标
+*   @param[in]      attitudeRadar[3]     雷达机的三个欧拉角姿态
+*   @param[in]      positionTarget[3]    目标机的三维位置坐标
+*   @param[in]      attitudeTarget[3]    目标机的三个欧拉角姿态
+*   @param[in]      SigimaType[5]        目标的5个RCS典型值(+x,-x,+y,-z,z)，使用RCS表时可为 NULL
+*   @param[in]      rcs_table            目标的RCS表，为 NULL 或空表时由 SigimaType 计算RCS
+*   @retval         0               正常
+*   @retval         1               错误，没有可用的RCS表且 SigimaType 为 NULL
+*/
+int RadarModel_C::Detect(
+	bool*							findedTarget,
+	double*							Pgr,
+	const double					positionRadar[3],
+	const double					attitudeRadar[3],
+	const double					positionTarget[3],
+	const double					attitudeTarget[3],
+	const double					SigimaType[5],
+	const RcsTable_C*				rcs_table) const
+{
+	//姿态按导航坐标北天东、机体坐标前上右重排，与 Radar() 相同
+	double RadarAttitude[3] = { attitudeRadar[0], attitudeRadar[2], attitudeRadar[1] };
+	double TargetAttitude[3] = { attitudeTarget[0], attitudeTarget[2], attitudeTarget[1] };
+
+	double RadarCnb[3][3], TargetCnb[3][3];
+	getAttitudeMatrix(RadarCnb, RadarAttitude);
+	getAttitudeMatrix(TargetCnb, TargetAttitude);
+
+	return Detect(findedTarget, Pgr, positionRadar, RadarCnb, positionTarget, TargetCnb, SigimaType, rcs_table);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          批量探测
+*   @details        目标按块处理：每块先算目标的方向余弦矩阵、高度平方根和最大探测距离，再对每部雷达逐级剔除后逐对计算。
+*                   扫过范围的判断只对通过剔除的目标对进行，用体轴投影比较
+*   @param[out]     findedTarget         探测矩阵[N][M]
+*   @param[out]     Pgr                  回波功率矩阵[N][M]
+*   @param[in]      radars               雷达机状态，共N部
+*   @param[in]      targets              目标机状态，共M个
+*   @param[out]     stats                剔除统计，可为 NULL
+*   @param[in]      scan_window          各雷达本步长扫过的范围，共N个，为 NULL 时整个扫描范围都被照射
+*   @retval         0               正常
+*   @retval         1               错误，参数为空或目标缺少RCS
+*/
+int RadarModel_C::DetectBatch(
+	bool*							findedTarget,
+	double*							Pgr,
+	const RadarBatchState_T*		radars,
+	const RadarBatchState_T*		targets,
+	RadarBatchStats_T*				stats,
+	const RadarScanWindow_T*		scan_window) const
+{
+	if (findedTarget == NULL || Pgr == NULL || radars == NULL || targets == NULL) {
+		return 1;
+	}
+	//没有RCS表或RCS表为空的目标须有5个RCS典型值
+	bool need_sigma = (targets->rcs_table == NULL);
+	for (int t = 0; !need_sigma && t < targets->count; t++) {
+		need_sigma = (targets->rcs_table[t] == NULL || targets->rcs_table[t]->Empty());
+	}
+	for (int k = 0; k < 5; k++) {
+		if (need_sigma && targets->sigma_type[k] == NULL) {
+			return 1;
+		}
+	}
+
+	int radar_count = radars->count;
+	int target_count = targets->count;
+
+	double target_Cnb[RADAR_BATCH_BLOCK][3][3];
+	double target_sight[RADAR_BATCH_BLOCK];
+	double target_range2[RADAR_BATCH_BLOCK];
+	int keep_list[RADAR_BATCH_BLOCK];
+
+	RadarBatchStats_T count_total = { 0, 0, 0, 0, 0, 0, 0 };
+	count_total.pair_count = (long long)radar_count * target_count;
+
+	for (int first = 0; first < target_count; first += RADAR_BATCH_BLOCK) {
+		int count = target_count - first;
+		if (count > RADAR_BATCH_BLOCK) {
+			count = RADAR_BATCH_BLOCK;
+		}
+
+		for (int j = 0; j < count; j++) {
+			StateMatrix(target_Cnb[j], targets, first + j);
+			target_sight[j] = sqrt(targets->position[1][first + j]);
+
+			//RCS取RCS表或五个典型值的最大值，留少量余量避免边界处误剔
+			const RcsTable_C* rcs_table = (targets->rcs_table != NULL) ? targets->rcs_table[first + j] : NULL;
+			rcs_table = (rcs_table != NULL && !rcs_table->Empty()) ? rcs_table : NULL;
+			double sigma_max = 0;
+			if (rcs_table != NULL) {
+				sigma_max = rcs_table->MaxValue(rcs_table->BandIndex(param.lambda));
+			}
+			else {
+				sigma_max = targets->sigma_type[0][first + j];
+				for (int s = 1; s < 5; s++) {
+					double sigma = targets->sigma_type[s][first + j];
+					sigma_max = (sigma > sigma_max) ? sigma : sigma_max;
+				}
+			}
+			target_range2[j] = sqrt(range4_scale * sigma_max) * (1.0 + 2 * range_margin);
+		}
+
+		for (int i = 0; i < radar_count; i++) {
+			bool* finded_row = findedTarget + (size_t)i * target_count + first;
+			double* power_row = Pgr + (size_t)i * target_count + first;
+			for (int j = 0; j < count; j++) {
+				finded_row[j] = false;
+				power_row[j] = 0;
+			}
+
+			double radar_position[3] = { radars->position[0][i], radars->position[1][i], radars->position[2][i] };
+			double radar_Cnb[3][3];
+			StateMatrix(radar_Cnb, radars, i);
+
+			CullInput_T in;
+			in.Cnb = &radar_Cnb[0][0];
+			in.radar_position = radar_position;
+			in.radar_sight = sqrt(radar_position[1]);
+			in.x = targets->position[0] + first;
+			in.y = targets->position[1] + first;
+			in.z = targets->position[2] + first;
+			in.target_sight = target_sight;
+			in.target_range2 = target_range2;
+			in.cos_azimuth = cos_azimuth;
+			in.tan_pitch = tan_pitch;
+
+			CullCount_T cull_count = { 0, 0, 0 };
+			int keep_count = CullBlock(in, count, keep_list, &cull_count);
+			count_total.range_culled += cull_count.range_culled;
+			count_total.sight_culled += cull_count.sight_culled;
+			count_total.beam_culled += cull_count.beam_culled;
+
+			for (int k = 0; k < keep_count; k++) {
+				int j = keep_list[k];
+				int t = first + j;
+				double target_position[3] = { targets->position[0][t], targets->position[1][t], targets->position[2][t] };
+				if (target_position[0] == radar_position[0] && target_position[1] == radar_position[1] && target_position[2] == radar_position[2]) {
+					continue;
+				}
+
+				//本步长波束扫过的范围
+				if (scan_window != NULL) {
+					double Vn[3] = { target_position[0] - radar_position[0], target_position[1] - radar_position[1], target_position[2] - radar_position[2] };
+					double Vb[3];
+					for (int k = 0; k < 3; k++) {
+						Vb[k] = radar_Cnb[k][0] * Vn[0] + radar_Cnb[k][1] * Vn[1] + radar_Cnb[k][2] * Vn[2];
+					}
+					if (!RadarScan_C::InWindow(scan_window[i], Vb)) {
+						count_total.scan_culled++;
+						continue;
+					}
+				}
+
+				const RcsTable_C* rcs_table = (targets->rcs_table != NULL) ? targets->rcs_table[t] : NULL;
+				rcs_table = (rcs_table != NULL && !rcs_table->Empty()) ? rcs_table : NULL;
+				double sigma[5] = { 0, 0, 0, 0, 0 };
+				if (rcs_table == NULL) {
+					for (int s = 0; s < 5; s++) {
+						sigma[s] = targets->sigma_type[s][t];
+					}
+				}
+
+				Detect(&finded_row[j], &power_row[j], radar_position, radar_Cnb, target_position, target_Cnb[j], sigma, rcs_table);
+				count_total.evaluated++;
+				count_total.finded += finded_row[j] ? 1 : 0;
+			}
+		}
+	}
+
+	if (stats != NULL) {
+		*stats = count_total;
+	}
+
+	return 0;
+}
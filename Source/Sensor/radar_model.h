@@ -0,0 +1,308 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           radar_model.h
+*   @brief          雷达模型。
+*   @details        保存一部雷达的参数，构造时算好与目标无关的常数：天线方向图系数、回波功率系数、最大探测距离系数、
+*                   波束范围的剔除限，探测时只计算与目标有关的部分。Radar()、RadarDetect()、RadarBatch() 为它的包装。
+*                   天线方向图可改为查插值表(SetGainTable)。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.6
+*   @par Copyright
+*                   LiDaiwei
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*                   1.0.0.2: agent, 20261018, 增加天线方向图插值表
+*                   1.0.0.3: agent, 20261018, 目标RCS可取自RCS表
+*                   1.0.0.4: agent, 20261018, 飞机状态可直接给出方向余弦矩阵
+*                   1.0.0.5: agent, 20261018, 增加参数序号和天线增益上界，供告警器批量计算缓存
+*                   1.0.0.6: agent, 20261018, 批量探测可只计算波束扫过范围内的目标
+*/
+
+#ifndef RADAR_MODEL_H_INCLUDED
+#define RADAR_MODEL_H_INCLUDED
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           被使用的头文件。
+*   @{
+*/
+#include "radar.h"
+#include "antenna_table.h"
+#include "rcs_table.h"
+#include "radar_scan.h"
+#include <stddef.h>
+/** @}  */
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          雷达参数。
+*   @details        与 Radar() 的参数相同。
+*/
+struct RadarParam_T
+{
+	double							lambda;							//!< 雷达工作波长
+	double							Pgt;							//!< 雷达发射功率
+	double							nG;								//!< 天线效率
+	double							Gmax;							//!< 天线最大增益
+	double							theta_t;						//!< 主瓣波束宽度
+	double							theta_b;						//!< 单程半功率点波束宽度
+	double							Lr;								//!< 雷达综合损耗
+	double							azimuth_radar_width;			//!< 雷达扫描方位角范围
+	double							pitch_radar_width;				//!< 雷达扫描俯仰角范围
+};
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          一组飞机的状态，按分量分开存放。
+*   @details        各数组长度均为 count，含义与 Radar() 的 position、attitude 相同：
+*                   position 为(北，天，东)，attitude 为(滚转，偏航，俯仰)，单位：米、弧度。
+*                   sigma_type 为目标的5个RCS典型值，rcs_table 为目标的RCS表，只对目标使用，雷达可为 NULL。
+*                   rcs_table 为 NULL 或其中某个目标的表为 NULL、为空时，该目标的RCS由 sigma_type 计算。
+*                   Cnb 为各飞机的方向余弦矩阵(可由 getQuaternionMatrix 每帧算一次)，给出时不使用 attitude，attitude 可为 NULL。
+*/
+struct RadarBatchState_T
+{
+	int								count;							//!< 飞机数
+	const double*					position[3];					//!< 位置的三个分量
+	const double*					attitude[3];					//!< 姿态的三个分量
+	const double*					sigma_type[5];					//!< RCS典型值的五个分量
+	const RcsTable_C* const*		rcs_table;						//!< 各目标的RCS表，可为 NULL
+	const double					(*Cnb)[3][3];					//!< 各飞机的方向余弦矩阵，可为 NULL
+};
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          批量探测统计。
+*   @details        每次调用重新计数，各级剔除数互不重叠。
+*/
+struct RadarBatchStats_T
+{
+	long long						pair_count;						//!< 目标对总数
+	long long						range_culled;					//!< 超出最大探测距离
+	long long						sight_culled;					//!< 超出视距
+	long long						beam_culled;					//!< 超出波束范围
+	long long						scan_culled;					//!< 不在本步长波束扫过的范围内
+	long long						evaluated;						//!< 逐对计算的目标对数
+	long long						finded;							//!< 发现的目标对数
+};
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          雷达模型。
+*   @details        构造后只读，可在多个线程中同时探测。
+*/
+class RadarModel_C
+{
+public:
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          创建雷达模型
+	*   @details        使用机载雷达的默认参数
+	*/
+	RadarModel_C();
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          创建雷达模型
+	*   @details        创建雷达模型
+	*   @param[in]      in_param        雷达参数
+	*/
+	explicit RadarModel_C(const RadarParam_T& in_param);
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          设置雷达参数
+	*   @details        重新计算全部常数，已设置方向图插值表时按原设置重新生成
+	*   @param[in]      in_param        雷达参数
+	*   @retval         0               正常
+	*   @retval         1               错误，插值表生成失败，改用解析方向图
+	*   @retval         2               错误，插值表误差超过容限，改用解析方向图
+	*/
+	int SetParam(const RadarParam_T& in_param);
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          设置天线方向图插值表
+	*   @details        默认使用解析方向图，结果与 Radar() 相同；使用插值表时天线增益有插值误差，
+	*                   回波功率接近门限的目标对探测结果可能不同
+	*   @param[in]      resolution      角度间隔，单位：弧度，<=0 表示使用解析方向图
+	*   @param[in]      interp          插值方式 ANTENNA_TABLE_LINEAR 或 ANTENNA_TABLE_CUBIC
+	*   @param[in]      tolerance       允许的最大插值误差(增益系数平方根的绝对误差)
+	*   @retval         0               正常
+	*   @retval         1               错误，参数无效，改用解析方向图
+	*   @retval         2               错误，插值误差超过容限，改用解析方向图
+	*/
+	int SetGainTable(
+		double							resolution,
+		int								interp,
+		double							tolerance);
+
+	const AntennaTable_C& GainTable() const { return gain_table; }
+
+	const RadarParam_T& Param() const { return param; }
+
+	//机载雷达、导弹跟踪雷达的默认参数
+	static RadarParam_T AircraftParam();
+	static RadarParam_T MissileParam();
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          雷达对单个目标的探测
+	*   @details        依次按最大探测距离、视距剔除，剔除时判为未发现且不修改 Pgr；天线增益为0时 Pgr 为0，不计算RCS。
+	*                   雷达与目标位置重合时判为未发现、Pgr 为0
+	*   @param[out]     findedTarget         是or否发现目标
+	*   @param[out]     Pgr                  目标回波功率
+	*   @param[in]      RadarPosition[3]     雷达机的三维位置坐标(北，天，东)
+	*   @param[in]      RadarCnb[3][3]       雷达机的方向余弦矩阵
+	*   @param[in]      TargetPosition[3]    目标机的三维位置坐标(北，天，东)
+	*   @param[in]      TargetCnb[3][3]      目标机的方向余弦矩阵
+	*   @param[in]      SigimaType[5]        目标的5个RCS典型值(+x,-x,+y,-z,z)，使用RCS表时可为 NULL
+	*   @param[in]      rcs_table            目标的RCS表，为 NULL 或空表时由 SigimaType 计算RCS
+	*   @retval         0               正常
+	*   @retval         1               错误，没有可用的RCS表且 SigimaType 为 NULL
+	*/
+	int Detect(
+		bool*							findedTarget,
+		double*							Pgr,
+		const double					RadarPosition[3],
+		const double					RadarCnb[3][3],
+		const double					TargetPosition[3],
+		const double					TargetCnb[3][3],
+		const double					SigimaType[5],
+		const RcsTable_C*				rcs_table = NULL) const;
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          雷达对单个目标的探测
+	*   @details        输入与 Radar() 相同，姿态为(滚转，偏航，俯仰)
+	*   @param[out]     findedTarget         是or否发现目标
+	*   @param[out]     Pgr                  目标回波功率
+	*   @param[in]      positionRadar[3]     雷达机的三维位置坐标
+	*   @param[in]      attitudeRadar[3]     雷达机的三个欧拉角姿态
+	*   @param[in]      positionTarget[3]    目标机的三维位置坐标
+	*   @param[in]      attitudeTarget[3]    目标机的三个欧拉角姿态
+	*   @param[in]      SigimaType[5]        目标的5个RCS典型值(+x,-x,+y,-z,z)，使用RCS表时可为 NULL
+	*   @param[in]      rcs_table            目标的RCS表，为 NULL 或空表时由 SigimaType 计算RCS
+	*   @retval         0               正常
+	*   @retval         1               错误，没有可用的RCS表且 SigimaType 为 NULL
+	*/
+	int Detect(
+		bool*							findedTarget,
+		double*							Pgr,
+		const double					positionRadar[3],
+		const double					attitudeRadar[3],
+		const double					positionTarget[3],
+		const double					attitudeTarget[3],
+		const double					SigimaType[5],
+		const RcsTable_C*				rcs_table = NULL) const;
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          批量探测
+	*   @details        第i部雷达对第j个目标的结果写入 findedTarget[i*M+j]、Pgr[i*M+j]，M 为目标数。
+	*                   目标按块处理，先成块逐级剔除(SSE2 每次两个目标)：距离平方与按目标最大RCS算出的最大探测距离比较，
+	*                   再比较视距，最后用体轴投影与波束范围的余弦、正切限比较。剔除时留有余量，只剔除一定未发现的目标对，
+	*                   其余目标对用 Detect 逐对计算。被剔除的目标对 Pgr 写0；
+	*                   雷达与目标位置重合时(如雷达与目标为同一组飞机时的对角线)判为未发现、Pgr 为0。
+	*                   给出 scan_window 时，通过剔除的目标对还须在该雷达本步长波束扫过的范围内(RadarScan_C::Window)，
+	*                   否则判为未发现、Pgr 为0
+	*   @param[out]     findedTarget         探测矩阵[N][M]
+	*   @param[out]     Pgr                  回波功率矩阵[N][M]
+	*   @param[in]      radars               雷达机状态，共N部
+	*   @param[in]      targets              目标机状态，共M个
+	*   @param[out]     stats                剔除统计，可为 NULL
+	*   @param[in]      scan_window          各雷达本步长扫过的范围，共N个，为 NULL 时整个扫描范围都被照射
+	*   @retval         0               正常
+	*   @retval         1               错误，参数为空或目标缺少RCS
+	*/
+	int DetectBatch(
+		bool*							findedTarget,
+		double*							Pgr,
+		const RadarBatchState_T*		radars,
+		const RadarBatchState_T*		targets,
+		RadarBatchStats_T*				stats = NULL,
+		const RadarScanWindow_T*		scan_window = NULL) const;
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          天线在目标方位的增益
+	*   @details        未设置插值表时与 getTargetAntennaGain 相同
+	*   @param[in]      azimuth_TargetToRadar   目标相对雷达的探测方位角，0 ~ 2pi
+	*   @param[in]      pitch_TargetToRadar     目标相对雷达的探测俯仰角
+	*   @retval         天线增益
+	*/
+	double AntennaGain(
+		double							azimuth_TargetToRadar,
+		double							pitch_TargetToRadar) const;
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          目标回波功率
+	*   @details        与 getTargetEchoPower 相同，距离以平方给出，免去开方
+	*   @param[in]      Ggt             发射天线增益
+	*   @param[in]      Sigima          目标RCS
+	*   @param[in]      R2              雷达与目标距离的平方
+	*   @retval         回波功率
+	*/
+	double EchoPower(
+		double							Ggt,
+		double							Sigima,
+		double							R2) const
+	{
+		return echo_scale * Ggt * Ggt * Sigima / (R2 * R2);
+	}
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          最大探测距离
+	*   @details        未设置插值表时与 getMaxDetectRange 相同，使用插值表时按插值误差放大
+	*   @param[in]      Sigima          目标RCS上界
+	*   @retval         最大探测距离
+	*/
+	double MaxDetectRange(double Sigima) const;
+
+	//扫描范围内天线增益的上界，使用插值表时按插值误差放大
+	double MaxGain() const { return gain_max; }
+
+	//参数序号，每次 SetParam、SetGainTable 后改变，缓存常数的调用方据此判断参数是否改变
+	unsigned int Serial() const { return serial; }
+
+	//取新的参数序号，与 AlarmModel_C 共用全局计数，不同对象的序号也不相同
+	static unsigned int NextSerial();
+
+private:
+	RadarParam_T					param;
+
+	//天线方向图
+	double							k_main;							//主瓣系数 4*log(sqrt(2)/theta_t^2)
+	double							k_other;						//旁瓣系数 1.3916/sin(theta_b/2)
+	double							gain_scale;						//nG*Gmax
+	double							half_azimuth;					//方位扫描半宽
+	double							half_pitch;						//俯仰扫描半宽
+	double							angle_180;						//与 getTargetAntennaGain 的换算常数相同
+	double							angle_360;
+	double							gain_max;						//扫描范围内天线增益的上界
+	double							gain_max_analytic;				//解析方向图的 gain_max
+
+	//回波功率与探测距离
+	double							echo_scale;						//Pgt*Lambda^2*Lr/(4pi)^3
+	double							range4_scale;					//最大探测距离的四次方与RCS之比
+	double							range4_analytic;				//解析方向图的 range4_scale
+
+	//天线方向图插值表，为空时使用解析方向图
+	AntennaTable_C					gain_table;
+	double							table_resolution;
+	int								table_interp;
+	double							table_tolerance;
+
+	//批量剔除限
+	double							cos_azimuth;					//体轴前向分量低于 cos_azimuth*水平距离 时超出方位范围
+	double							tan_pitch;						//竖直分量高于 tan_pitch*水平距离 时超出俯仰范围，<0 表示不剔除
+
+	unsigned int					serial;
+};
+
+#endif // RADAR_MODEL_H_INCLUDED
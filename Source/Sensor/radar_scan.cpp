@@ -0,0 +1,213 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           radar_scan.cpp
+*   @brief          雷达扫描方式。
+*   @details        雷达扫描方式。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   LiDaiwei
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*/
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           头文件。
+*   @{
+*/
+#include "radar_scan.h"
+#include "../Tools/tool_function.h"
+/** @}  */
+
+
+RadarScan_C::RadarScan_C()
+{
+	SetParam(AircraftParam());
+}
+
+
+RadarScan_C::RadarScan_C(const RadarScanParam_T& in_param)
+{
+	if (SetParam(in_param) != 0) {
+		SetParam(AircraftParam());
+	}
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          设置扫描方式参数
+*   @details        方位上的波位数为 ceil(azimuth_width/beam_width)，波位在扫描范围内等间隔分布
+*   @param[in]      in_param        扫描方式参数
+*   @retval         0               正常
+*   @retval         1               错误，参数无效，保留原参数
+*/
+int RadarScan_C::SetParam(const RadarScanParam_T& in_param)
+{
+	if (!(in_param.azimuth_width > 0 && in_param.azimuth_width <= 2 * M_PI) ||
+		in_param.bar_count < 1 || in_param.bar_count > RADAR_SCAN_MAX_BAR ||
+		!(in_param.bar_spacing >= 0) || !(in_param.beam_width > 0) || !(in_param.dwell_time > 0) ||
+		!(fabs(in_param.center_pitch) < 0.5 * M_PI)) {
+		return 1;
+	}
+
+	param = in_param;
+	column_count = (int)ceil(param.azimuth_width / param.beam_width);
+	column_count = (column_count > 1) ? column_count : 1;
+	column_step = param.azimuth_width / column_count;
+
+	return 0;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          机载雷达默认参数
+*   @details        方位 ±60 度，4 行，行间隔与波束宽度均为 1.5 度，帧时间 4 秒
+*/
+RadarScanParam_T RadarScan_C::AircraftParam()
+{
+	RadarScanParam_T p;
+	deg2rad(&p.azimuth_width, 120);
+	p.bar_count = 4;
+	deg2rad(&p.bar_spacing, 1.5);
+	p.center_pitch = 0;
+	deg2rad(&p.beam_width, 1.5);
+	//120/1.5*4=320 个波位
+	p.dwell_time = 4.0 / 320;
+
+	return p;
+}
+
+
+//行的俯仰角，第0行在最上方
+double RadarScan_C::BarPitch(int bar) const
+{
+	return param.center_pitch + (0.5 * (param.bar_count - 1) - bar) * param.bar_spacing;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          某一时刻的波束指向
+*   @details        时刻按帧时间取模，0 时刻为第0行最左侧波位
+*   @param[out]     azimuth         波束方位角，向左为正
+*   @param[out]     pitch           波束俯仰角
+*   @param[in]      time            时刻
+*   @retval         0               正常
+*/
+int RadarScan_C::BeamDirection(
+	double*							azimuth,
+	double*							pitch,
+	double							time) const
+{
+	double t = fmod(time, FrameTime());
+	t = (t >= 0) ? t : t + FrameTime();
+	int position = (int)(t / param.dwell_time);
+	position = (position < PositionCount()) ? position : PositionCount() - 1;
+
+	//偶数行从左到右，奇数行从右到左
+	int bar = position / column_count;
+	int k = position % column_count;
+	int column = (bar % 2 == 0) ? k : column_count - 1 - k;
+
+	*azimuth = 0.5 * param.azimuth_width - (column + 0.5) * column_step;
+	*pitch = BarPitch(bar);
+	return 0;
+}
+
+
+//在一行内加入第 first ~ last 个波位(按方位从左到右编号)，方位宽度超过 pi/2 时分块
+void RadarScan_C::AddBox(
+	RadarScanWindow_T*				window,
+	int								bar,
+	int								first,
+	int								last) const
+{
+	//波束覆盖波位中心两侧各半个波束宽度
+	double left = 0.5 * param.azimuth_width - (first + 0.5) * column_step + 0.5 * param.beam_width;
+	double right = 0.5 * param.azimuth_width - (last + 0.5) * column_step - 0.5 * param.beam_width;
+	double low = BarPitch(bar) - 0.5 * param.beam_width;
+	double high = BarPitch(bar) + 0.5 * param.beam_width;
+	double tan_low = (low > -0.5 * M_PI) ? tan(low) : -HUGE_VAL;
+	double tan_high = (high < 0.5 * M_PI) ? tan(high) : HUGE_VAL;
+
+	int piece_count = (int)ceil((left - right) / (0.5 * M_PI));
+	piece_count = (piece_count > 1) ? piece_count : 1;
+	double piece = (left - right) / piece_count;
+	for (int k = 0; k < piece_count; k++) {
+		//分块数超出上限时按整帧处理，只会多算目标
+		if (window->box_count >= RADAR_SCAN_MAX_BOX) {
+			window->full = true;
+			return;
+		}
+		double piece_left = left - k * piece;
+		double piece_right = (k == piece_count - 1) ? right : left - (k + 1) * piece;
+		int n = window->box_count++;
+		window->left_cos[n] = cos(piece_left);
+		window->left_sin[n] = sin(piece_left);
+		window->right_cos[n] = cos(piece_right);
+		window->right_sin[n] = sin(piece_right);
+		window->tan_low[n] = tan_low;
+		window->tan_high[n] = tan_high;
+	}
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          一段时间内扫过的范围
+*   @details        [time, time+dt) 内驻留过的全部波位，按行合并为方位范围；dt 不小于帧时间时为整帧
+*   @param[out]     window          扫过的范围
+*   @param[in]      time            开始时刻，各雷达可加不同的初相
+*   @param[in]      dt              时间长度，通常为仿真步长
+*   @retval         0               正常
+*/
+int RadarScan_C::Window(
+	RadarScanWindow_T*				window,
+	double							time,
+	double							dt) const
+{
+	window->full = false;
+	window->box_count = 0;
+
+	int position_count = PositionCount();
+	if (!(dt < FrameTime())) {
+		window->full = true;
+		return 0;
+	}
+
+	double t = fmod(time, FrameTime());
+	t = (t >= 0) ? t : t + FrameTime();
+	int first = (int)(t / param.dwell_time);
+	first = (first < position_count) ? first : position_count - 1;
+	//结束时刻恰在波位切换处时不含下一个波位
+	int last = (int)ceil((t + dt) / param.dwell_time) - 1;
+	last = (last > first) ? last : first;
+	if (last - first + 1 >= position_count) {
+		window->full = true;
+		return 0;
+	}
+
+	//按行分段，跨帧时回到第0行
+	for (int p = first; p <= last && !window->full; ) {
+		int q = p % position_count;
+		int bar = q / column_count;
+		int end = p + (column_count - 1 - q % column_count);
+		end = (end < last) ? end : last;
+
+		int k0 = q % column_count;
+		int k1 = k0 + (end - p);
+		if (bar % 2 == 0) {
+			AddBox(window, bar, k0, k1);
+		}
+		else {
+			AddBox(window, bar, column_count - 1 - k1, column_count - 1 - k0);
+		}
+		p = end + 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,192 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           radar_scan.h
+*   @brief          雷达扫描方式。
+*   @details        机载雷达按多行(bar)光栅扫描：每行由若干波位组成，波束在每个波位驻留 dwell_time，
+*                   奇数行反向扫描，扫完全部波位为一帧，帧时间即重访时间。
+*                   每个仿真步长只有波束扫过的波位被照射，Window 给出这一段时间内扫过的波位范围，
+*                   RadarModel_C::DetectBatch 只对落在范围内的目标逐对计算，其余目标判为未发现。
+*                   角度均在雷达机体坐标系(前上右)内，方位角向左为正，与 getBodyAzimuthPitch 换算到 -pi ~ pi 后相同。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   LiDaiwei
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*/
+
+#ifndef RADAR_SCAN_H_INCLUDED
+#define RADAR_SCAN_H_INCLUDED
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           被使用的头文件。
+*   @{
+*/
+#include <math.h>
+/** @}  */
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           扫描方式宏定义。
+*   @{
+*/
+#define RADAR_SCAN_MAX_BAR 8             //扫描行数上限
+#define RADAR_SCAN_MAX_BOX 32            //一个时间段内扫过范围的最多分块数
+/** @}  */
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          扫描方式参数。
+*   @details        角度单位：弧度，时间单位：秒。
+*/
+struct RadarScanParam_T
+{
+	double							azimuth_width;					//!< 扫描方位角范围，不超过 2pi
+	int								bar_count;						//!< 扫描行数，1 ~ RADAR_SCAN_MAX_BAR
+	double							bar_spacing;					//!< 相邻两行的俯仰角间隔
+	double							center_pitch;					//!< 扫描中心的俯仰角
+	double							beam_width;						//!< 波束宽度，方位、俯仰相同，同时为方位上的波位间隔
+	double							dwell_time;						//!< 每个波位的驻留时间
+};
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          一段时间内扫过的范围。
+*   @details        由若干个方位、俯仰范围组成，每块方位宽度不超过 pi/2，用体轴投影比较，免去反三角函数。
+*                   full 为 true 时这段时间扫完了整帧，范围为全部扫描空域。
+*/
+struct RadarScanWindow_T
+{
+	bool							full;							//!< 扫完整帧
+	int								box_count;						//!< 分块数
+	double							left_cos[RADAR_SCAN_MAX_BOX];	//!< 方位范围左边界(方位角大的一侧)的余弦、正弦
+	double							left_sin[RADAR_SCAN_MAX_BOX];
+	double							right_cos[RADAR_SCAN_MAX_BOX];	//!< 方位范围右边界的余弦、正弦
+	double							right_sin[RADAR_SCAN_MAX_BOX];
+	double							tan_low[RADAR_SCAN_MAX_BOX];	//!< 俯仰范围下边界、上边界的正切
+	double							tan_high[RADAR_SCAN_MAX_BOX];
+};
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          雷达扫描方式。
+*   @details        构造后只读，可在多个线程中同时使用。
+*/
+class RadarScan_C
+{
+public:
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          创建扫描方式
+	*   @details        使用机载雷达的默认参数
+	*/
+	RadarScan_C();
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          创建扫描方式
+	*   @details        参数无效时使用机载雷达的默认参数
+	*   @param[in]      in_param        扫描方式参数
+	*/
+	explicit RadarScan_C(const RadarScanParam_T& in_param);
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          设置扫描方式参数
+	*   @details        方位上的波位数为 ceil(azimuth_width/beam_width)，波位在扫描范围内等间隔分布
+	*   @param[in]      in_param        扫描方式参数
+	*   @retval         0               正常
+	*   @retval         1               错误，参数无效，保留原参数
+	*/
+	int SetParam(const RadarScanParam_T& in_param);
+
+	const RadarScanParam_T& Param() const { return param; }
+
+	//机载雷达默认参数：±60度，4行，波束宽度1.5度
+	static RadarScanParam_T AircraftParam();
+
+	int ColumnCount() const { return column_count; }
+	int PositionCount() const { return column_count * param.bar_count; }
+
+	//帧时间，即同一波位的重访时间
+	double FrameTime() const { return PositionCount() * param.dwell_time; }
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          某一时刻的波束指向
+	*   @details        时刻按帧时间取模，0 时刻为第0行最左侧波位
+	*   @param[out]     azimuth         波束方位角，向左为正
+	*   @param[out]     pitch           波束俯仰角
+	*   @param[in]      time            时刻
+	*   @retval         0               正常
+	*/
+	int BeamDirection(
+		double*							azimuth,
+		double*							pitch,
+		double							time) const;
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          一段时间内扫过的范围
+	*   @details        [time, time+dt) 内驻留过的全部波位，按行合并为方位范围；dt 不小于帧时间时为整帧
+	*   @param[out]     window          扫过的范围
+	*   @param[in]      time            开始时刻，各雷达可加不同的初相
+	*   @param[in]      dt              时间长度，通常为仿真步长
+	*   @retval         0               正常
+	*/
+	int Window(
+		RadarScanWindow_T*				window,
+		double							time,
+		double							dt) const;
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          目标是否在扫过的范围内
+	*   @details        Vb 为雷达机体坐标系内雷达到目标的向量(前，上，右)，范围边界上判为在范围内
+	*   @param[in]      window          扫过的范围
+	*   @param[in]      Vb[3]           雷达到目标的向量
+	*   @retval         true            在范围内
+	*/
+	static bool InWindow(
+		const RadarScanWindow_T&		window,
+		const double					Vb[3])
+	{
+		if (window.full) {
+			return true;
+		}
+		//(前，左)平面内向量在左右边界之间，且俯仰角在上下边界之间
+		double forward = Vb[0];
+		double left = -Vb[2];
+		double horizontal = sqrt(forward * forward + left * left);
+		for (int k = 0; k < window.box_count; k++) {
+			if (window.right_cos[k] * left - window.right_sin[k] * forward >= 0 &&
+				window.left_sin[k] * forward - window.left_cos[k] * left >= 0 &&
+				Vb[1] >= window.tan_low[k] * horizontal && Vb[1] <= window.tan_high[k] * horizontal) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+private:
+	RadarScanParam_T				param;
+	int								column_count;					//每行的波位数
+	double							column_step;					//方位上的波位间隔
+
+	//在一行内加入第 first ~ last 个波位(按方位从左到右编号)
+	void AddBox(
+		RadarScanWindow_T*				window,
+		int								bar,
+		int								first,
+		int								last) const;
+
+	//行的俯仰角
+	double BarPitch(int bar) const;
+};
+
+#endif // RADAR_SCAN_H_INCLUDED
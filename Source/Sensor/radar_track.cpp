@@ -0,0 +1,351 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           radar_track.cpp
+*   @brief          雷达航迹管理。
+*   @details        雷达航迹管理。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   LiDaiwei
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*/
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           头文件。
+*   @{
+*/
+#include "radar_track.h"
+#include <stddef.h>
+/** @}  */
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           航迹管理常数。
+*   @{
+*/
+static const double time_margin = 1e-6;                 //时刻比较的余量，避免步长累加的舍入误差推迟一步探测
+/** @}  */
+
+
+//确认窗口内的发现次数
+static int HitCount(unsigned int history)
+{
+	int count = 0;
+	for (; history != 0; history >>= 1) {
+		count += (int)(history & 1);
+	}
+	return count;
+}
+
+
+RadarTrack_C::RadarTrack_C()
+{
+	SetParam(DefaultParam());
+	next_search_time = -1;
+}
+
+
+RadarTrack_C::RadarTrack_C(const RadarTrackParam_T& in_param)
+{
+	if (SetParam(in_param) != 0) {
+		SetParam(DefaultParam());
+	}
+	next_search_time = -1;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          设置航迹管理参数
+*   @details        不清除已有航迹
+*   @param[in]      in_param        航迹管理参数
+*   @retval         0               正常
+*   @retval         1               错误，参数无效，保留原参数
+*/
+int RadarTrack_C::SetParam(const RadarTrackParam_T& in_param)
+{
+	if (in_param.confirm_window < 1 || in_param.confirm_window > RADAR_TRACK_MAX_WINDOW ||
+		in_param.confirm_hits < 1 || in_param.confirm_hits > in_param.confirm_window ||
+		in_param.drop_misses < 1 ||
+		!(in_param.alpha > 0 && in_param.alpha <= 1) || !(in_param.beta >= 0 && in_param.beta < 2) ||
+		!(in_param.revisit_time >= 0) || !(in_param.max_coast_time >= 0)) {
+		return 1;
+	}
+
+	param = in_param;
+	window_mask = (param.confirm_window < 32) ? (1u << param.confirm_window) - 1 : 0xFFFFFFFFu;
+
+	return 0;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          航迹管理默认参数
+*   @details        alpha 取0.5，beta 按 Kalata 关系 2(2-alpha)-4sqrt(1-alpha) 取0.17
+*/
+RadarTrackParam_T RadarTrack_C::DefaultParam()
+{
+	RadarTrackParam_T p;
+	p.confirm_hits = 2;
+	p.confirm_window = 3;
+	p.drop_misses = 3;
+	p.alpha = 0.5;
+	p.beta = 0.17;
+	p.revisit_time = 1.0;
+	p.max_coast_time = 4.0;
+
+	return p;
+}
+
+
+void RadarTrack_C::Clear()
+{
+	track_list.clear();
+	next_search_time = -1;
+}
+
+
+int RadarTrack_C::FindIndex(int target_id) const
+{
+	for (int k = 0; k < (int)track_list.size(); k++) {
+		if (track_list[k].target_id == target_id) {
+			return k;
+		}
+	}
+	return -1;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          按目标编号查找航迹
+*   @details        按目标编号查找航迹
+*   @param[in]      target_id       目标编号
+*   @retval         航迹，没有时为 NULL
+*/
+const RadarTrack_T* RadarTrack_C::Find(int target_id) const
+{
+	int index = FindIndex(target_id);
+	return (index >= 0) ? &track_list[index] : NULL;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          本步是否需要探测该目标
+*   @details        锁定的目标每步探测，有航迹的目标到重新探测时刻时探测，无航迹的目标到搜索时刻时探测
+*   @param[in]      target_id       目标编号
+*   @param[in]      time            当前时刻
+*   @retval         true            需要探测
+*/
+bool RadarTrack_C::NeedDetect(
+	int								target_id,
+	double							time) const
+{
+	const RadarTrack_T* track = Find(target_id);
+	if (track == NULL) {
+		return time >= next_search_time - time_margin;
+	}
+	return track->locked || time >= track->next_detect_time - time_margin;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          写入一次探测结果
+*   @details        无航迹的目标发现时建立暂定航迹，未发现时不处理；有航迹时更新确认窗口并做 alpha-beta 滤波：
+*                   第二次发现时由两点差分给出速度初值，之后按 alpha、beta 修正外推值
+*   @param[in]      target_id       目标编号
+*   @param[in]      detected        是否发现
+*   @param[in]      position[3]     目标位置，未发现时可为 NULL
+*   @param[in]      time            当前时刻
+*   @retval         0               正常
+*/
+int RadarTrack_C::Update(
+	int								target_id,
+	bool							detected,
+	const double					position[3],
+	double							time)
+{
+	int index = FindIndex(target_id);
+	if (index < 0) {
+		if (!detected) {
+			return 0;
+		}
+		RadarTrack_T track;
+		track.target_id = target_id;
+		track.state = (param.confirm_hits <= 1) ? RADAR_TRACK_CONFIRMED : RADAR_TRACK_TENTATIVE;
+		track.locked = false;
+		track.hit_history = 1;
+		track.detect_count = 1;
+		track.hit_count = 1;
+		track.miss_count = 0;
+		for (int k = 0; k < 3; k++) {
+			track.position[k] = position[k];
+			track.velocity[k] = 0;
+		}
+		track.update_time = time;
+		track.next_detect_time = time + param.revisit_time;
+		track_list.push_back(track);
+		return 0;
+	}
+
+	RadarTrack_T& track = track_list[index];
+	track.hit_history = ((track.hit_history << 1) | (detected ? 1u : 0u)) & window_mask;
+	track.detect_count++;
+	track.next_detect_time = time + param.revisit_time;
+	if (!detected) {
+		track.miss_count++;
+		return 0;
+	}
+
+	double dt = time - track.update_time;
+	for (int k = 0; k < 3; k++) {
+		if (!(dt > 0)) {
+			track.position[k] = position[k];
+		}
+		else if (track.hit_count == 1) {
+			track.velocity[k] = (position[k] - track.position[k]) / dt;
+			track.position[k] = position[k];
+		}
+		else {
+			double predicted = track.position[k] + track.velocity[k] * dt;
+			double residual = position[k] - predicted;
+			track.position[k] = predicted + param.alpha * residual;
+			track.velocity[k] += param.beta / dt * residual;
+		}
+	}
+	track.update_time = time;
+	track.hit_count++;
+	track.miss_count = 0;
+	if (track.state == RADAR_TRACK_TENTATIVE && HitCount(track.hit_history) >= param.confirm_hits) {
+		track.state = RADAR_TRACK_CONFIRMED;
+	}
+
+	return 0;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          一步结束
+*   @details        删除未通过确认或丢失的航迹：暂定航迹探测满一个确认窗口仍未确认时删除，
+*                   确认航迹连续 drop_misses 次未发现或外推超过 max_coast_time 时删除；到搜索时刻时安排下一次搜索
+*   @param[in]      time            当前时刻
+*   @retval         0               正常
+*/
+int RadarTrack_C::Step(double time)
+{
+	size_t keep = 0;
+	for (size_t k = 0; k < track_list.size(); k++) {
+		const RadarTrack_T& track = track_list[k];
+		bool drop = false;
+		if (track.state == RADAR_TRACK_TENTATIVE) {
+			drop = track.detect_count >= param.confirm_window && HitCount(track.hit_history) < param.confirm_hits;
+		}
+		else {
+			drop = track.miss_count >= param.drop_misses || time - track.update_time > param.max_coast_time;
+		}
+		if (!drop) {
+			track_list[keep++] = track;
+		}
+	}
+	track_list.resize(keep);
+
+	if (time >= next_search_time - time_margin) {
+		next_search_time = time + param.revisit_time;
+	}
+
+	return 0;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          锁定目标
+*   @details        只能锁定确认航迹，锁定后每步探测
+*   @param[in]      target_id       目标编号
+*   @retval         0               正常
+*   @retval         1               错误，没有该目标的确认航迹
+*/
+int RadarTrack_C::Lock(int target_id)
+{
+	int index = FindIndex(target_id);
+	if (index < 0 || track_list[index].state != RADAR_TRACK_CONFIRMED) {
+		return 1;
+	}
+	track_list[index].locked = true;
+	return 0;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          解除锁定
+*   @details        恢复按重新探测间隔探测
+*   @param[in]      target_id       目标编号
+*   @param[in]      time            当前时刻
+*   @retval         0               正常
+*   @retval         1               错误，没有该目标的航迹
+*/
+int RadarTrack_C::Unlock(
+	int								target_id,
+	double							time)
+{
+	int index = FindIndex(target_id);
+	if (index < 0) {
+		return 1;
+	}
+	track_list[index].locked = false;
+	track_list[index].next_detect_time = time + param.revisit_time;
+	return 0;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          外推航迹位置
+*   @details        按匀速模型外推到 time 时刻
+*   @param[out]     position[3]     外推位置
+*   @param[in]      track           航迹
+*   @param[in]      time            时刻
+*   @retval         0               正常
+*/
+int RadarTrack_C::Extrapolate(
+	double							position[3],
+	const RadarTrack_T&				track,
+	double							time)
+{
+	double dt = time - track.update_time;
+	for (int k = 0; k < 3; k++) {
+		position[k] = track.position[k] + track.velocity[k] * dt;
+	}
+	return 0;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          确认航迹的目标编号
+*   @details        可直接填写 Aircraft_Object_C 的 locked_id_list
+*   @param[out]     id_list         目标编号
+*   @param[in]      max_count       id_list 的长度
+*   @retval         写入的目标数
+*/
+int RadarTrack_C::ConfirmedList(
+	int*							id_list,
+	int								max_count) const
+{
+	int count = 0;
+	for (size_t k = 0; k < track_list.size() && count < max_count; k++) {
+		if (track_list[k].state == RADAR_TRACK_CONFIRMED) {
+			id_list[count++] = track_list[k].target_id;
+		}
+	}
+	return count;
+}
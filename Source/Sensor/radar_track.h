@@ -0,0 +1,228 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           radar_track.h
+*   @brief          雷达航迹管理。
+*   @details        每部雷达一张航迹表。探测结果先建立暂定航迹，最近 confirm_window 次探测中发现 confirm_hits 次后确认；
+*                   确认航迹连续 drop_misses 次未发现或外推超过 max_coast_time 后删除，确认和删除的条件不同，输出不会逐步跳变。
+*                   航迹用 alpha-beta 滤波(匀速模型)估计位置和速度，两次探测之间按匀速外推。
+*                   探测不再每步进行：已有航迹的目标每隔 revisit_time 重新探测，无航迹的目标按同一间隔搜索，
+*                   锁定的目标每步探测。每步先用 NeedDetect 选出要探测的目标，探测后 Update，最后 Step。
+*                   位置、速度的坐标系与探测输入相同，一般为雷达所用的(北，天，东)。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   LiDaiwei
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*/
+
+#ifndef RADAR_TRACK_H_INCLUDED
+#define RADAR_TRACK_H_INCLUDED
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           被使用的头文件。
+*   @{
+*/
+#include <vector>
+/** @}  */
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           航迹状态宏定义。
+*   @{
+*/
+#define RADAR_TRACK_TENTATIVE 1          //暂定航迹
+#define RADAR_TRACK_CONFIRMED 2          //确认航迹
+#define RADAR_TRACK_MAX_WINDOW 32        //确认窗口的最大次数
+/** @}  */
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          航迹管理参数。
+*   @details        时间单位：秒。
+*/
+struct RadarTrackParam_T
+{
+	int								confirm_hits;					//!< 确认所需的发现次数 M
+	int								confirm_window;					//!< 确认窗口的探测次数 N，不超过 RADAR_TRACK_MAX_WINDOW
+	int								drop_misses;					//!< 确认航迹连续未发现多少次后删除
+	double							alpha;							//!< 位置滤波系数
+	double							beta;							//!< 速度滤波系数
+	double							revisit_time;					//!< 重新探测的间隔，扫描雷达可取帧时间
+	double							max_coast_time;					//!< 最长外推时间，超过后删除航迹
+};
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          一条航迹。
+*   @details        position、velocity 为 update_time 时刻的估计值。
+*/
+struct RadarTrack_T
+{
+	int								target_id;						//!< 目标编号
+	int								state;							//!< RADAR_TRACK_TENTATIVE 或 RADAR_TRACK_CONFIRMED
+	bool							locked;							//!< 是否锁定
+	unsigned int					hit_history;					//!< 最近各次探测结果，最低位为最近一次，1 表示发现
+	int								detect_count;					//!< 探测次数
+	int								hit_count;						//!< 发现次数
+	int								miss_count;						//!< 连续未发现次数
+	double							position[3];					//!< 位置估计
+	double							velocity[3];					//!< 速度估计
+	double							update_time;					//!< 最近一次发现的时刻
+	double							next_detect_time;				//!< 下一次探测的时刻
+};
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          雷达航迹表。
+*   @details        一部雷达一个对象，不能在多个线程中同时修改。
+*/
+class RadarTrack_C
+{
+public:
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          创建航迹表
+	*   @details        使用默认参数
+	*/
+	RadarTrack_C();
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          创建航迹表
+	*   @details        参数无效时使用默认参数
+	*   @param[in]      in_param        航迹管理参数
+	*/
+	explicit RadarTrack_C(const RadarTrackParam_T& in_param);
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          设置航迹管理参数
+	*   @details        不清除已有航迹
+	*   @param[in]      in_param        航迹管理参数
+	*   @retval         0               正常
+	*   @retval         1               错误，参数无效，保留原参数
+	*/
+	int SetParam(const RadarTrackParam_T& in_param);
+
+	const RadarTrackParam_T& Param() const { return param; }
+
+	//默认参数：3次中发现2次确认，连续3次未发现删除，每秒探测一次
+	static RadarTrackParam_T DefaultParam();
+
+	//清除全部航迹，下一步立即搜索
+	void Clear();
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          本步是否需要探测该目标
+	*   @details        锁定的目标每步探测，有航迹的目标到重新探测时刻时探测，无航迹的目标到搜索时刻时探测
+	*   @param[in]      target_id       目标编号
+	*   @param[in]      time            当前时刻
+	*   @retval         true            需要探测
+	*/
+	bool NeedDetect(
+		int								target_id,
+		double							time) const;
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          写入一次探测结果
+	*   @details        无航迹的目标发现时建立暂定航迹，未发现时不处理；有航迹时更新确认窗口并做 alpha-beta 滤波
+	*   @param[in]      target_id       目标编号
+	*   @param[in]      detected        是否发现
+	*   @param[in]      position[3]     目标位置，未发现时可为 NULL
+	*   @param[in]      time            当前时刻
+	*   @retval         0               正常
+	*/
+	int Update(
+		int								target_id,
+		bool							detected,
+		const double					position[3],
+		double							time);
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          一步结束
+	*   @details        删除未通过确认或丢失的航迹，到搜索时刻时安排下一次搜索
+	*   @param[in]      time            当前时刻
+	*   @retval         0               正常
+	*/
+	int Step(double time);
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          锁定目标
+	*   @details        只能锁定确认航迹，锁定后每步探测
+	*   @param[in]      target_id       目标编号
+	*   @retval         0               正常
+	*   @retval         1               错误，没有该目标的确认航迹
+	*/
+	int Lock(int target_id);
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          解除锁定
+	*   @details        恢复按重新探测间隔探测
+	*   @param[in]      target_id       目标编号
+	*   @param[in]      time            当前时刻
+	*   @retval         0               正常
+	*   @retval         1               错误，没有该目标的航迹
+	*/
+	int Unlock(
+		int								target_id,
+		double							time);
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          按目标编号查找航迹
+	*   @details        按目标编号查找航迹
+	*   @param[in]      target_id       目标编号
+	*   @retval         航迹，没有时为 NULL
+	*/
+	const RadarTrack_T* Find(int target_id) const;
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          外推航迹位置
+	*   @details        按匀速模型外推到 time 时刻
+	*   @param[out]     position[3]     外推位置
+	*   @param[in]      track           航迹
+	*   @param[in]      time            时刻
+	*   @retval         0               正常
+	*/
+	static int Extrapolate(
+		double							position[3],
+		const RadarTrack_T&				track,
+		double							time);
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          确认航迹的目标编号
+	*   @details        可直接填写 Aircraft_Object_C 的 locked_id_list
+	*   @param[out]     id_list         目标编号
+	*   @param[in]      max_count       id_list 的长度
+	*   @retval         写入的目标数
+	*/
+	int ConfirmedList(
+		int*							id_list,
+		int								max_count) const;
+
+	int TrackCount() const { return (int)track_list.size(); }
+	const RadarTrack_T& Track(int index) const { return track_list[index]; }
+
+private:
+	RadarTrackParam_T				param;
+	std::vector<RadarTrack_T>		track_list;
+	double							next_search_time;				//下一次搜索的时刻，<0 表示立即搜索
+	unsigned int					window_mask;					//确认窗口内各次探测结果的掩码
+
+	int FindIndex(int target_id) const;
+};
+
+#endif // RADAR_TRACK_H_INCLUDED
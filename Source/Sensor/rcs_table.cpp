@@ -0,0 +1,282 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           rcs_table.cpp
+*   @brief          目标RCS表。
+*   @details        目标RCS表。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   LiDaiwei
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*/
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           头文件。
+*   @{
+*/
+#include "rcs_table.h"
+#include "radar.h"
+#include "../Tools/tool_function.h"
+#include <stdio.h>
+#include <string.h>
+/** @}  */
+
+
+//打开普通文件
+static FILE* OpenStream(const char* path, const char* mode)
+{
+	FILE* file = NULL;
+#ifdef _WIN32
+	if (fopen_s(&file, path, mode) != 0) {
+		return NULL;
+	}
+#else
+	file = fopen(path, mode);
+#endif
+	return file;
+}
+
+
+RcsTable_C::RcsTable_C()
+{
+	memset(name, 0, sizeof(name));
+	azimuth_count = 0;
+	pitch_count = 0;
+	row_size = 0;
+	inv_azimuth_step = 0;
+	inv_pitch_step = 0;
+	pitch_origin = 0.5 * M_PI;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          由网格数据生成表
+*   @details        value 按[频段][俯仰][方位]存放，共 band_count*pitch_count*azimuth_count 个
+*   @param[in]      in_azimuth_count   方位角点数，>=2
+*   @param[in]      in_pitch_count     俯仰角点数，>=2
+*   @param[in]      band_count      频段数，>=1
+*   @param[in]      in_band_lambda     各频段波长
+*   @param[in]      value           RCS，非负
+*   @param[in]      in_name            机型名，可为 NULL
+*   @retval         0               正常
+*   @retval         1               错误，参数无效
+*/
+int RcsTable_C::Build(
+	int								in_azimuth_count,
+	int								in_pitch_count,
+	int								band_count,
+	const double*					in_band_lambda,
+	const float*					value,
+	const char*						in_name)
+{
+	if (in_azimuth_count < 2 || in_azimuth_count > RCS_TABLE_MAX_COUNT ||
+		in_pitch_count < 2 || in_pitch_count > RCS_TABLE_MAX_COUNT ||
+		band_count < 1 || band_count > RCS_TABLE_MAX_BAND ||
+		in_band_lambda == NULL || value == NULL) {
+		return 1;
+	}
+	size_t value_count = (size_t)band_count * in_pitch_count * in_azimuth_count;
+	for (size_t k = 0; k < value_count; k++) {
+		//NaN 也不通过
+		if (!(value[k] >= 0)) {
+			return 1;
+		}
+	}
+
+	//机型名超长时截断
+	memset(name, 0, sizeof(name));
+	if (in_name != NULL) {
+		size_t length = strlen(in_name);
+		length = (length < RCS_TABLE_NAME_SIZE - 1) ? length : RCS_TABLE_NAME_SIZE - 1;
+		memcpy(name, in_name, length);
+	}
+	azimuth_count = in_azimuth_count;
+	pitch_count = in_pitch_count;
+	row_size = azimuth_count + 1;
+	inv_azimuth_step = azimuth_count / (2 * M_PI);
+	inv_pitch_step = (pitch_count - 1) / M_PI;
+
+	band_lambda.assign(in_band_lambda, in_band_lambda + band_count);
+	band_max.assign(band_count, 0.0);
+	value_list.resize((size_t)band_count * pitch_count * row_size);
+	for (int b = 0; b < band_count; b++) {
+		for (int j = 0; j < pitch_count; j++) {
+			const float* src = value + ((size_t)b * pitch_count + j) * azimuth_count;
+			float* dst = &value_list[((size_t)b * pitch_count + j) * row_size];
+			for (int i = 0; i < azimuth_count; i++) {
+				dst[i] = src[i];
+				band_max[b] = (src[i] > band_max[b]) ? src[i] : band_max[b];
+			}
+			dst[azimuth_count] = src[0];
+		}
+	}
+
+	return 0;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          由5个RCS典型值生成表
+*   @details        只有一个频段，网格点上的值由 getTargetRCS 算出
+*   @param[in]      SigimaType[5]   目标的5个RCS典型值(+x,-x,+y,-z,z)
+*   @param[in]      in_azimuth_count   方位角点数，>=2
+*   @param[in]      in_pitch_count     俯仰角点数，>=2
+*   @param[in]      lambda          频段波长
+*   @param[in]      in_name            机型名，可为 NULL
+*   @retval         0               正常
+*   @retval         1               错误，点数无效
+*/
+int RcsTable_C::BuildFromSigmaType(
+	const double					SigimaType[5],
+	int								in_azimuth_count,
+	int								in_pitch_count,
+	double							lambda,
+	const char*						in_name)
+{
+	if (SigimaType == NULL || in_azimuth_count < 2 || in_azimuth_count > RCS_TABLE_MAX_COUNT ||
+		in_pitch_count < 2 || in_pitch_count > RCS_TABLE_MAX_COUNT) {
+		return 1;
+	}
+
+	std::vector<float> value((size_t)in_pitch_count * in_azimuth_count);
+	for (int j = 0; j < in_pitch_count; j++) {
+		double pitch = -0.5 * M_PI + j * M_PI / (in_pitch_count - 1);
+		for (int i = 0; i < in_azimuth_count; i++) {
+			double azimuth = i * 2 * M_PI / in_azimuth_count;
+			double RCS = 0;
+			getTargetRCS(&RCS, azimuth, pitch, SigimaType);
+			value[(size_t)j * in_azimuth_count + i] = (float)RCS;
+		}
+	}
+
+	return Build(in_azimuth_count, in_pitch_count, 1, &lambda, &value[0], in_name);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          读入RCS表文件
+*   @details        检查文件头和文件长度，RCS须非负
+*   @param[in]      path            文件路径
+*   @retval         0               正常
+*   @retval         1               错误，文件无法打开或格式不符
+*/
+int RcsTable_C::Load(const char* path)
+{
+	if (path == NULL) {
+		return 1;
+	}
+	FILE* file = OpenStream(path, "rb");
+	if (file == NULL) {
+		return 1;
+	}
+
+	RcsTableHeader_T file_header;
+	if (fread(&file_header, sizeof(file_header), 1, file) != 1 ||
+		file_header.magic != RCS_TABLE_MAGIC || file_header.version != RCS_TABLE_VERSION ||
+		file_header.header_size != (int)sizeof(RcsTableHeader_T) ||
+		file_header.azimuth_count < 2 || file_header.azimuth_count > RCS_TABLE_MAX_COUNT ||
+		file_header.pitch_count < 2 || file_header.pitch_count > RCS_TABLE_MAX_COUNT ||
+		file_header.band_count < 1 || file_header.band_count > RCS_TABLE_MAX_BAND) {
+		fclose(file);
+		return 1;
+	}
+
+	std::vector<double> file_lambda(file_header.band_count);
+	std::vector<float> value((size_t)file_header.band_count * file_header.pitch_count * file_header.azimuth_count);
+	bool ok = fread(&file_lambda[0], sizeof(double), file_lambda.size(), file) == file_lambda.size() &&
+		fread(&value[0], sizeof(float), value.size(), file) == value.size();
+	//文件末尾不能有多余数据
+	char extra = 0;
+	ok = ok && fread(&extra, 1, 1, file) == 0;
+	fclose(file);
+	if (!ok) {
+		return 1;
+	}
+
+	file_header.name[RCS_TABLE_NAME_SIZE - 1] = 0;
+	return Build(file_header.azimuth_count, file_header.pitch_count, file_header.band_count,
+		&file_lambda[0], &value[0], file_header.name);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          写出RCS表文件
+*   @details        写出RCS表文件
+*   @param[in]      path            文件路径
+*   @retval         0               正常
+*   @retval         1               错误，表为空或文件无法写入
+*/
+int RcsTable_C::Save(const char* path) const
+{
+	if (path == NULL || Empty()) {
+		return 1;
+	}
+
+	RcsTableHeader_T file_header;
+	memset(&file_header, 0, sizeof(file_header));
+	file_header.magic = RCS_TABLE_MAGIC;
+	file_header.version = RCS_TABLE_VERSION;
+	file_header.header_size = (int)sizeof(RcsTableHeader_T);
+	file_header.azimuth_count = azimuth_count;
+	file_header.pitch_count = pitch_count;
+	file_header.band_count = BandCount();
+	memcpy(file_header.name, name, sizeof(name));
+
+	FILE* file = OpenStream(path, "wb");
+	if (file == NULL) {
+		return 1;
+	}
+
+	bool ok = fwrite(&file_header, sizeof(file_header), 1, file) == 1 &&
+		fwrite(&band_lambda[0], sizeof(double), band_lambda.size(), file) == band_lambda.size();
+	//去掉每行末尾 2pi 处的点
+	for (size_t row = 0; ok && row < (size_t)BandCount() * pitch_count; row++) {
+		ok = fwrite(&value_list[row * row_size], sizeof(float), azimuth_count, file) == (size_t)azimuth_count;
+	}
+	ok = (fclose(file) == 0) && ok;
+
+	return ok ? 0 : 1;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          取波长最接近的频段
+*   @details        取波长最接近的频段
+*   @param[in]      lambda          雷达工作波长
+*   @retval         频段下标，表为空时返回 -1
+*/
+int RcsTable_C::BandIndex(double lambda) const
+{
+	int band = -1;
+	double best = 0;
+	for (int b = 0; b < BandCount(); b++) {
+		double d = fabs(band_lambda[b] - lambda);
+		if (band < 0 || d < best) {
+			band = b;
+			best = d;
+		}
+	}
+	return band;
+}
+
+
+double RcsTable_C::WrapAzimuth(double a) const
+{
+	if (a != a) {
+		return 0;
+	}
+	a = fmod(a, (double)azimuth_count);
+	if (a < 0) {
+		a += azimuth_count;
+	}
+	//-1e-17 之类加上点数后舍入为 azimuth_count
+	return (a < azimuth_count) ? a : 0;
+}
@@ -0,0 +1,205 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           rcs_table.h
+*   @brief          目标RCS表。
+*   @details        每种机型一张表，按(频段，俯仰角，方位角)存放RCS，探测时双线性插值。
+*                   方位角、俯仰角与 getTargetRCS 相同，为雷达相对目标的探测角：方位角 0 ~ 2pi 等间隔且首尾相接，
+*                   俯仰角 -pi/2 ~ pi/2 等间隔含两端；频段按波长区分，探测时取波长最接近雷达工作波长的频段。
+*                   表从二进制文件读入，文件依次为文件头、各频段波长(double)、RCS(float，[频段][俯仰][方位])。
+*                   BuildFromSigmaType 由原来的5个RCS典型值生成表，结果在网格点上与 getTargetRCS 相同。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   LiDaiwei
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*/
+
+#ifndef RCS_TABLE_H_INCLUDED
+#define RCS_TABLE_H_INCLUDED
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           被使用的头文件。
+*   @{
+*/
+#include <stddef.h>
+#include <vector>
+/** @}  */
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           RCS表宏定义。
+*   @{
+*/
+#define RCS_TABLE_MAGIC 0x54534352       //RCS表文件标识 "RCST"
+#define RCS_TABLE_VERSION 1              //RCS表文件格式版本
+#define RCS_TABLE_NAME_SIZE 32           //机型名的最大长度，含结尾0
+#define RCS_TABLE_MAX_COUNT 4096         //方位、俯仰点数上限
+#define RCS_TABLE_MAX_BAND 16            //频段数上限
+/** @}  */
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          RCS表文件头。
+*   @details        RCS表文件头。
+*/
+struct RcsTableHeader_T
+{
+	int								magic;							//!< RCS_TABLE_MAGIC
+	int								version;						//!< RCS_TABLE_VERSION
+	int								header_size;					//!< sizeof(RcsTableHeader_T)
+	int								azimuth_count;					//!< 方位角点数，不含 2pi 处
+	int								pitch_count;					//!< 俯仰角点数，含 ±pi/2
+	int								band_count;						//!< 频段数
+	char							name[RCS_TABLE_NAME_SIZE];		//!< 机型名
+};
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          目标RCS表。
+*   @details        读入后只读，可在多个线程中同时查表，多个目标可共用一张表。
+*/
+class RcsTable_C
+{
+public:
+	RcsTable_C();
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          读入RCS表文件
+	*   @details        检查文件头和文件长度，RCS须非负
+	*   @param[in]      path            文件路径
+	*   @retval         0               正常
+	*   @retval         1               错误，文件无法打开或格式不符
+	*/
+	int Load(const char* path);
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          写出RCS表文件
+	*   @details        写出RCS表文件
+	*   @param[in]      path            文件路径
+	*   @retval         0               正常
+	*   @retval         1               错误，表为空或文件无法写入
+	*/
+	int Save(const char* path) const;
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          由5个RCS典型值生成表
+	*   @details        只有一个频段，网格点上的值由 getTargetRCS 算出
+	*   @param[in]      SigimaType[5]   目标的5个RCS典型值(+x,-x,+y,-z,z)
+	*   @param[in]      in_azimuth_count   方位角点数，>=2
+	*   @param[in]      in_pitch_count     俯仰角点数，>=2
+	*   @param[in]      lambda          频段波长
+	*   @param[in]      in_name            机型名，可为 NULL
+	*   @retval         0               正常
+	*   @retval         1               错误，点数无效
+	*/
+	int BuildFromSigmaType(
+		const double					SigimaType[5],
+		int								in_azimuth_count,
+		int								in_pitch_count,
+		double							lambda,
+		const char*						in_name);
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          由网格数据生成表
+	*   @details        value 按[频段][俯仰][方位]存放，共 band_count*pitch_count*azimuth_count 个
+	*   @param[in]      in_azimuth_count   方位角点数，>=2
+	*   @param[in]      in_pitch_count     俯仰角点数，>=2
+	*   @param[in]      band_count      频段数，>=1
+	*   @param[in]      in_band_lambda     各频段波长
+	*   @param[in]      value           RCS，非负
+	*   @param[in]      in_name            机型名，可为 NULL
+	*   @retval         0               正常
+	*   @retval         1               错误，参数无效
+	*/
+	int Build(
+		int								in_azimuth_count,
+		int								in_pitch_count,
+		int								band_count,
+		const double*					in_band_lambda,
+		const float*					value,
+		const char*						in_name);
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          取波长最接近的频段
+	*   @details        取波长最接近的频段
+	*   @param[in]      lambda          雷达工作波长
+	*   @retval         频段下标，表为空时返回 -1
+	*/
+	int BandIndex(double lambda) const;
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          查表
+	*   @details        方位角按 2pi 周期换算，俯仰角超出 ±pi/2 时取端点，双线性插值
+	*   @param[in]      azimuth_RadarToTarget   雷达相对目标的探测方位角，0 ~ 2pi
+	*   @param[in]      pitch_RadarToTarget     雷达相对目标的探测俯仰角
+	*   @param[in]      band                    频段下标，须有效
+	*   @retval         目标RCS
+	*/
+	double Sample(
+		double							azimuth_RadarToTarget,
+		double							pitch_RadarToTarget,
+		int								band) const
+	{
+		double a = azimuth_RadarToTarget * inv_azimuth_step;
+		if (!(a >= 0 && a < azimuth_count)) {
+			a = WrapAzimuth(a);
+		}
+		int i = (int)a;
+		double u = a - i;
+
+		double p = (pitch_RadarToTarget + pitch_origin) * inv_pitch_step;
+		p = (p > 0) ? p : 0;
+		p = (p < pitch_count - 1) ? p : pitch_count - 1;
+		int j = (int)p;
+		if (j > pitch_count - 2) {
+			j = pitch_count - 2;
+		}
+		double v = p - j;
+
+		//每行多存一个 2pi 处的点，i+1 不必取模
+		const float* row0 = &value_list[((size_t)band * pitch_count + j) * row_size];
+		const float* row1 = row0 + row_size;
+		double s0 = row0[i] + (row0[i + 1] - row0[i]) * u;
+		double s1 = row1[i] + (row1[i + 1] - row1[i]) * u;
+		return s0 + (s1 - s0) * v;
+	}
+
+	bool Empty() const { return value_list.empty(); }
+	int AzimuthCount() const { return azimuth_count; }
+	int PitchCount() const { return pitch_count; }
+	int BandCount() const { return (int)band_lambda.size(); }
+	const char* Name() const { return name; }
+
+	//频段内RCS的最大值，用于最大探测距离剔除；频段无效(如表为空时 BandIndex 返回的 -1)时为0
+	double MaxValue(int band) const { return (band >= 0 && band < (int)band_max.size()) ? band_max[band] : 0; }
+
+private:
+	char							name[RCS_TABLE_NAME_SIZE];
+	int								azimuth_count;
+	int								pitch_count;
+	int								row_size;						//azimuth_count+1
+	double							inv_azimuth_step;
+	double							inv_pitch_step;
+	double							pitch_origin;					//pi/2
+
+	std::vector<double>				band_lambda;
+	std::vector<double>				band_max;
+	std::vector<float>				value_list;						//[频段][俯仰][方位+1]
+
+	//方位角下标换算到 [0, azimuth_count)
+	double WrapAzimuth(double a) const;
+};
+
+#endif // RCS_TABLE_H_INCLUDED
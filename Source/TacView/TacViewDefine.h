@@ -70,7 +70,7 @@ namespace TacView
 	{
 		int  							id;								//!< 编号，唯一标识
 
-		int  							live;							//!< 存在，0 不存在，1 存在
+		int  							live;							//!< 存在，0 不存在(输出移除)，1 存在，-1 已移除(不再输出)
 
 		int								coordinate_valid;				//!< 坐标，有效性，0 无效，1 有效
 		int								coordinate_type;				//!< 坐标，类型，0 LLA，1 LLAUV，2 LLARPY，3 LLARPYUVH
@@ -19,14 +19,6 @@
 
 using namespace TacView;
 
-// --------------------------------------------------------------------------------------------------------------------------------
-/**
-*   @name           静态变量。
-*   @{
-*/
-char                            TacViewFile_T::file_str[net_buffer_size];      
-/** @}  */
-
 // --------------------------------------------------------------------------------------------------------------------------------
 /**
 *   @brief          构造函数。
@@ -110,7 +102,6 @@ int TacViewFile_T::Close()
 	fclose(m_file);
 	m_file = NULL;
 
-	delete[] file_str;
 	return 0;
 }
 
@@ -222,6 +213,12 @@ int TacViewFile_T::BuildString(
 	strcat_s(string, sizeof(char) * string_length, file_str_line);
 	for (int index = 0; index < state.object_count && index < max_object; index++)
 	{
+		// 已移除
+		if (state.object[index].live == -1)
+		{
+			continue;
+		}
+
 		// id
 		snprintf(file_str_line, sizeof(file_str_line), "%d,", state.object[index].id);
 		strcat_s(string, sizeof(char) * string_length, file_str_line);
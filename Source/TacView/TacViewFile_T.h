@@ -126,7 +126,7 @@ namespace TacView
 	private:
 
 		FILE*							m_file;							//!< 保存的文件
-		static char                     file_str[net_buffer_size];      //!< 保存缓存。
+		char                            file_str[net_buffer_size];      //!< 保存缓存。
 	};
 }
 
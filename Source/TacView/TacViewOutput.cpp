@@ -5,11 +5,12 @@
 *   @details        TacView 实体及事件更新，详见 ACMI 格式说明。
 *   @author         lidaiwei
 *   @date           20200808
-*   @version        1.0.0.1
+*   @version        1.0.0.2
 *   @par Copyright
 *                   GaoYang
 *   @par History
 *                   1.0.0.1: lidaiwei, 20200808, 首次创建
+*                   1.0.0.2: agent, 20261018, 雷达波束宽度改为按飞机给出
 */
 #include "TacViewOutput.h"
 #include <time.h>
@@ -27,6 +28,11 @@ TacViewOutput::TacViewOutput()
 
 	state->object_count = 0;
 	state->event_count = 0;
+	for (int index = 0; index < max_object; index++) {
+		state->object[index].live = -1;
+	}
+
+	memset(flight_live_last, 0, sizeof(flight_live_last));
 }
 
 TacViewOutput::~TacViewOutput() 
@@ -144,7 +150,9 @@ int TacViewOutput::InitOneObject(
 
 	(*state).object[object_id].live = 1;
 
-	(*state).object_count++;
+	if ((*state).object_count < object_id + 1) {
+		(*state).object_count = object_id + 1;
+	}
 
 	//(*server).Send(*state);
 	return 0;
@@ -167,6 +175,13 @@ int TacViewOutput::SendOneFrame(
 
 	(*server).Send(*state);
 
+	//已发送过移除的实体之后不再输出
+	for (int index = 0; index < (*state).object_count && index < max_object; index++) {
+		if ((*state).object[index].live == 0) {
+			(*state).object[index].live = -1;
+		}
+	}
+
 	//memset(state, 0, sizeof((*state)));
 	(*state).event_count = 0;
 	(*state).object_count = 0;
@@ -191,6 +206,8 @@ int TacViewOutput::SendOneFrame(
 *   @param[in]      flight_locked_target_id     雷达锁定目标的仿真唯一ID（负数表示没有锁定任何目标）
 *   @param[in]      flight_radar_azimuth        雷达波束方向 方位角 单位 度
 *   @param[in]      flight_radar_elevation      雷达波束方向 俯仰角 单位 度
+*   @param[in]      flight_radar_horizontal_beamwidth   雷达波束宽度 单位 度
+*   @param[in]      flight_radar_vertical_beamwidth     雷达波束高度 单位 度
 *   @retval         0               正常
 *   @retval         1               错误
 */
@@ -207,17 +224,22 @@ int TacViewOutput::OneFrameFlightState(
 	bool radar_opened,
 	int flight_locked_target_id,
 	double flight_radar_azimuth,
-	double flight_radar_elevation)
+	double flight_radar_elevation,
+	double flight_radar_horizontal_beamwidth,
+	double flight_radar_vertical_beamwidth)
 {
-		(*state).object_count++;
-
-		static bool flight_live_last[max_object] = { 0 };//记录飞机上一时刻存活状态
+		//实体数取本帧出现的最大编号+1，未更新的已移除实体不再输出
+		if ((*state).object_count < object_id + 1) {
+			(*state).object_count = object_id + 1;
+		}
 
         (*state).object[object_id].id = flight_id;
 		if(flight_live == 1){
 			(*state).object[object_id].live = 1; 
 		}else{
-			(*state).object[object_id].live = 0; 
+			if ((*state).object[object_id].live == 1) {
+				(*state).object[object_id].live = 0;
+			}
 			if (flight_live_last[object_id]) {//被摧毁的瞬间上报事件
 				(*state).event_count++;
 				strcpy_s((*state).event[(*state).event_count - 1].type, max_str, "Destroyed");
@@ -249,8 +271,8 @@ int TacViewOutput::OneFrameFlightState(
 			}else{
 				(*state).object[object_id].radar_valid = 1;
 				(*state).object[object_id].radar_mode  = 1;
-				(*state).object[object_id].radar_horizontal_beamwidth = RADAR_BEAMWIDTH;
-				(*state).object[object_id].radar_vertical_beamwidth   = RADAR_BEAMWIDTH;
+				(*state).object[object_id].radar_horizontal_beamwidth = flight_radar_horizontal_beamwidth;
+				(*state).object[object_id].radar_vertical_beamwidth   = flight_radar_vertical_beamwidth;
 				(*state).object[object_id].radar_range = RADAR_RANGE;
 
 				(*state).object[object_id].radar_azimuth = flight_radar_azimuth;
@@ -307,7 +329,9 @@ int TacViewOutput::OneFrameMissileState(
     double yaw,
 	int missile_target_id)
 {
-	(*state).object_count++;
+	if ((*state).object_count < object_id + 1) {
+		(*state).object_count = object_id + 1;
+	}
 
 	(*state).object[object_id].id = missile_id;
 	if (std::count(List_missile_id.begin(), List_missile_id.end(), missile_id) == 0) {
@@ -347,7 +371,7 @@ int TacViewOutput::OneFrameMissileState(
 			(*state).object[object_id].locked_target_mode  = 0;			
 		}			
 	}
-	else{
+	else if ((*state).object[object_id].live == 1) {
 		(*state).object[object_id].live = 0; 
 	}
         
@@ -5,11 +5,12 @@
 *   @details        TacView 实体及事件更新，详见 ACMI 格式说明。
 *   @author         lidaiwei
 *   @date           20200808
-*   @version        1.0.0.1
+*   @version        1.0.0.2
 *   @par Copyright
 *                   GaoYang
 *   @par History
 *                   1.0.0.1: lidaiwei, 20200808, 首次创建
+*                   1.0.0.2: agent, 20261018, 雷达波束宽度改为按飞机给出
 */
 
 #ifndef  TacViewOutput_H
@@ -29,7 +30,7 @@
 namespace TacView
 {
     #define RADAR_RANGE 8000	   //雷达扫描范围，单位 米
-    #define RADAR_BEAMWIDTH 1.5	   //雷达波束宽度，单位 度
+    #define RADAR_BEAMWIDTH 1.5	   //雷达波束宽度默认值，单位 度
 }
 
 class TacViewOutput
@@ -123,6 +124,8 @@ public:
 	*   @param[in]      flight_locked_target_id     雷达锁定目标的仿真唯一ID（负数表示没有锁定任何目标）
 	*   @param[in]      flight_radar_azimuth        雷达波束方向 方位角 单位 度
 	*   @param[in]      flight_radar_elevation      雷达波束方向 俯仰角 单位 度
+	*   @param[in]      flight_radar_horizontal_beamwidth   雷达波束宽度 单位 度，可取 RadarScan_C 的波束宽度
+	*   @param[in]      flight_radar_vertical_beamwidth     雷达波束高度 单位 度
 	*   @retval         0               正常
 	*   @retval         1               错误
 	*/
@@ -139,7 +142,9 @@ public:
 		bool radar_opened,
 		int flight_locked_target_id,
 		double flight_radar_azimuth,
-		double flight_radar_elevation);
+		double flight_radar_elevation,
+		double flight_radar_horizontal_beamwidth = RADAR_BEAMWIDTH,
+		double flight_radar_vertical_beamwidth = RADAR_BEAMWIDTH);
 
 
 	// --------------------------------------------------------------------------------------------------------------------------------
@@ -179,6 +184,7 @@ public:
 
 private:
 	std::vector<int> List_missile_id;
+	bool flight_live_last[max_object];		//记录飞机上一时刻存活状态
 };
 
 
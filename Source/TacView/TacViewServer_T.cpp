@@ -22,28 +22,6 @@
 
 using namespace TacView;
 
-// --------------------------------------------------------------------------------------------------------------------------------
-/**
-*   @name           静态变量。
-*   @{
-*/
-bool							TacViewServer_T::m_open = false;
-HANDLE							TacViewServer_T::m_idle = NULL;
-SOCKET							TacViewServer_T::m_server_socket = NULL;
-HANDLE							TacViewServer_T::m_listen_thread = NULL;
-
-std::list<int>					TacViewServer_T::m_client_id_idle_list;
-std::list<int>					TacViewServer_T::m_client_id_work_list;
-SOCKET							TacViewServer_T::m_client_socket_list[4];
-HANDLE							TacViewServer_T::m_recv_thread_list[4];
-char							TacViewServer_T::m_recv_buffer_list[4][max_str];
-HANDLE							TacViewServer_T::m_send_thread = NULL;
-HANDLE							TacViewServer_T::m_send_message_nonempty = NULL;
-std::list<std::string>			TacViewServer_T::m_send_message_list;
-std::string						TacViewServer_T::m_send_history;
-char                            TacViewServer_T::file_str[net_buffer_size];      
-/** @}  */
-
 // --------------------------------------------------------------------------------------------------------------------------------
 /**
 *   @brief          构造函数。
@@ -273,8 +251,6 @@ int TacViewServer_T::Close()
 	// 改变打开状态
 	m_open = false;
 
-	delete[] file_str;
-
 	return 0;
 }
 
@@ -311,44 +287,44 @@ int TacViewServer_T::Send(
 /**
 *   @brief          监听。
 *   @details        监听，对连入的客户端进行管理。
-*   @param[in]      para            多线程注册函数格式要求，创建线程时可传入参数。
+*   @param[in]      para            多线程注册函数格式要求，传入服务器对象指针。
 *   @retval         0               正常
 *   @retval         1               错误
 */
 unsigned long __stdcall TacViewServer_T::Listen(
 	void* para)
 {
-	UNREFERENCED_PARAMETER(para);
+	TacViewServer_T* server = (TacViewServer_T*)para;
 
 	while (1)
 	{
 		sockaddr_in sock_client;
 		int sock_client_len = sizeof(SOCKADDR);
 
-		SOCKET socket_client = accept(m_server_socket, (SOCKADDR*)&sock_client, &sock_client_len);
+		SOCKET socket_client = accept(server->m_server_socket, (SOCKADDR*)&sock_client, &sock_client_len);
 		
 		if (socket_client != INVALID_SOCKET)
 		{
 			// 有新连接客户端
-			::WaitForSingleObject(m_idle, INFINITE);
+			::WaitForSingleObject(server->m_idle, INFINITE);
 
 			// 开启接收线程
-			if (m_client_id_idle_list.empty() != true)
+			if (server->m_client_id_idle_list.empty() != true)
 			{
-				int client_id = m_client_id_idle_list.front();
-				m_client_id_idle_list.pop_front();
+				int client_id = server->m_client_id_idle_list.front();
+				server->m_client_id_idle_list.pop_front();
 
 				switch (client_id)
 				{
 				case 0:
 				{
 					unsigned long thread_address;
-					HANDLE receive_thread = (HANDLE)::CreateThread(NULL, 0, &Receive_0, NULL, 0, &thread_address);
+					HANDLE receive_thread = (HANDLE)::CreateThread(NULL, 0, &Receive_0, para, 0, &thread_address);
 
-					m_client_id_work_list.push_back(client_id);
-					m_client_socket_list[client_id] = socket_client;
-					m_recv_thread_list[client_id] = receive_thread;
-					memset(m_recv_buffer_list[client_id], 0, sizeof(m_recv_buffer_list[client_id]));
+					server->m_client_id_work_list.push_back(client_id);
+					server->m_client_socket_list[client_id] = socket_client;
+					server->m_recv_thread_list[client_id] = receive_thread;
+					memset(server->m_recv_buffer_list[client_id], 0, sizeof(server->m_recv_buffer_list[client_id]));
 
 					break;
 				}
@@ -356,12 +332,12 @@ unsigned long __stdcall TacViewServer_T::Listen(
 				case 1:
 				{
 					unsigned long thread_address;
-					HANDLE receive_thread = (HANDLE)::CreateThread(NULL, 0, &Receive_1, NULL, 0, &thread_address);
+					HANDLE receive_thread = (HANDLE)::CreateThread(NULL, 0, &Receive_1, para, 0, &thread_address);
 
-					m_client_id_work_list.push_back(client_id);
-					m_client_socket_list[client_id] = socket_client;
-					m_recv_thread_list[client_id] = receive_thread;
-					memset(m_recv_buffer_list[client_id], 0, sizeof(m_recv_buffer_list[client_id]));
+					server->m_client_id_work_list.push_back(client_id);
+					server->m_client_socket_list[client_id] = socket_client;
+					server->m_recv_thread_list[client_id] = receive_thread;
+					memset(server->m_recv_buffer_list[client_id], 0, sizeof(server->m_recv_buffer_list[client_id]));
 
 					break;
 				}
@@ -369,12 +345,12 @@ unsigned long __stdcall TacViewServer_T::Listen(
 				case 2:
 				{
 					unsigned long thread_address;
-					HANDLE receive_thread = (HANDLE)::CreateThread(NULL, 0, &Receive_2, NULL, 0, &thread_address);
+					HANDLE receive_thread = (HANDLE)::CreateThread(NULL, 0, &Receive_2, para, 0, &thread_address);
 
-					m_client_id_work_list.push_back(client_id);
-					m_client_socket_list[client_id] = socket_client;
-					m_recv_thread_list[client_id] = receive_thread;
-					memset(m_recv_buffer_list[client_id], 0, sizeof(m_recv_buffer_list[client_id]));
+					server->m_client_id_work_list.push_back(client_id);
+					server->m_client_socket_list[client_id] = socket_client;
+					server->m_recv_thread_list[client_id] = receive_thread;
+					memset(server->m_recv_buffer_list[client_id], 0, sizeof(server->m_recv_buffer_list[client_id]));
 
 					break;
 				}
@@ -382,12 +358,12 @@ unsigned long __stdcall TacViewServer_T::Listen(
 				case 3:
 				{
 					unsigned long thread_address;
-					HANDLE receive_thread = (HANDLE)::CreateThread(NULL, 0, &Receive_3, NULL, 0, &thread_address);
+					HANDLE receive_thread = (HANDLE)::CreateThread(NULL, 0, &Receive_3, para, 0, &thread_address);
 
-					m_client_id_work_list.push_back(client_id);
-					m_client_socket_list[client_id] = socket_client;
-					m_recv_thread_list[client_id] = receive_thread;
-					memset(m_recv_buffer_list[client_id], 0, sizeof(m_recv_buffer_list[client_id]));
+					server->m_client_id_work_list.push_back(client_id);
+					server->m_client_socket_list[client_id] = socket_client;
+					server->m_recv_thread_list[client_id] = receive_thread;
+					memset(server->m_recv_buffer_list[client_id], 0, sizeof(server->m_recv_buffer_list[client_id]));
 
 					break;
 				}
@@ -410,9 +386,9 @@ unsigned long __stdcall TacViewServer_T::Listen(
 			int send_data_size = send(socket_client, file_str_line, strlen(file_str_line) + 1, 0);
 
 			// 发送历史数据
-			send_data_size = send(socket_client, m_send_history.c_str(), m_send_history.length(), 0);
+			send_data_size = send(socket_client, server->m_send_history.c_str(), server->m_send_history.length(), 0);
 
-			::SetEvent(m_idle);
+			::SetEvent(server->m_idle);
 		}
 		else
 		{
@@ -428,14 +404,14 @@ unsigned long __stdcall TacViewServer_T::Listen(
 /**
 *   @brief          接收数据。
 *   @details        接收数据，每个客户端都在独立线程中运行。
-*   @param[in]      para            多线程注册函数格式要求，创建线程时可传入参数。
+*   @param[in]      para            多线程注册函数格式要求，传入服务器对象指针。
 *   @retval         0               正常
 *   @retval         1               错误
 */
 unsigned long __stdcall TacViewServer_T::Receive_0(
 	void* para)
 {
-	UNREFERENCED_PARAMETER(para);
+	TacViewServer_T* server = (TacViewServer_T*)para;
 
 	int client_id = 0;
 
@@ -443,15 +419,15 @@ unsigned long __stdcall TacViewServer_T::Receive_0(
 	while (connect)
 	{
 		int recv_data_size = 0;
-		recv_data_size = recv(m_client_socket_list[client_id], m_recv_buffer_list[client_id], max_str, 0);
+		recv_data_size = recv(server->m_client_socket_list[client_id], server->m_recv_buffer_list[client_id], max_str, 0);
 		if (recv_data_size <= 0)
 		{
-			::WaitForSingleObject(m_idle, INFINITE);
-			m_client_id_idle_list.push_back(client_id);
-			closesocket(m_client_socket_list[client_id]);
-			m_recv_thread_list[client_id] = NULL;
-			memset(m_recv_buffer_list[client_id], 0, sizeof(m_recv_buffer_list[client_id]));
-			::SetEvent(m_idle);
+			::WaitForSingleObject(server->m_idle, INFINITE);
+			server->m_client_id_idle_list.push_back(client_id);
+			closesocket(server->m_client_socket_list[client_id]);
+			server->m_recv_thread_list[client_id] = NULL;
+			memset(server->m_recv_buffer_list[client_id], 0, sizeof(server->m_recv_buffer_list[client_id]));
+			::SetEvent(server->m_idle);
 
 			connect = false;
 		}
@@ -464,14 +440,14 @@ unsigned long __stdcall TacViewServer_T::Receive_0(
 /**
 *   @brief          接收数据。
 *   @details        接收数据，每个客户端都在独立线程中运行。
-*   @param[in]      para            多线程注册函数格式要求，创建线程时可传入参数。
+*   @param[in]      para            多线程注册函数格式要求，传入服务器对象指针。
 *   @retval         0               正常
 *   @retval         1               错误
 */
 unsigned long __stdcall TacViewServer_T::Receive_1(
 	void* para)
 {
-	UNREFERENCED_PARAMETER(para);
+	TacViewServer_T* server = (TacViewServer_T*)para;
 
 	int client_id = 1;
 
@@ -479,15 +455,15 @@ unsigned long __stdcall TacViewServer_T::Receive_1(
 	while (connect)
 	{
 		int recv_data_size = 0;
-		recv_data_size = recv(m_client_socket_list[client_id], m_recv_buffer_list[client_id], max_str, 0);
+		recv_data_size = recv(server->m_client_socket_list[client_id], server->m_recv_buffer_list[client_id], max_str, 0);
 		if (recv_data_size <= 0)
 		{
-			::WaitForSingleObject(m_idle, INFINITE);
-			m_client_id_idle_list.push_back(client_id);
-			closesocket(m_client_socket_list[client_id]);
-			m_recv_thread_list[client_id] = NULL;
-			memset(m_recv_buffer_list[client_id], 0, sizeof(m_recv_buffer_list[client_id]));
-			::SetEvent(m_idle);
+			::WaitForSingleObject(server->m_idle, INFINITE);
+			server->m_client_id_idle_list.push_back(client_id);
+			closesocket(server->m_client_socket_list[client_id]);
+			server->m_recv_thread_list[client_id] = NULL;
+			memset(server->m_recv_buffer_list[client_id], 0, sizeof(server->m_recv_buffer_list[client_id]));
+			::SetEvent(server->m_idle);
 
 			connect = false;
 		}
@@ -500,14 +476,14 @@ unsigned long __stdcall TacViewServer_T::Receive_1(
 /**
 *   @brief          接收数据。
 *   @details        接收数据，每个客户端都在独立线程中运行。
-*   @param[in]      para            多线程注册函数格式要求，创建线程时可传入参数。
+*   @param[in]      para            多线程注册函数格式要求，传入服务器对象指针。
 *   @retval         0               正常
 *   @retval         1               错误
 */
 unsigned long __stdcall TacViewServer_T::Receive_2(
 	void* para)
 {
-	UNREFERENCED_PARAMETER(para);
+	TacViewServer_T* server = (TacViewServer_T*)para;
 
 	int client_id = 2;
 
@@ -515,15 +491,15 @@ unsigned long __stdcall TacViewServer_T::Receive_2(
 	while (connect)
 	{
 		int recv_data_size = 0;
-		recv_data_size = recv(m_client_socket_list[client_id], m_recv_buffer_list[client_id], max_str, 0);
+		recv_data_size = recv(server->m_client_socket_list[client_id], server->m_recv_buffer_list[client_id], max_str, 0);
 		if (recv_data_size <= 0)
 		{
-			::WaitForSingleObject(m_idle, INFINITE);
-			m_client_id_idle_list.push_back(client_id);
-			closesocket(m_client_socket_list[client_id]);
-			m_recv_thread_list[client_id] = NULL;
-			memset(m_recv_buffer_list[client_id], 0, sizeof(m_recv_buffer_list[client_id]));
-			::SetEvent(m_idle);
+			::WaitForSingleObject(server->m_idle, INFINITE);
+			server->m_client_id_idle_list.push_back(client_id);
+			closesocket(server->m_client_socket_list[client_id]);
+			server->m_recv_thread_list[client_id] = NULL;
+			memset(server->m_recv_buffer_list[client_id], 0, sizeof(server->m_recv_buffer_list[client_id]));
+			::SetEvent(server->m_idle);
 
 			connect = false;
 		}
@@ -536,14 +512,14 @@ unsigned long __stdcall TacViewServer_T::Receive_2(
 /**
 *   @brief          接收数据。
 *   @details        接收数据，每个客户端都在独立线程中运行。
-*   @param[in]      para            多线程注册函数格式要求，创建线程时可传入参数。
+*   @param[in]      para            多线程注册函数格式要求，传入服务器对象指针。
 *   @retval         0               正常
 *   @retval         1               错误
 */
 unsigned long __stdcall TacViewServer_T::Receive_3(
 	void* para)
 {
-	UNREFERENCED_PARAMETER(para);
+	TacViewServer_T* server = (TacViewServer_T*)para;
 
 	int client_id = 3;
 
@@ -551,15 +527,15 @@ unsigned long __stdcall TacViewServer_T::Receive_3(
 	while (connect)
 	{
 		int recv_data_size = 0;
-		recv_data_size = recv(m_client_socket_list[client_id], m_recv_buffer_list[client_id], max_str, 0);
+		recv_data_size = recv(server->m_client_socket_list[client_id], server->m_recv_buffer_list[client_id], max_str, 0);
 		if (recv_data_size <= 0)
 		{
-			::WaitForSingleObject(m_idle, INFINITE);
-			m_client_id_idle_list.push_back(client_id);
-			closesocket(m_client_socket_list[client_id]);
-			m_recv_thread_list[client_id] = NULL;
-			memset(m_recv_buffer_list[client_id], 0, sizeof(m_recv_buffer_list[client_id]));
-			::SetEvent(m_idle);
+			::WaitForSingleObject(server->m_idle, INFINITE);
+			server->m_client_id_idle_list.push_back(client_id);
+			closesocket(server->m_client_socket_list[client_id]);
+			server->m_recv_thread_list[client_id] = NULL;
+			memset(server->m_recv_buffer_list[client_id], 0, sizeof(server->m_recv_buffer_list[client_id]));
+			::SetEvent(server->m_idle);
 
 			connect = false;
 		}
@@ -572,42 +548,42 @@ unsigned long __stdcall TacViewServer_T::Receive_3(
 /**
 *   @brief          接收数据。
 *   @details        接收数据，每个客户端都在独立线程中运行。
-*   @param[in]      para            多线程注册函数格式要求，创建线程时可传入参数。
+*   @param[in]      para            多线程注册函数格式要求，传入服务器对象指针。
 *   @retval         0               正常
 *   @retval         1               错误
 */
 unsigned long __stdcall TacViewServer_T::SendAll(
 	void* para)
 {
-	UNREFERENCED_PARAMETER(para);
+	TacViewServer_T* server = (TacViewServer_T*)para;
 
 	while (1)
 	{
-		::WaitForSingleObject(m_send_message_nonempty, INFINITE);
+		::WaitForSingleObject(server->m_send_message_nonempty, INFINITE);
 
-		::WaitForSingleObject(m_idle, INFINITE);
+		::WaitForSingleObject(server->m_idle, INFINITE);
 
-		while (m_send_message_list.empty() == false)
+		while (server->m_send_message_list.empty() == false)
 		{
-			std::string send_message = m_send_message_list.front();
-			m_send_message_list.pop_front();
+			std::string send_message = server->m_send_message_list.front();
+			server->m_send_message_list.pop_front();
 
-			for (std::list<int>::iterator client_id_iterator = m_client_id_work_list.begin(); client_id_iterator != m_client_id_work_list.end(); client_id_iterator++)
+			for (std::list<int>::iterator client_id_iterator = server->m_client_id_work_list.begin(); client_id_iterator != server->m_client_id_work_list.end(); client_id_iterator++)
 			{
 				int client_id = *client_id_iterator;
 
-				send(m_client_socket_list[client_id], send_message.c_str(), send_message.length(), 0);
+				send(server->m_client_socket_list[client_id], send_message.c_str(), send_message.length(), 0);
 
 				//std::wstring send_message_utf8;
 				//std::wstring_convert<std::codecvt_utf8<wchar_t>> convert_utf8;
 				//send_message_utf8 = convert_utf8.from_bytes(send_message.c_str());
 
-				//send(m_client_socket_list[client_id], (char*)send_message_utf8.c_str(), send_message_utf8.length(), 0);
+				//send(server->m_client_socket_list[client_id], (char*)send_message_utf8.c_str(), send_message_utf8.length(), 0);
 			}
 
 		}
 
-		::SetEvent(m_idle);
+		::SetEvent(server->m_idle);
 	}
 
 	return 0;
@@ -816,7 +792,7 @@ int TacViewServer_T::BuildString(
 			snprintf(file_str_line, sizeof(file_str_line), "\n");
 			strcat_s(string, sizeof(char) * string_length, file_str_line);
 		}
-		else
+		else if (state.object[index].live == 0)
 		{
 			//id
 			snprintf(file_str_line, sizeof(file_str_line), "-%d\n", state.object[index].id);
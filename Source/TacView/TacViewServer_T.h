@@ -102,7 +102,7 @@ namespace TacView
 		/**
 		*   @brief          监听。
 		*   @details        监听，在独立线程中运行，对连入的客户端进行管理。
-		*   @param[in,out]  para            多线程注册函数格式要求，创建线程时可传入参数。
+		*   @param[in,out]  para            多线程注册函数格式要求，传入服务器对象指针。
 		*   @retval         0               正常
 		*   @retval         1               错误
 		*/
@@ -113,7 +113,7 @@ namespace TacView
 		/**
 		*   @brief          接收数据。
 		*   @details        接收数据，每个客户端都在独立线程中运行。
-		*   @param[in,out]  para            多线程注册函数格式要求，创建线程时可传入参数。
+		*   @param[in,out]  para            多线程注册函数格式要求，传入服务器对象指针。
 		*   @retval         0               正常
 		*   @retval         1               错误
 		*/
@@ -124,7 +124,7 @@ namespace TacView
 		/**
 		*   @brief          接收数据。
 		*   @details        接收数据，每个客户端都在独立线程中运行。
-		*   @param[in,out]  para            多线程注册函数格式要求，创建线程时可传入参数。
+		*   @param[in,out]  para            多线程注册函数格式要求，传入服务器对象指针。
 		*   @retval         0               正常
 		*   @retval         1               错误
 		*/
@@ -135,7 +135,7 @@ namespace TacView
 		/**
 		*   @brief          接收数据。
 		*   @details        接收数据，每个客户端都在独立线程中运行。
-		*   @param[in,out]  para            多线程注册函数格式要求，创建线程时可传入参数。
+		*   @param[in,out]  para            多线程注册函数格式要求，传入服务器对象指针。
 		*   @retval         0               正常
 		*   @retval         1               错误
 		*/
@@ -146,7 +146,7 @@ namespace TacView
 		/**
 		*   @brief          接收数据。
 		*   @details        接收数据，每个客户端都在独立线程中运行。
-		*   @param[in,out]  para            多线程注册函数格式要求，创建线程时可传入参数。
+		*   @param[in,out]  para            多线程注册函数格式要求，传入服务器对象指针。
 		*   @retval         0               正常
 		*   @retval         1               错误
 		*/
@@ -157,7 +157,7 @@ namespace TacView
 		/**
 		*   @brief          接收数据。
 		*   @details        接收数据，每个客户端都在独立线程中运行。
-		*   @param[in,out]  para            多线程注册函数格式要求，创建线程时可传入参数。
+		*   @param[in,out]  para            多线程注册函数格式要求，传入服务器对象指针。
 		*   @retval         0               正常
 		*   @retval         1               错误
 		*/
@@ -196,21 +196,21 @@ namespace TacView
 
 	private:
 		
-		static bool						m_open;							//!< 是否已经打开，true 已经打开，false 未打开。
-		static HANDLE					m_idle;							//!< 静态变量是否空闲。
-		static SOCKET					m_server_socket;				//!< 服务器 Socket 。
-		static HANDLE					m_listen_thread;				//!< 服务器 监听线程。
-
-		static std::list<int>			m_client_id_idle_list;			//!< 客户端 id 闲置列表，初始 [0, 1, 2, 3] 。
-		static std::list<int>			m_client_id_work_list;			//!< 客户端 id 工作列表，初始 [] 。
-		static SOCKET					m_client_socket_list[4];		//!< 客户端 Socket 列表。
-		static HANDLE					m_recv_thread_list[4];			//!< 客户端 接收线程列表。
-		static char						m_recv_buffer_list[4][max_str];	//!< 客户端 接收缓冲区列表。
-		static HANDLE					m_send_thread;					//!< 客户端 填写线程。
-		static HANDLE					m_send_message_nonempty;		//!< 客户端 有未填写数据标志。
-		static std::list<std::string>	m_send_message_list;			//!< 客户端 待填写消息列表。
-		static std::string				m_send_history;					//!< 客户端 填写历史。
-		static char                     file_str[net_buffer_size];      //!< 客户端 填写缓存。
+		bool							m_open;							//!< 是否已经打开，true 已经打开，false 未打开。
+		HANDLE							m_idle;							//!< 成员变量是否空闲。
+		SOCKET							m_server_socket;				//!< 服务器 Socket 。
+		HANDLE							m_listen_thread;				//!< 服务器 监听线程。
+
+		std::list<int>					m_client_id_idle_list;			//!< 客户端 id 闲置列表，初始 [0, 1, 2, 3] 。
+		std::list<int>					m_client_id_work_list;			//!< 客户端 id 工作列表，初始 [] 。
+		SOCKET							m_client_socket_list[4];		//!< 客户端 Socket 列表。
+		HANDLE							m_recv_thread_list[4];			//!< 客户端 接收线程列表。
+		char							m_recv_buffer_list[4][max_str];	//!< 客户端 接收缓冲区列表。
+		HANDLE							m_send_thread;					//!< 客户端 填写线程。
+		HANDLE							m_send_message_nonempty;		//!< 客户端 有未填写数据标志。
+		std::list<std::string>			m_send_message_list;			//!< 客户端 待填写消息列表。
+		std::string						m_send_history;					//!< 客户端 填写历史。
+		char							file_str[net_buffer_size];      //!< 客户端 填写缓存。
 		
 	};
 }
@@ -0,0 +1,393 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           counter_rand.cpp
+*   @brief          计数器随机数发生器实现。
+*   @details        计数器随机数发生器实现。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           头文件。
+*   @{
+*/
+#include "counter_rand.h"
+
+#include <math.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CRAND_SSE2
+#include <emmintrin.h>
+#endif
+/** @}  */
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           Philox4x32-10 常数。
+*   @{
+*/
+#define PHILOX_M0 0xD2511F53u
+#define PHILOX_M1 0xCD9E8D57u
+#define PHILOX_W0 0x9E3779B9u
+#define PHILOX_W1 0xBB67AE85u
+#define PHILOX_ROUNDS 10
+#define CRAND_CHUNK 64 //批量生成时每次计算的分组数
+/** @}  */
+
+static const double crand_two_pi = 6.28318530717958647692;
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          设置随机数键。
+*   @details        设置随机数键。
+*   @param[out]     key             随机数键
+*   @param[in]      seed            随机数种子
+*   @param[in]      env             战场编号
+*   @param[in]      entity          实体编号
+*   @param[in]      tick            时间步
+*   @retval         0               正常
+*   @retval         1               错误
+*/
+int crand_key(
+	CounterRand_T* key,
+	const unsigned long long seed,
+	const unsigned int env,
+	const unsigned int entity,
+	const unsigned int tick)
+{
+	if (key == 0) {
+		return 1;
+	}
+
+	key->seed = seed;
+	key->env = env;
+	key->entity = entity;
+	key->tick = tick;
+	return 0;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          Philox4x32-10 分组函数。
+*   @details        由128位计数器和64位密钥生成128位随机数。
+*   @param[out]     out             4个32位随机数
+*   @param[in]      counter         4个32位计数器
+*   @param[in]      key             2个32位密钥
+*   @retval         0               正常
+*   @retval         1               错误
+*/
+int philox4x32(
+	unsigned int out[4],
+	const unsigned int counter[4],
+	const unsigned int key[2])
+{
+	unsigned int c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+	unsigned int k0 = key[0], k1 = key[1];
+
+	for (int r = 0; r < PHILOX_ROUNDS; r++) {
+		unsigned long long p0 = (unsigned long long)PHILOX_M0 * c0;
+		unsigned long long p1 = (unsigned long long)PHILOX_M1 * c2;
+		unsigned int hi0 = (unsigned int)(p0 >> 32), lo0 = (unsigned int)p0;
+		unsigned int hi1 = (unsigned int)(p1 >> 32), lo1 = (unsigned int)p1;
+
+		c0 = hi1 ^ c1 ^ k0;
+		c1 = lo1;
+		c2 = hi0 ^ c3 ^ k1;
+		c3 = lo0;
+
+		k0 += PHILOX_W0;
+		k1 += PHILOX_W1;
+	}
+
+	out[0] = c0;
+	out[1] = c1;
+	out[2] = c2;
+	out[3] = c3;
+	return 0;
+}
+
+
+//计数器布局：[分组序号, 实体, 战场, 时间步]，密钥为种子
+static void crand_counter(
+	unsigned int counter[4],
+	unsigned int philox_key[2],
+	const CounterRand_T* key,
+	unsigned int block)
+{
+	counter[0] = block;
+	counter[1] = key->entity;
+	counter[2] = key->env;
+	counter[3] = key->tick;
+	philox_key[0] = (unsigned int)key->seed;
+	philox_key[1] = (unsigned int)(key->seed >> 32);
+}
+
+
+#ifdef CRAND_SSE2
+//4路 32x32->64 位乘法，分别取高、低32位
+static inline void philox_mulhilo_sse2(__m128i a, __m128i m, __m128i* hi, __m128i* lo)
+{
+	const __m128i mask_lo = _mm_set_epi32(0, -1, 0, -1);
+	const __m128i mask_hi = _mm_set_epi32(-1, 0, -1, 0);
+	__m128i even = _mm_mul_epu32(a, m);							//第0、2路
+	__m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), m);		//第1、3路
+
+	*lo = _mm_or_si128(_mm_and_si128(even, mask_lo), _mm_slli_epi64(odd, 32));
+	*hi = _mm_or_si128(_mm_srli_epi64(even, 32), _mm_and_si128(odd, mask_hi));
+}
+#endif
+
+
+//生成连续 block_count 个分组，words 按分组依次存放，每组4个字
+static void crand_blocks(
+	unsigned int* words,
+	const CounterRand_T* key,
+	unsigned int first_block,
+	int block_count)
+{
+	unsigned int counter[4];
+	unsigned int philox_key[2];
+	crand_counter(counter, philox_key, key, first_block);
+
+	int b = 0;
+#ifdef CRAND_SSE2
+	const __m128i m0 = _mm_set1_epi32((int)PHILOX_M0);
+	const __m128i m1 = _mm_set1_epi32((int)PHILOX_M1);
+	for (; b + 4 <= block_count; b += 4) {
+		unsigned int block = first_block + (unsigned int)b;
+		__m128i c0 = _mm_set_epi32((int)(block + 3), (int)(block + 2), (int)(block + 1), (int)block);
+		__m128i c1 = _mm_set1_epi32((int)counter[1]);
+		__m128i c2 = _mm_set1_epi32((int)counter[2]);
+		__m128i c3 = _mm_set1_epi32((int)counter[3]);
+		unsigned int k0 = philox_key[0], k1 = philox_key[1];
+
+		for (int r = 0; r < PHILOX_ROUNDS; r++) {
+			__m128i hi0, lo0, hi1, lo1;
+			philox_mulhilo_sse2(c0, m0, &hi0, &lo0);
+			philox_mulhilo_sse2(c2, m1, &hi1, &lo1);
+
+			c0 = _mm_xor_si128(_mm_xor_si128(hi1, c1), _mm_set1_epi32((int)k0));
+			c1 = lo1;
+			c2 = _mm_xor_si128(_mm_xor_si128(hi0, c3), _mm_set1_epi32((int)k1));
+			c3 = lo0;
+
+			k0 += PHILOX_W0;
+			k1 += PHILOX_W1;
+		}
+
+		//由 [字][路] 转置为 [路][字]
+		__m128i t0 = _mm_unpacklo_epi32(c0, c1);
+		__m128i t1 = _mm_unpacklo_epi32(c2, c3);
+		__m128i t2 = _mm_unpackhi_epi32(c0, c1);
+		__m128i t3 = _mm_unpackhi_epi32(c2, c3);
+		__m128i* dst = (__m128i*)(words + (size_t)b * 4);
+		_mm_storeu_si128(dst + 0, _mm_unpacklo_epi64(t0, t1));
+		_mm_storeu_si128(dst + 1, _mm_unpackhi_epi64(t0, t1));
+		_mm_storeu_si128(dst + 2, _mm_unpacklo_epi64(t2, t3));
+		_mm_storeu_si128(dst + 3, _mm_unpackhi_epi64(t2, t3));
+	}
+#endif
+	for (; b < block_count; b++) {
+		counter[0] = first_block + (unsigned int)b;
+		philox4x32(words + (size_t)b * 4, counter, philox_key);
+	}
+}
+
+
+//两个32位字组成53位均匀分布随机数，取值在 (0,1) 开区间
+static inline double crand_to_uniform(unsigned int hi, unsigned int lo)
+{
+	unsigned long long bits = ((unsigned long long)hi << 21) | (lo >> 11);
+	return ((double)bits + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          生成均匀分布随机数。
+*   @details        生成 (0,1) 开区间均匀分布随机数，53位精度。
+*   @param[out]     uniformOut      随机数输出
+*   @param[in]      key             随机数键
+*   @param[in]      index           随机数序号
+*   @retval         0               正常
+*   @retval         1               错误
+*/
+int crand_uniform(
+	double* uniformOut,
+	const CounterRand_T* key,
+	const unsigned int index)
+{
+	if (uniformOut == 0 || key == 0) {
+		return 1;
+	}
+
+	unsigned int counter[4];
+	unsigned int philox_key[2];
+	unsigned int words[4];
+	crand_counter(counter, philox_key, key, index >> 1);
+	philox4x32(words, counter, philox_key);
+
+	int k = (index & 1) * 2;
+	*uniformOut = crand_to_uniform(words[k], words[k + 1]);
+	return 0;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          生成高斯分布随机数。
+*   @details        期望为0.0，方差为1.0，Box-Muller 变换，序号 2k 和 2k+1 共用一对均匀分布随机数。
+*   @param[out]     gaussOut        随机数输出
+*   @param[in]      key             随机数键
+*   @param[in]      index           随机数序号
+*   @retval         0               正常
+*   @retval         1               错误
+*/
+int crand_normal(
+	double* gaussOut,
+	const CounterRand_T* key,
+	const unsigned int index)
+{
+	if (gaussOut == 0 || key == 0) {
+		return 1;
+	}
+
+	unsigned int counter[4];
+	unsigned int philox_key[2];
+	unsigned int words[4];
+	crand_counter(counter, philox_key, key, index >> 1);
+	philox4x32(words, counter, philox_key);
+
+	double u = crand_to_uniform(words[0], words[1]);
+	double v = crand_to_uniform(words[2], words[3]);
+	double radius = sqrt(-2 * log(u));
+	double angle = crand_two_pi * v;
+
+	*gaussOut = (index & 1) ? radius * sin(angle) : radius * cos(angle);
+	return 0;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          批量生成均匀分布随机数。
+*   @details        uniformOut[i] 与 crand_uniform(key, first_index + i) 相同。
+*   @param[out]     uniformOut      随机数输出 [count]
+*   @param[in]      count           数量
+*   @param[in]      key             随机数键
+*   @param[in]      first_index     第一个随机数的序号
+*   @retval         0               正常
+*   @retval         1               错误
+*/
+int crand_uniform_batch(
+	double* uniformOut,
+	const int count,
+	const CounterRand_T* key,
+	const unsigned int first_index)
+{
+	if (uniformOut == 0 || key == 0 || count < 0) {
+		return 1;
+	}
+
+	unsigned int words[CRAND_CHUNK * 4];
+	unsigned int block = first_index >> 1;
+	int skip = first_index & 1;				//首个分组中跳过的随机数
+	int done = 0;
+
+	while (done < count) {
+		int want = count - done + skip;
+		int block_count = (want + 1) / 2;
+		if (block_count > CRAND_CHUNK) {
+			block_count = CRAND_CHUNK;
+		}
+		crand_blocks(words, key, block, block_count);
+
+		int n = block_count * 2 - skip;
+		if (n > count - done) {
+			n = count - done;
+		}
+		for (int i = 0; i < n; i++) {
+			int w = (i + skip) * 2;
+			uniformOut[done + i] = crand_to_uniform(words[w], words[w + 1]);
+		}
+
+		done += n;
+		block += (unsigned int)block_count;
+		skip = 0;
+	}
+
+	return 0;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          批量生成高斯分布随机数。
+*   @details        gaussOut[i] 与 crand_normal(key, first_index + i) 相同。
+*   @param[out]     gaussOut        随机数输出 [count]
+*   @param[in]      count           数量
+*   @param[in]      key             随机数键
+*   @param[in]      first_index     第一个随机数的序号
+*   @retval         0               正常
+*   @retval         1               错误
+*/
+int crand_normal_batch(
+	double* gaussOut,
+	const int count,
+	const CounterRand_T* key,
+	const unsigned int first_index)
+{
+	if (gaussOut == 0 || key == 0 || count < 0) {
+		return 1;
+	}
+
+	unsigned int words[CRAND_CHUNK * 4];
+	double pair[CRAND_CHUNK * 2];
+	unsigned int block = first_index >> 1;
+	int skip = first_index & 1;
+	int done = 0;
+
+	while (done < count) {
+		int want = count - done + skip;
+		int block_count = (want + 1) / 2;
+		if (block_count > CRAND_CHUNK) {
+			block_count = CRAND_CHUNK;
+		}
+		crand_blocks(words, key, block, block_count);
+
+		//按分组成对变换，循环内无分支，便于编译器向量化
+		for (int b = 0; b < block_count; b++) {
+			double u = crand_to_uniform(words[b * 4 + 0], words[b * 4 + 1]);
+			double v = crand_to_uniform(words[b * 4 + 2], words[b * 4 + 3]);
+			double radius = sqrt(-2 * log(u));
+			double angle = crand_two_pi * v;
+			pair[b * 2 + 0] = radius * cos(angle);
+			pair[b * 2 + 1] = radius * sin(angle);
+		}
+
+		int n = block_count * 2 - skip;
+		if (n > count - done) {
+			n = count - done;
+		}
+		for (int i = 0; i < n; i++) {
+			gaussOut[done + i] = pair[i + skip];
+		}
+
+		done += n;
+		block += (unsigned int)block_count;
+		skip = 0;
+	}
+
+	return 0;
+}
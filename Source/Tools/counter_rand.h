@@ -0,0 +1,133 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           counter_rand.h
+*   @brief          计数器随机数发生器。
+*   @details        基于 Philox4x32-10 的无状态随机数：第 index 个随机数只由 (种子, 战场, 实体, 时间步, index) 决定，
+					与调用顺序、线程数和批量大小无关，可在任意线程中并行生成而结果不变。
+					单个生成与批量生成结果逐位相同；批量生成在支持 SSE2 的平台上4路并行计算。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+#ifndef COUNTER_RAND_H_INCLUDED
+#define COUNTER_RAND_H_INCLUDED
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          随机数键。
+*   @details        种子作为 Philox 密钥，战场、实体、时间步和序号组成计数器。同一个键下按 index 取不同的随机数。
+*/
+struct CounterRand_T
+{
+	unsigned long long				seed;							//!< 随机数种子
+	unsigned int					env;							//!< 战场编号
+	unsigned int					entity;							//!< 实体编号
+	unsigned int					tick;							//!< 时间步
+};
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          设置随机数键。
+*   @details        设置随机数键。
+*   @param[out]     key             随机数键
+*   @param[in]      seed            随机数种子
+*   @param[in]      env             战场编号
+*   @param[in]      entity          实体编号
+*   @param[in]      tick            时间步
+*   @retval         0               正常
+*   @retval         1               错误
+*/
+int crand_key(
+	CounterRand_T* key,
+	const unsigned long long seed,
+	const unsigned int env,
+	const unsigned int entity,
+	const unsigned int tick);
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          Philox4x32-10 分组函数。
+*   @details        由128位计数器和64位密钥生成128位随机数。
+*   @param[out]     out             4个32位随机数
+*   @param[in]      counter         4个32位计数器
+*   @param[in]      key             2个32位密钥
+*   @retval         0               正常
+*   @retval         1               错误
+*/
+int philox4x32(
+	unsigned int out[4],
+	const unsigned int counter[4],
+	const unsigned int key[2]);
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          生成均匀分布随机数。
+*   @details        生成 (0,1) 开区间均匀分布随机数，53位精度。
+*   @param[out]     uniformOut      随机数输出
+*   @param[in]      key             随机数键
+*   @param[in]      index           随机数序号
+*   @retval         0               正常
+*   @retval         1               错误
+*/
+int crand_uniform(
+	double* uniformOut,
+	const CounterRand_T* key,
+	const unsigned int index);
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          生成高斯分布随机数。
+*   @details        期望为0.0，方差为1.0，Box-Muller 变换，序号 2k 和 2k+1 共用一对均匀分布随机数。
+*   @param[out]     gaussOut        随机数输出
+*   @param[in]      key             随机数键
+*   @param[in]      index           随机数序号
+*   @retval         0               正常
+*   @retval         1               错误
+*/
+int crand_normal(
+	double* gaussOut,
+	const CounterRand_T* key,
+	const unsigned int index);
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          批量生成均匀分布随机数。
+*   @details        uniformOut[i] 与 crand_uniform(key, first_index + i) 相同。
+*   @param[out]     uniformOut      随机数输出 [count]
+*   @param[in]      count           数量
+*   @param[in]      key             随机数键
+*   @param[in]      first_index     第一个随机数的序号
+*   @retval         0               正常
+*   @retval         1               错误
+*/
+int crand_uniform_batch(
+	double* uniformOut,
+	const int count,
+	const CounterRand_T* key,
+	const unsigned int first_index);
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          批量生成高斯分布随机数。
+*   @details        gaussOut[i] 与 crand_normal(key, first_index + i) 相同。
+*   @param[out]     gaussOut        随机数输出 [count]
+*   @param[in]      count           数量
+*   @param[in]      key             随机数键
+*   @param[in]      first_index     第一个随机数的序号
+*   @retval         0               正常
+*   @retval         1               错误
+*/
+int crand_normal_batch(
+	double* gaussOut,
+	const int count,
+	const CounterRand_T* key,
+	const unsigned int first_index);
+
+
+#endif // COUNTER_RAND_H_INCLUDED
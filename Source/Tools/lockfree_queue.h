@@ -0,0 +1,156 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           lockfree_queue.h
+*   @brief          无锁有界队列。
+*   @details        多生产者多消费者有界环形队列，每个槽带序号，入队出队各用一次CAS，不加锁、不分配内存。
+					容量在创建时确定，取不小于请求值的2的幂。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+#ifndef LOCKFREE_QUEUE_H_INCLUDED
+#define LOCKFREE_QUEUE_H_INCLUDED
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           被使用的头文件。
+*   @{
+*/
+#include <atomic>
+#include <stddef.h>
+/** @}  */
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          无锁有界队列。
+*   @details        槽序号等于入队位置时可写，等于入队位置+1时可读；读出后序号前移一圈，供下一轮写入。
+					T 应为可平凡拷贝的小对象，如下标。
+*/
+template <typename T>
+class LockFreeQueue_C
+{
+public:
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          创建队列
+	*   @details        创建队列
+	*   @param[in]      capacity        最少容纳的元素数
+	*/
+	explicit LockFreeQueue_C(int capacity)
+	{
+		int size = 2;
+		while (size < capacity) {
+			size <<= 1;
+		}
+		mask = (size_t)size - 1;
+
+		cell_list = new Cell_T[size];
+		for (int i = 0; i < size; i++) {
+			cell_list[i].sequence.store((size_t)i, std::memory_order_relaxed);
+		}
+		enqueue_pos.store(0, std::memory_order_relaxed);
+		dequeue_pos.store(0, std::memory_order_relaxed);
+	}
+
+	~LockFreeQueue_C()
+	{
+		delete[] cell_list;
+	}
+
+	LockFreeQueue_C(const LockFreeQueue_C&) = delete;
+	LockFreeQueue_C& operator=(const LockFreeQueue_C&) = delete;
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          入队
+	*   @details        入队
+	*   @param[in]      value           元素
+	*   @retval         0               正常
+	*   @retval         1               队列已满
+	*/
+	int Push(const T& value)
+	{
+		size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+		for (;;) {
+			Cell_T* cell = &cell_list[pos & mask];
+			size_t seq = cell->sequence.load(std::memory_order_acquire);
+			ptrdiff_t diff = (ptrdiff_t)seq - (ptrdiff_t)pos;
+			if (diff == 0) {
+				if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+					cell->value = value;
+					cell->sequence.store(pos + 1, std::memory_order_release);
+					return 0;
+				}
+			}
+			else if (diff < 0) {
+				return 1;
+			}
+			else {
+				pos = enqueue_pos.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          出队
+	*   @details        出队
+	*   @param[out]     value           元素
+	*   @retval         0               正常
+	*   @retval         1               队列为空
+	*/
+	int Pop(T* value)
+	{
+		size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+		for (;;) {
+			Cell_T* cell = &cell_list[pos & mask];
+			size_t seq = cell->sequence.load(std::memory_order_acquire);
+			ptrdiff_t diff = (ptrdiff_t)seq - (ptrdiff_t)(pos + 1);
+			if (diff == 0) {
+				if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+					*value = cell->value;
+					cell->sequence.store(pos + mask + 1, std::memory_order_release);
+					return 0;
+				}
+			}
+			else if (diff < 0) {
+				return 1;
+			}
+			else {
+				pos = dequeue_pos.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          队列容量
+	*   @details        队列容量
+	*   @retval         最多容纳的元素数
+	*/
+	int Capacity() const { return (int)(mask + 1); }
+
+private:
+	struct Cell_T
+	{
+		std::atomic<size_t>			sequence;						//!< 槽序号
+		T							value;							//!< 元素
+	};
+
+	Cell_T*							cell_list;						//!< 环形槽数组
+	size_t							mask;							//!< 容量-1
+
+	//入队、出队位置分处不同缓存行，避免生产者与消费者互相干扰
+	alignas(64) std::atomic<size_t>	enqueue_pos;
+	alignas(64) std::atomic<size_t>	dequeue_pos;
+};
+
+
+#endif // LOCKFREE_QUEUE_H_INCLUDED
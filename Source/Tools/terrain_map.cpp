@@ -0,0 +1,672 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           terrain_map.cpp
+*   @brief          地形高程图实现。
+*   @details        地形高程图实现。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           被使用的头文件。
+*   @{
+*/
+#include "terrain_map.h"
+#include "counter_rand.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+/** @}  */
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           合成地形常数。
+*   @{
+*/
+static const int noise_octave_max = 8;                  //值噪声最多层数
+static const int noise_base_divide = 4;                 //最粗一层每个方向的格点数
+/** @}  */
+
+
+//打开普通文件
+static FILE* OpenStream(const char* path, const char* mode)
+{
+	FILE* file = NULL;
+#ifdef _WIN32
+	if (fopen_s(&file, path, mode) != 0) {
+		return NULL;
+	}
+#else
+	file = fopen(path, mode);
+#endif
+	return file;
+}
+
+
+static float Max4(float a, float b, float c, float d)
+{
+	float ab = (a > b) ? a : b;
+	float cd = (c > d) ? c : d;
+	return (ab > cd) ? ab : cd;
+}
+
+
+TerrainMap_C::TerrainMap_C()
+{
+	data = NULL;
+	data_size = 0;
+	header = NULL;
+	height_list = NULL;
+	inv_cell_size = 0;
+
+	map_view = NULL;
+	map_size = 0;
+#ifdef _WIN32
+	file_handle = NULL;
+	mapping_handle = NULL;
+#endif
+}
+
+
+TerrainMap_C::~TerrainMap_C()
+{
+	Close();
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          打开高程图文件
+*   @details        以只读方式映射整个文件，检查文件头后建立最大值金字塔，已打开的文件先关闭
+*   @param[in]      path            文件路径
+*   @retval         0               正常
+*   @retval         1               错误，文件无法打开或格式不符
+*/
+int TerrainMap_C::Open(const char* path)
+{
+	Close();
+	if (path == NULL) {
+		return 1;
+	}
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE) {
+		return 1;
+	}
+	LARGE_INTEGER size;
+	if (GetFileSizeEx(file, &size) == 0 || size.QuadPart < (LONGLONG)sizeof(TerrainMapHeader_T)) {
+		CloseHandle(file);
+		return 1;
+	}
+	HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mapping == NULL) {
+		CloseHandle(file);
+		return 1;
+	}
+	void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (view == NULL) {
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return 1;
+	}
+	file_handle = file;
+	mapping_handle = mapping;
+	map_view = view;
+	map_size = size.QuadPart;
+#else
+	int file = open(path, O_RDONLY);
+	if (file < 0) {
+		return 1;
+	}
+	struct stat status;
+	if (fstat(file, &status) != 0 || status.st_size < (off_t)sizeof(TerrainMapHeader_T)) {
+		close(file);
+		return 1;
+	}
+	void* view = mmap(NULL, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+	close(file);
+	if (view == MAP_FAILED) {
+		return 1;
+	}
+	map_view = view;
+	map_size = (long long)status.st_size;
+#endif
+
+	data = (const unsigned char*)map_view;
+	data_size = map_size;
+	if (Validate() != 0) {
+		Close();
+		return 1;
+	}
+
+	return 0;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          使用内存中的高程图
+*   @details        数据由调用者持有，关闭前须一直有效，首地址须按8字节对齐
+*   @param[in]      in_data         高程图数据，格式与文件相同
+*   @param[in]      size            字节数
+*   @retval         0               正常
+*   @retval         1               错误，格式不符
+*/
+int TerrainMap_C::Attach(const void* in_data, long long size)
+{
+	Close();
+	if (in_data == NULL || ((size_t)in_data & 7) != 0) {
+		return 1;
+	}
+
+	data = (const unsigned char*)in_data;
+	data_size = size;
+	if (Validate() != 0) {
+		Close();
+		return 1;
+	}
+
+	return 0;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          关闭高程图
+*   @details        解除文件映射，释放金字塔
+*   @retval         0               正常
+*/
+int TerrainMap_C::Close()
+{
+	if (map_view != NULL) {
+#ifdef _WIN32
+		UnmapViewOfFile(map_view);
+		CloseHandle((HANDLE)mapping_handle);
+		CloseHandle((HANDLE)file_handle);
+		mapping_handle = NULL;
+		file_handle = NULL;
+#else
+		munmap(map_view, (size_t)map_size);
+#endif
+		map_view = NULL;
+		map_size = 0;
+	}
+
+	data = NULL;
+	data_size = 0;
+	header = NULL;
+	height_list = NULL;
+	inv_cell_size = 0;
+	level_list.clear();
+	level_width.clear();
+	level_height.clear();
+
+	return 0;
+}
+
+
+int TerrainMap_C::Validate()
+{
+	if (data_size < (long long)sizeof(TerrainMapHeader_T)) {
+		return 1;
+	}
+
+	const TerrainMapHeader_T* file_header = (const TerrainMapHeader_T*)data;
+	if (file_header->magic != TERRAIN_MAP_MAGIC || file_header->version != TERRAIN_MAP_VERSION
+		|| file_header->header_size != (int)sizeof(TerrainMapHeader_T)) {
+		return 1;
+	}
+	if (file_header->width < 2 || file_header->width > TERRAIN_MAP_MAX_SIZE
+		|| file_header->height < 2 || file_header->height > TERRAIN_MAP_MAX_SIZE
+		|| !(file_header->cell_size > 0) || !(fabs(file_header->origin_north) < 1e12)
+		|| !(fabs(file_header->origin_east) < 1e12)) {
+		return 1;
+	}
+	long long point_count = (long long)file_header->width * (long long)file_header->height;
+	if (data_size != (long long)sizeof(TerrainMapHeader_T) + point_count * (long long)sizeof(float)) {
+		return 1;
+	}
+
+	const float* point = (const float*)(data + sizeof(TerrainMapHeader_T));
+	int width = file_header->width;
+	int height = file_header->height;
+
+	//第0层：每格四个角点的最大值，同时检查高程是否有效
+	int w = width - 1;
+	int h = height - 1;
+	level_list.push_back(std::vector<float>((size_t)w * (size_t)h));
+	level_width.push_back(w);
+	level_height.push_back(h);
+	for (int row = 0; row < h; row++) {
+		const float* south = point + (size_t)row * width;
+		const float* north = south + width;
+		float* cell = &level_list[0][(size_t)row * w];
+		for (int col = 0; col < w; col++) {
+			cell[col] = Max4(south[col], south[col + 1], north[col], north[col + 1]);
+			if (!(fabs(cell[col]) < 1e6f)) {
+				level_list.clear();
+				level_width.clear();
+				level_height.clear();
+				return 1;
+			}
+		}
+	}
+
+	//逐层取 2x2 最大值，直到只剩一格
+	while (w > 1 || h > 1) {
+		int up_w = (w + 1) / 2;
+		int up_h = (h + 1) / 2;
+		std::vector<float> up((size_t)up_w * (size_t)up_h);
+		const std::vector<float>& down = level_list.back();
+		for (int row = 0; row < up_h; row++) {
+			int r0 = 2 * row;
+			int r1 = (r0 + 1 < h) ? r0 + 1 : r0;
+			for (int col = 0; col < up_w; col++) {
+				int c0 = 2 * col;
+				int c1 = (c0 + 1 < w) ? c0 + 1 : c0;
+				up[(size_t)row * up_w + col] = Max4(
+					down[(size_t)r0 * w + c0], down[(size_t)r0 * w + c1],
+					down[(size_t)r1 * w + c0], down[(size_t)r1 * w + c1]);
+			}
+		}
+		level_list.push_back(up);
+		level_width.push_back(up_w);
+		level_height.push_back(up_h);
+		w = up_w;
+		h = up_h;
+	}
+
+	header = file_header;
+	height_list = point;
+	inv_cell_size = 1.0 / header->cell_size;
+
+	return 0;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          生成合成高程图文件
+*   @details        多层值噪声叠加的分形地形：最粗一层每个方向约 noise_base_divide 个格点，每层格点间隔减半、幅度减半，
+*                   格点值由 crand_uniform 按(种子，层号，格点序号)生成，层内用平滑插值，最后线性缩放到 0 ~ max_height
+*   @param[in]      path            文件路径
+*   @param[in]      width           东向高程点数，>=2
+*   @param[in]      height          北向高程点数，>=2
+*   @param[in]      cell_size       高程点间隔，单位：米
+*   @param[in]      max_height      最大高程，单位：米
+*   @param[in]      seed            随机数种子
+*   @retval         0               正常
+*   @retval         1               错误，参数无效或文件无法写入
+*/
+int TerrainMap_C::Generate(
+	const char*						path,
+	int								width,
+	int								height,
+	double							cell_size,
+	double							max_height,
+	unsigned long long				seed)
+{
+	if (path == NULL || width < 2 || width > TERRAIN_MAP_MAX_SIZE || height < 2 || height > TERRAIN_MAP_MAX_SIZE
+		|| !(cell_size > 0) || !(max_height >= 0)) {
+		return 1;
+	}
+
+	std::vector<double> value((size_t)width * (size_t)height, 0.0);
+	int size = (width > height) ? width : height;
+	double period = (double)(size - 1) / noise_base_divide;
+	double amplitude = 1.0;
+	for (int octave = 0; octave < noise_octave_max && period >= 2; octave++) {
+		CounterRand_T key;
+		crand_key(&key, seed, 0, (unsigned int)octave, 0);
+		int lattice_w = (int)((width - 1) / period) + 2;
+		int lattice_h = (int)((height - 1) / period) + 2;
+		std::vector<double> lattice((size_t)lattice_w * (size_t)lattice_h);
+		for (int k = 0; k < (int)lattice.size(); k++) {
+			crand_uniform(&lattice[k], &key, (unsigned int)k);
+		}
+
+		for (int row = 0; row < height; row++) {
+			double y = row / period;
+			int j = (int)y;
+			double fy = y - j;
+			fy = fy * fy * (3 - 2 * fy);
+			const double* south = &lattice[(size_t)j * lattice_w];
+			const double* north = south + lattice_w;
+			double* out = &value[(size_t)row * width];
+			for (int col = 0; col < width; col++) {
+				double x = col / period;
+				int i = (int)x;
+				double fx = x - i;
+				fx = fx * fx * (3 - 2 * fx);
+				double s = south[i] + (south[i + 1] - south[i]) * fx;
+				double n = north[i] + (north[i + 1] - north[i]) * fx;
+				out[col] += amplitude * (s + (n - s) * fy);
+			}
+		}
+		period *= 0.5;
+		amplitude *= 0.5;
+	}
+
+	double low = value[0];
+	double high = value[0];
+	for (size_t k = 1; k < value.size(); k++) {
+		low = (value[k] < low) ? value[k] : low;
+		high = (value[k] > high) ? value[k] : high;
+	}
+	double scale = (high > low) ? max_height / (high - low) : 0;
+	std::vector<float> point(value.size());
+	for (size_t k = 0; k < value.size(); k++) {
+		point[k] = (float)((value[k] - low) * scale);
+	}
+
+	TerrainMapHeader_T file_header;
+	memset(&file_header, 0, sizeof(file_header));
+	file_header.magic = TERRAIN_MAP_MAGIC;
+	file_header.version = TERRAIN_MAP_VERSION;
+	file_header.header_size = (int)sizeof(TerrainMapHeader_T);
+	file_header.width = width;
+	file_header.height = height;
+	file_header.origin_north = 0;
+	file_header.origin_east = 0;
+	file_header.cell_size = cell_size;
+
+	FILE* file = OpenStream(path, "wb");
+	if (file == NULL) {
+		return 1;
+	}
+	bool failed = fwrite(&file_header, sizeof(file_header), 1, file) != 1
+		|| fwrite(&point[0], sizeof(float), point.size(), file) != point.size();
+	if (fclose(file) != 0 || failed) {
+		return 1;
+	}
+
+	return 0;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          地形高度
+*   @details        双线性插值，图外为0
+*   @param[in]      north           北向坐标，单位：米
+*   @param[in]      east            东向坐标，单位：米
+*   @retval         地形高度，单位：米
+*/
+double TerrainMap_C::Height(
+	double							north,
+	double							east) const
+{
+	if (header == NULL) {
+		return 0;
+	}
+	double x = (east - header->origin_east) * inv_cell_size;
+	double y = (north - header->origin_north) * inv_cell_size;
+	if (!(x >= 0 && x <= header->width - 1 && y >= 0 && y <= header->height - 1)) {
+		return 0;
+	}
+
+	int col = (int)x;
+	int row = (int)y;
+	col = (col < header->width - 2) ? col : header->width - 2;
+	row = (row < header->height - 2) ? row : header->height - 2;
+	double fx = x - col;
+	double fy = y - row;
+	const float* south = height_list + (size_t)row * header->width + col;
+	const float* north_row = south + header->width;
+	double s = south[0] + (south[1] - south[0]) * fx;
+	double n = north_row[0] + (north_row[1] - north_row[0]) * fx;
+	return s + (n - s) * fy;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          批量离地高度
+*   @details        用于每步检查全部飞机是否触地
+*   @param[out]     hag             离地高度 [count]
+*   @param[in]      north           北向坐标 [count]
+*   @param[in]      east            东向坐标 [count]
+*   @param[in]      altitude        高度 [count]
+*   @param[in]      count           数量
+*   @retval         0               正常
+*   @retval         1               错误，参数为空或高程图未打开
+*/
+int TerrainMap_C::HeightAboveGroundBatch(
+	double*							hag,
+	const double*					north,
+	const double*					east,
+	const double*					altitude,
+	int								count) const
+{
+	if (header == NULL || hag == NULL || north == NULL || east == NULL || altitude == NULL) {
+		return 1;
+	}
+	for (int k = 0; k < count; k++) {
+		hag[k] = altitude[k] - Height(north[k], east[k]);
+	}
+	return 0;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          第0层格内射线是否低于地形
+*   @details        格内地形 h = h00 + a*fx + b*fy + c*fx*fy，fx、fy 均为 t 的一次式，
+*                   高度差 f(t) = z(t) - h(t) 为 t 的二次式，[t0, t1] 内最小值小于0时遮挡
+*   @param[in]      col             格的列号
+*   @param[in]      row             格的行号
+*   @param[in]      origin[3]       射线起点(列，行，高度)
+*   @param[in]      direction[3]    射线方向，t=1 时到达终点
+*   @param[in]      t0              段起点
+*   @param[in]      t1              段终点
+*   @retval         true            遮挡
+*/
+bool TerrainMap_C::CellBlocked(
+	int								col,
+	int								row,
+	const double					origin[3],
+	const double					direction[3],
+	double							t0,
+	double							t1) const
+{
+	const float* south = height_list + (size_t)row * header->width + col;
+	const float* north = south + header->width;
+	double h00 = south[0];
+	double a = south[1] - h00;
+	double b = north[0] - h00;
+	double c = north[1] - south[1] - north[0] + h00;
+
+	double px = origin[0] - col;
+	double py = origin[1] - row;
+	double dx = direction[0];
+	double dy = direction[1];
+	double f0 = origin[2] - (h00 + a * px + b * py + c * px * py);
+	double f1 = direction[2] - (a * dx + b * dy + c * (px * dy + py * dx));
+	double f2 = -c * dx * dy;
+
+	if (f0 + (f1 + f2 * t0) * t0 < 0 || f0 + (f1 + f2 * t1) * t1 < 0) {
+		return true;
+	}
+	//开口向上时最小值可能在段内
+	if (f2 > 0) {
+		double t = -f1 / (2 * f2);
+		if (t > t0 && t < t1 && f0 + (f1 + f2 * t) * t < 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          两点间通视
+*   @details        射线裁剪到图内后逐层 DDA：当前层格内射线最低点高于格最大值时跳过该格并上升一层，
+*                   否则下降一层；第0层不能跳过的格用 CellBlocked 精确判断
+*   @param[in]      positionA[3]    A点位置(北，天，东)
+*   @param[in]      positionB[3]    B点位置(北，天，东)
+*   @retval         true            通视
+*/
+bool TerrainMap_C::LineOfSight(
+	const double					positionA[3],
+	const double					positionB[3]) const
+{
+	if (header == NULL) {
+		return true;
+	}
+
+	//以高程点间隔为单位的(列，行，高度)
+	double origin[3] = {
+		(positionA[2] - header->origin_east) * inv_cell_size,
+		(positionA[0] - header->origin_north) * inv_cell_size,
+		positionA[1] };
+	double direction[3] = {
+		(positionB[2] - header->origin_east) * inv_cell_size - origin[0],
+		(positionB[0] - header->origin_north) * inv_cell_size - origin[1],
+		positionB[1] - positionA[1] };
+
+	//两端都高于全图最高点
+	int top = (int)level_list.size() - 1;
+	if (positionA[1] > level_list[top][0] && positionB[1] > level_list[top][0]) {
+		return true;
+	}
+
+	//裁剪到 [0, width-1] x [0, height-1]
+	double t_begin = 0;
+	double t_end = 1;
+	double extent[2] = { (double)(header->width - 1), (double)(header->height - 1) };
+	for (int k = 0; k < 2; k++) {
+		if (direction[k] == 0) {
+			if (origin[k] < 0 || origin[k] > extent[k]) {
+				return true;
+			}
+			continue;
+		}
+		double ta = (0 - origin[k]) / direction[k];
+		double tb = (extent[k] - origin[k]) / direction[k];
+		if (ta > tb) {
+			double temp = ta;
+			ta = tb;
+			tb = temp;
+		}
+		t_begin = (ta > t_begin) ? ta : t_begin;
+		t_end = (tb < t_end) ? tb : t_end;
+	}
+	if (!(t_begin <= t_end)) {
+		return true;
+	}
+
+	int step[2] = { (direction[0] > 0) ? 1 : -1, (direction[1] > 0) ? 1 : -1 };
+	int level = top;
+	double t = t_begin;
+	while (t < t_end) {
+		int size = 1 << level;
+		int w = level_width[level];
+		int h = level_height[level];
+
+		//当前点所在格，恰在格边界上时取射线前进方向一侧
+		int index[2];
+		double t_exit = t_end;
+		bool outside = false;
+		int limit[2] = { w, h };
+		for (int k = 0; k < 2; k++) {
+			double p = origin[k] + direction[k] * t;
+			int i = (int)floor(p / size);
+			if (direction[k] < 0 && i * size == p) {
+				i--;
+			}
+			if (direction[k] != 0) {
+				double te = ((step[k] > 0 ? i + 1 : i) * (double)size - origin[k]) / direction[k];
+				//舍入使当前点停在刚离开的格内时前进一格
+				if (!(te > t)) {
+					i += step[k];
+					te = ((step[k] > 0 ? i + 1 : i) * (double)size - origin[k]) / direction[k];
+				}
+				t_exit = (te < t_exit) ? te : t_exit;
+			}
+			//图的最后一行、列高程点属于前一格
+			if (i >= limit[k] && p <= (double)limit[k] * size) {
+				i = limit[k] - 1;
+			}
+			if (i < 0 || i >= limit[k]) {
+				outside = true;
+			}
+			index[k] = i;
+		}
+		if (outside) {
+			break;
+		}
+
+		double z0 = origin[2] + direction[2] * t;
+		double z1 = origin[2] + direction[2] * t_exit;
+		double z_min = (z0 < z1) ? z0 : z1;
+		if (z_min > level_list[level][(size_t)index[1] * w + index[0]]) {
+			t = t_exit;
+			level = (level < top) ? level + 1 : top;
+			continue;
+		}
+		if (level > 0) {
+			level--;
+			continue;
+		}
+		if (CellBlocked(index[0], index[1], origin, direction, t, t_exit)) {
+			return false;
+		}
+		t = t_exit;
+	}
+
+	return true;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          批量通视
+*   @details        第 k 对为 (from[0][k], from[1][k], from[2][k]) 到 (to[0][k], to[1][k], to[2][k])，分量为(北，天，东)
+*   @param[out]     visible         是否通视 [count]
+*   @param[in]      from            起点的三个分量
+*   @param[in]      to              终点的三个分量
+*   @param[in]      count           数量
+*   @retval         0               正常
+*   @retval         1               错误，参数为空或高程图未打开
+*/
+int TerrainMap_C::LineOfSightBatch(
+	bool*							visible,
+	const double* const				from[3],
+	const double* const				to[3],
+	int								count) const
+{
+	if (header == NULL || visible == NULL || from == NULL || to == NULL) {
+		return 1;
+	}
+	for (int k = 0; k < 3; k++) {
+		if (from[k] == NULL || to[k] == NULL) {
+			return 1;
+		}
+	}
+
+	for (int k = 0; k < count; k++) {
+		double a[3] = { from[0][k], from[1][k], from[2][k] };
+		double b[3] = { to[0][k], to[1][k], to[2][k] };
+		visible[k] = LineOfSight(a, b);
+	}
+	return 0;
+}
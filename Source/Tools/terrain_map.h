@@ -0,0 +1,240 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           terrain_map.h
+*   @brief          地形高程图。
+*   @details        以只读方式映射一块高程图文件(DEM 栅格)，提供地形高度、离地高度和两点间地形通视查询。
+					高程点按(北，东)等间隔排列，格内双线性插值；图外地形高度取0。
+					打开时建立最大值金字塔：第0层每格为四个角点高程的最大值(双线性曲面在格内不超过角点最大值)，
+					每上一层取下一层2x2格的最大值。通视查询沿射线按层做 DDA：射线在某格内的最低点高于该格最大值时整格跳过，
+					否则下降一层，到第0层时按双线性曲面精确判断，远离地形的射线只需访问少数几个粗层格。
+					通视只考虑地形遮挡，地球曲率仍由 getRadarSight 的视距考虑。
+					文件依次为文件头、高程(float，[北][东]，单位：米)。Generate 生成分形合成地形，供测试使用。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+#ifndef TERRAIN_MAP_H_INCLUDED
+#define TERRAIN_MAP_H_INCLUDED
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           被使用的头文件。
+*   @{
+*/
+#include <stddef.h>
+#include <vector>
+/** @}  */
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           高程图宏定义。
+*   @{
+*/
+#define TERRAIN_MAP_MAGIC 0x52524554     //高程图文件标识 "TERR"
+#define TERRAIN_MAP_VERSION 1            //高程图文件格式版本
+#define TERRAIN_MAP_MAX_SIZE 32768       //每个方向的高程点数上限
+/** @}  */
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          高程图文件头。
+*   @details        第 row 行第 col 列高程点位于 (origin_north+row*cell_size, origin_east+col*cell_size)。
+*/
+struct TerrainMapHeader_T
+{
+	int								magic;							//!< TERRAIN_MAP_MAGIC
+	int								version;						//!< TERRAIN_MAP_VERSION
+	int								header_size;					//!< sizeof(TerrainMapHeader_T)
+	int								width;							//!< 东向高程点数
+	int								height;							//!< 北向高程点数
+	int								reserved;
+	double							origin_north;					//!< 第0个高程点的北向坐标，单位：米
+	double							origin_east;					//!< 第0个高程点的东向坐标，单位：米
+	double							cell_size;						//!< 高程点间隔，单位：米
+};
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          地形高程图。
+*   @details        打开后只读，可在多个线程中同时查询。
+*/
+class TerrainMap_C
+{
+public:
+	TerrainMap_C();
+	~TerrainMap_C();
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          打开高程图文件
+	*   @details        以只读方式映射整个文件，检查文件头后建立最大值金字塔，已打开的文件先关闭
+	*   @param[in]      path            文件路径
+	*   @retval         0               正常
+	*   @retval         1               错误，文件无法打开或格式不符
+	*/
+	int Open(const char* path);
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          使用内存中的高程图
+	*   @details        数据由调用者持有，关闭前须一直有效，首地址须按8字节对齐
+	*   @param[in]      in_data         高程图数据，格式与文件相同
+	*   @param[in]      size            字节数
+	*   @retval         0               正常
+	*   @retval         1               错误，格式不符
+	*/
+	int Attach(const void* in_data, long long size);
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          关闭高程图
+	*   @details        解除文件映射，释放金字塔
+	*   @retval         0               正常
+	*/
+	int Close();
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          生成合成高程图文件
+	*   @details        多层值噪声叠加的分形地形，高程范围 0 ~ max_height，同一种子结果相同
+	*   @param[in]      path            文件路径
+	*   @param[in]      width           东向高程点数，>=2
+	*   @param[in]      height          北向高程点数，>=2
+	*   @param[in]      cell_size       高程点间隔，单位：米
+	*   @param[in]      max_height      最大高程，单位：米
+	*   @param[in]      seed            随机数种子
+	*   @retval         0               正常
+	*   @retval         1               错误，参数无效或文件无法写入
+	*/
+	static int Generate(
+		const char*						path,
+		int								width,
+		int								height,
+		double							cell_size,
+		double							max_height,
+		unsigned long long				seed);
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          地形高度
+	*   @details        双线性插值，图外为0
+	*   @param[in]      north           北向坐标，单位：米
+	*   @param[in]      east            东向坐标，单位：米
+	*   @retval         地形高度，单位：米
+	*/
+	double Height(
+		double							north,
+		double							east) const;
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          离地高度
+	*   @details        高度减去地形高度，<=0 表示触地
+	*   @param[in]      north           北向坐标，单位：米
+	*   @param[in]      east            东向坐标，单位：米
+	*   @param[in]      altitude        高度，单位：米
+	*   @retval         离地高度，单位：米
+	*/
+	double HeightAboveGround(
+		double							north,
+		double							east,
+		double							altitude) const
+	{
+		return altitude - Height(north, east);
+	}
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          批量离地高度
+	*   @details        用于每步检查全部飞机是否触地
+	*   @param[out]     hag             离地高度 [count]
+	*   @param[in]      north           北向坐标 [count]
+	*   @param[in]      east            东向坐标 [count]
+	*   @param[in]      altitude        高度 [count]
+	*   @param[in]      count           数量
+	*   @retval         0               正常
+	*   @retval         1               错误，参数为空或高程图未打开
+	*/
+	int HeightAboveGroundBatch(
+		double*							hag,
+		const double*					north,
+		const double*					east,
+		const double*					altitude,
+		int								count) const;
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          两点间通视
+	*   @details        位置与 Radar() 相同为(北，天，东)，射线低于地形时不通视，恰好擦过地形时通视；图外部分不检查
+	*   @param[in]      positionA[3]    A点位置
+	*   @param[in]      positionB[3]    B点位置
+	*   @retval         true            通视
+	*/
+	bool LineOfSight(
+		const double					positionA[3],
+		const double					positionB[3]) const;
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          批量通视
+	*   @details        第 k 对为 (from[0][k], from[1][k], from[2][k]) 到 (to[0][k], to[1][k], to[2][k])，分量为(北，天，东)
+	*   @param[out]     visible         是否通视 [count]
+	*   @param[in]      from            起点的三个分量
+	*   @param[in]      to              终点的三个分量
+	*   @param[in]      count           数量
+	*   @retval         0               正常
+	*   @retval         1               错误，参数为空或高程图未打开
+	*/
+	int LineOfSightBatch(
+		bool*							visible,
+		const double* const				from[3],
+		const double* const				to[3],
+		int								count) const;
+
+	bool Empty() const { return header == NULL; }
+	const TerrainMapHeader_T* Header() const { return header; }
+	int LevelCount() const { return (int)level_list.size(); }
+
+	//全图最高点，单位：米
+	double MaxHeight() const { return level_list.empty() ? 0 : level_list.back()[0]; }
+
+private:
+	const unsigned char*			data;
+	long long						data_size;
+	const TerrainMapHeader_T*		header;
+	const float*					height_list;					//[北][东]
+	double							inv_cell_size;
+
+	//最大值金字塔，level_list[k] 每格覆盖第0层 2^k x 2^k 格
+	std::vector<std::vector<float> >	level_list;
+	std::vector<int>				level_width;
+	std::vector<int>				level_height;
+
+	//文件映射句柄，Attach 时为空
+	void*							map_view;
+	long long						map_size;
+#ifdef _WIN32
+	void*							file_handle;
+	void*							mapping_handle;
+#endif
+
+	//检查文件头并建立金字塔
+	int Validate();
+
+	//第0层格内射线 t0 ~ t1 段是否低于双线性曲面，坐标以高程点间隔为单位
+	bool CellBlocked(
+		int								col,
+		int								row,
+		const double					origin[3],
+		const double					direction[3],
+		double							t0,
+		double							t1) const;
+};
+
+#endif // TERRAIN_MAP_H_INCLUDED
@@ -64,39 +64,76 @@ int rad2deg(
 }
 
 
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          生成[0,1]均匀分布随机数。
+*   @details        64位线性同余发生器，取高53位，状态保存在调用者提供的变量中。
+*   @param[in,out]  seed            发生器状态
+*   @retval         随机数
+*/
+static double uniformrand(
+	unsigned long long* seed)
+{
+	*seed = *seed * 6364136223846793005ULL + 1442695040888963407ULL;
+	return (double)(*seed >> 11) / 9007199254740991.0;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          初始化高斯随机数发生器状态。
+*   @details        初始化高斯随机数发生器状态。
+*   @param[out]     state           发生器状态
+*   @param[in]      seed            随机数种子
+*   @retval         0               正常
+*   @retval         1               错误
+*/
+int gaussrand_init(
+	GaussRand_T* state,
+	const unsigned long long seed)
+{
+	state->seed = seed;
+	state->V1 = 0;
+	state->V2 = 0;
+	state->S = 0;
+	state->phase = 0;
+	return 0;
+}
+
+
 // --------------------------------------------------------------------------------------------------------------------------------
 /**
 *   @brief          生成高斯分布随机数序列。
 *   @details        生成高斯分布随机数序列:期望为0.0，方差为1.0。
 *   @param[out]     gaussOut        随机数输出
+*   @param[in,out]  state           发生器状态
 *   @retval         0               正常
 *   @retval         1               错误
 */
 int gaussrand(
-	double* gaussOut
+	double* gaussOut,
+	GaussRand_T* state
 	)
 {
-    static double V1, V2, S;
-    static int phase = 0;
     double X;
 
-    if ( phase == 0 ) {
+    if ( state->phase == 0 ) {
         do {
-            double U1 = (double)rand() / RAND_MAX;
-            double U2 = (double)rand() / RAND_MAX;
+            double U1 = uniformrand(&state->seed);
+            double U2 = uniformrand(&state->seed);
 
-            V1 = 2 * U1 - 1;
-            V2 = 2 * U2 - 1;
-            S = V1 * V1 + V2 * V2;
-        } while(S >= 1 || S == 0);
+            state->V1 = 2 * U1 - 1;
+            state->V2 = 2 * U2 - 1;
+            state->S = state->V1 * state->V1 + state->V2 * state->V2;
+        } while(state->S >= 1 || state->S == 0);
 
-        X = V1 * sqrt(-2 * log(S) / S);
+        X = state->V1 * sqrt(-2 * log(state->S) / state->S);
     } else
-        X = V2 * sqrt(-2 * log(S) / S);
+        X = state->V2 * sqrt(-2 * log(state->S) / state->S);
 
-    phase = 1 - phase;
+    state->phase = 1 - state->phase;
 
     *gaussOut = X;
     return 0;
 }
-/** @}  */
+/** @}  */
\ No newline at end of file
@@ -52,16 +52,45 @@ int rad2deg(
 	const double radIn);
 
 
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          高斯随机数发生器状态。
+*   @details        由调用者持有，不同仿真实例各自保存一份，互不干扰。
+*/
+struct GaussRand_T
+{
+	unsigned long long				seed;							//!< 均匀分布随机数发生器状态
+	double							V1;								//!< 极坐标法中间量
+	double							V2;								//!< 极坐标法中间量
+	double							S;								//!< 极坐标法中间量
+	int								phase;							//!< 0-需要生成新的一对随机数 1-使用上次剩余的随机数
+};
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          初始化高斯随机数发生器状态。
+*   @details        初始化高斯随机数发生器状态。
+*   @param[out]     state           发生器状态
+*   @param[in]      seed            随机数种子
+*   @retval         0               正常
+*   @retval         1               错误
+*/
+int gaussrand_init(
+	GaussRand_T* state,
+	const unsigned long long seed);
+
 // --------------------------------------------------------------------------------------------------------------------------------
 /**
 *   @brief          生成高斯分布随机数序列。
 *   @details        生成高斯分布随机数序列:期望为0.0，方差为1.0。
 *   @param[out]     gaussOut        随机数输出
+*   @param[in,out]  state           发生器状态
 *   @retval         0               正常
 *   @retval         1               错误
 */
 int gaussrand(
-	double* gaussOut
+	double* gaussOut,
+	GaussRand_T* state
 	);
 
 
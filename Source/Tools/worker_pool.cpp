@@ -0,0 +1,148 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           worker_pool.cpp
+*   @brief          工作线程池实现。
+*   @details        工作线程池实现。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           被使用的头文件。
+*   @{
+*/
+#include "worker_pool.h"
+/** @}  */
+
+
+WorkerPool_C::WorkerPool_C(int thread_count)
+{
+	if (thread_count <= 0) {
+		thread_count = (int)std::thread::hardware_concurrency();
+		if (thread_count <= 0) {
+			thread_count = 1;
+		}
+	}
+
+	batch_task = NULL;
+	batch_context = NULL;
+	batch_count = 0;
+	batch_generation = 0;
+	batch_working = 0;
+	stopping = false;
+	next_index = 0;
+
+	//调用线程也参与计算，只需另建 thread_count-1 个线程
+	for (int i = 0; i < thread_count - 1; i++) {
+		thread_list.push_back(std::thread(&WorkerPool_C::WorkerLoop, this));
+	}
+}
+
+
+WorkerPool_C::~WorkerPool_C()
+{
+	{
+		std::lock_guard<std::mutex> lock(pool_mutex);
+		stopping = true;
+	}
+	start_cv.notify_all();
+
+	for (size_t i = 0; i < thread_list.size(); i++) {
+		thread_list[i].join();
+	}
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          并行执行任务
+*   @details        对 0 ~ task_count-1 的每个下标调用一次 task，返回时全部任务已完成
+*   @param[in]      task_count      任务数量
+*   @param[in]      task            任务函数
+*   @param[in]      context         传给任务函数的上下文
+*   @retval         0               正常
+*   @retval         1               错误
+*/
+int WorkerPool_C::ParallelFor(
+	int								task_count,
+	WorkerTask_F					task,
+	void*							context)
+{
+	if (task == NULL || task_count < 0) {
+		return 1;
+	}
+	if (task_count == 0) {
+		return 0;
+	}
+
+	//任务太少或没有工作线程时直接在本线程执行
+	if (thread_list.empty() || task_count == 1) {
+		for (int i = 0; i < task_count; i++) {
+			task(context, i);
+		}
+		return 0;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(pool_mutex);
+		batch_task = task;
+		batch_context = context;
+		batch_count = task_count;
+		batch_working = (int)thread_list.size();
+		next_index.store(0);
+		batch_generation++;
+	}
+	start_cv.notify_all();
+
+	Drain();
+
+	//等待工作线程结束本批，之后才能安全地发布下一批
+	std::unique_lock<std::mutex> lock(pool_mutex);
+	finish_cv.wait(lock, [this] { return batch_working == 0; });
+
+	return 0;
+}
+
+
+void WorkerPool_C::Drain()
+{
+	for (;;) {
+		int index = next_index.fetch_add(1);
+		if (index >= batch_count) {
+			break;
+		}
+		batch_task(batch_context, index);
+	}
+}
+
+
+void WorkerPool_C::WorkerLoop()
+{
+	long long seen_generation = 0;
+
+	for (;;) {
+		{
+			std::unique_lock<std::mutex> lock(pool_mutex);
+			start_cv.wait(lock, [&] { return stopping || batch_generation != seen_generation; });
+			if (stopping) {
+				return;
+			}
+			seen_generation = batch_generation;
+		}
+
+		Drain();
+
+		{
+			std::lock_guard<std::mutex> lock(pool_mutex);
+			batch_working--;
+		}
+		finish_cv.notify_one();
+	}
+}
@@ -0,0 +1,111 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           worker_pool.h
+*   @brief          工作线程池。
+*   @details        常驻工作线程执行并行循环，任务下标由原子计数器分发，调用过程中不分配内存。
+					只使用标准库线程，与平台无关。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+#ifndef WORKER_POOL_H_INCLUDED
+#define WORKER_POOL_H_INCLUDED
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           被使用的头文件。
+*   @{
+*/
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+/** @}  */
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          并行任务函数。
+*   @details        并行任务函数。
+*   @param[in]      context         调用者传入的上下文
+*   @param[in]      task_index      任务下标，0 ~ task_count-1
+*/
+typedef void (*WorkerTask_F)(void* context, int task_index);
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          工作线程池。
+*   @details        ParallelFor 阻塞直到全部任务完成，调用线程同时参与计算。同一线程池不支持多个线程同时调用 ParallelFor。
+*/
+class WorkerPool_C
+{
+public:
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          创建线程池
+	*   @details        创建线程池
+	*   @param[in]      thread_count    参与计算的线程总数(含调用线程)，不大于0时取硬件线程数
+	*/
+	explicit WorkerPool_C(int thread_count = 0);
+	~WorkerPool_C();
+
+	//线程不可拷贝
+	WorkerPool_C(const WorkerPool_C&) = delete;
+	WorkerPool_C& operator=(const WorkerPool_C&) = delete;
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          并行执行任务
+	*   @details        对 0 ~ task_count-1 的每个下标调用一次 task，返回时全部任务已完成
+	*   @param[in]      task_count      任务数量
+	*   @param[in]      task            任务函数
+	*   @param[in]      context         传给任务函数的上下文
+	*   @retval         0               正常
+	*   @retval         1               错误
+	*/
+	int ParallelFor(
+		int								task_count,
+		WorkerTask_F					task,
+		void*							context);
+
+	// --------------------------------------------------------------------------------------------------------------------------------
+	/**
+	*   @brief          参与计算的线程总数
+	*   @details        参与计算的线程总数，含调用线程
+	*   @retval         线程数
+	*/
+	int ThreadCount() const { return (int)thread_list.size() + 1; }
+
+private:
+	std::vector<std::thread>		thread_list;					//!< 工作线程
+	std::mutex						pool_mutex;
+	std::condition_variable			start_cv;						//!< 新一批任务开始
+	std::condition_variable			finish_cv;						//!< 本批任务全部结束
+
+	//本批任务，由 pool_mutex 保护发布
+	WorkerTask_F					batch_task;
+	void*							batch_context;
+	int								batch_count;
+	long long						batch_generation;				//!< 批次序号，工作线程据此判断是否有新任务
+	int								batch_working;					//!< 本批仍在执行的工作线程数
+	bool							stopping;
+
+	std::atomic<int>				next_index;						//!< 下一个待领取的任务下标
+
+	//工作线程主循环
+	void WorkerLoop();
+
+	//领取并执行任务直到全部领完
+	void Drain();
+};
+
+
+#endif // WORKER_POOL_H_INCLUDED
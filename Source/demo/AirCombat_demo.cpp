@@ -61,8 +61,8 @@ int main() {
 			color = "Blue";
 			pilot = "Human";
 		}
-		tacview_show.InitOneObject(i, battlefield.aircraft_list[i].Sim_id, battlefield.aircraft_list[i].base_name,
-			battlefield.aircraft_list[i].base_type, pilot,color,15.5, 9.7, 4.8,
+		tacview_show.InitOneObject(i, battlefield.aircraft_list[i].Sim_id, battlefield.aircraft_list[i].BaseName(),
+			battlefield.aircraft_list[i].BaseType(), pilot,color,15.5, 9.7, 4.8,
 			battlefield.aircraft_list[i].coordinate_longitude, battlefield.aircraft_list[i].coordinate_latitude, battlefield.aircraft_list[i].coordinate_altitude,
 			battlefield.aircraft_list[i].coordinate_roll, battlefield.aircraft_list[i].coordinate_pitch, battlefield.aircraft_list[i].coordinate_yaw);
 	}
@@ -73,18 +73,8 @@ int main() {
 	double dt = 0.1;
 	int ShootFlag = 0;
 	while (1) {
-		//*****л
-		if (battlefield.aircraft_list[0].base_live == 0) {
-			battlefield.aircraft_list[0].craft_handle << 0, 0, 0, 0;
-		}
-
-		//ɻ״̬
-		battlefield.aircraft_list[0].Run(dt);
-		//ʾ
-		tacview_show.OneFrameFlightState(0, battlefield.aircraft_list[0].Sim_id, battlefield.aircraft_list[0].base_live, 
-			battlefield.aircraft_list[0].coordinate_longitude, battlefield.aircraft_list[0].coordinate_latitude, battlefield.aircraft_list[0].coordinate_altitude,
-			battlefield.aircraft_list[0].coordinate_roll, battlefield.aircraft_list[0].coordinate_pitch, battlefield.aircraft_list[0].coordinate_yaw,
-			0, -1, 0, 0);
+		//»ʵбֻʾбеʵ
+		battlefield.RefreshActiveList();
 
 		//*****˿ػ
 		//ռ̻ݸź
@@ -122,13 +112,15 @@ int main() {
 			battlefield.aircraft_list[1].craft_handle(0) = (JSs2tate.lX) / 5000.0;//*
 		}
 
-		//ɻ״̬
-		battlefield.aircraft_list[1].Run(dt);
-		//ʾ
-		tacview_show.OneFrameFlightState(1, battlefield.aircraft_list[1].Sim_id, battlefield.aircraft_list[1].base_live,
-			battlefield.aircraft_list[1].coordinate_longitude, battlefield.aircraft_list[1].coordinate_latitude, battlefield.aircraft_list[1].coordinate_altitude,
-			battlefield.aircraft_list[1].coordinate_roll, battlefield.aircraft_list[1].coordinate_pitch, battlefield.aircraft_list[1].coordinate_yaw,
-			0, -1, 0, 0);
+		//ɻ״̬㼰ʾ0Ϊл1Ϊ˿ػ
+		for (int k = 0; k < battlefield.active_aircraft_count; k++) {
+			int i = battlefield.active_aircraft_list[k];
+			battlefield.aircraft_list[i].Run(dt);
+			tacview_show.OneFrameFlightState(i, battlefield.aircraft_list[i].Sim_id, battlefield.aircraft_list[i].base_live,
+				battlefield.aircraft_list[i].coordinate_longitude, battlefield.aircraft_list[i].coordinate_latitude, battlefield.aircraft_list[i].coordinate_altitude,
+				battlefield.aircraft_list[i].coordinate_roll, battlefield.aircraft_list[i].coordinate_pitch, battlefield.aircraft_list[i].coordinate_yaw,
+				0, -1, 0, 0);
+		}
 
 		if (ShootFlag == 1) {//ж
 			battlefield.MissileFire(battlefield.aircraft_list[1], battlefield.aircraft_list[0]);
@@ -136,7 +128,8 @@ int main() {
 			ShootFlag = 0;
 		}
 		//м
-		for (int i = 0; i < battlefield.missile_count; i++) {
+		for (int k = 0; k < battlefield.active_missile_count; k++) {
+			int i = battlefield.active_missile_list[k];
 			battlefield.missile_list[i].Run(dt);
 			string color;
 			if (battlefield.missile_list[i].base_team == 1) {
@@ -0,0 +1,210 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           Check_alarm.cpp
+*   @brief          批量告警计时与一致性检查。
+*   @details        随机生成N架飞机，各机的雷达型号和告警器型号随机选取或关闭，批量告警的掩码与逐对调用 Alarm() 相同，
+					记录逐对计算与批量计算的耗时；修改告警器参数后批量告警的缓存随之更新。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+#include "Check_demo.h"
+#include "../Sensor/alarm_model.h"
+#include "../Tools/counter_rand.h"
+
+#include <stdio.h>
+#include <vector>
+
+static const int check_pair_budget = 400000;		//计时时每种方式至少计算的飞机对数
+
+//随机场景，型号下标 <0 表示雷达未开机或没有告警器
+struct AlarmScene_T
+{
+	std::vector<double>				position[3];					//(北，天，东)，单位：米
+	std::vector<double>				attitude[3];					//(滚转，偏航，俯仰)，单位：弧度
+	std::vector<int>				radar_type;
+	std::vector<int>				alarm_type;
+	RadarBatchState_T				state;
+};
+
+//水平方向在 spread 见方内均匀分布，高度 0 ~ 12km；random_type 为 false 时全部使用第0种型号
+static void MakeAlarmScene(AlarmScene_T* scene, int count, double spread, bool random_type, unsigned int seed)
+{
+	for (int k = 0; k < 3; k++) {
+		scene->position[k].resize(count);
+		scene->attitude[k].resize(count);
+	}
+	scene->radar_type.assign(count, 0);
+	scene->alarm_type.assign(count, 0);
+	for (int i = 0; i < count; i++) {
+		CounterRand_T key;
+		double u[8];
+		crand_key(&key, 47, seed, (unsigned int)i, 0);
+		for (int k = 0; k < 8; k++) {
+			crand_uniform(&u[k], &key, k);
+		}
+		scene->position[0][i] = (u[0] - 0.5) * spread;
+		scene->position[1][i] = u[1] * 12000;
+		scene->position[2][i] = (u[2] - 0.5) * spread;
+		for (int k = 0; k < 3; k++) {
+			scene->attitude[k][i] = (u[3 + k] - 0.5) * 6.28;
+		}
+		if (random_type) {
+			scene->radar_type[i] = (int)(u[6] * 4) - 1;
+			scene->alarm_type[i] = (int)(u[7] * 4) - 1;
+		}
+	}
+
+	scene->state.count = count;
+	for (int k = 0; k < 3; k++) {
+		scene->state.position[k] = scene->position[k].data();
+		scene->state.attitude[k] = scene->attitude[k].data();
+	}
+	for (int k = 0; k < 5; k++) {
+		scene->state.sigma_type[k] = NULL;
+	}
+	scene->state.rcs_table = NULL;
+	scene->state.Cnb = NULL;
+}
+
+//第 i 架飞机的雷达是否照射到第 j 架飞机的告警器，逐对调用 Alarm()
+static bool AlarmPair(const AlarmScene_T& scene, const RadarModel_C* const* radar_models,
+	const AlarmModel_C* const* alarm_models, int i, int j)
+{
+	if (i == j || scene.radar_type[i] < 0 || scene.alarm_type[j] < 0) {
+		return false;
+	}
+	const RadarParam_T& p = radar_models[scene.radar_type[i]]->Param();
+	const AlarmParam_T& q = alarm_models[scene.alarm_type[j]]->Param();
+	double radar_position[3] = { scene.position[0][i], scene.position[1][i], scene.position[2][i] };
+	double radar_attitude[3] = { scene.attitude[0][i], scene.attitude[1][i], scene.attitude[2][i] };
+	double alarm_position[3] = { scene.position[0][j], scene.position[1][j], scene.position[2][j] };
+	double alarm_attitude[3] = { scene.attitude[0][j], scene.attitude[1][j], scene.attitude[2][j] };
+	bool alarm_on = false;
+	Alarm(&alarm_on, radar_position, radar_attitude, alarm_position, alarm_attitude, p.lambda, p.Pgt, p.nG, p.Gmax,
+		p.theta_t, p.theta_b, q.P, q.G, q.Ltx, q.Lp, q.f_min, q.f_max, q.azimuth_alarm_width, q.pitch_alarm_width,
+		p.azimuth_radar_width, p.pitch_radar_width);
+	return alarm_on;
+}
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          批量告警计时与一致性检查
+*   @details        三种雷达(其一不在告警频段内)、三种告警器(全向和两种受限接收范围)，60km 和 300km 两种范围，
+					逐位比较批量告警掩码与逐对 Alarm() 的结果；最后把告警器灵敏度门限放大100倍、再移出雷达频段，
+					检查告警数随参数改变
+*   @param[in]      argv[0]         飞机数量，缺省依次取 32、100、300
+*   @retval         0               通过
+*   @retval         1               未通过
+*/
+int CheckAlarmBatch(int argc, char* argv[])
+{
+	std::vector<int> count_list;
+	if (argc > 0) {
+		count_list.push_back(CheckArgInt(argc, argv, 0, 100));
+	}
+	else {
+		count_list.push_back(32);
+		count_list.push_back(100);
+		count_list.push_back(300);
+	}
+
+	RadarModel_C radar0;
+	RadarModel_C radar1(RadarModel_C::MissileParam());
+	RadarParam_T out_band = RadarModel_C::AircraftParam();
+	out_band.lambda = 0.5;
+	RadarModel_C radar2(out_band);
+	AlarmModel_C alarm0;
+	AlarmParam_T q = AlarmModel_C::DefaultParam();
+	q.azimuth_alarm_width = 2.0;
+	q.pitch_alarm_width = 1.0;
+	AlarmModel_C alarm1(q);
+	q.azimuth_alarm_width = 4.5;
+	q.pitch_alarm_width = 2.0;
+	AlarmModel_C alarm2(q);
+	const RadarModel_C* radar_models[3] = { &radar0, &radar1, &radar2 };
+	const AlarmModel_C* alarm_models[3] = { &alarm0, &alarm1, &alarm2 };
+	AlarmBatch_C batch;
+	batch.SetTypes(radar_models, 3, alarm_models, 3);
+
+	int fail = 0;
+	const double spread[2] = { 60000, 300000 };
+	for (size_t c = 0; c < count_list.size(); c++) {
+		int n = count_list[c];
+		if (n < 2) {
+			printf("参数无效\n");
+			return 1;
+		}
+		for (int s = 0; s < 2; s++) {
+			AlarmScene_T scene;
+			MakeAlarmScene(&scene, n, spread[s], true, (unsigned int)(n * 10 + s));
+			int words = AlarmBatch_C::MaskWords(n);
+			std::vector<unsigned long long> mask(n * words);
+			AlarmBatchStats_T stats;
+			batch.Run(mask.data(), &scene.state, scene.radar_type.data(), scene.alarm_type.data(), &stats);
+
+			long long diff = 0;
+			long long alarmed = 0;
+			for (int j = 0; j < n; j++) {
+				for (int i = 0; i < n; i++) {
+					bool on = AlarmPair(scene, radar_models, alarm_models, i, j);
+					diff += (AlarmBatch_C::Illuminated(&mask[j * words], i) != on);
+					alarmed += on;
+				}
+			}
+
+			int repeat = check_pair_budget / (n * n) + 1;
+			volatile long long sink = 0;
+			double t0 = CheckClock();
+			for (int r = 0; r < repeat; r++) {
+				for (int j = 0; j < n; j++) {
+					for (int i = 0; i < n; i++) {
+						sink += AlarmPair(scene, radar_models, alarm_models, i, j);
+					}
+				}
+			}
+			double alarm_time = (CheckClock() - t0) / repeat;
+			t0 = CheckClock();
+			for (int r = 0; r < repeat; r++) {
+				batch.Run(mask.data(), &scene.state, scene.radar_type.data(), scene.alarm_type.data());
+				sink += (long long)mask[0];
+			}
+			double batch_time = (CheckClock() - t0) / repeat;
+
+			printf("%3d 架 %3.0fkm: 飞机对 %lld, 告警 %lld, 不同 %lld | 剔除 频段 %lld 距离 %lld 视距 %lld 范围 %lld, 计算 %lld | "
+				"Alarm() %.1f us, 批量 %.1f us (%.1fx)\n", n, spread[s] / 1000, stats.pair_count, alarmed, diff,
+				stats.band_culled, stats.range_culled, stats.sight_culled, stats.cone_culled, stats.evaluated,
+				alarm_time * 1e6, batch_time * 1e6, alarm_time / batch_time);
+			fail |= (diff != 0) ? 1 : 0;
+		}
+	}
+
+	//修改告警器参数后缓存须更新
+	int n = 100;
+	AlarmScene_T scene;
+	MakeAlarmScene(&scene, n, 300000, false, 999);
+	int words = AlarmBatch_C::MaskWords(n);
+	std::vector<unsigned long long> mask(n * words);
+	AlarmBatchStats_T stats;
+	batch.Run(mask.data(), &scene.state, scene.radar_type.data(), scene.alarm_type.data(), &stats);
+	long long before = stats.alarmed;
+	AlarmParam_T changed = alarm0.Param();
+	changed.P *= 100;
+	alarm0.SetParam(changed);
+	batch.Run(mask.data(), &scene.state, scene.radar_type.data(), scene.alarm_type.data(), &stats);
+	long long after = stats.alarmed;
+	changed.f_min = 4e10;
+	alarm0.SetParam(changed);
+	batch.Run(mask.data(), &scene.state, scene.radar_type.data(), scene.alarm_type.data(), &stats);
+	printf("修改参数: 告警 %lld, 灵敏度门限x100 后 %lld, 移出频段后 %lld (频段剔除 %lld)\n", before, after, stats.alarmed, stats.band_culled);
+	if (after == before || stats.alarmed != 0) {
+		fail = 1;
+	}
+	return fail;
+}
@@ -0,0 +1,288 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           Check_battlefield.cpp
+*   @brief          多战场并行一致性检查。
+*   @details        N 个互不相同的战场先串行解算，再在多个线程中轮流单步解算，逐位比较两次的飞机、导弹状态和击毁事件。
+					仿真核心不含函数内静态变量和全局状态时两次结果完全相同。
+					另以确定的几何检查近炸引信：导弹在两个时间步之间掠过非目标敌机时引爆，脱靶量为上一步内的最近点距离，友机不引爆。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+#include "Check_demo.h"
+#include "../CombatSimulation/UnitDefine.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+using namespace CombatSimulation;
+
+static const double check_step = 0.02;				//单步时间间隔，单位：秒
+static const int check_fire_step = 50;				//发射导弹的步数
+static const double check_fuze_step = 0.1;			//近炸检查的步长，单位：秒
+static const double check_fuze_range = 20.0;		//近炸检查的杀伤半径，单位：米
+
+//第 index 个战场的初始态：2对2，位置和控制量按编号扰动
+static void SetupBattlefield(Battlefield_C* battlefield, int index)
+{
+	GaussRand_T rand_state;
+	gaussrand_init(&rand_state, 1000 + index);
+	double noise[8];
+	for (int k = 0; k < 8; k++) {
+		gaussrand(&noise[k], &rand_state);
+	}
+
+	battlefield->Reset();
+	battlefield->InitCoordinate(126.0, 30.0, 0.0);
+	battlefield->aircraft_count = 4;
+	for (int a = 0; a < 4; a++) {
+		int team = 1 + a % 2;
+		double lat = 30.0 + ((team == 1) ? 0.0 : 0.12) + 0.002 * noise[a];
+		double lon = 126.0 + 0.01 * (a / 2) + 0.002 * noise[4 + a];
+		double yaw = (team == 1) ? 0.0 : 180.0;
+		double speed = (team == 1) ? 250.0 : -250.0;
+		battlefield->aircraft_list[a].Init(10000001 + a, "F-16", team, lon, lat, 6000.0 + 100.0 * a, 0, 0, yaw, speed, 0, 0);
+		battlefield->aircraft_list[a].craft_handle << 0.02 * noise[a], 0.01 * noise[4 + a], 0, 10;
+	}
+}
+
+//单步解算，到发射步时每架飞机向对面同列的飞机发射一枚导弹
+static void StepBattlefield(Battlefield_C* battlefield, int step)
+{
+	if (step == check_fire_step) {
+		for (int a = 0; a < 4; a++) {
+			battlefield->MissileFire(battlefield->aircraft_list[a], battlefield->aircraft_list[a ^ 1]);
+		}
+	}
+	battlefield->Run(check_step);
+}
+
+//逐位比较两个战场，返回不同的字段数
+int CheckCompareBattlefield(const Battlefield_C& a, const Battlefield_C& b)
+{
+	int diff = 0;
+	diff += (memcmp(&a.time, &b.time, sizeof(double)) != 0);
+	diff += (a.aircraft_count != b.aircraft_count) + (a.missile_count != b.missile_count);
+	for (int i = 0; i < a.aircraft_count && i < b.aircraft_count; i++) {
+		const Aircraft_Object_C& x = a.aircraft_list[i];
+		const Aircraft_Object_C& y = b.aircraft_list[i];
+		diff += (x.base_live != y.base_live) + (x.lod_level != y.lod_level);
+		diff += (memcmp(x.craft_state.data(), y.craft_state.data(), sizeof(double) * 16) != 0);
+		diff += (memcmp(&x.coordinate_longitude, &y.coordinate_longitude, sizeof(double) * 9) != 0);
+	}
+	for (int i = 0; i < a.missile_count && i < b.missile_count; i++) {
+		const Missile_Object_C& x = a.missile_list[i];
+		const Missile_Object_C& y = b.missile_list[i];
+		diff += (x.base_live != y.base_live) + (x.missile_live != y.missile_live);
+		diff += (memcmp(x.missile_state.data(), y.missile_state.data(), sizeof(double) * 16) != 0);
+		diff += (memcmp(x.missile_handle.data(), y.missile_handle.data(), sizeof(double) * 4) != 0);
+	}
+	diff += (a.kill_event_count != b.kill_event_count);
+	for (int i = 0; i < a.kill_event_count && i < b.kill_event_count; i++) {
+		diff += (memcmp(&a.kill_event_list[i], &b.kill_event_list[i], sizeof(KillEvent_T)) != 0);
+	}
+	return diff;
+}
+
+//设置飞机导航系位置和速度
+static void PlaceState(Eigen::Matrix4d* state, double x, double y, double z, double vx)
+{
+	(*state)(0, 0) = x;
+	(*state)(0, 1) = y;
+	(*state)(0, 2) = z;
+	(*state)(1, 0) = vx;
+	(*state)(1, 1) = 0;
+	(*state)(1, 2) = 0;
+}
+
+//近炸几何：0号(1队)向北30公里外的1号(2队)发射导弹，导弹以800米/秒向北；
+//2号(2队)和3号(1队)向南飞，在下一步中点与导弹纵向对齐，横向分别偏 hostile_offset 和 -6 米
+static void SetupFuze(Battlefield_C* battlefield, double hostile_offset)
+{
+	battlefield->Reset();
+	battlefield->InitCoordinate(126.0, 30.0, 0.0);
+	battlefield->aircraft_count = 4;
+	for (int a = 0; a < 4; a++) {
+		int team = (a == 0 || a == 3) ? 1 : 2;
+		double yaw = (a <= 1) ? 0.0 : 180.0;
+		double speed = (a <= 1) ? 250.0 : -250.0;
+		battlefield->aircraft_list[a].Init(10000001 + a, "F-16", team, 126.0 + 0.01 * a, 30.0, 6000, 0, 0, yaw, speed, 0, 0);
+		battlefield->aircraft_list[a].craft_handle.setZero();
+	}
+	battlefield->Run(check_step);
+	battlefield->MissileFire(battlefield->aircraft_list[0], battlefield->aircraft_list[1]);
+
+	//相对速度约1050米/秒，一步内纵向相对位移约105米，两个时间步上的距离都远大于杀伤半径
+	double half_pass = 0.5 * (800.0 + 250.0) * check_fuze_step;
+	PlaceState(&battlefield->aircraft_list[0].craft_state, -5000, 0, -6000, 250);
+	PlaceState(&battlefield->aircraft_list[1].craft_state, 30000, 0, -6000, 250);
+	PlaceState(&battlefield->aircraft_list[2].craft_state, half_pass, hostile_offset, -6000, -250);
+	PlaceState(&battlefield->aircraft_list[3].craft_state, half_pass, -6, -6000, -250);
+
+	Missile_Object_C& missile = battlefield->missile_list[0];
+	missile.destroy_range = check_fuze_range;
+	missile.missile_state.row(0).head(3) << 0, 0, -6000;
+	missile.missile_state.row(1).head(3) << 800, 0, 0;
+}
+
+//导弹与飞机在 t∈[-d_time,0] 内按解算后的相对位置和速度匀速外推的最近点距离，end_distance 输出两个时间步上的较小距离
+static double ClosestApproach(const Missile_Object_C& missile, const Aircraft_Object_C& air, double d_time, double* end_distance)
+{
+	double r[3];
+	double v[3];
+	double vv = 0;
+	double rv = 0;
+	for (int j = 0; j < 3; j++) {
+		r[j] = missile.missile_state(0, j) - air.craft_state(0, j);
+		v[j] = missile.missile_state(1, j) - air.craft_state(1, j);
+		vv += v[j] * v[j];
+		rv += r[j] * v[j];
+	}
+	double t = (vv > 0) ? -rv / vv : 0;
+	t = (t < -d_time) ? -d_time : ((t > 0) ? 0 : t);
+
+	double miss2 = 0;
+	double now2 = 0;
+	double last2 = 0;
+	for (int j = 0; j < 3; j++) {
+		miss2 += (r[j] + v[j] * t) * (r[j] + v[j] * t);
+		now2 += r[j] * r[j];
+		last2 += (r[j] - v[j] * d_time) * (r[j] - v[j] * d_time);
+	}
+	*end_distance = sqrt((now2 < last2) ? now2 : last2);
+	return sqrt(miss2);
+}
+
+//近炸引信检查：掠过非目标敌机时引爆并记录最近点脱靶量，只有友机在杀伤半径内时不引爆。返回不一致的项数
+static int CheckProximityFuze()
+{
+	Battlefield_C* battlefield = new Battlefield_C;
+	int mismatch = 0;
+
+	//敌机横向偏12米，友机偏6米更近，只能击毁敌机
+	SetupFuze(battlefield, 12.0);
+	battlefield->Run(check_fuze_step);
+	const Missile_Object_C& missile = battlefield->missile_list[0];
+	double end_distance;
+	double expected = ClosestApproach(missile, battlefield->aircraft_list[2], check_fuze_step, &end_distance);
+	double miss_distance = -1;
+	int hostile_kill = battlefield->kill_event_count;
+	mismatch += (hostile_kill != 1);
+	if (battlefield->kill_event_count == 1) {
+		const KillEvent_T& kill = battlefield->kill_event_list[0];
+		miss_distance = kill.miss_distance;
+		mismatch += (kill.missile_index != 0) + (kill.aircraft_index != 2);
+		mismatch += (kill.aircraft_id != battlefield->aircraft_list[2].Sim_id) + (kill.missile_id != missile.Sim_id);
+		mismatch += !(fabs(kill.miss_distance - expected) <= 1e-9);
+	}
+	mismatch += !(expected <= check_fuze_range && fabs(expected - 12.0) < 1.0 && end_distance > check_fuze_range);
+	mismatch += (missile.missile_live != CS_NOT_LIVE) + (battlefield->aircraft_list[2].base_live == CS_LIVE);
+	mismatch += (battlefield->aircraft_list[1].base_live != CS_LIVE) + (battlefield->aircraft_list[3].base_live != CS_LIVE);
+
+	//敌机远离航线，杀伤半径内只有友机
+	SetupFuze(battlefield, 5000.0);
+	battlefield->Run(check_fuze_step);
+	double friendly_end;
+	double friendly_distance = ClosestApproach(battlefield->missile_list[0], battlefield->aircraft_list[3], check_fuze_step, &friendly_end);
+	int friendly_kill = battlefield->kill_event_count;
+	mismatch += (friendly_distance > check_fuze_range) + (friendly_kill != 0);
+	mismatch += (battlefield->missile_list[0].missile_live != CS_LIVE) + (battlefield->aircraft_list[3].base_live != CS_LIVE);
+
+	printf("近炸引信: 敌机击毁事件 %d, 脱靶量 %.6f 米 (最近点 %.6f 米, 时间步上 %.3f 米); 仅友机时最近点 %.3f 米, 击毁事件 %d; 不一致 %d\n",
+		hostile_kill, miss_distance, expected, end_distance, friendly_distance, friendly_kill, mismatch);
+
+	delete battlefield;
+	return mismatch;
+}
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          多战场并行一致性检查
+*   @details        每个线程轮流单步解算分到的战场，使不同战场的解算在线程间充分交错；
+					每步结束比较击毁事件，结束时比较全部状态。另做一次确定几何的近炸引信检查
+*   @param[in]      argv[0]         战场数量，缺省64
+*   @param[in]      argv[1]         步数，缺省2000
+*   @param[in]      argv[2]         线程数量，缺省为硬件线程数
+*   @retval         0               通过
+*   @retval         1               未通过
+*/
+int CheckBattlefieldStress(int argc, char* argv[])
+{
+	int env_count = CheckArgInt(argc, argv, 0, 64);
+	int step_count = CheckArgInt(argc, argv, 1, 2000);
+	int thread_count = CheckArgInt(argc, argv, 2, (int)std::thread::hardware_concurrency());
+	if (env_count < 1 || step_count < 1) {
+		printf("参数无效\n");
+		return 1;
+	}
+	if (thread_count < 2) {
+		thread_count = 2;
+	}
+
+	//串行基准，保存每步的击毁事件数
+	Battlefield_C* serial_list = new Battlefield_C[env_count];
+	std::vector<int> serial_kill(env_count * step_count);
+	double t0 = CheckClock();
+	for (int e = 0; e < env_count; e++) {
+		SetupBattlefield(&serial_list[e], e);
+		for (int s = 0; s < step_count; s++) {
+			StepBattlefield(&serial_list[e], s);
+			serial_kill[e * step_count + s] = serial_list[e].kill_event_count;
+		}
+	}
+	double serial_time = CheckClock() - t0;
+
+	//并行：线程 t 负责编号为 t, t+thread_count, ... 的战场
+	Battlefield_C* parallel_list = new Battlefield_C[env_count];
+	std::vector<int> parallel_kill(env_count * step_count);
+	for (int e = 0; e < env_count; e++) {
+		SetupBattlefield(&parallel_list[e], e);
+	}
+	t0 = CheckClock();
+	std::vector<std::thread> thread_list;
+	for (int t = 0; t < thread_count; t++) {
+		thread_list.push_back(std::thread([&, t]() {
+			for (int s = 0; s < step_count; s++) {
+				for (int e = t; e < env_count; e += thread_count) {
+					StepBattlefield(&parallel_list[e], s);
+					parallel_kill[e * step_count + s] = parallel_list[e].kill_event_count;
+				}
+			}
+		}));
+	}
+	for (size_t t = 0; t < thread_list.size(); t++) {
+		thread_list[t].join();
+	}
+	double parallel_time = CheckClock() - t0;
+
+	int mismatch = 0;
+	int kill_total = 0;
+	for (int e = 0; e < env_count; e++) {
+		int diff = CheckCompareBattlefield(serial_list[e], parallel_list[e]);
+		for (int s = 0; s < step_count; s++) {
+			diff += (serial_kill[e * step_count + s] != parallel_kill[e * step_count + s]);
+			kill_total += serial_kill[e * step_count + s];
+		}
+		if (diff != 0) {
+			printf("战场 %d: %d 处不同\n", e, diff);
+			mismatch++;
+		}
+	}
+
+	printf("%d 个战场 x %d 步, %d 线程: 串行 %.3f s, 并行 %.3f s, 击毁事件 %d, 不一致战场 %d\n",
+		env_count, step_count, thread_count, serial_time, parallel_time, kill_total, mismatch);
+
+	int fuze_mismatch = CheckProximityFuze();
+
+	delete[] serial_list;
+	delete[] parallel_list;
+	return (mismatch == 0 && fuze_mismatch == 0) ? 0 : 1;
+}
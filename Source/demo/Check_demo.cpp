@@ -0,0 +1,100 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           Check_demo.cpp
+*   @brief          性能与一致性检查程序入口。
+*   @details        按第一个命令行参数选择检查函数并传入其余参数，all 以缺省参数依次运行全部检查，全部通过时返回0；
+					不带参数或检查名不存在时列出检查名和参数说明。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+#include "Check_demo.h"
+#include "../Tools/counter_rand.h"
+
+#include <stdio.h>
+#include <string.h>
+
+struct CheckEntry_T
+{
+	const char*						name;
+	CheckFunction_F					function;
+	const char*						usage;
+};
+
+static const CheckEntry_T check_list[] = {
+	{ "battlefield_stress", CheckBattlefieldStress, "[战场数=64] [步数=2000] [线程数=硬件线程数]" },
+	{ "spatial_index", CheckSpatialIndex, "[实体数=100,10000,50000]" },
+	{ "lod", CheckLevelOfDetail, "[飞机数=500] [步数=400]" },
+	{ "envpool", CheckEnvPool, "[战场数=256] [步数=200] [批大小=64] [线程数]" },
+	{ "snapshot", CheckSnapshot, "[计时次数=200000]" },
+	{ "reset_pool", CheckResetPool, "[初始化次数=20000]" },
+	{ "scenario_file", CheckScenarioFile, "[想定数=100000]" },
+	{ "event_scheduler", CheckEventScheduler, "[步数=200000]" },
+	{ "radar_batch", CheckRadarBatch, "[飞机数=32,100]" },
+	{ "radar_cull", CheckRadarCull, "[飞机数=100]" },
+	{ "radar_model", CheckRadarModel, "[飞机数=100]" },
+	{ "antenna_table", CheckAntennaTable, "[飞机数=300]" },
+	{ "rcs_table", CheckRcsTable, "[飞机数=300]" },
+	{ "radar_quaternion", CheckRadarQuaternion, "[飞机数=32,100,300]" },
+	{ "alarm_batch", CheckAlarmBatch, "[飞机数=32,100,300]" },
+	{ "radar_scan", CheckRadarScan, "[飞机数=100,300]" },
+	{ "radar_track", CheckRadarTrack, "[雷达数=20] [目标数=100] [步数=1200]" },
+	{ "terrain_map", CheckTerrainMap, "[高程点数=4097]" },
+	{ "lane", CheckLane, "[战场数=16] [步数=3000]" },
+	{ "rollout", CheckRollout, "[分支数=8] [线程数=4]" },
+};
+
+static const int check_count = sizeof(check_list) / sizeof(check_list[0]);
+
+double CheckUniform(unsigned int check, unsigned int stream, unsigned int index, int k)
+{
+	CounterRand_T key;
+	double u;
+	crand_key(&key, check, stream, index, 0);
+	crand_uniform(&u, &key, k);
+	return u;
+}
+
+static void PrintUsage()
+{
+	printf("Check_demo <检查名|all> [参数...]\n");
+	for (int i = 0; i < check_count; i++) {
+		printf("  %-24s %s\n", check_list[i].name, check_list[i].usage);
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2) {
+		PrintUsage();
+		return 1;
+	}
+
+	//all 以缺省参数依次运行全部检查
+	int failed = 0;
+	int found = 0;
+	for (int i = 0; i < check_count; i++) {
+		if (strcmp(argv[1], "all") != 0 && strcmp(argv[1], check_list[i].name) != 0) {
+			continue;
+		}
+		found++;
+		printf("== %s\n", check_list[i].name);
+		int result = (strcmp(argv[1], "all") == 0) ? check_list[i].function(0, NULL) : check_list[i].function(argc - 2, argv + 2);
+		printf("== %s %s\n", check_list[i].name, (result == 0) ? "通过" : "未通过");
+		if (result != 0) {
+			failed++;
+		}
+	}
+
+	if (found == 0) {
+		PrintUsage();
+		return 1;
+	}
+	return (failed == 0) ? 0 : 1;
+}
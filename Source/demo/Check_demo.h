@@ -0,0 +1,124 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           Check_demo.h
+*   @brief          性能与一致性检查程序。
+*   @details        每项检查是一个函数，由 Check_demo.cpp 按名字调用，例：Check_demo battlefield_stress 64 2000。
+					检查函数的参数为名字之后的命令行参数，返回0表示通过，输出的计时结果用于复现提交说明中的数据。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+#ifndef CHECK_DEMO_H_INCLUDED
+#define CHECK_DEMO_H_INCLUDED
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @name           被使用的头文件。
+*   @{
+*/
+#include <stdlib.h>
+#include <chrono>
+/** @}  */
+
+namespace CombatSimulation
+{
+	class Battlefield_C;
+}
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          检查函数
+*   @param[in]      argc            参数数量
+*   @param[in]      argv            参数列表，不含程序名和检查名
+*   @retval         0               通过
+*   @retval         1               未通过
+*/
+typedef int (*CheckFunction_F)(int argc, char* argv[]);
+
+//单调时钟，单位：秒
+inline double CheckClock()
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//第 index 个参数转为整数，缺省时取 default_value
+inline int CheckArgInt(int argc, char* argv[], int index, int default_value)
+{
+	return (index < argc) ? atoi(argv[index]) : default_value;
+}
+
+//第 check 项检查第 stream 组第 index 个随机数的第 k 个分量，0 ~ 1 均匀分布，与平台和调用次序无关
+double CheckUniform(unsigned int check, unsigned int stream, unsigned int index, int k);
+
+//逐位比较两个战场的时标、飞机与导弹状态和本步击毁事件，返回不同的字段数，定义在 Check_battlefield.cpp
+int CheckCompareBattlefield(
+	const CombatSimulation::Battlefield_C&	a,
+	const CombatSimulation::Battlefield_C&	b);
+
+//并行战场与串行结果逐位比较
+int CheckBattlefieldStress(int argc, char* argv[]);
+
+//空间索引重建与查询计时，结果与逐个比较对照
+int CheckSpatialIndex(int argc, char* argv[]);
+
+//分级解算计时，粗略解算与完整动力学的位置差
+int CheckLevelOfDetail(int argc, char* argv[]);
+
+//同步推进与异步战场池的吞吐量
+int CheckEnvPool(int argc, char* argv[]);
+
+//快照保存、恢复计时，重放与增量恢复逐位比较
+int CheckSnapshot(int argc, char* argv[]);
+
+//直接初始化与初始态池恢复的耗时，池中初始态可复现
+int CheckResetPool(int argc, char* argv[]);
+
+//想定库转换、实例化计时，实例化结果与 Init 对照
+int CheckScenarioFile(int argc, char* argv[]);
+
+//事件调度与逐步轮询的定时器开销，触发顺序与次数
+int CheckEventScheduler(int argc, char* argv[]);
+
+//批量雷达探测与逐对 Radar() 的耗时，结果逐位比较
+int CheckRadarBatch(int argc, char* argv[]);
+
+//批量雷达探测的分级剔除统计、耗时和结果比较
+int CheckRadarCull(int argc, char* argv[]);
+
+//雷达模型按姿态、方向余弦矩阵和批量探测的耗时，结果与 Radar() 比较
+int CheckRadarModel(int argc, char* argv[]);
+
+//天线方向图插值表的误差、天线增益耗时和探测结果比较
+int CheckAntennaTable(int argc, char* argv[]);
+
+//RCS表的插值误差、文件存取、取值耗时和探测结果比较
+int CheckRcsTable(int argc, char* argv[]);
+
+//姿态四元数求方向余弦矩阵的几何检查、探测结果比较和耗时
+int CheckRadarQuaternion(int argc, char* argv[]);
+
+//批量告警与逐对 Alarm() 的耗时、结果比较和参数缓存更新
+int CheckAlarmBatch(int argc, char* argv[]);
+
+//雷达行扫描的扫过范围、一帧覆盖和按扫过范围剔除的批量探测
+int CheckRadarScan(int argc, char* argv[]);
+
+//航迹表重访探测与每步探测的次数、耗时、一致比例和外推误差
+int CheckRadarTrack(int argc, char* argv[]);
+
+//地形通视与密集采样比较，批量通视和离地高度的吞吐量
+int CheckTerrainMap(int argc, char* argv[]);
+
+//通道战场与 Battlefield_C 一致性检查
+int CheckLane(int argc, char* argv[]);
+
+//并行推演与逐步解算一致性检查
+int CheckRollout(int argc, char* argv[]);
+
+#endif // CHECK_DEMO_H_INCLUDED
@@ -0,0 +1,121 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           Check_envpool.cpp
+*   @brief          异步战场池吞吐量检查。
+*   @details        每8个战场中有1个在初始化时齐射10枚导弹，比较同步推进全部战场与异步取回最先完成的一批战场的吞吐量。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+#include "Check_demo.h"
+#include "../CombatSimulation/EnvPool.h"
+
+#include <stdio.h>
+#include <vector>
+using namespace CombatSimulation;
+
+static const int check_agent_count = 2;				//每个战场的智能体数量
+static const int check_salvo = 10;					//齐射导弹数量
+
+//默认初始化后，每8个战场中的第1个由0号飞机向1号飞机齐射
+static int SalvoReset(Battlefield_C* battlefield, int env_index, int agent_count, GaussRand_T* rand_state, void* context)
+{
+	(void)context;
+	VecBattlefield_C::DefaultReset(battlefield, env_index, agent_count, rand_state, NULL);
+	if (env_index % 8 == 0) {
+		for (int k = 0; k < check_salvo; k++) {
+			battlefield->MissileFire(battlefield->aircraft_list[0], battlefield->aircraft_list[1]);
+		}
+	}
+	return 0;
+}
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          异步战场池吞吐量检查
+*   @details        两种方式推进的总步数相同，异步方式检查取回的战场序号有效且同一批内不重复
+*   @param[in]      argv[0]         战场数量，缺省256
+*   @param[in]      argv[1]         每个战场的步数，缺省200
+*   @param[in]      argv[2]         异步取回的批大小，缺省64
+*   @param[in]      argv[3]         线程数，缺省为硬件线程数
+*   @retval         0               通过
+*   @retval         1               取回的战场序号无效
+*/
+int CheckEnvPool(int argc, char* argv[])
+{
+	int env_count = CheckArgInt(argc, argv, 0, 256);
+	int step_count = CheckArgInt(argc, argv, 1, 200);
+	int batch_size = CheckArgInt(argc, argv, 2, 64);
+	int thread_count = CheckArgInt(argc, argv, 3, 0);
+	if (env_count < 1 || step_count < 1 || batch_size < 1 || batch_size > env_count) {
+		printf("参数无效\n");
+		return 1;
+	}
+
+	{
+		VecBattlefield_C vec(env_count, check_agent_count, thread_count);
+		vec.SetReset(SalvoReset, NULL);
+		int obs_size = vec.ObsSize();
+		std::vector<double> action(env_count * check_agent_count * VB_ACTION_SIZE, 0.0);
+		std::vector<double> obs(env_count * check_agent_count * obs_size);
+		std::vector<double> reward(env_count * check_agent_count);
+		std::vector<int> done(env_count);
+		vec.Reset(obs.data());
+
+		double t0 = CheckClock();
+		for (int s = 0; s < step_count; s++) {
+			vec.Step(action.data(), obs.data(), reward.data(), done.data());
+		}
+		double seconds = CheckClock() - t0;
+		printf("同步 %d 个战场, %d 线程: %.0f 战场步/s\n", env_count, vec.ThreadCount(), env_count * step_count / seconds);
+	}
+
+	int invalid = 0;
+	{
+		EnvPool_C pool(env_count, check_agent_count, thread_count);
+		pool.Envs().SetReset(SalvoReset, NULL);
+		int obs_size = pool.ObsSize();
+		std::vector<double> action(batch_size * check_agent_count * VB_ACTION_SIZE, 0.0);
+		std::vector<double> obs(batch_size * check_agent_count * obs_size);
+		std::vector<double> reward(batch_size * check_agent_count);
+		std::vector<int> done(batch_size);
+		std::vector<int> env_ids(batch_size);
+		std::vector<int> seen(env_count, -1);
+		pool.AsyncReset();
+
+		long long total = 0;
+		int batch_index = 0;
+		double t0 = CheckClock();
+		int count = pool.Recv(batch_size, env_ids.data(), obs.data(), reward.data(), done.data());
+		while (total < (long long)env_count * step_count) {
+			for (int i = 0; i < count; i++) {
+				int id = env_ids[i];
+				if (id < 0 || id >= env_count || seen[id] == batch_index) {
+					invalid++;
+					continue;
+				}
+				seen[id] = batch_index;
+			}
+			batch_index++;
+			pool.Send(env_ids.data(), count, action.data());
+			count = pool.Recv(batch_size, env_ids.data(), obs.data(), reward.data(), done.data());
+			total += count;
+		}
+		double seconds = CheckClock() - t0;
+
+		//取回剩余的请求，再析构
+		while (pool.InFlight() > 0) {
+			pool.Recv(batch_size, env_ids.data(), obs.data(), reward.data(), done.data());
+		}
+		printf("异步 %d 个战场, 批 %d, %d 线程: %.0f 战场步/s, 无效序号 %d\n", env_count, batch_size, pool.ThreadCount(),
+			total / seconds, invalid);
+	}
+
+	return (invalid == 0) ? 0 : 1;
+}
@@ -0,0 +1,172 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           Check_lane.cpp
+*   @brief          通道战场与 Battlefield_C 一致性检查。
+*   @details        W 个1对1战场装入通道战场，与逐个 Battlefield_C::Run 推进相同步数，比较位置和存活状态；
+					另检查装载后立即写回不改变战场，包括已命中和已超出射程的导弹。记录两种方式的每步耗时。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+#include "Check_demo.h"
+#include "../CombatSimulation/LaneBattlefield.h"
+#include "../CombatSimulation/BattlefieldSnapshot.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+using namespace CombatSimulation;
+
+static const double check_step = 0.02;				//单步时间间隔，单位：秒
+static const double check_tolerance = 1e-6;			//位置允许误差，单位：米
+
+//第 index 个战场：1对1东西向互射导弹，偶数编号相向飞行，导弹命中；奇数编号背向飞行，导弹超出射程
+static void SetupBattlefield(Battlefield_C* battlefield, int index)
+{
+	double heading = (index % 2 == 0) ? 1.0 : -1.0;
+	battlefield->Reset();
+	battlefield->InitCoordinate(126.0, 30.0, 0.0);
+	battlefield->aircraft_count = 2;
+	battlefield->aircraft_list[0].Init(10000001, "F-16", 1, 126.0, 30.0 + 0.01 * CheckUniform(34, 0, index, 0), 6000,
+		0, 0, 90 * heading, 0, 250 * heading, 0);
+	battlefield->aircraft_list[1].Init(10000002, "F-16", 2, 126.14, 30.0 + 0.01 * CheckUniform(34, 0, index, 1), 6100,
+		0, 0, -90 * heading, 0, -250 * heading, 0);
+	battlefield->aircraft_list[0].craft_handle << 0.02 * CheckUniform(34, 1, index, 0) - 0.01, 0.01 * CheckUniform(34, 1, index, 1), 0, 10;
+	battlefield->aircraft_list[1].craft_handle << 0.02 * CheckUniform(34, 2, index, 0) - 0.01, 0.01 * CheckUniform(34, 2, index, 1), 0, 12;
+
+	//Init 不设置速度分量，先解算一步
+	battlefield->Run(check_step);
+	battlefield->MissileFire(battlefield->aircraft_list[0], battlefield->aircraft_list[1]);
+	battlefield->MissileFire(battlefield->aircraft_list[1], battlefield->aircraft_list[0]);
+}
+
+//两个战场位置的最大差值，存活状态不同时返回 -1，出现非数时返回非数
+static double CompareState(const Battlefield_C& a, const Battlefield_C& b)
+{
+	double max_error = 0;
+	for (int i = 0; i < a.aircraft_count; i++) {
+		if (a.aircraft_list[i].base_live != b.aircraft_list[i].base_live) {
+			return -1;
+		}
+		for (int c = 0; c < 3; c++) {
+			double error = fabs(a.aircraft_list[i].craft_state(0, c) - b.aircraft_list[i].craft_state(0, c));
+			max_error = (error > max_error || error != error) ? error : max_error;
+		}
+	}
+	for (int i = 0; i < a.missile_count; i++) {
+		if (a.missile_list[i].missile_live != b.missile_list[i].missile_live) {
+			return -1;
+		}
+		for (int c = 0; c < 3; c++) {
+			double error = fabs(a.missile_list[i].missile_state(0, c) - b.missile_list[i].missile_state(0, c));
+			max_error = (error > max_error || error != error) ? error : max_error;
+		}
+	}
+	return max_error;
+}
+
+//两个战场的完整快照逐字节比较，覆盖导弹目标、射程、制导误差等 CheckCompareBattlefield 不比较的字段，返回 0 表示相同
+static int CompareSnapshot(const Battlefield_C& a, const Battlefield_C& b, std::vector<unsigned char>* buffer)
+{
+	int capacity = Battlefield_C::SnapshotCapacity();
+	int size_a;
+	int size_b;
+	buffer->assign(2 * capacity, 0);
+	a.SaveSnapshot(buffer->data(), capacity, &size_a);
+	b.SaveSnapshot(buffer->data() + capacity, capacity, &size_b);
+	return (size_a != size_b || memcmp(buffer->data(), buffer->data() + capacity, size_a) != 0) ? 1 : 0;
+}
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          通道战场与 Battlefield_C 一致性检查
+*   @details        偶数编号的战场导弹命中目标，奇数编号的导弹超出射程；结束时全部导弹均已结束
+*   @param[in]      argv[0]         战场(通道)数量，缺省16
+*   @param[in]      argv[1]         步数，缺省3000
+*   @retval         0               通过
+*   @retval         1               位置超出允许误差、存活状态不同或装载写回改变了战场
+*/
+int CheckLane(int argc, char* argv[])
+{
+	int lane_count = CheckArgInt(argc, argv, 0, 16);
+	int step_count = CheckArgInt(argc, argv, 1, 3000);
+	if (lane_count < 1 || step_count < 1) {
+		printf("参数无效\n");
+		return 1;
+	}
+
+	Battlefield_C* reference = new Battlefield_C[lane_count];
+	Battlefield_C* result = new Battlefield_C[lane_count];
+	LaneBattlefield_C* lane = new LaneBattlefield_C(lane_count, 2, 2);
+	int mismatch = 0;
+
+	for (int l = 0; l < lane_count; l++) {
+		SetupBattlefield(&reference[l], l);
+		SetupBattlefield(&result[l], l);
+		mismatch += (lane->LoadLane(l, reference[l]) != 0);
+	}
+
+	double t0 = CheckClock();
+	for (int l = 0; l < lane_count; l++) {
+		for (int k = 0; k < step_count; k++) {
+			reference[l].Run(check_step);
+		}
+	}
+	double battlefield_time = CheckClock() - t0;
+	t0 = CheckClock();
+	for (int k = 0; k < step_count; k++) {
+		lane->Run(check_step);
+	}
+	double lane_time = CheckClock() - t0;
+
+	double max_error = 0;
+	int hit = 0;
+	int miss = 0;
+	for (int l = 0; l < lane_count; l++) {
+		lane->StoreLane(l, &result[l]);
+		double error = CompareState(reference[l], result[l]);
+		if (!(error >= 0 && error <= check_tolerance)) {
+			printf("战场 %d: 位置误差 %.3e 米或存活状态不同\n", l, error);
+			mismatch++;
+		}
+		max_error = (error > max_error || error != error) ? error : max_error;
+		for (int m = 0; m < reference[l].missile_count; m++) {
+			hit += (reference[l].missile_list[m].missile_live == CS_NOT_LIVE);
+			miss += (reference[l].missile_list[m].missile_live == CS_MISS);
+			mismatch += (reference[l].missile_list[m].missile_live == CS_LIVE);
+		}
+	}
+
+	//已结束的导弹装载后写回，战场逐位不变
+	LaneBattlefield_C* round_trip = new LaneBattlefield_C(lane_count, 2, 2);
+	std::vector<unsigned char> buffer;
+	int round_trip_diff = 0;
+	for (int l = 0; l < lane_count; l++) {
+		SetupBattlefield(&result[l], l);
+		for (int k = 0; k < step_count; k++) {
+			result[l].Run(check_step);
+		}
+		mismatch += (round_trip->LoadLane(l, reference[l]) != 0);
+		round_trip->StoreLane(l, &result[l]);
+		round_trip_diff += CheckCompareBattlefield(reference[l], result[l]) + CompareSnapshot(reference[l], result[l], &buffer);
+	}
+	mismatch += (round_trip_diff != 0);
+
+	printf("%d 个战场 x %d 步: 命中 %d 枚, 超出射程 %d 枚, 最大位置误差 %.3e 米, 装载写回差异 %d\n",
+		lane_count, step_count, hit, miss, max_error, round_trip_diff);
+	printf("每战场每步: Battlefield_C %.3f us, 通道战场 %.3f us\n",
+		battlefield_time / lane_count / step_count * 1e6, lane_time / lane_count / step_count * 1e6);
+
+	delete[] reference;
+	delete[] result;
+	delete lane;
+	delete round_trip;
+	return (mismatch == 0) ? 0 : 1;
+}
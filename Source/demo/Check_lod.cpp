@@ -0,0 +1,214 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           Check_lod.cpp
+*   @brief          分级解算计时与误差检查。
+*   @details        500架飞机分别全部完整动力学、90%粗略运动学时的解算速度，以及平飞、盘旋的飞机粗略解算20秒后与完整动力学的位置差；
+					另由战场 Run 驱动，检查敌机接近、远离时的升级、滞环降级和切换时的状态衔接，以及逐步改变控制量的飞机始终按完整动力学解算。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+#include "Check_demo.h"
+#include "../CombatSimulation/UnitDefine.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+using namespace CombatSimulation;
+
+static const double check_step = 0.05;				//单步时间间隔，单位：秒
+static const double check_max_relative_error = 0.03;	//粗略解算的位置误差上限，相对飞行路程
+static const double check_run_step = 0.1;			//Run 驱动检查的步长，单位：秒
+static const int check_run_warmup = 300;			//Run 驱动检查启用分级解算前的稳定步数
+static const int check_run_count = 2000;			//Run 驱动检查的步数
+static const double check_promote_range = 20000;	//Run 驱动检查的升级距离，单位：米
+static const double check_demote_range = 30000;		//Run 驱动检查的降级距离，单位：米
+
+//第 i 架飞机，按 max_object 分到各个战场
+static Aircraft_Object_C& AircraftAt(Battlefield_C* battlefield_list, int i)
+{
+	return battlefield_list[i / max_object].aircraft_list[i % max_object];
+}
+
+//0号(1队)向北平飞；1号(2队)在北约100公里、东约3公里处向南对飞，约135秒后交错再远离；
+//2号(1队)在西约50公里外，之后由外部逐步改变控制量。先以完整动力学稳定30秒，粗略解算沿用的转率不含初始化后的过渡
+static void SetupRun(Battlefield_C* battlefield)
+{
+	battlefield->Reset();
+	battlefield->InitCoordinate(120.0, 30.0, 0.0);
+	battlefield->lod_enable = 0;
+	battlefield->lod_promote_range = check_promote_range;
+	battlefield->lod_demote_range = check_demote_range;
+	battlefield->aircraft_count = 3;
+	battlefield->aircraft_list[0].Init(1, "F-16", 1, 120.0, 30.0, 5000, 0, 0, 0, 250, 0, 0);
+	battlefield->aircraft_list[1].Init(2, "F-16", 2, 120.03, 30.9, 5000, 0, 0, 180, -250, 0, 0);
+	battlefield->aircraft_list[2].Init(3, "F-16", 1, 119.48, 30.0, 5000, 0, 0, 0, 250, 0, 0);
+	for (int a = 0; a < 3; a++) {
+		battlefield->aircraft_list[a].craft_handle << 0, 0, 0, 20;
+	}
+	for (int s = 0; s < check_run_warmup; s++) {
+		battlefield->Run(check_run_step);
+	}
+}
+
+//第 step 步外部写入的控制量，每步都与上一步不同
+static void ExternalHandle(Aircraft_Object_C* air, int step)
+{
+	air->craft_handle << 0.01 * sin(0.05 * (step + 1)), 0, 0, 20;
+}
+
+//Run 驱动的分级解算检查，返回不一致的项数
+static int CheckLevelOfDetailRun()
+{
+	Battlefield_C* battlefield = new Battlefield_C;
+	Battlefield_C* reference = new Battlefield_C;
+	SetupRun(battlefield);
+	SetupRun(reference);
+	battlefield->lod_enable = 1;
+
+	int mismatch = 0;
+	int promote = 0;
+	int demote = 0;
+	int hold_full = 0;
+	int hold_coarse = 0;
+	double min_distance = 1e12;
+	double handover_error = -1;
+	double journey = 0;
+	int level = battlefield->aircraft_list[0].lod_level;
+	for (int s = 0; s < check_run_count; s++) {
+		ExternalHandle(&battlefield->aircraft_list[2], s);
+		ExternalHandle(&reference->aircraft_list[2], s);
+		battlefield->Run(check_run_step);
+		reference->Run(check_run_step);
+
+		const Aircraft_Object_C& self = battlefield->aircraft_list[0];
+		double distance = (self.craft_state.row(0) - battlefield->aircraft_list[1].craft_state.row(0)).norm();
+		min_distance = (distance < min_distance) ? distance : min_distance;
+		journey += reference->aircraft_list[0].craft_state.row(1).norm() * check_run_step;
+
+		//威胁在升级距离内必须为完整动力学，超出降级距离必须为粗略运动学，两者之间保持原精度
+		mismatch += (distance < check_promote_range && self.lod_level != CS_LOD_FULL);
+		mismatch += (distance > check_demote_range && self.lod_level != CS_LOD_COARSE);
+		if (distance >= check_promote_range && distance <= check_demote_range) {
+			mismatch += (self.lod_level != level);
+			hold_full += (self.lod_level == CS_LOD_FULL);
+			hold_coarse += (self.lod_level == CS_LOD_COARSE);
+		}
+
+		//升级时累积的粗略时间已推进完，与完整动力学的位置差为切换时的衔接误差
+		if (self.lod_level != level) {
+			if (self.lod_level == CS_LOD_FULL) {
+				promote++;
+				mismatch += (self.lod_elapsed != 0);
+				handover_error = (self.craft_state.row(0) - reference->aircraft_list[0].craft_state.row(0)).norm();
+			}
+			else {
+				demote++;
+			}
+			level = self.lod_level;
+		}
+	}
+
+	//外部控制的飞机逐步改变控制量，与不启用分级解算的逐位相同
+	const Aircraft_Object_C& controlled = battlefield->aircraft_list[2];
+	int controlled_diff = (memcmp(controlled.craft_state.data(), reference->aircraft_list[2].craft_state.data(), sizeof(double) * 16) != 0);
+	double final_error = (battlefield->aircraft_list[0].craft_state.row(0) - reference->aircraft_list[0].craft_state.row(0)).norm();
+
+	mismatch += (promote != 1) + (demote != 2) + (hold_full == 0) + (hold_coarse == 0) + controlled_diff;
+	mismatch += !(handover_error >= 0 && handover_error <= check_max_relative_error * journey);
+	mismatch += !(final_error <= check_max_relative_error * journey);
+
+	printf("Run 驱动: 最近距离 %.0f m, 升级 %d 次, 降级 %d 次, 滞环内保持完整 %d 步、粗略 %d 步, 升级时位置差 %.2f m, 结束位置差 %.2f m, 外部控制飞机差异 %d, 不一致 %d\n",
+		min_distance, promote, demote, hold_full, hold_coarse, handover_error, final_error, controlled_diff, mismatch);
+
+	delete battlefield;
+	delete reference;
+	return mismatch;
+}
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          分级解算计时与误差检查
+*   @details        计时时飞机不经战场 Run 直接逐架解算，只比较两种解算精度本身的开销；另做一次 Run 驱动的升降级检查
+*   @param[in]      argv[0]         飞机数量，缺省500
+*   @param[in]      argv[1]         步数，缺省400
+*   @retval         0               通过
+*   @retval         1               位置误差超过飞行路程的3%，或 Run 驱动时升降级、衔接与预期不符
+*/
+int CheckLevelOfDetail(int argc, char* argv[])
+{
+	int aircraft_count = CheckArgInt(argc, argv, 0, 500);
+	int step_count = CheckArgInt(argc, argv, 1, 400);
+	if (aircraft_count < 1 || step_count < 1) {
+		printf("参数无效\n");
+		return 1;
+	}
+
+	int battlefield_count = (aircraft_count + max_object - 1) / max_object;
+	Battlefield_C* battlefield_list = new Battlefield_C[battlefield_count];
+	double rate[2];
+	for (int mode = 0; mode < 2; mode++) {
+		for (int b = 0; b < battlefield_count; b++) {
+			battlefield_list[b].Reset();
+			battlefield_list[b].InitCoordinate(120.0, 30.0, 0.0);
+		}
+		for (int i = 0; i < aircraft_count; i++) {
+			Aircraft_Object_C& air = AircraftAt(battlefield_list, i);
+			air.Init(i, "F-16", 1 + i % 2, 120 + 0.01 * (i % 25), 30 + 0.01 * (i / 25), 5000, 0, 0, (i * 7) % 360, 200, 0, 0);
+			air.craft_handle << 0, 0, 0.02, 5;
+			air.Run(check_step);
+			//第二轮只保留十分之一为完整动力学
+			air.SetLevelOfDetail((mode == 1 && i % 10 != 0) ? CS_LOD_COARSE : CS_LOD_FULL);
+		}
+
+		double t0 = CheckClock();
+		for (int s = 0; s < step_count; s++) {
+			for (int i = 0; i < aircraft_count; i++) {
+				AircraftAt(battlefield_list, i).Run(check_step);
+			}
+		}
+		rate[mode] = (double)aircraft_count * step_count / (CheckClock() - t0);
+	}
+	printf("%d 架飞机: 完整动力学 %.0f 架次/s, 90%%粗略 %.0f 架次/s (%.1fx)\n", aircraft_count, rate[0], rate[1], rate[1] / rate[0]);
+
+	//同一飞机：一架始终完整动力学，一架稳定30秒后粗略解算20秒，分平飞和盘旋两种
+	int failed = 0;
+	Battlefield_C& battlefield = battlefield_list[0];
+	for (int turn = 0; turn < 2; turn++) {
+		battlefield.Reset();
+		Aircraft_Object_C& full = battlefield.aircraft_list[0];
+		Aircraft_Object_C& coarse = battlefield.aircraft_list[1];
+		full.Init(1, "F-16", 1, 120, 30, 5000, 0, 0, 0, 250, 0, 0);
+		coarse.Init(2, "F-16", 1, 120, 30, 5000, 0, 0, 0, 250, 0, 0);
+		full.craft_handle << 0, 0, 0.05 * turn, 20;
+		coarse.craft_handle = full.craft_handle;
+		for (int s = 0; s < 600; s++) {
+			full.Run(check_step);
+			coarse.Run(check_step);
+		}
+		double journey = 0;
+		coarse.SetLevelOfDetail(CS_LOD_COARSE);
+		for (int s = 0; s < 400; s++) {
+			full.Run(check_step);
+			coarse.Run(check_step);
+			journey += full.craft_state.row(1).norm() * check_step;
+		}
+		coarse.SetLevelOfDetail(CS_LOD_FULL);
+		double position_error = (full.craft_state.row(0) - coarse.craft_state.row(0)).norm();
+		double velocity_error = (full.craft_state.row(1) - coarse.craft_state.row(1)).norm();
+		printf("%s粗略解算20秒: 路程 %.0f m, 位置差 %.1f m (%.2f%%), 速度差 %.2f m/s\n", (turn == 0) ? "平飞" : "盘旋",
+			journey, position_error, 100 * position_error / journey, velocity_error);
+		failed += (position_error > check_max_relative_error * journey);
+	}
+
+	failed += CheckLevelOfDetailRun();
+
+	delete[] battlefield_list;
+	return (failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,967 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           Check_radar.cpp
+*   @brief          批量雷达探测计时与一致性检查。
+*   @details        随机生成N架飞机互为雷达和目标，批量探测的探测矩阵与冻结在本文件中的重构前 Radar() 计算相同、回波功率只差舍入，
+					记录逐对计算与批量计算每个探测矩阵的耗时，以及批量探测各级剔除的目标对数；
+					雷达模型按姿态和按方向余弦矩阵逐对探测的结果同样与之比较；
+					天线方向图插值表的误差与建表时记录的最大误差一致；RCS表与五个典型值模型的误差和探测结果比较；
+					由姿态四元数求得的方向余弦矩阵与 Eigen 北东地坐标下的计算一致。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+#include "Check_demo.h"
+#include "../Sensor/radar.h"
+#include "../Sensor/radar_batch.h"
+#include "../Tools/coordinate.h"
+#include "../Tools/counter_rand.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+static const int check_pair_budget = 200000;		//计时时每种方式至少计算的目标对数
+static const int check_gain_sample = 200000;		//检查插值误差时扫描半个波束宽度的点数
+static const int check_gain_call = 1 << 16;			//天线增益计时的方位数
+static const int check_rcs_sample = 400000;		//检查RCS表插值误差的随机方向数
+static const int check_quaternion_sample = 200000;	//检查四元数方向余弦矩阵的随机姿态数
+static const double check_pi = 3.14159265358979323846;
+static const double check_power_tolerance = 4e-15;	//回波功率与参考计算的相对误差上限，常数重新结合引起
+
+//随机场景，各量按 RadarBatchState_T 的分量存放
+struct RadarScene_T
+{
+	int								count;
+	std::vector<double>				position[3];					//(北，天，东)，单位：米
+	std::vector<double>				attitude[3];					//(滚转，偏航，俯仰)，单位：弧度
+	std::vector<double>				sigma[5];						//RCS典型值，单位：平方米
+	RadarBatchState_T				state;
+};
+
+//水平方向在 spread 见方内均匀分布，高度 0 ~ 12km，RCS 在 rcs_min ~ rcs_min+rcs_span 内均匀分布
+static void MakeScene(RadarScene_T* scene, int count, double spread, double rcs_min, double rcs_span, unsigned int seed)
+{
+	scene->count = count;
+	for (int k = 0; k < 3; k++) {
+		scene->position[k].resize(count);
+		scene->attitude[k].resize(count);
+	}
+	for (int k = 0; k < 5; k++) {
+		scene->sigma[k].resize(count);
+	}
+	for (int i = 0; i < count; i++) {
+		CounterRand_T key;
+		double u[11];
+		crand_key(&key, 41, seed, (unsigned int)i, 0);
+		for (int k = 0; k < 11; k++) {
+			crand_uniform(&u[k], &key, k);
+		}
+		scene->position[0][i] = (u[0] - 0.5) * spread;
+		scene->position[1][i] = u[1] * 12000;
+		scene->position[2][i] = (u[2] - 0.5) * spread;
+		for (int k = 0; k < 3; k++) {
+			scene->attitude[k][i] = (u[3 + k] - 0.5) * 2 * 3.14159;
+		}
+		for (int k = 0; k < 5; k++) {
+			scene->sigma[k][i] = rcs_min + rcs_span * u[6 + k];
+		}
+	}
+
+	scene->state.count = count;
+	for (int k = 0; k < 3; k++) {
+		scene->state.position[k] = scene->position[k].data();
+		scene->state.attitude[k] = scene->attitude[k].data();
+	}
+	for (int k = 0; k < 5; k++) {
+		scene->state.sigma_type[k] = scene->sigma[k].data();
+	}
+	scene->state.rcs_table = NULL;
+	scene->state.Cnb = NULL;
+}
+
+//以下为 RadarModel_C 引入之前 Radar() 的计算(已修正雷达姿态角下标)，逐项照录并冻结，作为与被测代码无关的参考。
+//坐标为(北，天，东)，姿态为(滚转，俯仰，偏航)，机体系为(前，上，右)
+
+static void ReferenceAttitudeMatrix(double Cnb[3][3], const double attitude[3])
+{
+	double c1 = cos(attitude[1]), s1 = sin(attitude[1]);
+	double c2 = cos(attitude[2]), s2 = sin(attitude[2]);
+	double c3 = cos(attitude[0]), s3 = sin(attitude[0]);
+	Cnb[0][0] = c1 * c2;	Cnb[0][1] = s1 * s3 - c1 * c3 * s2;	Cnb[0][2] = c3 * s1 + c1 * s2 * s3;
+	Cnb[1][0] = s2;			Cnb[1][1] = c2 * c3;				Cnb[1][2] = -c2 * s3;
+	Cnb[2][0] = -c2 * s1;	Cnb[2][1] = c1 * s3 + c3 * s1 * s2;	Cnb[2][2] = c1 * c3 - s1 * s2 * s3;
+}
+
+static void ReferenceBodyAngle(double* azimuth, double* pitch, const double Cnb[3][3], const double a[3], const double b[3])
+{
+	double Vban[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+	double Vbab[3];
+	for (int i = 0; i < 3; i++) {
+		Vbab[i] = Cnb[i][0] * Vban[0] + Cnb[i][1] * Vban[1] + Cnb[i][2] * Vban[2];
+	}
+	double angle = acos(Vbab[0] / sqrt(pow(Vbab[0], 2) + pow(Vbab[2], 2)));
+	*azimuth = (Vbab[2] < 0) ? angle : (check_pi * 360.0 / 180 - angle);
+	*pitch = atan(Vbab[1] / sqrt(pow(Vbab[0], 2) + pow(Vbab[2], 2)));
+}
+
+static double ReferenceSurfaceGain(double theta, double theta_t, double theta_b)
+{
+	double k_main = 4 * log(sqrt(2) / (theta_t * theta_t));
+	double f_main = exp(-k_main * theta * theta);
+	double k_other = 1.3916 / (sin(0.5 * theta_b));
+	double f_other = (sin(theta) == 0) ? 0 : ((1 + cos(theta)) / 2) * (sin(k_other * sin(theta)) / (k_other * sin(theta)));
+	return (f_main >= f_other) ? f_main : f_other;
+}
+
+static double ReferenceAntennaGain(double azimuth, double pitch, const RadarParam_T& p)
+{
+	double signed_azimuth = (azimuth > check_pi * 180 / 180) ? -(check_pi * 360 / 180 - azimuth) : azimuth;
+	double f_azimuth = 0;
+	if (signed_azimuth >= -p.azimuth_radar_width / 2.0 && signed_azimuth <= p.azimuth_radar_width / 2.0) {
+		f_azimuth = ReferenceSurfaceGain(signed_azimuth, p.theta_t, p.theta_b);
+	}
+	double f_pitch = 0;
+	if (pitch >= -p.pitch_radar_width / 2.0 && pitch <= p.pitch_radar_width / 2.0) {
+		f_pitch = ReferenceSurfaceGain(pitch, p.theta_t, p.theta_b);
+	}
+	return p.nG * p.Gmax * sqrt(f_azimuth * f_pitch);
+}
+
+static double ReferenceRCS(double azimuth, double pitch, const double sigma[5])
+{
+	double S1 = (azimuth > check_pi * 90 / 180 && azimuth < check_pi * 270 / 180) ? sigma[1] : sigma[0];
+	double S2 = (pitch < 0) ? sigma[3] : sigma[2];
+	double S3 = sigma[4];
+	return S1 * (1 - sqrt(fabs(sin(pitch)))) * (1 - sqrt(fabs(sin(azimuth)))) + S2 * fabs(sin(pitch)) +
+		S3 * (1 - sqrt(fabs(sin(pitch)))) * fabs(sin(azimuth));
+}
+
+//超出视距时不修改 Pgr
+static void ReferenceRadar(bool* finded, double* Pgr, const double radar_position[3], const double radar_attitude[3],
+	const double target_position[3], const double target_attitude[3], const double sigma[5], const RadarParam_T& p)
+{
+	double radar_euler[3] = { radar_attitude[0], radar_attitude[2], radar_attitude[1] };
+	double target_euler[3] = { target_attitude[0], target_attitude[2], target_attitude[1] };
+	double radar_Cnb[3][3], target_Cnb[3][3];
+	ReferenceAttitudeMatrix(radar_Cnb, radar_euler);
+	ReferenceAttitudeMatrix(target_Cnb, target_euler);
+
+	double distance = sqrt(pow(radar_position[0] - target_position[0], 2) + pow(radar_position[1] - target_position[1], 2) +
+		pow(radar_position[2] - target_position[2], 2));
+	double sight = 4120 * (sqrt(radar_position[1]) + sqrt(target_position[1]));
+	if (sight < distance) {
+		*finded = false;
+		return;
+	}
+
+	double azimuth_target, pitch_target, azimuth_radar, pitch_radar;
+	ReferenceBodyAngle(&azimuth_target, &pitch_target, radar_Cnb, radar_position, target_position);
+	ReferenceBodyAngle(&azimuth_radar, &pitch_radar, target_Cnb, target_position, radar_position);
+	double gain = ReferenceAntennaGain(azimuth_target, pitch_target, p);
+	double rcs = ReferenceRCS(azimuth_radar, pitch_radar, sigma);
+	double power = (p.Pgt * gain * gain * rcs * p.lambda * p.lambda / (pow(4 * check_pi, 3) * pow(distance, 4))) * p.Lr;
+	*Pgr = power;
+	*finded = !(power < RADAR_DETECT_THRESHOLD);
+}
+
+//第 i 架飞机作为雷达对第 j 架飞机调用冻结的参考计算
+static void RadarPair(bool* finded, double* Pgr, const RadarScene_T& scene, const RadarParam_T& p, int i, int j)
+{
+	double radar_position[3] = { scene.position[0][i], scene.position[1][i], scene.position[2][i] };
+	double radar_attitude[3] = { scene.attitude[0][i], scene.attitude[1][i], scene.attitude[2][i] };
+	double target_position[3] = { scene.position[0][j], scene.position[1][j], scene.position[2][j] };
+	double target_attitude[3] = { scene.attitude[0][j], scene.attitude[1][j], scene.attitude[2][j] };
+	double sigma[5] = { scene.sigma[0][j], scene.sigma[1][j], scene.sigma[2][j], scene.sigma[3][j], scene.sigma[4][j] };
+	*finded = false;
+	*Pgr = 0;
+	ReferenceRadar(finded, Pgr, radar_position, radar_attitude, target_position, target_attitude, sigma, p);
+}
+
+//与参考计算结果不同的目标对数：发现标志须相同，回波功率相对误差不超过 check_power_tolerance；
+//对角线(雷达与目标为同一架飞机)不比较，最大相对误差累计到 max_error
+static long long CompareWithReference(const RadarScene_T& scene, const RadarParam_T& p, const bool* finded, const double* Pgr,
+	double* max_error)
+{
+	int n = scene.count;
+	long long diff = 0;
+	for (int i = 0; i < n; i++) {
+		for (int j = 0; j < n; j++) {
+			if (i == j) {
+				continue;
+			}
+			bool f;
+			double pw;
+			RadarPair(&f, &pw, scene, p, i, j);
+			double error = f ? fabs(Pgr[i * n + j] - pw) / pw : 0;
+			*max_error = (error > *max_error) ? error : *max_error;
+			diff += (f != finded[i * n + j] || !(error <= check_power_tolerance));
+		}
+	}
+	return diff;
+}
+
+//逐对调用参考计算得到整个探测矩阵的耗时，即重构前 Radar() 的耗时，单位：秒
+static double TimeRadar(const RadarScene_T& scene, const RadarParam_T& p)
+{
+	int n = scene.count;
+	int repeat = check_pair_budget / (n * n) + 1;
+	volatile double sink = 0;
+	double t0 = CheckClock();
+	for (int r = 0; r < repeat; r++) {
+		for (int i = 0; i < n; i++) {
+			for (int j = 0; j < n; j++) {
+				bool f;
+				double pw;
+				RadarPair(&f, &pw, scene, p, i, j);
+				sink += pw;
+			}
+		}
+	}
+	return (CheckClock() - t0) / repeat;
+}
+
+//批量探测整个探测矩阵的耗时，单位：秒
+static double TimeBatch(const RadarScene_T& scene, const RadarParam_T& p, bool* finded, double* Pgr)
+{
+	int n = scene.count;
+	int repeat = check_pair_budget / (n * n) + 1;
+	double t0 = CheckClock();
+	for (int r = 0; r < repeat; r++) {
+		RadarBatch(finded, Pgr, &scene.state, &scene.state, &p);
+	}
+	return (CheckClock() - t0) / repeat;
+}
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          批量雷达探测计时与一致性检查
+*   @details        机载雷达 150km 范围、导弹跟踪雷达 20km 范围、全向扫描(方位7、俯仰4弧度) 150km 范围三种场景
+*   @param[in]      argv[0]         飞机数量，缺省依次取 32、100
+*   @retval         0               通过
+*   @retval         1               批量探测与重构前 Radar() 结果不同
+*/
+int CheckRadarBatch(int argc, char* argv[])
+{
+	std::vector<int> count_list;
+	if (argc > 0) {
+		count_list.push_back(CheckArgInt(argc, argv, 0, 32));
+	}
+	else {
+		count_list.push_back(32);
+		count_list.push_back(100);
+	}
+
+	const char* mode_name[3] = { "机载雷达", "导弹雷达", "全向扫描" };
+	long long diff_total = 0;
+	double power_error = 0;
+	for (int mode = 0; mode < 3; mode++) {
+		RadarParam_T p = (mode == 1) ? RadarModel_C::MissileParam() : RadarModel_C::AircraftParam();
+		if (mode == 2) {
+			p.azimuth_radar_width = 7;
+			p.pitch_radar_width = 4;
+		}
+		double spread = (mode == 1) ? 20000 : 150000;
+		for (size_t c = 0; c < count_list.size(); c++) {
+			int n = count_list[c];
+			if (n < 2) {
+				printf("参数无效\n");
+				return 1;
+			}
+			RadarScene_T scene;
+			MakeScene(&scene, n, spread, 1, 10, (unsigned int)(mode * 1000 + n));
+			std::vector<unsigned char> finded(n * n);
+			std::vector<double> Pgr(n * n);
+			double batch_time = TimeBatch(scene, p, (bool*)finded.data(), Pgr.data());
+			long long diff = CompareWithReference(scene, p, (const bool*)finded.data(), Pgr.data(), &power_error);
+			double radar_time = TimeRadar(scene, p);
+			long long found = 0;
+			for (int k = 0; k < n * n; k++) {
+				found += finded[k];
+			}
+			printf("%s %3dx%-3d: 原Radar() %8.1f us, 批量 %8.1f us (%.1fx), 发现 %lld, 不同 %lld\n", mode_name[mode], n, n,
+				radar_time * 1e6, batch_time * 1e6, radar_time / batch_time, found, diff);
+			diff_total += diff;
+		}
+	}
+	printf("Pgr 与原 Radar() 最大相对误差 %.1e\n", power_error);
+	return (diff_total == 0) ? 0 : 1;
+}
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          批量雷达探测分级剔除检查
+*   @details        100架飞机分布在 400km 见方内，分别取常规 RCS(1 ~ 11平方米)和隐身 RCS(0.001 ~ 0.011平方米)，
+					统计距离、视距、波束各级剔除和逐对计算的目标对数，剔除后的探测矩阵仍与重构前 Radar() 相同
+*   @param[in]      argv[0]         飞机数量，缺省100
+*   @retval         0               通过
+*   @retval         1               探测结果与重构前 Radar() 不同或统计数不守恒
+*/
+int CheckRadarCull(int argc, char* argv[])
+{
+	int n = CheckArgInt(argc, argv, 0, 100);
+	if (n < 2) {
+		printf("参数无效\n");
+		return 1;
+	}
+
+	const char* rcs_name[2] = { "常规RCS", "隐身RCS" };
+	const double rcs_min[2] = { 1, 0.001 };
+	const double rcs_span[2] = { 10, 0.01 };
+	RadarParam_T p = RadarModel_C::AircraftParam();
+	int fail = 0;
+	double power_error = 0;
+	for (int r = 0; r < 2; r++) {
+		RadarScene_T scene;
+		MakeScene(&scene, n, 400000, rcs_min[r], rcs_span[r], (unsigned int)(5000 + r));
+		std::vector<unsigned char> finded(n * n);
+		std::vector<double> Pgr(n * n);
+		RadarBatchStats_T stats;
+		memset(&stats, 0, sizeof(stats));
+		RadarBatch((bool*)finded.data(), Pgr.data(), &scene.state, &scene.state, &p, &stats);
+
+		double Rmax = 0;
+		getMaxDetectRange(&Rmax, rcs_min[r] + rcs_span[r], p.lambda, p.Pgt, p.nG, p.Gmax, p.theta_t, p.Lr,
+			p.azimuth_radar_width, p.pitch_radar_width);
+
+		double batch_time = TimeBatch(scene, p, (bool*)finded.data(), Pgr.data());
+		long long diff = CompareWithReference(scene, p, (const bool*)finded.data(), Pgr.data(), &power_error);
+		double radar_time = TimeRadar(scene, p);
+		//雷达与目标为同一架飞机的 n 对位置重合，不计入任何一级
+		long long sum = stats.range_culled + stats.sight_culled + stats.beam_culled + stats.scan_culled + stats.evaluated + n;
+		double total = (stats.pair_count > 0) ? (double)stats.pair_count : 1;
+
+		printf("%s: 最大探测距离 %.0f km, 目标对 %lld\n", rcs_name[r], Rmax / 1000, stats.pair_count);
+		printf("    剔除: 距离 %.1f%%, 视距 %.1f%%, 波束 %.1f%%; 逐对计算 %.1f%%, 发现 %lld\n",
+			100 * stats.range_culled / total, 100 * stats.sight_culled / total, 100 * stats.beam_culled / total,
+			100 * stats.evaluated / total, stats.finded);
+		printf("    原Radar() %.1f us, 批量 %.1f us (%.1fx), 不同 %lld, Pgr 最大相对误差 %.1e\n",
+			radar_time * 1e6, batch_time * 1e6, radar_time / batch_time, diff, power_error);
+		if (diff != 0 || sum != stats.pair_count) {
+			printf("    %s未通过: 统计和 %lld\n", rcs_name[r], sum);
+			fail = 1;
+		}
+	}
+	return fail;
+}
+
+//雷达模型逐对探测整个探测矩阵的耗时，单位：秒；Cnb 不为空时按方向余弦矩阵探测，否则按姿态探测
+static double TimeModel(const RadarScene_T& scene, const RadarModel_C& model, const double* Cnb, bool* finded, double* Pgr)
+{
+	int n = scene.count;
+	int repeat = check_pair_budget / (n * n) + 1;
+	double t0 = CheckClock();
+	for (int r = 0; r < repeat; r++) {
+		for (int i = 0; i < n; i++) {
+			double radar_position[3] = { scene.position[0][i], scene.position[1][i], scene.position[2][i] };
+			double radar_attitude[3] = { scene.attitude[0][i], scene.attitude[1][i], scene.attitude[2][i] };
+			for (int j = 0; j < n; j++) {
+				double target_position[3] = { scene.position[0][j], scene.position[1][j], scene.position[2][j] };
+				double target_attitude[3] = { scene.attitude[0][j], scene.attitude[1][j], scene.attitude[2][j] };
+				double sigma[5] = { scene.sigma[0][j], scene.sigma[1][j], scene.sigma[2][j], scene.sigma[3][j], scene.sigma[4][j] };
+				finded[i * n + j] = false;
+				Pgr[i * n + j] = 0;
+				if (Cnb != NULL) {
+					model.Detect(&finded[i * n + j], &Pgr[i * n + j], radar_position, (const double(*)[3])&Cnb[i * 9],
+						target_position, (const double(*)[3])&Cnb[j * 9], sigma);
+				}
+				else {
+					model.Detect(&finded[i * n + j], &Pgr[i * n + j], radar_position, radar_attitude,
+						target_position, target_attitude, sigma);
+				}
+			}
+		}
+	}
+	return (CheckClock() - t0) / repeat;
+}
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          雷达模型计时与一致性检查
+*   @details        机载雷达、导弹雷达和 400km 隐身RCS 三种场景，依次记录重构前 Radar()、按姿态探测、
+					按方向余弦矩阵探测和批量探测的耗时，后三者与冻结的重构前 Radar() 计算比较，发现标志相同，回波功率只差舍入
+*   @param[in]      argv[0]         飞机数量，缺省100
+*   @retval         0               通过
+*   @retval         1               结果与重构前 Radar() 不同
+*/
+int CheckRadarModel(int argc, char* argv[])
+{
+	int n = CheckArgInt(argc, argv, 0, 100);
+	if (n < 2) {
+		printf("参数无效\n");
+		return 1;
+	}
+
+	const char* mode_name[3] = { "机载雷达", "导弹雷达", "400km隐身" };
+	long long diff_total = 0;
+	double power_error = 0;
+	printf("%-10s %10s %10s %10s %10s  (us/探测矩阵)\n", "场景", "原Radar()", "姿态", "Cnb", "批量");
+	for (int mode = 0; mode < 3; mode++) {
+		RadarParam_T p = (mode == 1) ? RadarModel_C::MissileParam() : RadarModel_C::AircraftParam();
+		RadarModel_C model(p);
+		double spread = (mode == 0) ? 150000 : ((mode == 1) ? 20000 : 400000);
+		RadarScene_T scene;
+		if (mode == 2) {
+			MakeScene(&scene, n, spread, 0.001, 0.01, (unsigned int)(7000 + n));
+		}
+		else {
+			MakeScene(&scene, n, spread, 1, 10, (unsigned int)(7000 + mode * 1000 + n));
+		}
+
+		//方向余弦矩阵与原 Radar() 相同，姿态按(滚转，俯仰，偏航)排列
+		std::vector<double> Cnb(n * 9);
+		for (int i = 0; i < n; i++) {
+			double attitude[3] = { scene.attitude[0][i], scene.attitude[2][i], scene.attitude[1][i] };
+			ReferenceAttitudeMatrix((double(*)[3])&Cnb[i * 9], attitude);
+		}
+
+		std::vector<unsigned char> finded(n * n);
+		std::vector<double> Pgr(n * n);
+		double radar_time = TimeRadar(scene, p);
+		double attitude_time = TimeModel(scene, model, NULL, (bool*)finded.data(), Pgr.data());
+		long long diff = CompareWithReference(scene, p, (const bool*)finded.data(), Pgr.data(), &power_error);
+		double cnb_time = TimeModel(scene, model, Cnb.data(), (bool*)finded.data(), Pgr.data());
+		diff += CompareWithReference(scene, p, (const bool*)finded.data(), Pgr.data(), &power_error);
+		int repeat = check_pair_budget / (n * n) + 1;
+		double t0 = CheckClock();
+		for (int r = 0; r < repeat; r++) {
+			model.DetectBatch((bool*)finded.data(), Pgr.data(), &scene.state, &scene.state);
+		}
+		double batch_time = (CheckClock() - t0) / repeat;
+		diff += CompareWithReference(scene, p, (const bool*)finded.data(), Pgr.data(), &power_error);
+
+		printf("%-10s %10.1f %10.1f %10.1f %10.1f  不同 %lld\n", mode_name[mode],
+			radar_time * 1e6, attitude_time * 1e6, cnb_time * 1e6, batch_time * 1e6, diff);
+		diff_total += diff;
+	}
+	printf("Pgr 与原 Radar() 最大相对误差 %.1e\n", power_error);
+	return (diff_total == 0) ? 0 : 1;
+}
+
+//均匀扫描方位角(俯仰角为0)，插值表天线增益相对 nG*Gmax 的最大误差
+static double ScanGainError(const RadarModel_C& analytic, const RadarModel_C& table)
+{
+	const RadarParam_T& p = analytic.Param();
+	double half = p.azimuth_radar_width / 2;
+	double max_error = 0;
+	for (int k = 0; k <= check_gain_sample; k++) {
+		double theta = -half + 2 * half * k / check_gain_sample;
+		double azimuth = (theta < 0) ? theta + 2 * check_pi : theta;
+		double error = fabs(analytic.AntennaGain(azimuth, 0) - table.AntennaGain(azimuth, 0)) / (p.nG * p.Gmax);
+		max_error = (error > max_error) ? error : max_error;
+	}
+	return max_error;
+}
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          天线方向图插值表检查
+*   @details        机载雷达线性、三次插值在 0.01、0.001 弧度间隔下，密集扫描的误差不超过建表时记录的最大误差；
+					记录天线增益单次调用耗时；三个场景中角度间隔 0.001 弧度的插值表与解析方向图的探测矩阵相同，
+					三次插值逐对探测与批量探测逐位相同
+*   @param[in]      argv[0]         飞机数量，缺省300
+*   @retval         0               通过
+*   @retval         1               未通过
+*/
+int CheckAntennaTable(int argc, char* argv[])
+{
+	int n = CheckArgInt(argc, argv, 0, 300);
+	if (n < 2) {
+		printf("参数无效\n");
+		return 1;
+	}
+
+	int fail = 0;
+	const char* interp_name[2] = { "线性", "三次" };
+	RadarParam_T p = RadarModel_C::AircraftParam();
+	RadarModel_C analytic(p);
+	const double resolution[2] = { 0.01, 0.001 };
+	for (int interp = 0; interp < 2; interp++) {
+		for (int r = 0; r < 2; r++) {
+			RadarModel_C table(p);
+			int rc = table.SetGainTable(resolution[r], interp, 1.0);
+			double error = ScanGainError(analytic, table);
+			printf("%s插值 间隔 %.3f: 表长 %d, 建表误差 %.2e, 扫描误差 %.2e\n", interp_name[interp], resolution[r],
+				table.GainTable().Size(), table.GainTable().MaxError(), error);
+			if (rc != 0 || error > table.GainTable().MaxError() * 1.1 + 1e-15) {
+				fail = 1;
+			}
+		}
+	}
+
+	//天线增益单次调用耗时
+	std::vector<double> azimuth(check_gain_call);
+	std::vector<double> pitch(check_gain_call);
+	for (int i = 0; i < check_gain_call; i++) {
+		CounterRand_T key;
+		crand_key(&key, 44, 0, (unsigned int)i, 0);
+		crand_uniform(&azimuth[i], &key, 0);
+		crand_uniform(&pitch[i], &key, 1);
+		azimuth[i] = (azimuth[i] - 0.5) * 2.4;
+		azimuth[i] += (azimuth[i] < 0) ? 2 * check_pi : 0;
+		pitch[i] = (pitch[i] - 0.5) * 2.4;
+	}
+	const char* gain_name[3] = { "解析", "线性", "三次" };
+	for (int mode = 0; mode < 3; mode++) {
+		RadarModel_C model(p);
+		if (mode > 0) {
+			model.SetGainTable(0.001, mode - 1, 1e-3);
+		}
+		volatile double sink = 0;
+		double t0 = CheckClock();
+		for (int r = 0; r < 100; r++) {
+			double sum = 0;
+			for (int i = 0; i < check_gain_call; i++) {
+				sum += model.AntennaGain(azimuth[i], pitch[i]);
+			}
+			sink += sum;
+		}
+		printf("天线增益 %s: %.1f ns/次\n", gain_name[mode], (CheckClock() - t0) / (100.0 * check_gain_call) * 1e9);
+	}
+
+	//探测矩阵：150km 常规RCS、150km 隐身RCS、400km 常规RCS
+	const double spread[3] = { 150000, 150000, 400000 };
+	const double rcs_min[3] = { 1, 0.001, 1 };
+	const double rcs_span[3] = { 10, 0.01, 10 };
+	for (int scene_index = 0; scene_index < 3; scene_index++) {
+		RadarScene_T scene;
+		MakeScene(&scene, n, spread[scene_index], rcs_min[scene_index], rcs_span[scene_index], (unsigned int)(9000 + scene_index));
+		RadarModel_C model_list[3] = { RadarModel_C(p), RadarModel_C(p), RadarModel_C(p) };
+		model_list[1].SetGainTable(0.001, ANTENNA_TABLE_LINEAR, 1e-3);
+		model_list[2].SetGainTable(0.001, ANTENNA_TABLE_CUBIC, 1e-3);
+		std::vector<unsigned char> finded[3];
+		std::vector<double> Pgr[3];
+		double batch_time[3];
+		for (int m = 0; m < 3; m++) {
+			finded[m].resize(n * n);
+			Pgr[m].resize(n * n);
+			double t0 = CheckClock();
+			for (int r = 0; r < 5; r++) {
+				model_list[m].DetectBatch((bool*)finded[m].data(), Pgr[m].data(), &scene.state, &scene.state);
+			}
+			batch_time[m] = (CheckClock() - t0) / 5;
+		}
+
+		//三次插值逐对探测与批量探测比较
+		std::vector<unsigned char> pair_finded(n * n);
+		std::vector<double> pair_Pgr(n * n);
+		TimeModel(scene, model_list[2], NULL, (bool*)pair_finded.data(), pair_Pgr.data());
+		long long pair_diff = 0;
+		for (int k = 0; k < n * n; k++) {
+			pair_diff += (pair_finded[k] != finded[2][k] ||
+				(pair_finded[k] && memcmp(&pair_Pgr[k], &Pgr[2][k], sizeof(double)) != 0));
+		}
+
+		long long found = 0;
+		long long flag_diff[3] = { 0, 0, 0 };
+		double Pgr_error[3] = { 0, 0, 0 };
+		for (int k = 0; k < n * n; k++) {
+			found += finded[0][k];
+			for (int m = 1; m < 3; m++) {
+				flag_diff[m] += (finded[m][k] != finded[0][k]);
+				if (finded[m][k] && finded[0][k]) {
+					double error = fabs(Pgr[m][k] - Pgr[0][k]) / Pgr[0][k];
+					Pgr_error[m] = (error > Pgr_error[m]) ? error : Pgr_error[m];
+				}
+			}
+		}
+		printf("场景 %d: 发现 %lld; 探测矩阵不同 线性 %lld 三次 %lld; Pgr 相对误差 线性 %.2e 三次 %.2e; 逐对与批量不同 %lld\n",
+			scene_index, found, flag_diff[1], flag_diff[2], Pgr_error[1], Pgr_error[2], pair_diff);
+		printf("    批量 解析 %.2f ms, 线性 %.2f ms, 三次 %.2f ms\n", batch_time[0] * 1e3, batch_time[1] * 1e3, batch_time[2] * 1e3);
+		if (flag_diff[1] != 0 || flag_diff[2] != 0 || pair_diff != 0) {
+			fail = 1;
+		}
+	}
+	return fail;
+}
+
+//RCS表在第 i 个方位点、第 j 个俯仰点的方向
+static void RcsGridAngle(double* azimuth, double* pitch, const RcsTable_C& table, int i, int j)
+{
+	*azimuth = i * 2 * check_pi / table.AzimuthCount();
+	*pitch = -check_pi / 2 + j * check_pi / (table.PitchCount() - 1);
+}
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          RCS表检查
+*   @details        由典型值 {3,8,12,9,6} 生成 1、0.5、0.25 度间隔的RCS表，网格点与 getTargetRCS 的差别在单精度舍入以内，
+					记录随机方向的插值误差；检查文件存取、拒绝多余字节、方位角回绕和单次取值耗时；
+					两个场景中使用RCS表的探测矩阵与典型值模型只在门限附近不同，逐对探测与批量探测逐位相同
+*   @param[in]      argv[0]         飞机数量，缺省300
+*   @retval         0               通过
+*   @retval         1               未通过
+*/
+int CheckRcsTable(int argc, char* argv[])
+{
+	int n = CheckArgInt(argc, argv, 0, 300);
+	if (n < 2) {
+		printf("参数无效\n");
+		return 1;
+	}
+
+	int fail = 0;
+	double table_error = 0;								//1度间隔RCS表的最大插值相对误差
+	double sigma[5] = { 3, 8, 12, 9, 6 };
+	double lambda = RadarModel_C::AircraftParam().lambda;
+	for (int res = 1; res <= 4; res *= 2) {
+		RcsTable_C table;
+		int rc = table.BuildFromSigmaType(sigma, 360 * res, 180 * res + 1, lambda, "check");
+
+		//网格点
+		double grid_error = 0;
+		for (int j = 0; j < table.PitchCount(); j++) {
+			for (int i = 0; i < table.AzimuthCount(); i++) {
+				double azimuth, pitch, rcs;
+				RcsGridAngle(&azimuth, &pitch, table, i, j);
+				getTargetRCS(&rcs, azimuth, pitch, sigma);
+				double error = fabs(table.Sample(azimuth, pitch, 0) - rcs) / ((rcs > 1e-3) ? rcs : 1);
+				grid_error = (error > grid_error) ? error : grid_error;
+			}
+		}
+
+		//随机方向，相对误差只统计RCS大于0.5平方米的方向
+		double max_error = 0;
+		double sum_error = 0;
+		int count = 0;
+		for (int k = 0; k < check_rcs_sample; k++) {
+			CounterRand_T key;
+			double u[2], rcs;
+			crand_key(&key, 45, (unsigned int)res, (unsigned int)k, 0);
+			crand_uniform(&u[0], &key, 0);
+			crand_uniform(&u[1], &key, 1);
+			double azimuth = u[0] * 2 * check_pi;
+			double pitch = (u[1] - 0.5) * check_pi;
+			getTargetRCS(&rcs, azimuth, pitch, sigma);
+			if (rcs > 0.5) {
+				double error = fabs(table.Sample(azimuth, pitch, 0) - rcs) / rcs;
+				max_error = (error > max_error) ? error : max_error;
+				sum_error += error;
+				count++;
+			}
+		}
+		printf("间隔 %.2f 度: 网格点相对误差 %.1e, 插值相对误差 平均 %.1e 最大 %.1e, %d KB\n", 1.0 / res, grid_error,
+			sum_error / count, max_error, (int)((long long)table.PitchCount() * (table.AzimuthCount() + 1) * 4 / 1024));
+		if (rc != 0 || grid_error > 1e-6) {
+			fail = 1;
+		}
+		if (res == 1) {
+			table_error = max_error;
+		}
+	}
+
+	//文件存取
+	const char* rcs_path = "check_rcs.rcs";
+	RcsTable_C table;
+	table.BuildFromSigmaType(sigma, 360, 181, lambda, "check");
+	RcsTable_C loaded;
+	int save_rc = table.Save(rcs_path);
+	int load_rc = loaded.Load(rcs_path);
+	long long load_diff = 0;
+	for (int k = 0; k < 10000; k++) {
+		CounterRand_T key;
+		double u[2];
+		crand_key(&key, 45, 100, (unsigned int)k, 0);
+		crand_uniform(&u[0], &key, 0);
+		crand_uniform(&u[1], &key, 1);
+		double azimuth = u[0] * 7 - 0.3;
+		double pitch = (u[1] - 0.5) * 3.5;
+		load_diff += (table.Sample(azimuth, pitch, 0) != loaded.Sample(azimuth, pitch, 0));
+	}
+	FILE* file = fopen(rcs_path, "ab");
+	int trailing_rc = 0;
+	if (file != NULL) {
+		fputc(0, file);
+		fclose(file);
+		RcsTable_C trailing;
+		trailing_rc = trailing.Load(rcs_path);
+	}
+	remove(rcs_path);
+	double wrap[3] = { table.Sample(-1e-17, 0.1, 0), table.Sample(2 * check_pi, 0.1, 0), table.Sample(0, 0.1, 0) };
+	printf("文件存取: 写 %d 读 %d 不同 %lld, 多余字节 %d; 方位回绕 %g %g %g\n", save_rc, load_rc, load_diff, trailing_rc,
+		wrap[0], wrap[1], wrap[2]);
+	if (save_rc != 0 || load_rc != 0 || load_diff != 0 || trailing_rc == 0 || wrap[0] != wrap[2] || wrap[1] != wrap[2]) {
+		fail = 1;
+	}
+
+	//单次取值耗时
+	std::vector<double> azimuth(check_gain_call);
+	std::vector<double> pitch(check_gain_call);
+	for (int i = 0; i < check_gain_call; i++) {
+		CounterRand_T key;
+		crand_key(&key, 45, 200, (unsigned int)i, 0);
+		crand_uniform(&azimuth[i], &key, 0);
+		crand_uniform(&pitch[i], &key, 1);
+		azimuth[i] *= 2 * check_pi;
+		pitch[i] = (pitch[i] - 0.5) * check_pi;
+	}
+	RcsTable_C fine_table;
+	fine_table.BuildFromSigmaType(sigma, 720, 361, lambda, "check");
+	volatile double sink = 0;
+	double t0 = CheckClock();
+	for (int r = 0; r < 100; r++) {
+		double sum = 0;
+		for (int i = 0; i < check_gain_call; i++) {
+			double rcs;
+			getTargetRCS(&rcs, azimuth[i], pitch[i], sigma);
+			sum += rcs;
+		}
+		sink += sum;
+	}
+	double analytic_time = (CheckClock() - t0) / (100.0 * check_gain_call);
+	t0 = CheckClock();
+	for (int r = 0; r < 100; r++) {
+		double sum = 0;
+		for (int i = 0; i < check_gain_call; i++) {
+			sum += fine_table.Sample(azimuth[i], pitch[i], 0);
+		}
+		sink += sum;
+	}
+	double table_time = (CheckClock() - t0) / (100.0 * check_gain_call);
+	printf("RCS取值: 典型值 %.1f ns/次, RCS表 %.1f ns/次\n", analytic_time * 1e9, table_time * 1e9);
+
+	//探测矩阵：150km 常规RCS、400km 隐身RCS，全部目标使用同一张表
+	RadarModel_C model(RadarModel_C::AircraftParam());
+	for (int scene_index = 0; scene_index < 2; scene_index++) {
+		double scale = (scene_index == 0) ? 1 : 0.001;
+		double scene_sigma[5];
+		for (int k = 0; k < 5; k++) {
+			scene_sigma[k] = sigma[k] * scale;
+		}
+		RadarScene_T scene;
+		MakeScene(&scene, n, (scene_index == 0) ? 150000 : 400000, 1, 0, (unsigned int)(9500 + scene_index));
+		for (int k = 0; k < 5; k++) {
+			scene.sigma[k].assign(n, scene_sigma[k]);
+			scene.state.sigma_type[k] = scene.sigma[k].data();
+		}
+		RcsTable_C scene_table;
+		scene_table.BuildFromSigmaType(scene_sigma, 360, 181, lambda, "check");
+		std::vector<const RcsTable_C*> table_list(n, &scene_table);
+		RadarBatchState_T table_state = scene.state;
+		table_state.rcs_table = table_list.data();
+		for (int k = 0; k < 5; k++) {
+			table_state.sigma_type[k] = NULL;
+		}
+
+		std::vector<unsigned char> finded(n * n), table_finded(n * n);
+		std::vector<double> Pgr(n * n), table_Pgr(n * n);
+		t0 = CheckClock();
+		for (int r = 0; r < 5; r++) {
+			model.DetectBatch((bool*)finded.data(), Pgr.data(), &scene.state, &scene.state);
+		}
+		double sigma_time = (CheckClock() - t0) / 5;
+		int rc = 0;
+		t0 = CheckClock();
+		for (int r = 0; r < 5; r++) {
+			rc |= model.DetectBatch((bool*)table_finded.data(), table_Pgr.data(), &scene.state, &table_state);
+		}
+		double batch_time = (CheckClock() - t0) / 5;
+
+		//回波功率接近门限的目标对可能因RCS插值误差判别不同，两者须分居门限两侧且相差不超过RCS表的插值误差
+		long long found = 0;
+		long long flag_diff = 0;
+		long long flag_bad = 0;
+		double flag_gap = 0;
+		long long pair_diff = 0;
+		for (int i = 0; i < n; i++) {
+			double radar_position[3] = { scene.position[0][i], scene.position[1][i], scene.position[2][i] };
+			double radar_attitude[3] = { scene.attitude[0][i], scene.attitude[1][i], scene.attitude[2][i] };
+			for (int j = 0; j < n; j++) {
+				found += finded[i * n + j];
+				flag_diff += (finded[i * n + j] != table_finded[i * n + j]);
+				if (finded[i * n + j] != table_finded[i * n + j]) {
+					double low = (Pgr[i * n + j] < table_Pgr[i * n + j]) ? Pgr[i * n + j] : table_Pgr[i * n + j];
+					double high = (Pgr[i * n + j] < table_Pgr[i * n + j]) ? table_Pgr[i * n + j] : Pgr[i * n + j];
+					double gap = (low > 0) ? (high - low) / low : 1e300;
+					flag_gap = (gap > flag_gap) ? gap : flag_gap;
+					flag_bad += (low > RADAR_DETECT_THRESHOLD || high < RADAR_DETECT_THRESHOLD || gap > table_error);
+				}
+				if (i == j) {
+					continue;
+				}
+				double target_position[3] = { scene.position[0][j], scene.position[1][j], scene.position[2][j] };
+				double target_attitude[3] = { scene.attitude[0][j], scene.attitude[1][j], scene.attitude[2][j] };
+				bool f = false;
+				double pw = 0;
+				model.Detect(&f, &pw, radar_position, radar_attitude, target_position, target_attitude, NULL, &scene_table);
+				pair_diff += (f != (bool)table_finded[i * n + j] ||
+					(f && memcmp(&pw, &table_Pgr[i * n + j], sizeof(double)) != 0));
+			}
+		}
+		printf("场景 %d: 发现 %lld; 探测矩阵不同 %lld (门限附近，Pgr 最大相差 %.1e), 逐对与批量不同 %lld; 批量 典型值 %.2f ms, RCS表 %.2f ms\n",
+			scene_index, found, flag_diff, flag_gap, pair_diff, sigma_time * 1e3, batch_time * 1e3);
+		if (rc != 0 || flag_bad != 0 || pair_diff != 0) {
+			fail = 1;
+		}
+	}
+	return fail;
+}
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          姿态四元数求方向余弦矩阵检查
+*   @details        随机未归一化四元数由 getQuaternionMatrix 求方向余弦矩阵，用 getBodyAzimuthPitch 算得的方位、俯仰角
+					与 Eigen 在北东地、前右下坐标下的计算比较，并检查正交性；按方向余弦矩阵逐对探测与批量探测逐位相同；
+					记录逐对、批量探测按姿态和按方向余弦矩阵的耗时，以及求一个方向余弦矩阵的耗时
+*   @param[in]      argv[0]         飞机数量，缺省依次取 32、100、300
+*   @retval         0               通过
+*   @retval         1               未通过
+*/
+int CheckRadarQuaternion(int argc, char* argv[])
+{
+	std::vector<int> count_list;
+	if (argc > 0) {
+		count_list.push_back(CheckArgInt(argc, argv, 0, 100));
+	}
+	else {
+		count_list.push_back(32);
+		count_list.push_back(100);
+		count_list.push_back(300);
+	}
+
+	//几何量与 Eigen 比较
+	double azimuth_error = 0;
+	double pitch_error = 0;
+	double orthogonal_error = 0;
+	for (int k = 0; k < check_quaternion_sample; k++) {
+		double u[10];
+		for (int i = 0; i < 10; i++) {
+			u[i] = CheckUniform(46, 0, (unsigned int)k, i);
+		}
+		Eigen::Vector4d q;
+		euler_to_quaternion_bn(&q, (u[0] - 0.5) * 360, (u[1] - 0.5) * 170, (u[2] - 0.5) * 360);
+		q *= 0.9 + 0.2 * u[3];
+		Eigen::Matrix3d Rbn;
+		quaternion_to_rotation(&Rbn, q / q.norm());
+
+		//北东地坐标，机体前右下
+		Eigen::Vector3d a((u[4] - 0.5) * 1e5, (u[5] - 0.5) * 1e5, -u[6] * 1e4);
+		Eigen::Vector3d b((u[7] - 0.5) * 1e5, (u[8] - 0.5) * 1e5, -u[9] * 1e4);
+		Eigen::Vector3d body = Rbn.transpose() * (b - a);
+		double forward = body(0), right = body(1), up = -body(2);
+		double horizontal = sqrt(forward * forward + right * right);
+		double azimuth = acos(forward / horizontal);
+		azimuth = (right < 0) ? azimuth : 2 * check_pi - azimuth;
+		double pitch = atan(up / horizontal);
+
+		double quaternion[4] = { q(0), q(1), q(2), q(3) };
+		double Cnb[3][3];
+		getQuaternionMatrix(Cnb, quaternion);
+		double positionA[3] = { a(0), -a(2), a(1) };
+		double positionB[3] = { b(0), -b(2), b(1) };
+		double azimuth_dcm, pitch_dcm;
+		getBodyAzimuthPitch(&azimuth_dcm, &pitch_dcm, Cnb, positionA, positionB);
+
+		double d = fabs(azimuth - azimuth_dcm);
+		d = (d < 2 * check_pi - d) ? d : 2 * check_pi - d;
+		azimuth_error = (d > azimuth_error) ? d : azimuth_error;
+		d = fabs(pitch - pitch_dcm);
+		pitch_error = (d > pitch_error) ? d : pitch_error;
+		for (int i = 0; i < 3; i++) {
+			for (int j = 0; j < 3; j++) {
+				double dot = Cnb[i][0] * Cnb[j][0] + Cnb[i][1] * Cnb[j][1] + Cnb[i][2] * Cnb[j][2];
+				d = fabs(dot - ((i == j) ? 1 : 0));
+				orthogonal_error = (d > orthogonal_error) ? d : orthogonal_error;
+			}
+		}
+	}
+	printf("与 Eigen 比较: 方位角 %.2e rad, 俯仰角 %.2e rad, 正交性 %.2e\n", azimuth_error, pitch_error, orthogonal_error);
+	//方位角由 acos 求得，前向附近舍入误差放大，允许 1e-9
+	int fail = (azimuth_error > 1e-9 || pitch_error > 1e-12 || orthogonal_error > 1e-12) ? 1 : 0;
+
+	RadarModel_C model;
+	for (size_t c = 0; c < count_list.size(); c++) {
+		int n = count_list[c];
+		if (n < 2) {
+			printf("参数无效\n");
+			return 1;
+		}
+		RadarScene_T scene;
+		MakeScene(&scene, n, 150000, 1, 10, (unsigned int)(4600 + n));
+		std::vector<double> quaternion(n * 4);
+		std::vector<double> Cnb(n * 9);
+		for (int i = 0; i < n; i++) {
+			Eigen::Vector4d q;
+			euler_to_quaternion_bn(&q, (CheckUniform(46, 1, (unsigned int)i, 0) - 0.5) * 360,
+				(CheckUniform(46, 1, (unsigned int)i, 1) - 0.5) * 170, (CheckUniform(46, 1, (unsigned int)i, 2) - 0.5) * 360);
+			for (int k = 0; k < 4; k++) {
+				quaternion[i * 4 + k] = q(k);
+			}
+			getQuaternionMatrix((double(*)[3])&Cnb[i * 9], &quaternion[i * 4]);
+		}
+		RadarBatchState_T dcm_state = scene.state;
+		dcm_state.Cnb = (const double(*)[3][3])Cnb.data();
+		for (int k = 0; k < 3; k++) {
+			dcm_state.attitude[k] = NULL;
+		}
+
+		std::vector<unsigned char> finded(n * n), pair_finded(n * n);
+		std::vector<double> Pgr(n * n), pair_Pgr(n * n);
+		model.DetectBatch((bool*)finded.data(), Pgr.data(), &dcm_state, &dcm_state);
+		double pair_dcm_time = TimeModel(scene, model, Cnb.data(), (bool*)pair_finded.data(), pair_Pgr.data());
+		long long diff = 0;
+		for (int k = 0; k < n * n; k++) {
+			diff += (pair_finded[k] != finded[k] || (finded[k] && memcmp(&pair_Pgr[k], &Pgr[k], sizeof(double)) != 0));
+		}
+		double pair_euler_time = TimeModel(scene, model, NULL, (bool*)pair_finded.data(), pair_Pgr.data());
+
+		//批量探测，按方向余弦矩阵时计入每步由四元数求矩阵的时间
+		int repeat = check_pair_budget / (n * n) + 1;
+		double t0 = CheckClock();
+		for (int r = 0; r < repeat; r++) {
+			model.DetectBatch((bool*)finded.data(), Pgr.data(), &scene.state, &scene.state);
+		}
+		double batch_euler_time = (CheckClock() - t0) / repeat;
+		t0 = CheckClock();
+		for (int r = 0; r < repeat; r++) {
+			for (int i = 0; i < n; i++) {
+				getQuaternionMatrix((double(*)[3])&Cnb[i * 9], &quaternion[i * 4]);
+			}
+			model.DetectBatch((bool*)finded.data(), Pgr.data(), &dcm_state, &dcm_state);
+		}
+		double batch_dcm_time = (CheckClock() - t0) / repeat;
+
+		printf("%3dx%-3d: 逐对与批量不同 %lld | 逐对 姿态 %.0f us, 矩阵 %.0f us | 批量 姿态 %.0f us, 四元数 %.0f us\n", n, n, diff,
+			pair_euler_time * 1e6, pair_dcm_time * 1e6, batch_euler_time * 1e6, batch_dcm_time * 1e6);
+		fail |= (diff != 0) ? 1 : 0;
+	}
+
+	//求一个方向余弦矩阵的耗时
+	std::vector<double> attitude(3 * 4096);
+	std::vector<double> quaternion(4 * 4096);
+	for (int i = 0; i < 4096; i++) {
+		for (int k = 0; k < 3; k++) {
+			attitude[i * 3 + k] = (CheckUniform(46, 2, (unsigned int)i, k) - 0.5) * 6;
+		}
+		for (int k = 0; k < 4; k++) {
+			quaternion[i * 4 + k] = CheckUniform(46, 3, (unsigned int)i, k) - 0.5;
+		}
+	}
+	double Cnb[3][3];
+	volatile double sink = 0;
+	double t0 = CheckClock();
+	for (int r = 0; r < 1000; r++) {
+		for (int i = 0; i < 4096; i++) {
+			getAttitudeMatrix(Cnb, &attitude[i * 3]);
+			sink += Cnb[1][2];
+		}
+	}
+	double euler_time = (CheckClock() - t0) / (1000 * 4096.0);
+	t0 = CheckClock();
+	for (int r = 0; r < 1000; r++) {
+		for (int i = 0; i < 4096; i++) {
+			getQuaternionMatrix(Cnb, &quaternion[i * 4]);
+			sink += Cnb[1][2];
+		}
+	}
+	double quaternion_time = (CheckClock() - t0) / (1000 * 4096.0);
+	printf("一个方向余弦矩阵: 欧拉角 %.1f ns, 四元数 %.1f ns\n", euler_time * 1e9, quaternion_time * 1e9);
+	return fail;
+}
@@ -0,0 +1,159 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           Check_resetpool.cpp
+*   @brief          初始态池计时与复现检查。
+*   @details        比较战场按分布直接初始化与从初始态池取快照恢复的耗时；池中第0局初始态与 DistributionSample 直接生成的逐位相同；
+					后台生成中的池与从不启动(全部同步生成)的池，各战场各局的初始观测逐位相同。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+#include "Check_demo.h"
+#include "../CombatSimulation/VecBattlefield.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+using namespace CombatSimulation;
+
+static const int check_pool_size = 256;				//池容量
+static const int check_rounds = 40;					//取空再填满的轮数
+static const int check_env = 8;						//复现检查的战场数
+static const int check_episode = 40;				//复现检查每个战场的局数
+
+//等待池填满后停止生成，计时只包含取用
+static void FillPool(ResetPool_C* pool, unsigned long long seed)
+{
+	pool->Start(seed);
+	while (pool->ReadyCount() < check_pool_size) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	pool->Stop();
+}
+
+//同一种子下，后台生成中的池与从不启动的池逐局比较初始观测；奇数轮先等池中就绪再取，偶数轮立即取。返回不一致的项数
+static int CheckKeyedReset(unsigned long long seed)
+{
+	const int agent_count = 2;
+	VecBattlefield_C live(check_env, agent_count, 4);
+	VecBattlefield_C sync(check_env, agent_count, 1);
+	ResetPool_C live_pool(check_env * 4, agent_count, check_env);
+	ResetPool_C sync_pool(check_env, agent_count, check_env);
+	int mismatch = 0;
+
+	//自定义初始化函数与池不能同时使用
+	mismatch += (sync.SetReset(ResetPool_C::DistributionReset, NULL) != 0);
+	mismatch += (sync.SetResetPool(&sync_pool) == 0);
+	mismatch += (sync.SetReset(NULL, NULL) != 0);
+	mismatch += (sync.SetResetPool(&sync_pool) != 0);
+	mismatch += (sync.SetReset(ResetPool_C::DistributionReset, NULL) == 0);
+
+	live.Seed(seed);
+	sync.Seed(seed);
+	mismatch += (live.SetResetPool(&live_pool) != 0);
+	live_pool.Start(seed);
+
+	std::vector<double> live_obs((size_t)check_env * agent_count * live.ObsSize());
+	std::vector<double> sync_obs(live_obs.size());
+	int diff = 0;
+	for (int k = 0; k < check_episode; k++) {
+		double t0 = CheckClock();
+		while (k % 2 == 1 && live_pool.ReadyCount() < check_env && CheckClock() - t0 < 1.0) {
+			std::this_thread::yield();
+		}
+		mismatch += (live.Reset(live_obs.data()) != 0) + (sync.Reset(sync_obs.data()) != 0);
+		diff += (memcmp(live_obs.data(), sync_obs.data(), live_obs.size() * sizeof(double)) != 0);
+	}
+	live_pool.Stop();
+
+	int total = check_env * check_episode;
+	int hit = total - live_pool.MissCount();
+	mismatch += diff + (hit == 0) + (sync_pool.MissCount() != total);
+	printf("%d 个战场 x %d 局: 后台生成池命中 %d 局, 同步生成 %d 局, 初始观测不一致 %d 轮\n",
+		check_env, check_episode, hit, sync_pool.MissCount(), diff);
+
+	return mismatch;
+}
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          初始态池计时与复现检查
+*   @details        智能体数量取2、8、16
+*   @param[in]      argv[0]         直接初始化的次数，缺省20000
+*   @retval         0               通过
+*   @retval         1               池中初始态与直接生成的不同，或初始态与池的状态有关
+*/
+int CheckResetPool(int argc, char* argv[])
+{
+	int reset_count = CheckArgInt(argc, argv, 0, 20000);
+	if (reset_count < 1) {
+		printf("参数无效\n");
+		return 1;
+	}
+
+	const int agent_list[3] = { 2, 8, 16 };
+	for (int i = 0; i < 3; i++) {
+		int agent_count = agent_list[i];
+		VecBattlefield_C vec(1, agent_count, 1);
+		vec.Reset(NULL);
+		double t0 = CheckClock();
+		for (int k = 0; k < reset_count; k++) {
+			vec.ResetEnv(0, NULL);
+		}
+		double direct = (CheckClock() - t0) / reset_count;
+
+		ResetPool_C pool(check_pool_size, agent_count);
+		vec.SetResetPool(&pool);
+		double taken = 0;
+		for (int r = 0; r < check_rounds; r++) {
+			//池与批量战场种子相同，局序号从0开始，取用全部命中
+			vec.Seed(7 + r);
+			FillPool(&pool, 7 + r);
+			t0 = CheckClock();
+			for (int k = 0; k < check_pool_size; k++) {
+				vec.ResetEnv(0, NULL);
+			}
+			taken += CheckClock() - t0;
+		}
+		taken /= check_rounds * check_pool_size;
+		printf("%2d 个智能体: 直接初始化 %.0f ns, 从池中恢复 %.0f ns\n", agent_count, direct * 1e9, taken * 1e9);
+	}
+
+	//池中战场0的第0局
+	const int agent_count = 2;
+	ResetPool_C pool(4, agent_count);
+	pool.Start(9);
+	while (pool.ReadyCount() < 4) {
+		std::this_thread::yield();
+	}
+	pool.Stop();
+	Battlefield_C* taken = new Battlefield_C;
+	Battlefield_C* direct = new Battlefield_C;
+	taken->InitCoordinate(126, 30, 0);
+	direct->InitCoordinate(126, 30, 0);
+	pool.Take(taken, 9, 0, 0);
+	ResetPool_C::DistributionSample(direct, agent_count, ResetPool_C::DefaultDistribution(), 9, 0, 0);
+	//Init 不写入 velocity_north 等输出量，解算一步后由状态更新再比较
+	taken->Run(0.02);
+	direct->Run(0.02);
+	int diff = CheckCompareBattlefield(*taken, *direct);
+	int name_diff = 0;
+	for (int a = 0; a < agent_count; a++) {
+		name_diff += (strcmp(taken->aircraft_list[a].BaseName(), direct->aircraft_list[a].BaseName()) != 0);
+	}
+	printf("池中第0局与直接生成: 状态差异 %d, 名字差异 %d, 同步生成 %d 次\n", diff, name_diff, pool.MissCount());
+
+	int keyed_mismatch = CheckKeyedReset(11);
+
+	delete taken;
+	delete direct;
+	return (diff == 0 && name_diff == 0 && pool.MissCount() == 0 && keyed_mismatch == 0) ? 0 : 1;
+}
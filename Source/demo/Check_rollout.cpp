@@ -0,0 +1,171 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           Check_rollout.cpp
+*   @brief          并行推演与逐步解算一致性检查。
+*   @details        K 个分支使用相同的控制序列，推演结果与在同一战场上按相同控制量逐步 Run 的结果逐位相同；
+					导弹命中后一方全灭时分支提前结束并置 decided，自定义结局判定在指定步数结束同样置 decided。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+#include "Check_demo.h"
+#include "../CombatSimulation/RolloutArena.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+using namespace CombatSimulation;
+
+static const double check_step = 0.02;				//单步时间间隔，单位：秒
+static const double check_segment = 0.1;			//控制段时长，单位：秒，累加时标除以段长会在段边界两侧取整
+static const int check_segment_count = 50;			//控制段数
+static const double check_horizon = 60.0;			//推演时长，单位：秒
+
+//1对1东西向相向飞行，0号飞机向1号发射一枚导弹，导弹命中后2队全灭
+static void SetupBattlefield(Battlefield_C* battlefield)
+{
+	battlefield->Reset();
+	battlefield->InitCoordinate(126.0, 30.0, 0.0);
+	battlefield->aircraft_count = 2;
+	battlefield->aircraft_list[0].Init(10000001, "F-16", 1, 126.0, 30.0, 6000, 0, 0, 90, 0, 250, 0);
+	battlefield->aircraft_list[1].Init(10000002, "F-16", 2, 126.14, 30.0, 6100, 0, 0, -90, 0, -250, 0);
+	battlefield->aircraft_list[0].craft_handle << 0, 0, 0, 10;
+	battlefield->aircraft_list[1].craft_handle << 0, 0, 0, 12;
+
+	//Init 不设置速度分量，先解算一步
+	battlefield->Run(check_step);
+	battlefield->MissileFire(battlefield->aircraft_list[0], battlefield->aircraft_list[1]);
+}
+
+//一方全部被击毁，同 RolloutArena 的缺省结局判定
+static int TeamEliminated(const Battlefield_C& battlefield)
+{
+	int live[3] = { 0, 0, 0 };
+	for (int i = 0; i < battlefield.aircraft_count; i++) {
+		live[battlefield.aircraft_list[i].base_team] += (battlefield.aircraft_list[i].base_live == CS_LIVE);
+	}
+	return (live[1] == 0 || live[2] == 0) ? 1 : 0;
+}
+
+//推演到 context 指定的步数即结束
+static int StepLimitDone(const Battlefield_C* battlefield, int branch, void* context)
+{
+	(void)branch;
+	const double* limit_time = (const double*)context;
+	return (battlefield->time >= *limit_time) ? 1 : 0;
+}
+
+//在 battlefield 上按控制序列逐步解算，控制段按步序号划分，最多 step_count 步，
+//limit_step 不小于0时推演到该步结束，否则一方全灭时结束；返回实际步数
+static int RunReference(Battlefield_C* battlefield, const double* controls, int step_count, int limit_step)
+{
+	int steps_per_segment = (int)(check_segment / check_step + 0.5);
+	int steps = 0;
+	for (int step = 0; step < step_count; step++) {
+		int segment = step / steps_per_segment;
+		segment = (segment < check_segment_count) ? segment : check_segment_count - 1;
+		const double* handle = controls + segment * battlefield->aircraft_count * 4;
+		for (int i = 0; i < battlefield->aircraft_count; i++) {
+			battlefield->aircraft_list[i].craft_handle << handle[i * 4 + 0], handle[i * 4 + 1], handle[i * 4 + 2], handle[i * 4 + 3];
+		}
+
+		battlefield->Run(check_step);
+		steps++;
+		if ((limit_step >= 0) ? (steps >= limit_step) : (TeamEliminated(*battlefield) != 0)) {
+			break;
+		}
+	}
+	return steps;
+}
+
+//各分支与参考战场逐位比较，并检查推演步数、结束时标和 decided，返回不一致的分支数
+static int CompareBranch(RolloutArena_C* arena, const RolloutSummary_T* summary, const Battlefield_C& reference, int steps)
+{
+	int mismatch = 0;
+	for (int k = 0; k < arena->BranchCount(); k++) {
+		int diff = CheckCompareBattlefield(reference, *arena->Branch(k));
+		diff += (summary[k].steps != steps) + (summary[k].decided != 1);
+		diff += (memcmp(&summary[k].end_time, &reference.time, sizeof(double)) != 0);
+		if (diff != 0) {
+			printf("分支 %d: 差异 %d, 步数 %d/%d, decided %d\n", k, diff, summary[k].steps, steps, summary[k].decided);
+			mismatch++;
+		}
+	}
+	return mismatch;
+}
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          并行推演与逐步解算一致性检查
+*   @details        控制段长 0.1 秒、步长 0.02 秒，每段5步；各分支控制序列相同，与逐步解算逐位比较
+*   @param[in]      argv[0]         分支数量，缺省8
+*   @param[in]      argv[1]         线程数量，缺省4
+*   @retval         0               通过
+*   @retval         1               结果与逐步解算不同或提前结束时未置 decided
+*/
+int CheckRollout(int argc, char* argv[])
+{
+	int branch_count = CheckArgInt(argc, argv, 0, 8);
+	int thread_count = CheckArgInt(argc, argv, 1, 4);
+	if (branch_count < 1) {
+		printf("参数无效\n");
+		return 1;
+	}
+
+	Battlefield_C* source = new Battlefield_C;
+	Battlefield_C* reference = new Battlefield_C;
+	RolloutArena_C* arena = new RolloutArena_C(branch_count, thread_count);
+	std::vector<RolloutSummary_T> summary(branch_count);
+	int step_count = (int)(check_horizon / check_step + 0.5);
+	int mismatch = 0;
+
+	//每段控制量不同，各分支相同
+	int segment_size = 2 * 4;
+	std::vector<double> controls((size_t)branch_count * check_segment_count * segment_size);
+	for (int s = 0; s < check_segment_count; s++) {
+		for (int i = 0; i < 2; i++) {
+			double* handle = &controls[(size_t)s * segment_size + i * 4];
+			handle[0] = 0.02 * CheckUniform(36, i, s, 0) - 0.01;
+			handle[1] = 0.01 * CheckUniform(36, i, s, 1) - 0.005;
+			handle[2] = 0;
+			handle[3] = 10 + 2 * CheckUniform(36, i, s, 2);
+		}
+	}
+	for (int k = 1; k < branch_count; k++) {
+		memcpy(&controls[(size_t)k * check_segment_count * segment_size], &controls[0], sizeof(double) * check_segment_count * segment_size);
+	}
+
+	//缺省结局判定：导弹命中后2队全灭，提前结束
+	SetupBattlefield(source);
+	SetupBattlefield(reference);
+	int hit_steps = RunReference(reference, &controls[0], step_count, -1);
+	mismatch += (TeamEliminated(*reference) == 0);
+	mismatch += (arena->Fork(*source, branch_count) != 0);
+	double t0 = CheckClock();
+	mismatch += (arena->Run(&controls[0], check_segment_count, check_segment, check_horizon, check_step, &summary[0]) != 0);
+	double rollout_time = CheckClock() - t0;
+	int hit_mismatch = CompareBranch(arena, &summary[0], *reference, hit_steps);
+
+	//自定义结局判定：推演到指定时标结束
+	int limit_steps = hit_steps / 2 + 3;
+	SetupBattlefield(reference);
+	RunReference(reference, &controls[0], step_count, limit_steps);
+	double limit_time = reference->time;
+	arena->SetDone(StepLimitDone, &limit_time);
+	mismatch += (arena->Run(&controls[0], check_segment_count, check_segment, check_horizon, check_step, &summary[0]) != 0);
+	int limit_mismatch = CompareBranch(arena, &summary[0], *reference, limit_steps);
+
+	printf("%d 个分支 x %d 线程: 命中结束 %d 步, 不一致分支 %d; 限定结束 %d 步, 不一致分支 %d; 推演耗时 %.3f ms\n",
+		branch_count, arena->ThreadCount(), hit_steps, hit_mismatch, limit_steps, limit_mismatch, rollout_time * 1e3);
+
+	delete source;
+	delete reference;
+	delete arena;
+	return (mismatch + hit_mismatch + limit_mismatch == 0) ? 0 : 1;
+}
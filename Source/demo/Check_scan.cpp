@@ -0,0 +1,187 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           Check_scan.cpp
+*   @brief          雷达行扫描检查。
+*   @details        扫过范围与逐个波位的方位、俯仰范围比较，检查一帧内扫描空域全部被照射，
+					以及按步长扫过范围剔除后批量探测逐对计算的目标对数和耗时。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+#include "Check_demo.h"
+#include "../Sensor/radar_model.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <vector>
+
+static const double check_step = 0.05;				//仿真步长，单位：秒
+static const int check_window_trial = 2000;			//检查扫过范围的随机时刻数
+static const int check_window_direction = 200;		//每个时刻的随机方向数
+static const int check_cover_direction = 20000;		//检查一帧覆盖的随机方向数
+static const int check_detect_tick = 40;			//批量探测计时的步数
+
+//方位角 azimuth(向左为正)、俯仰角 pitch 的单位向量(前，上，右)
+static void BodyVector(double Vb[3], double azimuth, double pitch)
+{
+	Vb[0] = cos(pitch) * cos(azimuth);
+	Vb[1] = sin(pitch);
+	Vb[2] = -cos(pitch) * sin(azimuth);
+}
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          雷达行扫描检查
+*   @details        默认扫描方式(4行，0.05s 步长)：随机时刻的扫过范围与该步驻留过的各波位方位、俯仰 ±半波束宽度逐个比较；
+					一帧内扫描空域中的随机方向至少被照射一次；批量探测加入扫过范围后发现的目标是整个扫描空域结果的子集，
+					且回波功率相同，记录每步逐对计算的目标对数和耗时
+*   @param[in]      argv[0]         飞机数量，缺省依次取 100、300
+*   @retval         0               通过
+*   @retval         1               未通过
+*/
+int CheckRadarScan(int argc, char* argv[])
+{
+	std::vector<int> count_list;
+	if (argc > 0) {
+		count_list.push_back(CheckArgInt(argc, argv, 0, 100));
+	}
+	else {
+		count_list.push_back(100);
+		count_list.push_back(300);
+	}
+
+	RadarScan_C scan;
+	const RadarScanParam_T& sp = scan.Param();
+	double half_beam = sp.beam_width / 2;
+	printf("每行 %d 个波位, 共 %d 个, 帧时间 %.3f s\n", scan.ColumnCount(), scan.PositionCount(), scan.FrameTime());
+
+	//扫过范围与逐个波位比较，相邻波位间隔等于波束宽度，合并后的范围与逐个波位的并集相同
+	long long window_diff = 0;
+	for (int trial = 0; trial < check_window_trial; trial++) {
+		double t = CheckUniform(48, 0, (unsigned int)trial, 0) * 20 - 5;
+		RadarScanWindow_T window;
+		scan.Window(&window, t, check_step);
+		double frame_time = fmod(t, scan.FrameTime());
+		frame_time += (frame_time < 0) ? scan.FrameTime() : 0;
+		int first = (int)(frame_time / sp.dwell_time);
+		int last = (int)ceil((frame_time + check_step) / sp.dwell_time) - 1;
+		for (int k = 0; k < check_window_direction; k++) {
+			double azimuth = (CheckUniform(48, 1 + trial, (unsigned int)k, 0) - 0.5) * 2.4;
+			double pitch = (CheckUniform(48, 1 + trial, (unsigned int)k, 1) - 0.5) * 0.2;
+			bool in_cell = false;
+			for (int p = first; p <= last; p++) {
+				double beam_azimuth, beam_pitch;
+				scan.BeamDirection(&beam_azimuth, &beam_pitch, (p + 0.5) * sp.dwell_time);
+				in_cell = in_cell || (fabs(azimuth - beam_azimuth) <= half_beam + 1e-12 && fabs(pitch - beam_pitch) <= half_beam + 1e-12);
+			}
+			double Vb[3];
+			BodyVector(Vb, azimuth, pitch);
+			window_diff += (RadarScan_C::InWindow(window, Vb) != in_cell);
+		}
+	}
+	printf("扫过范围与逐个波位比较: %lld / %d 不同\n", window_diff, check_window_trial * check_window_direction);
+
+	//一帧覆盖
+	int tick_count = (int)ceil(scan.FrameTime() / check_step);
+	std::vector<RadarScanWindow_T> frame_window(tick_count);
+	for (int s = 0; s < tick_count; s++) {
+		scan.Window(&frame_window[s], s * check_step, check_step);
+	}
+	int miss = 0;
+	int max_hit = 0;
+	long long sum_hit = 0;
+	for (int k = 0; k < check_cover_direction; k++) {
+		double azimuth = (CheckUniform(48, 0, (unsigned int)k, 2) - 0.5) * sp.azimuth_width;
+		double pitch = sp.center_pitch + (CheckUniform(48, 0, (unsigned int)k, 3) - 0.5) * (sp.bar_count * sp.bar_spacing);
+		double Vb[3];
+		BodyVector(Vb, azimuth, pitch);
+		int hit = 0;
+		for (int s = 0; s < tick_count; s++) {
+			hit += RadarScan_C::InWindow(frame_window[s], Vb);
+		}
+		miss += (hit == 0);
+		max_hit = (hit > max_hit) ? hit : max_hit;
+		sum_hit += hit;
+	}
+	printf("一帧覆盖: %d / %d 个方向未被照射, 平均照射 %.2f 步, 最多 %d 步\n", miss, check_cover_direction,
+		(double)sum_hit / check_cover_direction, max_hit);
+	int fail = (window_diff != 0 || miss != 0) ? 1 : 0;
+
+	//批量探测：飞机近似水平飞行，60km 见方
+	RadarModel_C model;
+	for (size_t c = 0; c < count_list.size(); c++) {
+		int n = count_list[c];
+		if (n < 2) {
+			printf("参数无效\n");
+			return 1;
+		}
+		std::vector<double> position[3], attitude[3], sigma[5];
+		for (int k = 0; k < 3; k++) {
+			position[k].resize(n);
+			attitude[k].resize(n);
+		}
+		for (int k = 0; k < 5; k++) {
+			sigma[k].resize(n);
+		}
+		for (int i = 0; i < n; i++) {
+			position[0][i] = (CheckUniform(48, 100 + n, (unsigned int)i, 0) - 0.5) * 60000;
+			position[1][i] = 5000 + CheckUniform(48, 100 + n, (unsigned int)i, 1) * 1000;
+			position[2][i] = (CheckUniform(48, 100 + n, (unsigned int)i, 2) - 0.5) * 60000;
+			attitude[0][i] = (CheckUniform(48, 100 + n, (unsigned int)i, 3) - 0.5) * 0.2;
+			attitude[1][i] = (CheckUniform(48, 100 + n, (unsigned int)i, 4) - 0.5) * 6.28;
+			attitude[2][i] = (CheckUniform(48, 100 + n, (unsigned int)i, 5) - 0.5) * 0.05;
+			for (int k = 0; k < 5; k++) {
+				sigma[k][i] = 1 + 10 * CheckUniform(48, 100 + n, (unsigned int)i, 6 + k);
+			}
+		}
+		RadarBatchState_T state;
+		state.count = n;
+		for (int k = 0; k < 3; k++) {
+			state.position[k] = position[k].data();
+			state.attitude[k] = attitude[k].data();
+		}
+		for (int k = 0; k < 5; k++) {
+			state.sigma_type[k] = sigma[k].data();
+		}
+		state.rcs_table = NULL;
+		state.Cnb = NULL;
+
+		std::vector<unsigned char> full_finded(n * n), scan_finded(n * n);
+		std::vector<double> full_Pgr(n * n), scan_Pgr(n * n);
+		std::vector<RadarScanWindow_T> window(n);
+		RadarBatchStats_T full_stats, scan_stats;
+		long long violation = 0;
+		long long evaluated = 0;
+		long long scan_culled = 0;
+		double scan_time = 0;
+		double full_time = 0;
+		for (int tick = 0; tick < check_detect_tick; tick++) {
+			//各雷达取不同的初相
+			double t0 = CheckClock();
+			for (int i = 0; i < n; i++) {
+				scan.Window(&window[i], tick * check_step + i * 0.37, check_step);
+			}
+			model.DetectBatch((bool*)scan_finded.data(), scan_Pgr.data(), &state, &state, &scan_stats, window.data());
+			scan_time += CheckClock() - t0;
+			t0 = CheckClock();
+			model.DetectBatch((bool*)full_finded.data(), full_Pgr.data(), &state, &state, &full_stats);
+			full_time += CheckClock() - t0;
+			evaluated += scan_stats.evaluated;
+			scan_culled += scan_stats.scan_culled;
+			for (int k = 0; k < n * n; k++) {
+				violation += (scan_finded[k] && (!full_finded[k] || scan_Pgr[k] != full_Pgr[k]));
+			}
+		}
+		printf("%d 架: 逐对计算 整个空域 %lld/步, 扫过范围 %.1f/步 (扫描剔除 %.1f/步) | %.0f us 对 %.0f us 每步 | 不在整个空域结果中 %lld\n",
+			n, full_stats.evaluated, (double)evaluated / check_detect_tick, (double)scan_culled / check_detect_tick,
+			scan_time / check_detect_tick * 1e6, full_time / check_detect_tick * 1e6, violation);
+		fail |= (violation != 0) ? 1 : 0;
+	}
+	return fail;
+}
@@ -0,0 +1,191 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           Check_scenario.cpp
+*   @brief          想定库装入计时与正确性检查。
+*   @details        生成10万个2~4架飞机的文本想定并转换为二进制想定库，比较逐个实例化与逐架调用 Init 的耗时，
+					实例化结果与 Init 的差异应在文本精度以内；格式错误的文本和内存数据应被拒绝。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+#include "Check_demo.h"
+#include "../CombatSimulation/ScenarioFile.h"
+#include "../Tools/counter_rand.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+using namespace CombatSimulation;
+
+static const double check_max_state_error = 0.01;	//实例化与 Init 的状态差上限，文本速度保留3位小数，解算2秒后位置差在厘米以内
+
+//想定中一架飞机的初始值，与文本相同的顺序
+struct CheckAircraft_T
+{
+	int								id;
+	int								team;
+	double							value[9];						//经度、纬度、高度、滚转、俯仰、偏航、北向、东向、地向速度
+};
+
+//飞机名字，单数为 J-20
+static const char* AircraftName(int i)
+{
+	return (i % 2 != 0) ? "J-20" : "F-16";
+}
+
+//生成文本想定，同时保存初始值
+static int WriteText(const char* path, std::vector<std::vector<CheckAircraft_T> >& library, int scenario_count)
+{
+	FILE* file = fopen(path, "w");
+	if (file == NULL) {
+		return 1;
+	}
+	fprintf(file, "# Check_demo scenario_file\n");
+	library.assign(scenario_count, std::vector<CheckAircraft_T>());
+	for (int k = 0; k < scenario_count; k++) {
+		fprintf(file, "scenario sc%d 126.0 30.0 0.0\n", k);
+		CounterRand_T key;
+		crand_key(&key, 39, (unsigned int)k, 0, 0);
+		int count = 2 + k % 3;
+		for (int i = 0; i < count; i++) {
+			double u[6];
+			for (int j = 0; j < 6; j++) {
+				crand_uniform(&u[j], &key, i * 6 + j);
+			}
+			CheckAircraft_T air = { 10000001 + i, 1 + i % 2,
+				{ 126 + 0.2 * u[0], 30 + 0.2 * u[1], 5000 + 5000 * u[2], 0, 5 * u[3], 360 * u[4] - 180, 200 * u[5], 100 - 200 * u[5], 0 } };
+			library[k].push_back(air);
+			fprintf(file, "aircraft %d %s %d %.9f %.9f %.3f %.3f %.3f %.3f %.3f %.3f %.3f\n", air.id, AircraftName(i), air.team,
+				air.value[0], air.value[1], air.value[2], air.value[3], air.value[4], air.value[5], air.value[6], air.value[7], air.value[8]);
+		}
+		fprintf(file, "end\n");
+	}
+	fclose(file);
+	return 0;
+}
+
+//两个战场全部飞机状态差的最大值
+static double MaxStateError(const Battlefield_C& a, const Battlefield_C& b)
+{
+	double error = (a.aircraft_count == b.aircraft_count) ? 0 : 1e300;
+	for (int i = 0; i < a.aircraft_count && i < b.aircraft_count; i++) {
+		double e = (a.aircraft_list[i].craft_state - b.aircraft_list[i].craft_state).cwiseAbs().maxCoeff();
+		error = (e > error) ? e : error;
+	}
+	return error;
+}
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          想定库装入计时与正确性检查
+*   @details        文本和二进制文件写在当前目录，名为 check_scenario.txt、check_scenario.bin
+*   @param[in]      argv[0]         想定数量，缺省100000
+*   @retval         0               通过
+*   @retval         1               转换失败、实例化结果超差或错误输入未被拒绝
+*/
+int CheckScenarioFile(int argc, char* argv[])
+{
+	int scenario_count = CheckArgInt(argc, argv, 0, 100000);
+	if (scenario_count < 1) {
+		printf("参数无效\n");
+		return 1;
+	}
+	const char* text_path = "check_scenario.txt";
+	const char* binary_path = "check_scenario.bin";
+
+	std::vector<std::vector<CheckAircraft_T> > library;
+	if (WriteText(text_path, library, scenario_count) != 0) {
+		printf("无法写入 %s\n", text_path);
+		return 1;
+	}
+	double t0 = CheckClock();
+	int error = ScenarioFile_C::ConvertText(text_path, binary_path);
+	double convert_time = CheckClock() - t0;
+
+	ScenarioFile_C file;
+	t0 = CheckClock();
+	error += file.Open(binary_path);
+	double open_time = CheckClock() - t0;
+	if (error != 0 || file.ScenarioCount() != scenario_count) {
+		printf("转换或打开失败\n");
+		return 1;
+	}
+
+	//逐个实例化，与由内存中的初始值逐架 Init 比较
+	Battlefield_C* instance = new Battlefield_C;
+	Battlefield_C* reference = new Battlefield_C;
+	double max_error = 0;
+	t0 = CheckClock();
+	for (int k = 0; k < scenario_count; k++) {
+		file.Instantiate(k, instance);
+	}
+	double instantiate_time = CheckClock() - t0;
+
+	t0 = CheckClock();
+	for (int k = 0; k < scenario_count; k++) {
+		reference->Reset();
+		reference->InitCoordinate(126, 30, 0);
+		for (size_t i = 0; i < library[k].size(); i++) {
+			const CheckAircraft_T& air = library[k][i];
+			reference->aircraft_list[i].Init(air.id, AircraftName((int)i), air.team, air.value[0], air.value[1], air.value[2],
+				air.value[3], air.value[4], air.value[5], air.value[6], air.value[7], air.value[8]);
+			reference->aircraft_list[i].craft_handle.setZero();
+		}
+		reference->aircraft_count = (int)library[k].size();
+	}
+	double init_time = CheckClock() - t0;
+
+	//抽查100个想定，并解算100步
+	for (int k = 0; k < scenario_count; k += (scenario_count + 99) / 100) {
+		file.Instantiate(k, instance);
+		reference->Reset();
+		reference->InitCoordinate(126, 30, 0);
+		for (size_t i = 0; i < library[k].size(); i++) {
+			const CheckAircraft_T& air = library[k][i];
+			reference->aircraft_list[i].Init(air.id, AircraftName((int)i), air.team, air.value[0], air.value[1], air.value[2],
+				air.value[3], air.value[4], air.value[5], air.value[6], air.value[7], air.value[8]);
+			reference->aircraft_list[i].craft_handle.setZero();
+		}
+		reference->aircraft_count = (int)library[k].size();
+		double e = MaxStateError(*instance, *reference);
+		for (int s = 0; s < 100; s++) {
+			instance->Run(0.02);
+			reference->Run(0.02);
+		}
+		double e_run = MaxStateError(*instance, *reference);
+		e = (e_run > e) ? e_run : e;
+		max_error = (e > max_error) ? e : max_error;
+		if (strcmp(instance->aircraft_list[1].BaseName(), "J-20") != 0) {
+			max_error = 1e300;
+		}
+	}
+
+	//错误输入
+	std::vector<long long> garbage(1000, 0);
+	int garbage_rejected = (file.Attach(garbage.data(), garbage.size() * sizeof(long long)) != 0);
+	const char* bad_path = "check_scenario_bad.txt";
+	FILE* bad = fopen(bad_path, "w");
+	if (bad != NULL) {
+		fprintf(bad, "scenario a 1 2 3\naircraft 1 F-16 1 1 2 x 0 0 0 0 0 0\nend\n");
+		fclose(bad);
+	}
+	int text_rejected = (ScenarioFile_C::ConvertText(bad_path, "check_scenario_bad.bin") != 0);
+
+	printf("%d 个想定: 转换 %.2f s, 打开 %.1f us, 实例化 %.0f ns/个, 逐架 Init %.0f ns/个\n", scenario_count,
+		convert_time, open_time * 1e6, instantiate_time / scenario_count * 1e9, init_time / scenario_count * 1e9);
+	printf("最大状态差 %.3g, 拒绝错误数据 %d, 拒绝错误文本 %d\n", max_error, garbage_rejected, text_rejected);
+
+	file.Close();
+	delete instance;
+	delete reference;
+	remove(text_path);
+	remove(binary_path);
+	remove(bad_path);
+	return (max_error <= check_max_state_error && garbage_rejected && text_rejected) ? 0 : 1;
+}
@@ -0,0 +1,160 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           Check_scheduler.cpp
+*   @brief          事件调度计时与正确性检查。
+*   @details        周期定时器分别用逐步倒计时轮询和事件调度实现，比较每步开销，两者触发次数应相同；
+					另检查触发顺序、取消和不提前触发。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+#include "Check_demo.h"
+#include "../CombatSimulation/EventScheduler.h"
+#include "../Tools/counter_rand.h"
+
+#include <stdio.h>
+#include <vector>
+using namespace CombatSimulation;
+
+static const double check_step = 0.02;				//单步时间间隔，单位：秒
+
+//周期定时器的状态，owner 为当前时刻
+struct CheckTimer_T
+{
+	EventScheduler_C*				scheduler;
+	std::vector<double>				period;
+	long long						fired;
+	double							max_late;
+	int								early;
+};
+
+//触发后按周期重新登记
+static int PeriodicHandler(void* owner, const ScheduledEvent_T* event, void* context)
+{
+	CheckTimer_T* timer = (CheckTimer_T*)context;
+	double now = *(const double*)owner;
+	timer->fired++;
+	timer->early += (now < event->time);
+	timer->max_late = (now - event->time > timer->max_late) ? now - event->time : timer->max_late;
+	timer->scheduler->Schedule(event->time + timer->period[event->entity], 0, event->entity, 0, NULL);
+	return 0;
+}
+
+//记录触发顺序
+static int RecordHandler(void* owner, const ScheduledEvent_T* event, void* context)
+{
+	(void)owner;
+	((std::vector<double>*)context)->push_back(event->time);
+	return 0;
+}
+
+//触发顺序与取消，返回错误数
+static int CheckOrder()
+{
+	EventScheduler_C scheduler(0.01, 16);
+	std::vector<double> order;
+	scheduler.SetHandler(1, RecordHandler, &order);
+	const double time_list[8] = { 0.5, 0.031, 100.0, 0.03, 7.77, 0.5, 0.2, 55.5 };
+	EventHandle_T handle[8];
+	for (int i = 0; i < 8; i++) {
+		scheduler.Schedule(time_list[i], 1, i, 0, &handle[i]);
+	}
+	int error = (scheduler.Cancel(handle[6]) != 0);
+	error += (scheduler.Cancel(handle[6]) == 0);
+	double now = 0;
+	for (int k = 1; k <= 10000; k++) {
+		now = k * check_step;
+		size_t before = order.size();
+		scheduler.Advance(now, &now);
+		for (size_t i = before; i < order.size(); i++) {
+			error += (order[i] > now);
+		}
+	}
+	error += (order.size() != 7) + (scheduler.PendingCount() != 0);
+	for (size_t i = 1; i < order.size(); i++) {
+		error += (order[i] < order[i - 1]);
+	}
+	printf("触发顺序:");
+	for (size_t i = 0; i < order.size(); i++) {
+		printf(" %g", order[i]);
+	}
+	printf(", 错误 %d\n", error);
+	return error;
+}
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          事件调度计时与正确性检查
+*   @details        定时器周期为 5 ~ 30 秒，只计定时器本身的开销，不含战场解算
+*   @param[in]      argv[0]         步数，缺省200000
+*   @retval         0               通过
+*   @retval         1               触发顺序错误、提前触发或触发次数与轮询不同
+*/
+int CheckEventScheduler(int argc, char* argv[])
+{
+	int step_count = CheckArgInt(argc, argv, 0, 200000);
+	if (step_count < 1) {
+		printf("参数无效\n");
+		return 1;
+	}
+	int error = CheckOrder();
+
+	const int timer_list[3] = { 16, 128, 1024 };
+	for (int n = 0; n < 3; n++) {
+		int timer_count = timer_list[n];
+		std::vector<double> period(timer_count);
+		CounterRand_T key;
+		crand_key(&key, 40, 0, 0, 0);
+		for (int i = 0; i < timer_count; i++) {
+			double u;
+			crand_uniform(&u, &key, i);
+			period[i] = 5 + 25 * u;
+		}
+
+		//轮询：每步每个定时器倒计时
+		std::vector<double> left(period);
+		long long polled = 0;
+		double t0 = CheckClock();
+		for (int k = 0; k < step_count; k++) {
+			for (int i = 0; i < timer_count; i++) {
+				left[i] -= check_step;
+				if (left[i] <= 0) {
+					left[i] += period[i];
+					polled++;
+				}
+			}
+		}
+		double polling_time = CheckClock() - t0;
+
+		EventScheduler_C scheduler;
+		CheckTimer_T timer;
+		timer.scheduler = &scheduler;
+		timer.period = period;
+		timer.fired = 0;
+		timer.max_late = 0;
+		timer.early = 0;
+		scheduler.SetHandler(0, PeriodicHandler, &timer);
+		for (int i = 0; i < timer_count; i++) {
+			scheduler.Schedule(period[i], 0, i, 0, NULL);
+		}
+		double now = 0;
+		t0 = CheckClock();
+		for (int k = 0; k < step_count; k++) {
+			now += check_step;
+			scheduler.Advance(now, &now);
+		}
+		double scheduler_time = CheckClock() - t0;
+
+		printf("%4d 个定时器: 轮询 %.1f ns/步 (%lld 次), 调度 %.1f ns/步 (%lld 次, 最大延迟 %.3f s, 提前 %d)\n",
+			timer_count, polling_time / step_count * 1e9, polled, scheduler_time / step_count * 1e9, timer.fired,
+			timer.max_late, timer.early);
+		error += (polled != timer.fired) + timer.early;
+	}
+	return (error == 0) ? 0 : 1;
+}
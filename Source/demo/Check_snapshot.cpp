@@ -0,0 +1,223 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           Check_snapshot.cpp
+*   @brief          战场快照计时与复现检查。
+*   @details        保存快照后继续解算，再由快照恢复到另一个战场重放相同步数，两者逐位相同；
+					增量快照恢复后与原战场逐位相同，部分改变的分支增量小于完整快照；保存时待触发的调度事件在恢复后照常触发。记录快照大小和保存、恢复耗时。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+#include "Check_demo.h"
+#include "../CombatSimulation/BattlefieldSnapshot.h"
+
+#include <stdio.h>
+#include <vector>
+using namespace CombatSimulation;
+
+static const double check_step = 0.02;				//单步时间间隔，单位：秒
+static const int check_replay = 1000;				//重放步数
+
+//pairs 对飞机相向飞行，发射 fire 枚导弹
+static void SetupBattlefield(Battlefield_C* battlefield, int pairs, int fire)
+{
+	battlefield->Reset();
+	battlefield->InitCoordinate(126.0, 30.0, 0.0);
+	battlefield->aircraft_count = 2 * pairs;
+	for (int p = 0; p < pairs; p++) {
+		battlefield->aircraft_list[2 * p].Init(10000001 + 2 * p, "F-16", 1, 126.0 + 0.01 * p, 30.0, 6000, 0, 0, 0, 250, 0, 0);
+		battlefield->aircraft_list[2 * p + 1].Init(10000002 + 2 * p, "F-16", 2, 126.0 + 0.01 * p + 0.005, 30.12, 6100, 0, 0, 180, -250, 0, 0);
+		battlefield->aircraft_list[2 * p].craft_handle << 0.05, 0.02, 0, 10;
+		battlefield->aircraft_list[2 * p + 1].craft_handle << -0.1, 0.01, 0, 12;
+	}
+	for (int k = 0; k < fire; k++) {
+		battlefield->MissileFire(battlefield->aircraft_list[k % (2 * pairs)], battlefield->aircraft_list[(k + 1) % (2 * pairs)]);
+	}
+}
+
+//恢复快照用的空战场，字符串表与参考点同源战场
+static void PrepareTarget(Battlefield_C* battlefield, const Battlefield_C& source)
+{
+	battlefield->string_table = source.string_table;
+	battlefield->InitCoordinate(126.0, 30.0, 0.0);
+}
+
+//机动事件：改变一架飞机的滚转控制量，0.5 秒后反向再来一次，context 为触发次数
+static int ManeuverHandler(void* owner, const ScheduledEvent_T* event, void* context)
+{
+	Battlefield_C* battlefield = (Battlefield_C*)owner;
+	battlefield->aircraft_list[event->entity].craft_handle(0) = event->param;
+	battlefield->event_scheduler.Schedule(event->time + 0.5, event->type, event->entity, -event->param, NULL);
+	(*(int*)context)++;
+	return 0;
+}
+
+//跨快照的待触发事件：保存时有周期事件、远期事件和已取消事件，恢复后重放与原战场逐位相同，
+//保存前取得的句柄在恢复后仍能取消。返回不一致的项数
+static int CheckPendingEvent()
+{
+	const int maneuver_type = 3;
+	int capacity = Battlefield_C::SnapshotCapacity();
+	std::vector<unsigned char> buffer(capacity);
+	Battlefield_C* source = new Battlefield_C;
+	Battlefield_C* replay = new Battlefield_C;
+	int source_fired = 0;
+	int replay_fired = 0;
+	int mismatch = 0;
+
+	SetupBattlefield(source, 2, 2);
+	source->event_scheduler.SetHandler(maneuver_type, ManeuverHandler, &source_fired);
+	for (int k = 0; k < 100; k++) {
+		source->Run(check_step);
+	}
+	EventHandle_T cancelled;
+	EventHandle_T kept;
+	source->event_scheduler.Schedule(source->time + 0.3, maneuver_type, 0, 0.2, NULL);
+	source->event_scheduler.Schedule(source->time + 15.0, maneuver_type, 1, -0.1, NULL);
+	source->event_scheduler.Schedule(source->time + 1.0, maneuver_type, 2, 0.3, &cancelled);
+	source->event_scheduler.Schedule(source->time + 5.0, maneuver_type, 3, 0.3, &kept);
+	mismatch += (source->event_scheduler.Cancel(cancelled) != 0);
+	mismatch += (source->SaveSnapshot(buffer.data(), capacity, NULL) != 0);
+	mismatch += (((const SnapshotHeader_T*)buffer.data())->event_count != 3);
+
+	//两边在同一步取消保存前登记的事件
+	for (int k = 0; k < check_replay; k++) {
+		if (k == 10) {
+			mismatch += (source->event_scheduler.Cancel(kept) != 0);
+		}
+		source->Run(check_step);
+	}
+
+	PrepareTarget(replay, *source);
+	replay->event_scheduler.SetHandler(maneuver_type, ManeuverHandler, &replay_fired);
+	mismatch += (replay->RestoreSnapshot(buffer.data()) != 0);
+	mismatch += (replay->event_scheduler.PendingCount() != 3);
+	for (int k = 0; k < check_replay; k++) {
+		if (k == 10) {
+			mismatch += (replay->event_scheduler.Cancel(kept) != 0);
+		}
+		replay->Run(check_step);
+	}
+	int diff = CheckCompareBattlefield(*source, *replay);
+	mismatch += (diff != 0) + (source_fired != replay_fired) + (source_fired == 0);
+	mismatch += (source->event_scheduler.PendingCount() != replay->event_scheduler.PendingCount());
+
+	printf("待触发事件: 保存 3 个, 原战场触发 %d 次, 重放触发 %d 次, 重放差异 %d\n", source_fired, replay_fired, diff);
+
+	delete source;
+	delete replay;
+	return mismatch;
+}
+
+//同一规模下的检查，返回不一致的项数
+static int CheckScale(int pairs, int fire, int repeat)
+{
+	int capacity = Battlefield_C::SnapshotCapacity();
+	std::vector<unsigned char> buffer(capacity);
+	std::vector<unsigned char> delta_buffer(capacity);
+	Battlefield_C* source = new Battlefield_C;
+	Battlefield_C* replay = new Battlefield_C;
+	Battlefield_C* branch = new Battlefield_C;
+	Battlefield_C* restored = new Battlefield_C;
+	int mismatch = 0;
+
+	//保存后继续解算，与由快照恢复后重放的结果比较
+	SetupBattlefield(source, pairs, fire);
+	for (int k = 0; k < 100; k++) {
+		source->Run(check_step);
+	}
+	int size;
+	source->SaveSnapshot(buffer.data(), capacity, &size);
+	for (int k = 0; k < check_replay; k++) {
+		source->Run(check_step);
+	}
+	PrepareTarget(replay, *source);
+	replay->RestoreSnapshot(buffer.data());
+	for (int k = 0; k < check_replay; k++) {
+		replay->Run(check_step);
+	}
+	int replay_diff = CheckCompareBattlefield(*source, *replay);
+	mismatch += (replay_diff != 0);
+
+	//分支只改一架飞机的控制量，增量快照恢复后与分支比较
+	PrepareTarget(branch, *source);
+	branch->RestoreSnapshot(buffer.data());
+	branch->aircraft_list[0].craft_handle(0) = 0.3;
+	branch->Run(check_step);
+	int branch_size;
+	int delta_size;
+	branch->SaveSnapshot(delta_buffer.data(), capacity, &branch_size);
+	mismatch += (branch->SaveDelta(buffer.data(), delta_buffer.data(), capacity, &delta_size) != 0);
+	PrepareTarget(restored, *source);
+	restored->RestoreSnapshot(delta_buffer.data(), buffer.data());
+	int delta_diff = CheckCompareBattlefield(*branch, *restored);
+	mismatch += (delta_diff != 0);
+
+	//推进一步后各实体的编号、挂载、锁定列表等不变，增量只含变化的字，应小于完整快照
+	mismatch += (delta_size >= branch_size);
+
+	//未改变的分支
+	PrepareTarget(restored, *source);
+	restored->RestoreSnapshot(buffer.data());
+	int unchanged_size;
+	restored->SaveDelta(buffer.data(), delta_buffer.data(), capacity, &unchanged_size);
+
+	//只改一个控制量的分支，增量只比未改变的多一个字掩码和一个字
+	restored->aircraft_list[0].craft_handle(0) = 0.3;
+	int handle_size;
+	restored->SaveDelta(buffer.data(), delta_buffer.data(), capacity, &handle_size);
+	mismatch += (handle_size != unchanged_size + 2 * (int)sizeof(SnapshotWord_T));
+	PrepareTarget(replay, *source);
+	replay->RestoreSnapshot(delta_buffer.data(), buffer.data());
+	delta_diff += CheckCompareBattlefield(*restored, *replay);
+	mismatch += (delta_diff != 0);
+	restored->RestoreSnapshot(buffer.data());
+
+	double t0 = CheckClock();
+	for (int r = 0; r < repeat; r++) {
+		branch->SaveSnapshot(buffer.data(), capacity, &size);
+		restored->RestoreSnapshot(buffer.data());
+	}
+	double round_trip = (CheckClock() - t0) / repeat;
+	t0 = CheckClock();
+	for (int r = 0; r < repeat; r++) {
+		branch->SaveSnapshot(buffer.data(), capacity, &size);
+	}
+	double save_only = (CheckClock() - t0) / repeat;
+
+	printf("%2d 个实体: 快照 %d 字节, 重放差异 %d, 增量 %d 字节 (未改变 %d 字节, 改一个控制量 %d 字节), 增量恢复差异 %d, 保存+恢复 %.2f us, 仅保存 %.2f us\n",
+		source->aircraft_count + source->missile_count, size, replay_diff, delta_size, unchanged_size, handle_size, delta_diff,
+		round_trip * 1e6, save_only * 1e6);
+
+	delete source;
+	delete replay;
+	delete branch;
+	delete restored;
+	return mismatch;
+}
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          战场快照计时与复现检查
+*   @details        分别检查1对飞机无导弹和8对飞机16枚导弹两种规模，以及跨快照的待触发事件
+*   @param[in]      argv[0]         计时重复次数，缺省200000
+*   @retval         0               通过
+*   @retval         1               重放、增量恢复、增量大小或事件触发结果不一致
+*/
+int CheckSnapshot(int argc, char* argv[])
+{
+	int repeat = CheckArgInt(argc, argv, 0, 200000);
+	if (repeat < 1) {
+		printf("参数无效\n");
+		return 1;
+	}
+	printf("快照容量 %d 字节\n", Battlefield_C::SnapshotCapacity());
+	int mismatch = CheckScale(1, 0, repeat) + CheckScale(8, 16, repeat) + CheckPendingEvent();
+	return (mismatch == 0) ? 0 : 1;
+}
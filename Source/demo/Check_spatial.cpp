@@ -0,0 +1,195 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           Check_spatial.cpp
+*   @brief          空间索引计时与正确性检查。
+*   @details        一半实体均匀分布、一半成簇分布，分别以网格和 BVH 模式重建索引并做半径、锥形、k近邻查询，
+					记录每次调用的平均耗时，查询结果与逐个比较的结果对照。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+#include "Check_demo.h"
+#include "../CombatSimulation/SpatialIndex.h"
+#include "../Tools/tool_function.h"
+
+#include <stdio.h>
+#include <math.h>
+#include <algorithm>
+#include <vector>
+using namespace CombatSimulation;
+
+static const double check_cell_size = 5000;			//网格边长，单位：米
+static const double check_radius = 8000;			//半径查询，单位：米
+static const double check_cone_range = 30000;		//锥形查询作用距离，单位：米
+static const double check_cone_half_angle = 0.5;	//锥形查询半锥角，单位：弧度
+static const int check_knn = 8;						//近邻数量
+static const int check_query_count = 200;			//每种查询的次数
+
+//一半均匀分布在 200km 见方内，一半分为10簇，每簇标准差 3km
+static void MakeEntities(std::vector<double>& x, std::vector<double>& y, std::vector<double>& z, int count)
+{
+	GaussRand_T rand_state;
+	gaussrand_init(&rand_state, 27);
+	x.resize(count);
+	y.resize(count);
+	z.resize(count);
+	double g[3];
+	for (int i = 0; i < count; i++) {
+		for (int k = 0; k < 3; k++) {
+			gaussrand(&g[k], &rand_state);
+		}
+		if (i % 2 == 0) {
+			//高斯值经误差函数变为均匀分布
+			x[i] = 100000.0 * erf(g[0] / sqrt(2.0));
+			y[i] = 100000.0 * erf(g[1] / sqrt(2.0));
+			z[i] = -6000.0 + 3000.0 * erf(g[2] / sqrt(2.0));
+		}
+		else {
+			int cluster = (i / 2) % 10;
+			x[i] = -80000.0 + 16000.0 * cluster + 3000.0 * g[0];
+			y[i] = 40000.0 * ((cluster % 3) - 1) + 3000.0 * g[1];
+			z[i] = -6000.0 + 500.0 * g[2];
+		}
+	}
+}
+
+//逐个比较的半径查询
+static void BruteRadius(std::vector<int>& out, const std::vector<double>& x, const std::vector<double>& y, const std::vector<double>& z,
+	const Eigen::Vector3d& center, double radius)
+{
+	out.clear();
+	for (size_t i = 0; i < x.size(); i++) {
+		Eigen::Vector3d d(x[i] - center(0), y[i] - center(1), z[i] - center(2));
+		if (d.norm() <= radius) {
+			out.push_back((int)i);
+		}
+	}
+}
+
+//逐个比较的锥形查询
+static void BruteCone(std::vector<int>& out, const std::vector<double>& x, const std::vector<double>& y, const std::vector<double>& z,
+	const Eigen::Vector3d& apex, const Eigen::Vector3d& dir, double half_angle, double range)
+{
+	out.clear();
+	Eigen::Vector3d axis = dir.normalized();
+	double cos_half = cos(half_angle);
+	for (size_t i = 0; i < x.size(); i++) {
+		Eigen::Vector3d d(x[i] - apex(0), y[i] - apex(1), z[i] - apex(2));
+		double distance = d.norm();
+		if (distance <= range && d.dot(axis) >= cos_half * distance) {
+			out.push_back((int)i);
+		}
+	}
+}
+
+//逐个比较的k近邻查询，返回第k近的距离
+static double BruteNearest(const std::vector<double>& x, const std::vector<double>& y, const std::vector<double>& z,
+	const Eigen::Vector3d& center, int k, int exclude_id)
+{
+	std::vector<double> dist;
+	for (size_t i = 0; i < x.size(); i++) {
+		if ((int)i == exclude_id) {
+			continue;
+		}
+		dist.push_back(Eigen::Vector3d(x[i] - center(0), y[i] - center(1), z[i] - center(2)).norm());
+	}
+	std::sort(dist.begin(), dist.end());
+	return dist.empty() ? 0 : dist[std::min(k, (int)dist.size()) - 1];
+}
+
+//同一组实体、同一模式下的计时与对照，返回不一致的查询数
+static int CheckMode(int mode, int count)
+{
+	std::vector<double> x, y, z;
+	MakeEntities(x, y, z, count);
+	std::vector<int> id(count);
+	for (int i = 0; i < count; i++) {
+		id[i] = i;
+	}
+
+	SpatialIndex_C index;
+	index.SetMode(mode, check_cell_size);
+	int build_repeat = (count <= 1000) ? 1000 : 20;
+	double t0 = CheckClock();
+	for (int r = 0; r < build_repeat; r++) {
+		index.Build(x.data(), y.data(), z.data(), id.data(), count);
+	}
+	double build_time = (CheckClock() - t0) / build_repeat;
+
+	//查询中心取实体位置，方向按编号变化
+	std::vector<int> result(count);
+	std::vector<double> result_dist(check_knn);
+	int result_count;
+	double time_radius = 0, time_cone = 0, time_knn = 0;
+	int mismatch = 0;
+	std::vector<int> expect;
+	for (int q = 0; q < check_query_count; q++) {
+		int center_id = (int)(((long long)q * 7919) % count);
+		Eigen::Vector3d center(x[center_id], y[center_id], z[center_id]);
+		Eigen::Vector3d dir(cos(0.1 * q), sin(0.1 * q), 0.05);
+
+		t0 = CheckClock();
+		index.QueryRadius(result.data(), &result_count, count, center, check_radius);
+		time_radius += CheckClock() - t0;
+		BruteRadius(expect, x, y, z, center, check_radius);
+		std::sort(result.begin(), result.begin() + result_count);
+		mismatch += (result_count != (int)expect.size() || !std::equal(expect.begin(), expect.end(), result.begin()));
+
+		t0 = CheckClock();
+		index.QueryCone(result.data(), &result_count, count, center, dir, check_cone_half_angle, check_cone_range);
+		time_cone += CheckClock() - t0;
+		BruteCone(expect, x, y, z, center, dir, check_cone_half_angle, check_cone_range);
+		std::sort(result.begin(), result.begin() + result_count);
+		mismatch += (result_count != (int)expect.size() || !std::equal(expect.begin(), expect.end(), result.begin()));
+
+		t0 = CheckClock();
+		index.QueryNearest(result.data(), result_dist.data(), &result_count, check_knn, center, center_id);
+		time_knn += CheckClock() - t0;
+		double kth = BruteNearest(x, y, z, center, check_knn, center_id);
+		mismatch += (result_count != std::min(check_knn, count - 1) || fabs(result_dist[result_count - 1] - kth) > 1e-6);
+	}
+
+	printf("%-4s n=%-6d build %9.1f us, radius %7.1f us, cone %7.1f us, knn %6.1f us, 不一致 %d\n",
+		(mode == SI_GRID) ? "grid" : "bvh", count, build_time * 1e6,
+		time_radius / check_query_count * 1e6, time_cone / check_query_count * 1e6, time_knn / check_query_count * 1e6, mismatch);
+	return mismatch;
+}
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          空间索引计时与正确性检查
+*   @details        网格边长 5km，半径查询 8km，锥形查询 30km，k=8
+*   @param[in]      argv[0]         实体数量，缺省依次取 100、10000、50000
+*   @retval         0               通过
+*   @retval         1               查询结果与逐个比较不一致
+*/
+int CheckSpatialIndex(int argc, char* argv[])
+{
+	std::vector<int> count_list;
+	if (argc > 0) {
+		count_list.push_back(CheckArgInt(argc, argv, 0, 100));
+	}
+	else {
+		count_list.push_back(100);
+		count_list.push_back(10000);
+		count_list.push_back(50000);
+	}
+
+	int mismatch = 0;
+	for (int mode = SI_GRID; mode <= SI_BVH; mode++) {
+		for (size_t i = 0; i < count_list.size(); i++) {
+			if (count_list[i] < 2) {
+				printf("参数无效\n");
+				return 1;
+			}
+			mismatch += CheckMode(mode, count_list[i]);
+		}
+	}
+	return (mismatch == 0) ? 0 : 1;
+}
@@ -0,0 +1,174 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           Check_terrain.cpp
+*   @brief          地形高程图检查。
+*   @details        生成合成高程图，通视查询与沿射线密集采样的结果比较，记录批量通视和批量离地高度的吞吐量。
+					高程图写在当前目录，检查结束后删除。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+#include "Check_demo.h"
+#include "../Tools/terrain_map.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <vector>
+
+static const double check_cell_size = 30;			//高程点间隔，单位：米
+static const double check_max_height = 3000;		//最大高程，单位：米
+static const int check_ray_count = 20000;			//与密集采样比较的射线数
+static const int check_batch_count = 1000000;		//计时的射线数、离地高度查询数
+static const double check_margin = 1e-3;			//射线离地高度在此以内时密集采样本身不可靠，不比较，单位：米
+
+//沿射线每 1/16 个高程点间隔采样，返回是否通视，margin 为各采样点离地高度的最小值
+static bool SampleLineOfSight(const TerrainMap_C& map, const double a[3], const double b[3], double* margin)
+{
+	double length = sqrt((a[0] - b[0]) * (a[0] - b[0]) + (a[2] - b[2]) * (a[2] - b[2]));
+	int n = (int)(length / map.Header()->cell_size * 16) + 2;
+	double lowest = 1e30;
+	for (int i = 0; i <= n; i++) {
+		double t = (double)i / n;
+		double p[3];
+		for (int k = 0; k < 3; k++) {
+			p[k] = a[k] + (b[k] - a[k]) * t;
+		}
+		double d = p[1] - map.Height(p[0], p[2]);
+		lowest = (d < lowest) ? d : lowest;
+	}
+	*margin = lowest;
+	return lowest >= 0;
+}
+
+//通视查询与密集采样不同时返回1，射线贴近地形时不计
+static int CompareLineOfSight(const TerrainMap_C& map, const double a[3], const double b[3])
+{
+	double margin;
+	bool sampled = SampleLineOfSight(map, a, b, &margin);
+	return (map.LineOfSight(a, b) != sampled && fabs(margin) > check_margin) ? 1 : 0;
+}
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          地形高程图检查
+*   @details        生成 30m 间隔、最大高程 3000m 的分形地形；20000 条 2 ~ 32km 长、离地 10 ~ 2010m 的随机射线
+					与密集采样比较，另检查沿坐标轴、斜穿全图和起于图角的射线；记录离地 3 ~ 12km、50 ~ 1550m 两种
+					射线的批量通视吞吐量和批量离地高度吞吐量
+*   @param[in]      argv[0]         每个方向的高程点数，缺省4097
+*   @retval         0               通过
+*   @retval         1               未通过
+*/
+int CheckTerrainMap(int argc, char* argv[])
+{
+	int size = CheckArgInt(argc, argv, 0, 4097);
+	if (size < 2) {
+		printf("参数无效\n");
+		return 1;
+	}
+
+	const char* terrain_path = "check_terrain.bin";
+	if (TerrainMap_C::Generate(terrain_path, size, size, check_cell_size, check_max_height, 12345) != 0) {
+		printf("无法写入 %s\n", terrain_path);
+		return 1;
+	}
+	TerrainMap_C map;
+	if (map.Open(terrain_path) != 0) {
+		printf("无法打开 %s\n", terrain_path);
+		remove(terrain_path);
+		return 1;
+	}
+	double extent = (size - 1) * check_cell_size;
+	printf("%dx%d 高程点, 金字塔 %d 层, 最高点 %.1f m\n", size, size, map.LevelCount(), map.MaxHeight());
+
+	//随机射线
+	int mismatch = 0;
+	int blocked = 0;
+	for (int i = 0; i < check_ray_count; i++) {
+		double u[6];
+		for (int k = 0; k < 6; k++) {
+			u[k] = CheckUniform(50, 0, (unsigned int)i, k);
+		}
+		double range = 2000 + u[2] * 30000;
+		double heading = u[3] * 6.283;
+		double a[3] = { u[0] * extent, 0, u[1] * extent };
+		double b[3] = { a[0] + range * cos(heading), 0, a[2] + range * sin(heading) };
+		a[1] = map.Height(a[0], a[2]) + 10 + u[4] * 2000;
+		b[1] = map.Height(b[0], b[2]) + 10 + u[5] * 2000;
+		blocked += !map.LineOfSight(a, b);
+		mismatch += CompareLineOfSight(map, a, b);
+	}
+
+	//沿坐标轴高于最高点、斜穿全图贴近地面、起于图角
+	double axis_a[3] = { 100 * check_cell_size, check_max_height + 2000, 0 };
+	double axis_b[3] = { 100 * check_cell_size, check_max_height + 2000, extent };
+	double diagonal_a[3] = { -1000, 10, -1000 };
+	double diagonal_b[3] = { extent + 1000, 10, extent + 1000 };
+	double corner_a[3] = { extent, 0, extent };
+	double corner_b[3] = { extent - 3000, map.MaxHeight() + 1, extent - 3000 };
+	int edge_mismatch = !map.LineOfSight(axis_a, axis_b);
+	edge_mismatch += CompareLineOfSight(map, diagonal_a, diagonal_b);
+	edge_mismatch += CompareLineOfSight(map, corner_a, corner_b);
+	printf("%d 条随机射线: 遮挡 %d, 与密集采样不同 %d; 特殊射线不同 %d\n", check_ray_count, blocked, mismatch, edge_mismatch);
+
+	//批量通视吞吐量
+	std::vector<double> from[3], to[3];
+	for (int k = 0; k < 3; k++) {
+		from[k].resize(check_batch_count);
+		to[k].resize(check_batch_count);
+	}
+	std::vector<unsigned char> visible(check_batch_count);
+	const char* scene_name[2] = { "离地 3 ~ 12km", "离地 50 ~ 1550m" };
+	for (int scene = 0; scene < 2; scene++) {
+		for (int i = 0; i < check_batch_count; i++) {
+			double u[6];
+			for (int k = 0; k < 6; k++) {
+				u[k] = CheckUniform(50, 1 + scene, (unsigned int)i, k);
+			}
+			double range = 5000 + u[2] * 60000;
+			double heading = u[3] * 6.283;
+			from[0][i] = u[0] * extent;
+			from[2][i] = u[1] * extent;
+			to[0][i] = from[0][i] + range * cos(heading);
+			to[2][i] = from[2][i] + range * sin(heading);
+			from[1][i] = map.Height(from[0][i], from[2][i]) + ((scene == 0) ? 3000 + u[4] * 9000 : 50 + u[4] * 1500);
+			to[1][i] = map.Height(to[0][i], to[2][i]) + ((scene == 0) ? 3000 + u[5] * 9000 : 50 + u[5] * 1500);
+		}
+		const double* from_list[3] = { from[0].data(), from[1].data(), from[2].data() };
+		const double* to_list[3] = { to[0].data(), to[1].data(), to[2].data() };
+		double t0 = CheckClock();
+		map.LineOfSightBatch((bool*)visible.data(), from_list, to_list, check_batch_count);
+		double batch_time = CheckClock() - t0;
+		int visible_count = 0;
+		for (int i = 0; i < check_batch_count; i++) {
+			visible_count += visible[i];
+		}
+		printf("%s: %.2f M 条射线/s, 通视 %.1f%%\n", scene_name[scene], check_batch_count / batch_time / 1e6,
+			100.0 * visible_count / check_batch_count);
+	}
+
+	//批量离地高度吞吐量
+	std::vector<double> north(check_batch_count), east(check_batch_count), altitude(check_batch_count), hag(check_batch_count);
+	for (int i = 0; i < check_batch_count; i++) {
+		north[i] = CheckUniform(50, 3, (unsigned int)i, 0) * extent;
+		east[i] = CheckUniform(50, 3, (unsigned int)i, 1) * extent;
+		altitude[i] = CheckUniform(50, 3, (unsigned int)i, 2) * 4000;
+	}
+	double t0 = CheckClock();
+	map.HeightAboveGroundBatch(hag.data(), north.data(), east.data(), altitude.data(), check_batch_count);
+	double hag_time = CheckClock() - t0;
+	int crashed = 0;
+	for (int i = 0; i < check_batch_count; i++) {
+		crashed += (hag[i] <= 0);
+	}
+	printf("离地高度: %.1f M 次/s, 触地 %d\n", check_batch_count / hag_time / 1e6, crashed);
+
+	map.Close();
+	remove(terrain_path);
+	return (mismatch == 0 && edge_mismatch == 0) ? 0 : 1;
+}
@@ -0,0 +1,163 @@
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @file           Check_track.cpp
+*   @brief          雷达航迹表检查。
+*   @details        多部雷达跟踪蛇形机动的目标，比较每步全部探测与按航迹表重访探测的探测次数和耗时，
+					统计确认航迹与每步探测结果一致的比例和外推位置误差。
+*   @author         agent
+*   @date           20261018
+*   @version        1.0.0.1
+*   @par Copyright
+*                   GaoYang
+*   @par History
+*                   1.0.0.1: agent, 20261018, 首次创建
+*
+*/
+
+#include "Check_demo.h"
+#include "../Sensor/radar_model.h"
+#include "../Sensor/radar_track.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <vector>
+
+static const double check_step = 0.05;				//仿真步长，单位：秒
+static const int check_lock_step = 400;				//各雷达锁定第一条确认航迹的步数
+static const int check_settle_step = 100;			//开始统计外推误差的步数
+static const double check_min_agree = 0.95;			//确认航迹与每步探测结果一致的最小比例
+
+// --------------------------------------------------------------------------------------------------------------------------------
+/**
+*   @brief          雷达航迹表检查
+*   @details        雷达与目标在 80km 见方、高度 3 ~ 11km 内，以 250m/s 匀速飞行，目标航向按正弦规律蛇形变化。
+					每步对全部目标对探测作为基准；航迹表只探测 NeedDetect 选出的目标，并在第 400 步锁定一条确认航迹。
+					探测次数须减少，确认航迹与每步探测结果一致的比例不低于 95%
+*   @param[in]      argv[0]         雷达数量，缺省20
+*   @param[in]      argv[1]         目标数量，缺省100
+*   @param[in]      argv[2]         步数，缺省1200
+*   @retval         0               通过
+*   @retval         1               未通过
+*/
+int CheckRadarTrack(int argc, char* argv[])
+{
+	int radar_count = CheckArgInt(argc, argv, 0, 20);
+	int target_count = CheckArgInt(argc, argv, 1, 100);
+	int step_count = CheckArgInt(argc, argv, 2, 1200);
+	if (radar_count < 1 || target_count < 1 || step_count <= check_settle_step) {
+		printf("参数无效\n");
+		return 1;
+	}
+
+	//第 i 个为飞机，前 radar_count 个为雷达；位置(北，天，东)，姿态(滚转，偏航，俯仰)
+	int count = radar_count + target_count;
+	std::vector<double> position(3 * count), velocity(3 * count), attitude(3 * count);
+	for (int i = 0; i < count; i++) {
+		double heading = CheckUniform(49, 0, (unsigned int)i, 3) * 6.28;
+		position[3 * i] = (CheckUniform(49, 0, (unsigned int)i, 0) - 0.5) * 80000;
+		position[3 * i + 1] = 3000 + CheckUniform(49, 0, (unsigned int)i, 1) * 8000;
+		position[3 * i + 2] = (CheckUniform(49, 0, (unsigned int)i, 2) - 0.5) * 80000;
+		velocity[3 * i] = 250 * cos(heading);
+		velocity[3 * i + 1] = 0;
+		velocity[3 * i + 2] = 250 * sin(heading);
+		attitude[3 * i] = 0;
+		attitude[3 * i + 1] = -heading;
+		attitude[3 * i + 2] = 0;
+	}
+	double sigma[5] = { 5, 5, 5, 5, 5 };
+
+	RadarModel_C model;
+	std::vector<RadarTrack_C> track(radar_count);
+	std::vector<int> confirmed_id(target_count);
+	std::vector<char> raw(radar_count * target_count);
+	std::vector<char> previous_raw(radar_count * target_count, 0);
+	std::vector<char> previous_track(radar_count * target_count, 0);
+	long long full_call = 0, track_call = 0;
+	double full_time = 0, track_time = 0;
+	long long agree = 0, total = 0;
+	long long raw_toggle = 0, track_toggle = 0;
+	double error_sum = 0, error_max = 0;
+	long long error_count = 0;
+	for (int s = 0; s < step_count; s++) {
+		double time = s * check_step;
+		for (int i = 0; i < 3 * count; i++) {
+			position[i] += velocity[i] * check_step;
+		}
+		for (int i = radar_count; i < count; i++) {
+			double turn = 0.2 * sin(0.3 * time + i) * check_step;
+			double north = velocity[3 * i];
+			double east = velocity[3 * i + 2];
+			velocity[3 * i] = cos(turn) * north - sin(turn) * east;
+			velocity[3 * i + 2] = sin(turn) * north + cos(turn) * east;
+		}
+
+		//每步全部探测
+		double t0 = CheckClock();
+		for (int r = 0; r < radar_count; r++) {
+			for (int j = 0; j < target_count; j++) {
+				bool finded = false;
+				double Pgr = 0;
+				model.Detect(&finded, &Pgr, &position[3 * r], &attitude[3 * r], &position[3 * (radar_count + j)],
+					&attitude[3 * (radar_count + j)], sigma);
+				raw[r * target_count + j] = finded;
+				full_call++;
+			}
+		}
+		full_time += CheckClock() - t0;
+
+		//按航迹表探测
+		t0 = CheckClock();
+		for (int r = 0; r < radar_count; r++) {
+			for (int j = 0; j < target_count; j++) {
+				if (!track[r].NeedDetect(j, time)) {
+					continue;
+				}
+				bool finded = false;
+				double Pgr = 0;
+				model.Detect(&finded, &Pgr, &position[3 * r], &attitude[3 * r], &position[3 * (radar_count + j)],
+					&attitude[3 * (radar_count + j)], sigma);
+				track[r].Update(j, finded, &position[3 * (radar_count + j)], time);
+				track_call++;
+			}
+			if (s == check_lock_step && track[r].TrackCount() > 0) {
+				if (track[r].ConfirmedList(confirmed_id.data(), target_count) > 0) {
+					track[r].Lock(confirmed_id[0]);
+				}
+			}
+			track[r].Step(time);
+		}
+		track_time += CheckClock() - t0;
+
+		for (int r = 0; r < radar_count; r++) {
+			for (int j = 0; j < target_count; j++) {
+				int k = r * target_count + j;
+				const RadarTrack_T* t = track[r].Find(j);
+				char confirmed = (t != NULL && t->state == RADAR_TRACK_CONFIRMED);
+				agree += (confirmed == raw[k]);
+				total++;
+				raw_toggle += (raw[k] != previous_raw[k]);
+				track_toggle += (confirmed != previous_track[k]);
+				previous_raw[k] = raw[k];
+				previous_track[k] = confirmed;
+				if (confirmed && s > check_settle_step) {
+					double e[3];
+					RadarTrack_C::Extrapolate(e, *t, time);
+					const double* p = &position[3 * (radar_count + j)];
+					double d = sqrt((e[0] - p[0]) * (e[0] - p[0]) + (e[1] - p[1]) * (e[1] - p[1]) + (e[2] - p[2]) * (e[2] - p[2]));
+					error_sum += d;
+					error_max = (d > error_max) ? d : error_max;
+					error_count++;
+				}
+			}
+		}
+	}
+
+	double agree_ratio = (double)agree / total;
+	printf("%d 部雷达 x %d 个目标 x %d 步: 探测次数 每步全部 %lld, 航迹表 %lld (%.1fx) | 耗时 %.1f ms 对 %.1f ms\n",
+		radar_count, target_count, step_count, full_call, track_call, (double)full_call / (track_call > 0 ? track_call : 1),
+		full_time * 1e3, track_time * 1e3);
+	printf("确认航迹与每步探测一致 %.2f%% | 状态切换 每步探测 %lld, 航迹表 %lld\n", 100 * agree_ratio, raw_toggle, track_toggle);
+	printf("外推位置误差: 平均 %.1f m, 最大 %.1f m, 共 %lld 个航迹步\n", (error_count > 0) ? error_sum / error_count : 0,
+		error_max, error_count);
+	return (track_call < full_call && agree_ratio >= check_min_agree) ? 0 : 1;
+}